@@ -1,5 +1,5 @@
 #include "AIController.hpp"
-#include <random>
+#include "../Core/WorldSeed.hpp"
 #include <godot_cpp/core/class_db.hpp>
 
 void AIController::_bind_methods() {
@@ -12,6 +12,9 @@ AIController::AIController() = default;
 void AIController::set_start_city(const std::shared_ptr<City>& startCity) {
     currentCity = startCity;
     visitedCities.push_back(currentCity);
+    route_stream = Core::WorldSeed::get_instance().derive("ai_controller");
+    route_entity = godot::String(get_path()).hash();
+    moves = 0;
 }
 
 void AIController::move_to_next_city() {
@@ -19,16 +22,15 @@ void AIController::move_to_next_city() {
         return;
     }
 
-    static thread_local std::mt19937 rng(std::random_device{}());
     const auto& connected_cities = currentCity->get_connected_cities();
-    std::uniform_int_distribution<size_t> dist(0, connected_cities.size() - 1);
+    uint64_t roll = Core::WorldSeed::draw(route_stream, route_entity, moves++);
     
     const size_t batch_size = 8; // AVX register size
     if (connected_cities.size() >= batch_size) {
         update_positions_simd(connected_cities.data(), batch_size);
     }
 
-    auto nextCity = connected_cities[dist(rng)];
+    auto nextCity = connected_cities[roll % connected_cities.size()];
     currentCity = nextCity;
 
     CacheOptimizer<City>::prefetch_data(nextCity.get(), 1);
@@ -10,6 +10,11 @@ class AIController : public godot::Node {
 private:
     std::shared_ptr<City> currentCity;
     std::vector<std::shared_ptr<City>> visitedCities;
+    // Route choices are WorldSeed draws keyed by this controller's node
+    // path and its move count, so a replay retraces the route
+    uint64_t route_stream{0};
+    uint64_t route_entity{0};
+    uint64_t moves{0};
 
 protected:
     static void _bind_methods();
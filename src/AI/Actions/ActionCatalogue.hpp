@@ -0,0 +1,223 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <immintrin.h>
+#include "../Core/DynamicBitset.hpp"
+#include "../Core/StringInterner.hpp"
+
+// Dense, column-oriented view of the action pool used to answer "which
+// actions can each species discover" in bulk.
+//
+// Actions: per-dimension requirement columns padded to a multiple of 8,
+// a discoverable flag, and per-trait bitsets of the actions requiring
+// that trait. Species: one capability row, a trait bitset and a
+// known-action bitset. Eligibility compares 8 actions per AVX step and
+// writes the result straight into 64-bit bitset words.
+class ActionCatalogue {
+public:
+    using ActionId = uint32_t;
+    using SpeciesIndex = uint32_t;
+    using TraitId = StringInterner::Id;
+
+    enum Dimension : size_t {
+        COGNITIVE = 0,
+        PHYSICAL = 1,
+        SOCIAL = 2,
+        TECH = 3,
+        DIMENSION_COUNT = 4
+    };
+
+    struct Capabilities {
+        float values[DIMENSION_COUNT]{0.5f, 0.5f, 0.5f, 0.5f};
+    };
+
+private:
+    static constexpr size_t LANES = 8;
+
+    StringInterner action_ids;
+    StringInterner trait_ids;
+
+    // Requirement columns; padding lanes hold +inf so they never qualify
+    std::vector<float> requirements[DIMENSION_COUNT];
+    DynamicBitset discoverable;
+    std::vector<DynamicBitset> actions_requiring_trait;
+
+    struct SpeciesRow {
+        Capabilities capabilities;
+        DynamicBitset traits;
+        DynamicBitset known;
+    };
+    std::unordered_map<std::string, SpeciesIndex> species_lookup;
+    std::vector<SpeciesRow> species;
+
+    // Scratch for eligibility
+    DynamicBitset blocked;
+
+public:
+    ActionId add_action(const std::string& action_id,
+                        const float (&required)[DIMENSION_COUNT],
+                        const std::vector<std::string>& required_traits,
+                        bool can_be_innovated) {
+        ActionId id = action_ids.intern(action_id);
+        if (id >= action_count_padded()) grow_actions(static_cast<size_t>(id) + 1);
+
+        for (size_t dim = 0; dim < DIMENSION_COUNT; ++dim) {
+            requirements[dim][id] = required[dim];
+        }
+        if (can_be_innovated) discoverable.set(id); else discoverable.reset(id);
+
+        for (auto& requiring : actions_requiring_trait) requiring.reset(id);
+        for (TraitId trait : trait_ids.intern_set(required_traits)) {
+            trait_bitset(trait).set(id);
+        }
+        return id;
+    }
+
+    ActionId find_action(const std::string& action_id) const {
+        return action_ids.find(action_id);
+    }
+
+    const std::string& action_name(ActionId id) const { return action_ids.name(id); }
+    size_t action_count() const { return action_ids.size(); }
+
+    SpeciesIndex get_species(const std::string& species_id) {
+        auto [it, inserted] = species_lookup.try_emplace(
+            species_id, static_cast<SpeciesIndex>(species.size()));
+        if (inserted) {
+            species.emplace_back();
+            species.back().known = DynamicBitset(action_count_padded());
+            species.back().traits = DynamicBitset(trait_ids.size());
+        }
+        return it->second;
+    }
+
+    void set_capabilities(SpeciesIndex index, const Capabilities& capabilities) {
+        species[index].capabilities = capabilities;
+    }
+
+    const Capabilities& get_capabilities(SpeciesIndex index) const {
+        return species[index].capabilities;
+    }
+
+    // Traits are interned even if no action requires them yet, so an
+    // action added later with that requirement sees the species has it
+    void set_traits(SpeciesIndex index, const std::vector<std::string>& traits) {
+        std::vector<TraitId> ids = trait_ids.intern_set(traits);
+        auto& row = species[index].traits;
+        row = DynamicBitset(trait_ids.size());
+        for (TraitId id : ids) row.set(id);
+    }
+
+    void mark_known(SpeciesIndex index, ActionId action) {
+        species[index].known.set(action);
+    }
+
+    bool is_known(SpeciesIndex index, ActionId action) const {
+        return species[index].known.test(action);
+    }
+
+    const DynamicBitset& known_actions(SpeciesIndex index) const {
+        return species[index].known;
+    }
+
+    // Single-action check; use eligible_actions when asking about many
+    bool is_eligible(SpeciesIndex index, ActionId action) const {
+        const SpeciesRow& row = species[index];
+        for (size_t dim = 0; dim < DIMENSION_COUNT; ++dim) {
+            if (row.capabilities.values[dim] < requirements[dim][action]) return false;
+        }
+        for (TraitId trait = 0; trait < actions_requiring_trait.size(); ++trait) {
+            if (actions_requiring_trait[trait].test(action) &&
+                (trait >= row.traits.size() || !row.traits.test(trait))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Actions whose requirements and traits the species meets, whether or
+    // not it already knows them or they can be innovated
+    void eligible_actions(SpeciesIndex index, DynamicBitset& out) {
+        const SpeciesRow& row = species[index];
+        out = DynamicBitset(action_count_padded());
+        compare_requirements(row.capabilities, out.data());
+
+        // Drop actions requiring any trait the species lacks
+        blocked = DynamicBitset(action_count_padded());
+        for (TraitId trait = 0; trait < actions_requiring_trait.size(); ++trait) {
+            if (trait >= row.traits.size() || !row.traits.test(trait)) {
+                blocked |= actions_requiring_trait[trait];
+            }
+        }
+        out.and_not(blocked);
+    }
+
+    // For each species, the actions it could newly discover this tick:
+    // eligible, innovatable and not yet known
+    void discoverable_actions(const std::vector<SpeciesIndex>& indices,
+                              std::vector<DynamicBitset>& out) {
+        out.resize(indices.size());
+        for (size_t i = 0; i < indices.size(); ++i) {
+            eligible_actions(indices[i], out[i]);
+            out[i] &= discoverable;
+            out[i].and_not(species[indices[i]].known);
+        }
+    }
+
+private:
+    size_t action_count_padded() const { return requirements[0].size(); }
+
+    void grow_actions(size_t min_count) {
+        size_t padded = (min_count + LANES - 1) / LANES * LANES;
+        // Grow in whole 64-action words to keep bitset resizes rare
+        padded = (padded + 63) / 64 * 64;
+        for (auto& column : requirements) {
+            column.resize(padded, std::numeric_limits<float>::infinity());
+        }
+        discoverable.resize(padded);
+        for (auto& requiring : actions_requiring_trait) requiring.resize(padded);
+        for (auto& row : species) row.known.resize(padded);
+    }
+
+    DynamicBitset& trait_bitset(TraitId trait) {
+        if (trait >= actions_requiring_trait.size()) {
+            actions_requiring_trait.resize(static_cast<size_t>(trait) + 1,
+                                           DynamicBitset(action_count_padded()));
+            for (auto& row : species) row.traits.resize(trait_ids.size());
+        }
+        return actions_requiring_trait[trait];
+    }
+
+    // Writes one bit per action: capability >= requirement in every dimension
+    void compare_requirements(const Capabilities& caps, uint64_t* words) const {
+        const size_t count = action_count_padded();
+#if defined(__AVX__)
+        const __m256 cap[DIMENSION_COUNT] = {
+            _mm256_set1_ps(caps.values[COGNITIVE]),
+            _mm256_set1_ps(caps.values[PHYSICAL]),
+            _mm256_set1_ps(caps.values[SOCIAL]),
+            _mm256_set1_ps(caps.values[TECH])
+        };
+        for (size_t i = 0; i < count; i += LANES) {
+            __m256 ok = _mm256_cmp_ps(cap[0], _mm256_loadu_ps(&requirements[0][i]), _CMP_GE_OQ);
+            for (size_t dim = 1; dim < DIMENSION_COUNT; ++dim) {
+                ok = _mm256_and_ps(ok, _mm256_cmp_ps(
+                    cap[dim], _mm256_loadu_ps(&requirements[dim][i]), _CMP_GE_OQ));
+            }
+            uint64_t mask = static_cast<uint64_t>(_mm256_movemask_ps(ok));
+            words[i / 64] |= mask << (i % 64);
+        }
+#else
+        for (size_t i = 0; i < count; ++i) {
+            bool ok = true;
+            for (size_t dim = 0; dim < DIMENSION_COUNT; ++dim) {
+                ok &= caps.values[dim] >= requirements[dim][i];
+            }
+            if (ok) words[i / 64] |= uint64_t{1} << (i % 64);
+        }
+#endif
+    }
+};
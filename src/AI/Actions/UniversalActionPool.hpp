@@ -3,6 +3,8 @@
 #include <string>
 #include <vector>
 #include <random>
+#include "../../Core/WorldSeed.hpp"
+#include "ActionCatalogue.hpp"
 
 class UniversalActionPool {
 public:
@@ -44,8 +46,9 @@ public:
 private:
     std::unordered_map<std::string, UniversalAction> action_pool;
     
-    // Track which species have discovered which actions
-    std::unordered_map<std::string, std::vector<std::string>> species_actions;
+    // Dense requirement columns plus per-species capability rows and
+    // known-action bitsets; answers eligibility without string searches
+    ActionCatalogue catalogue;
     
     // Track historical first discoveries
     struct Discovery {
@@ -64,24 +67,33 @@ private:
     };
 
     Capabilities get_species_capabilities(const std::string& species_id) {
-        // TODO: Implement actual capability lookup
-        return {0.5f, 0.5f, 0.5f, 0.5f}; // Default values
+        const auto& caps = catalogue.get_capabilities(catalogue.get_species(species_id));
+        return {
+            caps.values[ActionCatalogue::COGNITIVE],
+            caps.values[ActionCatalogue::PHYSICAL],
+            caps.values[ActionCatalogue::SOCIAL],
+            caps.values[ActionCatalogue::TECH]
+        };
     }
 
     void add_action(const UniversalAction& action) {
         action_pool[action.id] = action;
-    }
 
-    bool has_required_traits(const std::string& species_id, 
-                           const std::vector<std::string>& required_traits) {
-        // TODO: Implement actual trait checking
-        return required_traits.empty(); // For now, only pass if no traits required
+        const auto& prereq = action.prerequisites;
+        catalogue.add_action(
+            action.id,
+            {prereq.cognitive_complexity,
+             prereq.physical_capability,
+             prereq.social_complexity,
+             prereq.technological_level},
+            prereq.required_traits,
+            action.transmission.can_be_innovated);
     }
 
     float random_float() {
         // Create static random number generator for reuse
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
+        static std::mt19937 gen(static_cast<std::mt19937::result_type>(
+            Core::WorldSeed::get_instance().derive("universal_action_pool")));
         static std::uniform_real_distribution<float> dist(0.0f, 1.0f);
         
         return dist(gen);
@@ -134,20 +146,55 @@ public:
         });
     }
 
+    void set_species_profile(const std::string& species_id,
+                             const Capabilities& capabilities,
+                             const std::vector<std::string>& traits) {
+        auto species = catalogue.get_species(species_id);
+        catalogue.set_capabilities(species, {{
+            capabilities.cognitive,
+            capabilities.physical,
+            capabilities.social,
+            capabilities.tech
+        }});
+        catalogue.set_traits(species, traits);
+    }
+
     bool can_species_learn_action(const std::string& species_id, 
                                 const std::string& action_id) {
-        const auto& action = action_pool[action_id];
-        const auto& prereq = action.prerequisites;
-        
-        // Get species capabilities
-        auto capabilities = get_species_capabilities(species_id);
-        
-        // Check if species meets requirements
-        return capabilities.cognitive >= prereq.cognitive_complexity &&
-               capabilities.physical >= prereq.physical_capability &&
-               capabilities.social >= prereq.social_complexity &&
-               capabilities.tech >= prereq.technological_level &&
-               has_required_traits(species_id, prereq.required_traits);
+        auto action = catalogue.find_action(action_id);
+        if (action == StringInterner::INVALID_ID) return false;
+
+        return catalogue.is_eligible(catalogue.get_species(species_id), action);
+    }
+
+    bool has_species_action(const std::string& species_id,
+                            const std::string& action_id) {
+        auto action = catalogue.find_action(action_id);
+        return action != StringInterner::INVALID_ID &&
+               catalogue.is_known(catalogue.get_species(species_id), action);
+    }
+
+    // Actions each species could newly innovate this tick, evaluated for
+    // the whole pool in one pass; result is index-aligned with species_ids
+    std::vector<std::vector<std::string>> find_discoverable_actions(
+        const std::vector<std::string>& species_ids) {
+        std::vector<ActionCatalogue::SpeciesIndex> indices;
+        indices.reserve(species_ids.size());
+        for (const auto& species_id : species_ids) {
+            indices.push_back(catalogue.get_species(species_id));
+        }
+
+        std::vector<DynamicBitset> discoverable;
+        catalogue.discoverable_actions(indices, discoverable);
+
+        std::vector<std::vector<std::string>> result(species_ids.size());
+        for (size_t i = 0; i < discoverable.size(); ++i) {
+            discoverable[i].for_each_set([&](size_t action) {
+                result[i].push_back(catalogue.action_name(
+                    static_cast<ActionCatalogue::ActionId>(action)));
+            });
+        }
+        return result;
     }
 
     bool attempt_action_discovery(const std::string& species_id,
@@ -234,7 +281,8 @@ private:
     void record_discovery(const std::string& species_id, 
                          const std::string& action_id,
                          bool was_taught = false) {
-        species_actions[species_id].push_back(action_id);
+        catalogue.mark_known(catalogue.get_species(species_id),
+                             catalogue.find_action(action_id));
         
         discovery_history.push_back({
             action_id,
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Growable bitset over dense integer IDs, stored as 64-bit words so set
+// operations run a word at a time.
+class DynamicBitset {
+private:
+    static constexpr size_t WORD_BITS = 64;
+    std::vector<uint64_t> words;
+    size_t bit_count{0};
+
+public:
+    DynamicBitset() = default;
+    explicit DynamicBitset(size_t bits) { resize(bits); }
+
+    void resize(size_t bits) {
+        bit_count = bits;
+        words.resize((bits + WORD_BITS - 1) / WORD_BITS, 0);
+        // Keep bits past the end cleared so count/any stay exact
+        if (bits % WORD_BITS != 0) {
+            words.back() &= (uint64_t{1} << (bits % WORD_BITS)) - 1;
+        }
+    }
+
+    size_t size() const { return bit_count; }
+    size_t word_count() const { return words.size(); }
+    const uint64_t* data() const { return words.data(); }
+    uint64_t* data() { return words.data(); }
+
+    void set(size_t bit) { words[bit / WORD_BITS] |= uint64_t{1} << (bit % WORD_BITS); }
+    void reset(size_t bit) { words[bit / WORD_BITS] &= ~(uint64_t{1} << (bit % WORD_BITS)); }
+    bool test(size_t bit) const {
+        return (words[bit / WORD_BITS] >> (bit % WORD_BITS)) & 1;
+    }
+
+    void clear() {
+        for (auto& word : words) word = 0;
+    }
+
+    bool any() const {
+        for (uint64_t word : words) {
+            if (word) return true;
+        }
+        return false;
+    }
+
+    size_t count() const {
+        size_t total = 0;
+        for (uint64_t word : words) {
+            total += static_cast<size_t>(__builtin_popcountll(word));
+        }
+        return total;
+    }
+
+    // Operands must have the same size
+    DynamicBitset& operator|=(const DynamicBitset& other) {
+        for (size_t i = 0; i < words.size(); ++i) words[i] |= other.words[i];
+        return *this;
+    }
+
+    DynamicBitset& operator&=(const DynamicBitset& other) {
+        for (size_t i = 0; i < words.size(); ++i) words[i] &= other.words[i];
+        return *this;
+    }
+
+    DynamicBitset& and_not(const DynamicBitset& other) {
+        for (size_t i = 0; i < words.size(); ++i) words[i] &= ~other.words[i];
+        return *this;
+    }
+
+    bool is_subset_of(const DynamicBitset& other) const {
+        for (size_t i = 0; i < words.size(); ++i) {
+            if (words[i] & ~other.words[i]) return false;
+        }
+        return true;
+    }
+
+    // Calls fn(bit) for every set bit in ascending order
+    template<typename F>
+    void for_each_set(F&& fn) const {
+        for (size_t i = 0; i < words.size(); ++i) {
+            uint64_t word = words[i];
+            while (word) {
+                size_t bit = static_cast<size_t>(__builtin_ctzll(word));
+                fn(i * WORD_BITS + bit);
+                word &= word - 1;
+            }
+        }
+    }
+};
@@ -1,24 +1,26 @@
 #pragma once
 #include <random>
+#include "../../Core/WorldSeed.hpp"
 
 class RandomGenerator {
 private:
-    static std::mt19937 rng;
-    static std::uniform_real_distribution<float> dist;
+    // Seeded from the world seed on first use, after a replay has set it
+    static std::mt19937& generator() {
+        static std::mt19937 rng(
+            static_cast<std::mt19937::result_type>(Core::WorldSeed::get_instance().derive("ai_random")));
+        return rng;
+    }
 
 public:
     static float get_random_float() {
-        return dist(rng);
+        return std::uniform_real_distribution<float>{0.0f, 1.0f}(generator());
     }
 
     static int get_random_int(int min, int max) {
-        return std::uniform_int_distribution<int>{min, max}(rng);
+        return std::uniform_int_distribution<int>{min, max}(generator());
     }
 
     static void seed(uint32_t seed) {
-        rng.seed(seed);
+        generator().seed(seed);
     }
 };
-
-std::mt19937 RandomGenerator::rng{std::random_device{}()};
-std::uniform_real_distribution<float> RandomGenerator::dist{0.0f, 1.0f}; 
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Maps strings to dense, stable integer IDs so hot paths can compare
+// and index by integer instead of hashing or comparing strings.
+class StringInterner {
+public:
+    using Id = uint32_t;
+    static constexpr Id INVALID_ID = static_cast<Id>(-1);
+
+private:
+    std::unordered_map<std::string, Id> ids;
+    std::vector<const std::string*> names;
+
+public:
+    Id intern(const std::string& value) {
+        auto [it, inserted] = ids.try_emplace(value, static_cast<Id>(names.size()));
+        if (inserted) {
+            // Node-based map keeps key addresses stable across rehashes
+            names.push_back(&it->first);
+        }
+        return it->second;
+    }
+
+    // Lookup without inserting; unknown strings return INVALID_ID
+    Id find(const std::string& value) const {
+        auto it = ids.find(value);
+        return it != ids.end() ? it->second : INVALID_ID;
+    }
+
+    const std::string& name(Id id) const {
+        return *names[id];
+    }
+
+    size_t size() const { return names.size(); }
+
+    // Interns every element and returns the IDs sorted and de-duplicated
+    std::vector<Id> intern_set(const std::vector<std::string>& values) {
+        std::vector<Id> result;
+        result.reserve(values.size());
+        for (const auto& value : values) {
+            result.push_back(intern(value));
+        }
+        sort_unique(result);
+        return result;
+    }
+
+    // Same as intern_set but skips strings that were never interned
+    std::vector<Id> find_set(const std::vector<std::string>& values) const {
+        std::vector<Id> result;
+        result.reserve(values.size());
+        for (const auto& value : values) {
+            Id id = find(value);
+            if (id != INVALID_ID) result.push_back(id);
+        }
+        sort_unique(result);
+        return result;
+    }
+
+    static void sort_unique(std::vector<Id>& values) {
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+    }
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include "../Actions/UniversalActionPool.hpp"
-#include <unordered_set>
+#include "../Core/EnvironmentalState.hpp"
+#include "TechnologyGraph.hpp"
 
 class EmergentTechnologySystem {
 public:
@@ -40,10 +41,13 @@ public:
     };
 
 private:
-    // Track all possible and discovered technologies
-    std::unordered_map<std::string, Discovery> potential_discoveries;
-    std::unordered_map<std::string, std::unordered_set<std::string>> 
-        species_discoveries;  // species_id -> discoveries
+    // Track all possible technologies; index is the tech graph node ID
+    std::vector<Discovery> potential_discoveries;
+    std::unordered_map<std::string, TechnologyGraph::NodeId> discovery_lookup;
+
+    // Compiled prerequisite DAG plus per-species discovered/frontier bitsets
+    TechnologyGraph tech_graph;
+    bool graph_dirty{true};
 
     // Track combinations that led to discoveries
     struct EmergentPattern {
@@ -55,6 +59,18 @@ private:
     std::vector<EmergentPattern> successful_patterns;
 
 public:
+    void add_potential_discovery(const Discovery& discovery) {
+        auto [it, inserted] = discovery_lookup.try_emplace(
+            discovery.id,
+            static_cast<TechnologyGraph::NodeId>(potential_discoveries.size()));
+        if (inserted) {
+            potential_discoveries.push_back(discovery);
+        } else {
+            potential_discoveries[it->second] = discovery;
+        }
+        graph_dirty = true;
+    }
+
     void initialize_potential_discoveries() {
         // Basic tool use might emerge from combining simple actions
         add_potential_discovery({
@@ -100,61 +116,96 @@ public:
     bool check_for_discovery(const std::string& species_id,
                            const std::vector<std::string>& current_actions,
                            const EnvironmentalState& env_state) {
-        for (const auto& [tech_id, discovery] : potential_discoveries) {
-            // Skip if already discovered
-            if (species_discoveries[species_id].contains(tech_id)) {
+        compile_tech_graph();
+        auto species = tech_graph.get_species(species_id);
+
+        // Observed actions and environmental conditions feed the graph;
+        // only discoveries whose requirements flipped are re-evaluated
+        std::vector<std::string> observed = current_actions;
+        observed.insert(observed.end(),
+                        env_state.active_conditions.begin(),
+                        env_state.active_conditions.end());
+        for (auto& factor : env_state.get_relevant_factors()) {
+            observed.push_back(std::move(factor));
+        }
+        tech_graph.set_observed(species, observed);
+
+        // Frontier holds undiscovered techs with every requirement met
+        std::vector<TechnologyGraph::NodeId> candidates;
+        tech_graph.frontier(species).for_each_set([&](size_t node) {
+            candidates.push_back(static_cast<TechnologyGraph::NodeId>(node));
+        });
+
+        for (auto node : candidates) {
+            const Discovery& discovery = potential_discoveries[node];
+            if (get_species_complexity(species_id) <
+                discovery.origin.complexity_threshold) {
                 continue;
             }
 
-            if (can_make_discovery(species_id, discovery, current_actions, env_state)) {
-                float discovery_chance = calculate_discovery_chance(
-                    species_id, discovery, current_actions
-                );
+            float discovery_chance = calculate_discovery_chance(
+                species_id, discovery, current_actions
+            );
 
-                if (random_float() < discovery_chance) {
-                    record_discovery(species_id, tech_id, current_actions, env_state);
-                    return true;
-                }
+            if (random_float() < discovery_chance) {
+                record_discovery(species_id, discovery.id, current_actions, env_state);
+                return true;
             }
         }
         return false;
     }
 
-private:
-    bool can_make_discovery(const std::string& species_id,
-                          const Discovery& discovery,
-                          const std::vector<std::string>& current_actions,
-                          const EnvironmentalState& env_state) {
-        // Check prerequisites
-        bool has_required_actions = std::all_of(
-            discovery.origin.prerequisite_actions.begin(),
-            discovery.origin.prerequisite_actions.end(),
-            [&](const std::string& action) {
-                return std::find(current_actions.begin(), 
-                               current_actions.end(), 
-                               action) != current_actions.end();
-            }
-        );
+    bool has_discovery(const std::string& species_id, const std::string& tech_id) {
+        auto it = discovery_lookup.find(tech_id);
+        if (it == discovery_lookup.end()) return false;
+        compile_tech_graph();
+        return tech_graph.is_discovered(tech_graph.get_species(species_id), it->second);
+    }
 
-        // Check environmental conditions
-        bool env_conditions_met = check_environmental_conditions(
-            discovery.origin.environmental_conditions,
-            env_state
-        );
+private:
+    void compile_tech_graph() {
+        if (!graph_dirty) return;
+
+        std::vector<TechnologyGraph::NodeSpec> specs;
+        specs.reserve(potential_discoveries.size());
+        std::unordered_map<std::string, bool> provided;
+        for (const auto& discovery : potential_discoveries) {
+            TechnologyGraph::NodeSpec spec;
+            const auto& caps = discovery.capabilities;
+            spec.provides = caps.new_actions;
+            spec.provides.insert(spec.provides.end(),
+                caps.enhanced_abilities.begin(), caps.enhanced_abilities.end());
+            for (const auto& item : spec.provides) provided[item] = true;
+            specs.push_back(std::move(spec));
+        }
 
-        // Check species capabilities
-        bool meets_complexity = get_species_complexity(species_id) >= 
-                              discovery.origin.complexity_threshold;
+        for (size_t i = 0; i < potential_discoveries.size(); ++i) {
+            const auto& origin = potential_discoveries[i].origin;
+            auto& requirements = specs[i].requirements;
+            requirements = origin.prerequisite_actions;
+            requirements.insert(requirements.end(),
+                origin.environmental_conditions.begin(),
+                origin.environmental_conditions.end());
+
+            // Knowledge only gates a discovery when another discovery can
+            // teach it; otherwise it is not observable and is not checked
+            for (const auto& knowledge : origin.required_knowledge) {
+                if (provided.count(knowledge)) requirements.push_back(knowledge);
+            }
+        }
 
-        return has_required_actions && env_conditions_met && meets_complexity;
+        tech_graph.compile(specs);
+        graph_dirty = false;
     }
 
     void record_discovery(const std::string& species_id,
                          const std::string& tech_id,
                          const std::vector<std::string>& contributing_actions,
                          const EnvironmentalState& env_state) {
-        // Record the discovery for this species
-        species_discoveries[species_id].insert(tech_id);
+        // Record the discovery for this species; grants its capabilities
+        // as requirements and unlocks dependent techs in the graph
+        tech_graph.mark_discovered(
+            tech_graph.get_species(species_id), discovery_lookup.at(tech_id));
 
         // Record the pattern that led to discovery
         successful_patterns.push_back({
@@ -170,7 +221,7 @@ private:
 
     void apply_discovery_effects(const std::string& species_id,
                                const std::string& tech_id) {
-        const auto& discovery = potential_discoveries[tech_id];
+        const auto& discovery = potential_discoveries[discovery_lookup.at(tech_id)];
         
         // Grant new actions
         for (const auto& action : discovery.capabilities.new_actions) {
@@ -1,6 +1,11 @@
 #pragma once
 #include "PatternRecognitionSystem.hpp"
+#include "PatternSearchEngine.hpp"
+#include "../Core/Pattern.hpp"
+#include <memory>
 #include <random>
+#include "../../Core/WorkerPool.hpp"
+#include "../../Core/WorldSeed.hpp"
 
 class PatternEvolution {
 public:
@@ -19,7 +24,7 @@ public:
 
 private:
     // Random number generation
-    std::mt19937 rng{std::random_device{}()};
+    std::mt19937 rng{static_cast<std::mt19937::result_type>(Core::WorldSeed::get_instance().derive("pattern_evolution"))};
     std::uniform_real_distribution<float> dist{0.0f, 1.0f};
 
     // Evolution parameters
@@ -30,6 +35,10 @@ private:
         float synergy_threshold{0.6f};
     } params;
 
+    // Background population search over pattern combinations, run on the
+    // shared worker pool
+    std::unique_ptr<PatternSearchEngine> search_engine;
+
 public:
     EvolutionResult evolve_pattern(const Pattern& pattern) {
         EvolutionResult result;
@@ -68,6 +77,34 @@ public:
         return result;
     }
 
+    // Starts a population search seeded from known patterns, replacing any
+    // search still running. The fitness function runs on pool workers and
+    // must not touch shared game state.
+    void begin_pattern_search(const std::vector<Pattern>& seeds,
+                              PatternSearchEngine::FitnessFunction fitness,
+                              size_t generations) {
+        if (!search_engine) {
+            search_engine = std::make_unique<PatternSearchEngine>(Core::WorkerPool::get_instance());
+        }
+        search_engine->set_fitness_function(std::move(fitness));
+        search_engine->seed_population(seeds);
+        search_engine->run_generations(generations);
+    }
+
+    // Call once per frame; never blocks on the search
+    bool update_pattern_search() {
+        return search_engine && search_engine->update();
+    }
+
+    std::vector<Pattern> get_search_results(size_t count) const {
+        std::vector<Pattern> results;
+        if (!search_engine) return results;
+        for (auto& individual : search_engine->get_best(count)) {
+            results.push_back(std::move(individual.pattern));
+        }
+        return results;
+    }
+
 private:
     void mutate_pattern(Pattern& pattern) {
         // Possible mutations:
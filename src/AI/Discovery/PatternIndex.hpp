@@ -0,0 +1,172 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../Core/StringInterner.hpp"
+
+// Inverted index over verified patterns. Each pattern is stored as three
+// sorted sets of interned element IDs (actions, environmental factors,
+// cultural elements), and every element keeps a posting list of the
+// patterns containing it. A query only touches patterns that share at
+// least one element with the observation, so matching cost scales with
+// the overlap rather than with the number of stored patterns.
+class PatternIndex {
+public:
+    using ElementId = StringInterner::Id;
+    using Slot = uint32_t;
+
+    enum Field : size_t {
+        ACTIONS = 0,
+        ENVIRONMENT = 1,
+        CULTURE = 2,
+        FIELD_COUNT = 3
+    };
+
+    using ElementSets = std::array<std::vector<ElementId>, FIELD_COUNT>;
+
+    struct Candidate {
+        Slot slot{0};
+        // Per-field overlap: shared elements / max(query size, pattern size)
+        std::array<float, FIELD_COUNT> similarity{};
+    };
+
+private:
+    StringInterner elements;
+    std::vector<ElementSets> entries;
+    std::array<std::vector<std::vector<Slot>>, FIELD_COUNT> postings;
+
+    // Query scratch, reused between calls to avoid per-query allocation
+    mutable std::vector<std::array<uint16_t, FIELD_COUNT>> hit_counts;
+    mutable std::vector<Slot> touched;
+
+public:
+    Slot add(const std::vector<std::string>& actions,
+             const std::vector<std::string>& env_factors,
+             const std::vector<std::string>& cultural_elements) {
+        Slot slot = static_cast<Slot>(entries.size());
+        entries.push_back({
+            elements.intern_set(actions),
+            elements.intern_set(env_factors),
+            elements.intern_set(cultural_elements)
+        });
+        hit_counts.emplace_back();
+
+        for (size_t field = 0; field < FIELD_COUNT; ++field) {
+            for (ElementId id : entries[slot][field]) {
+                posting_list(field, id).push_back(slot);
+            }
+        }
+        return slot;
+    }
+
+    // Re-indexes a pattern after its elements changed. Only the elements
+    // that were added or removed touch the posting lists.
+    void update(Slot slot,
+                const std::vector<std::string>& actions,
+                const std::vector<std::string>& env_factors,
+                const std::vector<std::string>& cultural_elements) {
+        ElementSets updated{
+            elements.intern_set(actions),
+            elements.intern_set(env_factors),
+            elements.intern_set(cultural_elements)
+        };
+
+        for (size_t field = 0; field < FIELD_COUNT; ++field) {
+            const auto& before = entries[slot][field];
+            const auto& after = updated[field];
+
+            std::vector<ElementId> removed;
+            std::set_difference(before.begin(), before.end(),
+                                after.begin(), after.end(),
+                                std::back_inserter(removed));
+            for (ElementId id : removed) {
+                auto& list = posting_list(field, id);
+                list.erase(std::remove(list.begin(), list.end(), slot), list.end());
+            }
+
+            std::vector<ElementId> added;
+            std::set_difference(after.begin(), after.end(),
+                                before.begin(), before.end(),
+                                std::back_inserter(added));
+            for (ElementId id : added) {
+                posting_list(field, id).push_back(slot);
+            }
+        }
+
+        entries[slot] = std::move(updated);
+    }
+
+    // Collects every stored pattern sharing at least one element with the
+    // query, together with its per-field overlap scores.
+    void query(const std::vector<std::string>& actions,
+               const std::vector<std::string>& env_factors,
+               const std::vector<std::string>& cultural_elements,
+               std::vector<Candidate>& out) const {
+        out.clear();
+        touched.clear();
+
+        const std::vector<std::string>* query_fields[FIELD_COUNT] = {
+            &actions, &env_factors, &cultural_elements
+        };
+        std::array<size_t, FIELD_COUNT> query_sizes{};
+
+        for (size_t field = 0; field < FIELD_COUNT; ++field) {
+            std::vector<ElementId> ids = elements.find_set(*query_fields[field]);
+            query_sizes[field] = count_distinct(*query_fields[field], ids.size());
+
+            for (ElementId id : ids) {
+                if (id >= postings[field].size()) continue;
+                for (Slot slot : postings[field][id]) {
+                    auto& counts = hit_counts[slot];
+                    if (counts[ACTIONS] == 0 && counts[ENVIRONMENT] == 0 &&
+                        counts[CULTURE] == 0) {
+                        touched.push_back(slot);
+                    }
+                    ++counts[field];
+                }
+            }
+        }
+
+        out.reserve(touched.size());
+        for (Slot slot : touched) {
+            Candidate candidate{slot, {}};
+            auto& counts = hit_counts[slot];
+            for (size_t field = 0; field < FIELD_COUNT; ++field) {
+                size_t denom = std::max(query_sizes[field], entries[slot][field].size());
+                if (denom > 0) {
+                    candidate.similarity[field] =
+                        static_cast<float>(counts[field]) / static_cast<float>(denom);
+                }
+            }
+            counts = {};
+            out.push_back(candidate);
+        }
+    }
+
+    const ElementSets& get_elements(Slot slot) const { return entries[slot]; }
+    const std::string& element_name(ElementId id) const { return elements.name(id); }
+    size_t size() const { return entries.size(); }
+
+private:
+    std::vector<Slot>& posting_list(size_t field, ElementId id) {
+        auto& lists = postings[field];
+        if (id >= lists.size()) lists.resize(static_cast<size_t>(id) + 1);
+        return lists[id];
+    }
+
+    // Distinct query elements, counting strings unknown to the index too so
+    // that unseen elements still dilute the overlap score.
+    size_t count_distinct(const std::vector<std::string>& values,
+                          size_t known_distinct) const {
+        std::vector<std::string_view> unknown;
+        for (const auto& value : values) {
+            if (elements.find(value) == StringInterner::INVALID_ID) unknown.push_back(value);
+        }
+        std::sort(unknown.begin(), unknown.end());
+        return known_distinct + static_cast<size_t>(std::unique(unknown.begin(), unknown.end()) - unknown.begin());
+    }
+};
@@ -3,8 +3,8 @@
 #include <string>
 #include <unordered_map>
 #include <algorithm>
-#include <immintrin.h>  // For SIMD
-#include "../Core/SIMDHelper.hpp"
+#include "PatternIndex.hpp"
+#include "SequenceSimilarity.hpp"
 
 class PatternRecognitionSystem {
 public:
@@ -25,6 +25,7 @@ public:
     };
 
     struct PatternMatch {
+        std::string pattern_id;
         float similarity_score{0.0f};
         float confidence{0.0f};
         std::vector<std::string> missing_elements;
@@ -32,9 +33,16 @@ public:
     };
 
 private:
-    // Store observed patterns
-    std::unordered_map<std::string, Pattern> verified_patterns;
+    // Store observed patterns. Verified patterns live in a dense array whose
+    // slots line up with pattern_index; the map only resolves IDs to slots.
+    std::vector<Pattern> verified_patterns;
+    std::vector<std::string> verified_ids;
+    std::unordered_map<std::string, PatternIndex::Slot> verified_lookup;
+    PatternIndex pattern_index;
     std::vector<Pattern> emerging_patterns;
+
+    // Running total of verified observations for frequency weighting
+    float total_observations{0.0f};
     
     // Track pattern frequencies
     struct PatternFrequency {
@@ -43,9 +51,14 @@ private:
         alignas(32) std::vector<float> cultural_frequencies;
     } frequencies;
 
-    // SIMD-aligned similarity calculation data
-    alignas(32) std::vector<float> similarity_scores;
-    alignas(32) std::vector<float> frequency_weights;
+    // Reused candidate buffer for index queries
+    std::vector<PatternIndex::Candidate> candidates;
+
+    // Ordered action sequences of verified patterns as interned symbols,
+    // slot-aligned with verified_patterns, for the LCS kernel
+    StringInterner action_symbols;
+    std::vector<SequenceSimilarity::Sequence> action_sequences;
+    SequenceSimilarity sequence_kernel;
 
     // Additional similarity metrics
     struct SimilarityMetrics {
@@ -59,24 +72,41 @@ private:
     float calculate_sequence_similarity(
         const std::vector<std::string>& seq1,
         const std::vector<std::string>& seq2) {
-        // Longest Common Subsequence algorithm
-        std::vector<std::vector<int>> dp(
-            seq1.size() + 1,
-            std::vector<int>(seq2.size() + 1, 0)
-        );
+        // Longest Common Subsequence over interned action IDs
+        std::unordered_map<std::string, SequenceSimilarity::Symbol> unknown;
+        return sequence_kernel.similarity(
+            lookup_sequence(seq1, unknown), lookup_sequence(seq2, unknown));
+    }
 
-        for (size_t i = 1; i <= seq1.size(); ++i) {
-            for (size_t j = 1; j <= seq2.size(); ++j) {
-                if (seq1[i-1] == seq2[j-1]) {
-                    dp[i][j] = dp[i-1][j-1] + 1;
-                } else {
-                    dp[i][j] = std::max(dp[i-1][j], dp[i][j-1]);
-                }
+    // Read-only counterpart of intern_sequence for queries: strings the
+    // interner has not seen get temporary IDs past its end, shared through
+    // `unknown`, so equal unknown actions still match each other without
+    // growing action_symbols on arbitrary input
+    SequenceSimilarity::Sequence lookup_sequence(
+        const std::vector<std::string>& actions,
+        std::unordered_map<std::string, SequenceSimilarity::Symbol>& unknown) const {
+        SequenceSimilarity::Sequence sequence;
+        sequence.reserve(actions.size());
+        for (const auto& action : actions) {
+            SequenceSimilarity::Symbol symbol = action_symbols.find(action);
+            if (symbol == StringInterner::INVALID_ID) {
+                auto [it, inserted] = unknown.try_emplace(
+                    action, static_cast<SequenceSimilarity::Symbol>(action_symbols.size() + unknown.size()));
+                symbol = it->second;
             }
+            sequence.push_back(symbol);
         }
+        return sequence;
+    }
 
-        float lcs_length = static_cast<float>(dp[seq1.size()][seq2.size()]);
-        return lcs_length / std::max(seq1.size(), seq2.size());
+    SequenceSimilarity::Sequence intern_sequence(
+        const std::vector<std::string>& actions) {
+        SequenceSimilarity::Sequence sequence;
+        sequence.reserve(actions.size());
+        for (const auto& action : actions) {
+            sequence.push_back(action_symbols.intern(action));
+        }
+        return sequence;
     }
 
     float calculate_context_similarity(
@@ -134,24 +164,32 @@ private:
     }
 
     void update_existing_pattern(Pattern& pattern, const PatternMatch& match) {
-        auto it = verified_patterns.find(match.pattern_id);
-        if (it != verified_patterns.end()) {
+        auto it = verified_lookup.find(match.pattern_id);
+        if (it != verified_lookup.end()) {
+            Pattern& existing = verified_patterns[it->second];
+
             // Update observation count
-            it->second.observation_count++;
+            existing.observation_count++;
+            total_observations += 1.0f;
             
             // Update success rate with decay
             const float DECAY_RATE = 0.95f;
-            it->second.success_rate = 
-                it->second.success_rate * DECAY_RATE + 
+            existing.success_rate = 
+                existing.success_rate * DECAY_RATE + 
                 pattern.success_rate * (1.0f - DECAY_RATE);
             
             // Update impact if new impact is higher
-            if (pattern.discovery_impact > it->second.discovery_impact) {
-                it->second.discovery_impact = pattern.discovery_impact;
+            if (pattern.discovery_impact > existing.discovery_impact) {
+                existing.discovery_impact = pattern.discovery_impact;
             }
             
-            // Merge new elements
-            merge_pattern_elements(it->second, pattern);
+            // Merge new elements and re-index only what changed
+            merge_pattern_elements(existing, pattern);
+            pattern_index.update(it->second,
+                                 existing.actions,
+                                 existing.environmental_factors,
+                                 existing.cultural_elements);
+            action_sequences[it->second] = intern_sequence(existing.actions);
         }
     }
 
@@ -217,67 +255,37 @@ public:
     }
 
     PatternMatch find_similar_pattern(const Pattern& pattern) {
-        const size_t pattern_count = verified_patterns.size();
-        
-        // Prepare SIMD arrays
-        prepare_similarity_calculation(pattern);
+        // Only patterns sharing at least one element can score above zero,
+        // so the inverted index hands back exactly the ones worth scoring
+        pattern_index.query(pattern.actions,
+                            pattern.environmental_factors,
+                            pattern.cultural_elements,
+                            candidates);
         
-        // Calculate similarities in batches
-        for (size_t i = 0; i < pattern_count; i += 8) {
-            calculate_similarity_batch(pattern, i);
-        }
-        
-        // Find best match
         return find_best_match(pattern);
     }
 
-private:
-    void prepare_similarity_calculation(const Pattern& pattern) {
-        similarity_scores.clear();
-        similarity_scores.resize(verified_patterns.size(), 0.0f);
-        
-        // Prepare frequency weights for SIMD
-        frequency_weights.clear();
-        frequency_weights.resize(8, 0.0f);
-        
-        for (size_t i = 0; i < 8; ++i) {
-            frequency_weights[i] = calculate_frequency_weight(i);
-        }
-    }
-
-    void calculate_similarity_batch(const Pattern& pattern, size_t start_idx) {
-        // Load pattern data into SIMD registers
-        __m256 action_sim = calculate_action_similarity_simd(
-            pattern.actions, start_idx);
-        __m256 env_sim = calculate_environmental_similarity_simd(
-            pattern.environmental_factors, start_idx);
-        __m256 cultural_sim = calculate_cultural_similarity_simd(
-            pattern.cultural_elements, start_idx);
-        
-        // Weight similarities based on frequencies
-        __m256 weights = _mm256_load_ps(frequency_weights.data());
-        
-        // Combine similarities
-        __m256 combined = _mm256_mul_ps(
-            _mm256_add_ps(
-                _mm256_add_ps(action_sim, env_sim),
-                cultural_sim
-            ),
-            weights
-        );
-        
-        // Store results
-        _mm256_store_ps(&similarity_scores[start_idx], combined);
+    // Action-order similarity of one sequence against every verified
+    // pattern, slot-aligned with the verified pattern array
+    void score_action_sequences(const std::vector<std::string>& actions,
+                                std::vector<float>& scores) {
+        std::unordered_map<std::string, SequenceSimilarity::Symbol> unknown;
+        sequence_kernel.score_batch(lookup_sequence(actions, unknown), action_sequences, scores);
     }
 
+private:
     PatternMatch find_best_match(const Pattern& pattern) {
         float best_score = 0.0f;
         size_t best_idx = 0;
         
-        for (size_t i = 0; i < similarity_scores.size(); ++i) {
-            if (similarity_scores[i] > best_score) {
-                best_score = similarity_scores[i];
-                best_idx = i;
+        for (const auto& candidate : candidates) {
+            float score = (candidate.similarity[PatternIndex::ACTIONS] +
+                           candidate.similarity[PatternIndex::ENVIRONMENT] +
+                           candidate.similarity[PatternIndex::CULTURE]) *
+                          calculate_frequency_weight(candidate.slot);
+            if (score > best_score) {
+                best_score = score;
+                best_idx = candidate.slot;
             }
         }
         
@@ -285,7 +293,7 @@ private:
             return create_pattern_match(pattern, best_idx, best_score);
         }
         
-        return PatternMatch{0.0f, 0.0f, {}, false};
+        return PatternMatch{"", 0.0f, 0.0f, {}, false};
     }
 
     void verify_emerging_patterns() {
@@ -294,8 +302,8 @@ private:
             if (should_verify_pattern(*it)) {
                 // Move to verified patterns
                 std::string pattern_id = generate_pattern_id(*it);
-                verified_patterns[pattern_id] = std::move(*it);
-                verified_patterns[pattern_id].is_verified = true;
+                it->is_verified = true;
+                add_verified_pattern(pattern_id, std::move(*it));
                 
                 it = emerging_patterns.erase(it);
             } else {
@@ -304,6 +312,33 @@ private:
         }
     }
 
+    void add_verified_pattern(const std::string& pattern_id, Pattern pattern) {
+        total_observations += static_cast<float>(pattern.observation_count);
+
+        auto existing = verified_lookup.find(pattern_id);
+        if (existing != verified_lookup.end()) {
+            // Same ID replaces the old pattern in place
+            Pattern& slot_pattern = verified_patterns[existing->second];
+            total_observations -= static_cast<float>(slot_pattern.observation_count);
+            slot_pattern = std::move(pattern);
+            pattern_index.update(existing->second,
+                                 slot_pattern.actions,
+                                 slot_pattern.environmental_factors,
+                                 slot_pattern.cultural_elements);
+            action_sequences[existing->second] = intern_sequence(slot_pattern.actions);
+            return;
+        }
+
+        PatternIndex::Slot slot = pattern_index.add(
+            pattern.actions,
+            pattern.environmental_factors,
+            pattern.cultural_elements);
+        verified_lookup.emplace(pattern_id, slot);
+        verified_ids.push_back(pattern_id);
+        action_sequences.push_back(intern_sequence(pattern.actions));
+        verified_patterns.push_back(std::move(pattern));
+    }
+
     bool should_verify_pattern(const Pattern& pattern) {
         return pattern.observation_count >= 3 && 
                pattern.success_rate > 0.7f &&
@@ -327,6 +362,14 @@ private:
         }
     }
 
+    // Defined in PatternRecognitionSystem.cpp
+    void update_frequency(std::vector<float>& frequencies, const std::string& element);
+    float calculate_frequency_weight(size_t index);
+    PatternMatch create_pattern_match(const Pattern& pattern,
+                                      size_t match_idx,
+                                      float similarity_score);
+    std::string generate_pattern_id(const Pattern& pattern);
+
     float calculate_impact(const std::string& discovery_id) {
         // Calculate how significant this discovery is
         // based on its effects and uniqueness
@@ -0,0 +1,347 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../Core/Pattern.hpp"
+#include "../Core/ThreadPool.hpp"
+
+// Population-based evolutionary search over Patterns.
+//
+// Each generation is split into chunks that run on the thread pool. A chunk
+// breeds its share of offspring (tournament selection, crossover, mutation)
+// from the previous generation, which is read-only while the generation
+// runs, and scores them. Every chunk draws from its own RNG stream derived
+// from (seed, generation, chunk), so results do not depend on scheduling.
+// Fitness is cached by pattern content hash so identical candidates are
+// never rescored.
+//
+// The engine is driven from the main loop through update(), which never
+// blocks: it only collects a generation once all of its chunks are done.
+class PatternSearchEngine {
+public:
+    // Must be thread-safe; called concurrently from pool workers
+    using FitnessFunction = std::function<float(const Pattern&)>;
+    using MutationOperator = std::function<void(Pattern&, std::mt19937&)>;
+    using CrossoverOperator =
+        std::function<Pattern(const Pattern&, const Pattern&, std::mt19937&)>;
+
+    struct Params {
+        size_t population_size{512};
+        size_t elite_count{16};
+        size_t tournament_size{4};
+        size_t chunk_size{64};
+        float crossover_rate{0.3f};
+        float mutation_rate{0.9f};
+        size_t max_cache_entries{1 << 18};
+        uint64_t seed{0x5EED5EEDULL};
+    };
+
+    struct Individual {
+        Pattern pattern;
+        uint64_t key{0};
+        float fitness{0.0f};
+    };
+
+private:
+    ThreadPool& pool;
+    Params params;
+
+    FitnessFunction fitness_fn;
+    MutationOperator mutate_fn;
+    CrossoverOperator crossover_fn;
+
+    // Sorted by descending fitness after each generation
+    std::vector<Individual> population;
+    std::vector<Individual> offspring;
+
+    std::unordered_map<uint64_t, float> fitness_cache;
+
+    // Per-chunk results of the generation in flight
+    struct ChunkResult {
+        std::vector<std::pair<uint64_t, float>> new_scores;
+        size_t cache_hits{0};
+    };
+    std::vector<ChunkResult> chunk_results;
+    std::vector<std::future<void>> pending;
+
+    size_t generation{0};
+    size_t generations_remaining{0};
+    size_t evaluations{0};
+    size_t cache_hits{0};
+
+public:
+    explicit PatternSearchEngine(ThreadPool& thread_pool)
+        : PatternSearchEngine(thread_pool, Params()) {}
+
+    PatternSearchEngine(ThreadPool& thread_pool, Params search_params)
+        : pool(thread_pool)
+        , params(search_params)
+        , mutate_fn(default_mutation)
+        , crossover_fn(default_crossover) {
+        params.elite_count = std::min(params.elite_count, params.population_size);
+        params.tournament_size = std::max<size_t>(1, params.tournament_size);
+        params.chunk_size = std::max<size_t>(1, params.chunk_size);
+    }
+
+    ~PatternSearchEngine() {
+        // Workers reference this engine; drain the generation in flight
+        cancel();
+    }
+
+    // Operators are read by pool workers, so swapping one cancels the
+    // queued generations and drains the one in flight first. Scores cached
+    // under the old fitness function are dropped with it.
+    void set_fitness_function(FitnessFunction fn) {
+        cancel();
+        fitness_fn = std::move(fn);
+        fitness_cache.clear();
+    }
+    void set_mutation_operator(MutationOperator fn) {
+        cancel();
+        mutate_fn = std::move(fn);
+    }
+    void set_crossover_operator(CrossoverOperator fn) {
+        cancel();
+        crossover_fn = std::move(fn);
+    }
+
+    // Seeds generation zero. Seeds are scored synchronously on the calling
+    // thread, so keep the seed set small; offspring are scored in parallel.
+    // Cancels any queued generations; only the one in flight is drained.
+    void seed_population(const std::vector<Pattern>& seeds) {
+        cancel();
+        population.clear();
+        generation = 0;
+
+        for (const auto& seed : seeds) {
+            if (population.size() >= params.population_size) break;
+            Individual individual{seed, hash_pattern(seed), 0.0f};
+            individual.fitness = score(individual);
+            population.push_back(std::move(individual));
+        }
+        sort_population();
+    }
+
+    // Queues generations to run; they advance as update() is called
+    void run_generations(size_t count) {
+        generations_remaining += count;
+        if (pending.empty()) launch_generation();
+    }
+
+    // Non-blocking. Returns true when at least one generation finished.
+    bool update() {
+        if (pending.empty()) return false;
+
+        for (auto& future : pending) {
+            if (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                return false;
+            }
+        }
+
+        finish_generation();
+        launch_generation();
+        return true;
+    }
+
+    // Blocks until every queued generation has completed
+    void wait() {
+        while (!pending.empty()) {
+            for (auto& future : pending) future.wait();
+            finish_generation();
+            launch_generation();
+        }
+    }
+
+    // Drops the queued generations and blocks until the one in flight is done
+    void cancel() {
+        generations_remaining = 0;
+        wait();
+    }
+
+    bool is_running() const { return !pending.empty(); }
+
+    // Best individuals of the last completed generation, fittest first
+    std::vector<Individual> get_best(size_t count) const {
+        count = std::min(count, population.size());
+        return std::vector<Individual>(population.begin(), population.begin() + count);
+    }
+
+    size_t get_generation() const { return generation; }
+    size_t get_evaluation_count() const { return evaluations; }
+    size_t get_cache_hit_count() const { return cache_hits; }
+
+    static uint64_t hash_pattern(const Pattern& pattern) {
+        // FNV-1a over all element strings, with field separators so that
+        // moving an element between fields changes the hash
+        uint64_t hash = 14695981039346656037ULL;
+        auto mix = [&hash](const std::string& value) {
+            for (unsigned char c : value) {
+                hash ^= c;
+                hash *= 1099511628211ULL;
+            }
+            hash ^= 0xFF;
+            hash *= 1099511628211ULL;
+        };
+        auto mix_field = [&](const std::vector<std::string>& values, uint64_t tag) {
+            hash ^= tag;
+            hash *= 1099511628211ULL;
+            for (const auto& value : values) mix(value);
+        };
+        mix_field(pattern.actions, 1);
+        mix_field(pattern.environmental_factors, 2);
+        mix_field(pattern.cultural_elements, 3);
+        return hash;
+    }
+
+    static void default_mutation(Pattern& pattern, std::mt19937& rng) {
+        if (pattern.actions.size() < 2) return;
+
+        std::uniform_int_distribution<size_t> pick(0, pattern.actions.size() - 1);
+        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+        if (dist(rng) < 0.5f) {
+            // Reorder: action order matters for sequence similarity
+            std::swap(pattern.actions[pick(rng)], pattern.actions[pick(rng)]);
+        } else {
+            pattern.actions.erase(pattern.actions.begin() + pick(rng));
+        }
+    }
+
+    static Pattern default_crossover(const Pattern& a, const Pattern& b, std::mt19937& rng) {
+        Pattern child = a;
+        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+        auto inherit = [&](std::vector<std::string>& into,
+                           const std::vector<std::string>& from) {
+            for (const auto& element : from) {
+                if (dist(rng) < 0.5f &&
+                    std::find(into.begin(), into.end(), element) == into.end()) {
+                    into.push_back(element);
+                }
+            }
+        };
+        inherit(child.actions, b.actions);
+        inherit(child.environmental_factors, b.environmental_factors);
+        inherit(child.cultural_elements, b.cultural_elements);
+        return child;
+    }
+
+private:
+    static uint64_t split_mix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    float score(const Individual& individual) {
+        auto it = fitness_cache.find(individual.key);
+        if (it != fitness_cache.end()) {
+            ++cache_hits;
+            return it->second;
+        }
+        float fitness = fitness_fn ? fitness_fn(individual.pattern) : 0.0f;
+        ++evaluations;
+        fitness_cache.emplace(individual.key, fitness);
+        return fitness;
+    }
+
+    void sort_population() {
+        std::stable_sort(population.begin(), population.end(),
+            [](const Individual& a, const Individual& b) {
+                return a.fitness > b.fitness;
+            });
+    }
+
+    const Individual& tournament(std::mt19937& rng) const {
+        std::uniform_int_distribution<size_t> pick(0, population.size() - 1);
+        const Individual* best = &population[pick(rng)];
+        for (size_t i = 1; i < params.tournament_size; ++i) {
+            const Individual& challenger = population[pick(rng)];
+            if (challenger.fitness > best->fitness) best = &challenger;
+        }
+        return *best;
+    }
+
+    void launch_generation() {
+        if (generations_remaining == 0 || population.empty()) return;
+        --generations_remaining;
+
+        const size_t elites = std::min(params.elite_count, population.size());
+        const size_t children = params.population_size - elites;
+        const size_t chunk_count = (children + params.chunk_size - 1) / params.chunk_size;
+
+        // Elites carry over unchanged and keep their fitness
+        offspring.assign(population.begin(), population.begin() + elites);
+        offspring.resize(params.population_size);
+        chunk_results.assign(chunk_count, ChunkResult{});
+
+        for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+            size_t begin = elites + chunk * params.chunk_size;
+            size_t end = std::min(begin + params.chunk_size, params.population_size);
+            uint64_t stream = split_mix(params.seed ^ split_mix(generation) ^
+                                        split_mix(chunk + 0x1000));
+
+            pending.push_back(pool.enqueue([this, begin, end, chunk, stream]() {
+                breed_chunk(begin, end, chunk_results[chunk], stream);
+            }));
+        }
+    }
+
+    // Runs on a pool worker. Reads population and fitness_cache, which are
+    // not modified until every chunk of the generation has finished.
+    void breed_chunk(size_t begin, size_t end, ChunkResult& result, uint64_t stream) {
+        std::mt19937 rng(static_cast<uint32_t>(stream ^ (stream >> 32)));
+        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+        for (size_t i = begin; i < end; ++i) {
+            Individual& child = offspring[i];
+            const Individual& parent = tournament(rng);
+
+            if (dist(rng) < params.crossover_rate) {
+                child.pattern = crossover_fn(parent.pattern, tournament(rng).pattern, rng);
+            } else {
+                child.pattern = parent.pattern;
+            }
+            if (dist(rng) < params.mutation_rate) {
+                mutate_fn(child.pattern, rng);
+            }
+
+            child.key = hash_pattern(child.pattern);
+            auto cached = fitness_cache.find(child.key);
+            if (cached != fitness_cache.end()) {
+                child.fitness = cached->second;
+                ++result.cache_hits;
+            } else {
+                child.fitness = fitness_fn ? fitness_fn(child.pattern) : 0.0f;
+                result.new_scores.emplace_back(child.key, child.fitness);
+            }
+        }
+    }
+
+    void finish_generation() {
+        pending.clear();
+
+        if (fitness_cache.size() > params.max_cache_entries) {
+            fitness_cache.clear();
+        }
+        for (const auto& result : chunk_results) {
+            cache_hits += result.cache_hits;
+            evaluations += result.new_scores.size();
+            for (const auto& [key, fitness] : result.new_scores) {
+                fitness_cache.emplace(key, fitness);
+            }
+        }
+        chunk_results.clear();
+
+        population.swap(offspring);
+        sort_population();
+        ++generation;
+    }
+};
@@ -0,0 +1,135 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "../Core/StringInterner.hpp"
+
+// Bit-parallel longest-common-subsequence kernel (Allison-Dix / Hyyro).
+// The query is encoded once as one match bitmask per distinct symbol; each
+// element of the other sequence then advances 64 DP columns per machine
+// word with a single add/and/or step, instead of filling an n*m table.
+// All working memory lives in member scratch buffers reused across calls,
+// so an instance is not thread-safe; use one per worker.
+class SequenceSimilarity {
+public:
+    using Symbol = StringInterner::Id;
+    using Sequence = std::vector<Symbol>;
+
+private:
+    static constexpr size_t WORD_BITS = 64;
+
+    // Match masks for the current query, one row of `words` per distinct symbol
+    std::vector<uint64_t> match_masks;
+    // Symbol -> mask row, valid only where row_stamp matches query_stamp
+    std::vector<uint32_t> symbol_row;
+    std::vector<uint32_t> row_stamp;
+    uint32_t query_stamp{0};
+
+    std::vector<uint64_t> columns;
+    size_t query_length{0};
+    size_t words{0};
+
+public:
+    // Encodes the query; following lcs_length/similarity calls compare against it
+    void set_query(const Sequence& query) {
+        query_length = query.size();
+        words = (query_length + WORD_BITS - 1) / WORD_BITS;
+        match_masks.clear();
+
+        if (++query_stamp == 0) {
+            std::fill(row_stamp.begin(), row_stamp.end(), 0u);
+            query_stamp = 1;
+        }
+
+        for (size_t i = 0; i < query_length; ++i) {
+            Symbol symbol = query[i];
+            if (symbol >= symbol_row.size()) {
+                symbol_row.resize(static_cast<size_t>(symbol) + 1, 0);
+                row_stamp.resize(static_cast<size_t>(symbol) + 1, 0);
+            }
+            if (row_stamp[symbol] != query_stamp) {
+                row_stamp[symbol] = query_stamp;
+                symbol_row[symbol] = static_cast<uint32_t>(match_masks.size() / words);
+                match_masks.resize(match_masks.size() + words, 0);
+            }
+            match_masks[symbol_row[symbol] * words + i / WORD_BITS] |=
+                uint64_t{1} << (i % WORD_BITS);
+        }
+    }
+
+    size_t lcs_length(const Sequence& other) {
+        if (query_length == 0 || other.empty()) return 0;
+
+        columns.assign(words, ~uint64_t{0});
+
+        if (words == 1) {
+            uint64_t v = columns[0];
+            for (Symbol symbol : other) {
+                const uint64_t* mask = find_mask(symbol);
+                if (!mask) continue;
+                uint64_t u = v & *mask;
+                v = (v + u) | (v - u);
+            }
+            columns[0] = v;
+        } else {
+            for (Symbol symbol : other) {
+                const uint64_t* mask = find_mask(symbol);
+                if (!mask) continue;
+
+                // Multi-word add with carry: V = (V + (V & M)) | (V & ~M)
+                uint64_t carry = 0;
+                for (size_t w = 0; w < words; ++w) {
+                    uint64_t v = columns[w];
+                    uint64_t u = v & mask[w];
+                    uint64_t partial = v + carry;
+                    uint64_t next_carry = partial < carry;
+                    uint64_t sum = partial + u;
+                    next_carry |= sum < u;
+                    columns[w] = sum | (v & ~mask[w]);
+                    carry = next_carry;
+                }
+            }
+        }
+
+        // LCS length is the number of zero bits within the query length
+        size_t zeros = 0;
+        for (size_t w = 0; w < words; ++w) {
+            uint64_t valid = ~uint64_t{0};
+            size_t tail = query_length - w * WORD_BITS;
+            if (tail < WORD_BITS) valid = (uint64_t{1} << tail) - 1;
+            zeros += static_cast<size_t>(__builtin_popcountll(~columns[w] & valid));
+        }
+        return zeros;
+    }
+
+    // LCS length normalised by the longer sequence, in [0, 1]
+    float similarity(const Sequence& other) {
+        size_t longest = std::max(query_length, other.size());
+        if (longest == 0) return 0.0f;
+        return static_cast<float>(lcs_length(other)) / static_cast<float>(longest);
+    }
+
+    float similarity(const Sequence& a, const Sequence& b) {
+        set_query(a);
+        return similarity(b);
+    }
+
+    // Scores one query against many stored sequences, encoding the query once
+    void score_batch(const Sequence& query,
+                     const std::vector<Sequence>& sequences,
+                     std::vector<float>& scores) {
+        set_query(query);
+        scores.resize(sequences.size());
+        for (size_t i = 0; i < sequences.size(); ++i) {
+            scores[i] = similarity(sequences[i]);
+        }
+    }
+
+private:
+    const uint64_t* find_mask(Symbol symbol) const {
+        if (symbol >= row_stamp.size() || row_stamp[symbol] != query_stamp) {
+            return nullptr;
+        }
+        return &match_masks[symbol_row[symbol] * words];
+    }
+};
@@ -0,0 +1,239 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../Core/DynamicBitset.hpp"
+#include "../Core/StringInterner.hpp"
+
+// Compiled form of the emergent tech tree. Discoveries become dense node
+// IDs, and their prerequisite actions, knowledge and conditions become
+// dense requirement IDs. Node B depends on node A when A provides a
+// requirement of B, which gives the prerequisite DAG.
+//
+// For each species the graph keeps the requirements it currently has
+// (observed this tick, or granted by earlier discoveries) and a count of
+// unmet requirements per node. A change to one requirement only touches
+// the nodes that need it. The frontier bitset (nodes with everything met
+// that are not yet discovered) stays current without rescanning the tree.
+class TechnologyGraph {
+public:
+    using NodeId = uint32_t;
+    using RequirementId = StringInterner::Id;
+    using SpeciesIndex = uint32_t;
+
+    struct NodeSpec {
+        std::vector<std::string> requirements;
+        std::vector<std::string> provides;
+    };
+
+private:
+    StringInterner requirement_ids;
+
+    std::vector<std::vector<RequirementId>> node_requirements;
+    std::vector<std::vector<RequirementId>> node_provides;
+    // Requirement -> nodes that need it
+    std::vector<std::vector<NodeId>> needed_by;
+    // DAG edges: prerequisite node -> dependent nodes, and the reverse
+    std::vector<std::vector<NodeId>> dependents;
+    std::vector<std::vector<NodeId>> prerequisite_nodes;
+    std::vector<NodeId> topo_order;
+    std::vector<DynamicBitset> reachable;
+
+    struct SpeciesState {
+        DynamicBitset observed;
+        DynamicBitset granted;
+        DynamicBitset discovered;
+        DynamicBitset frontier;
+        std::vector<uint16_t> missing;
+    };
+    std::unordered_map<std::string, SpeciesIndex> species_lookup;
+    std::vector<SpeciesState> species;
+
+    // Scratch for set_observed
+    DynamicBitset next_observed;
+
+public:
+    void compile(const std::vector<NodeSpec>& specs) {
+        const size_t nodes = specs.size();
+        requirement_ids = StringInterner{};
+        node_requirements.assign(nodes, {});
+        node_provides.assign(nodes, {});
+
+        for (size_t node = 0; node < nodes; ++node) {
+            node_requirements[node] = requirement_ids.intern_set(specs[node].requirements);
+            node_provides[node] = requirement_ids.intern_set(specs[node].provides);
+        }
+
+        const size_t requirement_count = requirement_ids.size();
+        needed_by.assign(requirement_count, {});
+        std::vector<std::vector<NodeId>> provided_by(requirement_count);
+        for (NodeId node = 0; node < nodes; ++node) {
+            for (RequirementId req : node_requirements[node]) needed_by[req].push_back(node);
+            for (RequirementId req : node_provides[node]) provided_by[req].push_back(node);
+        }
+
+        dependents.assign(nodes, {});
+        prerequisite_nodes.assign(nodes, {});
+        for (NodeId node = 0; node < nodes; ++node) {
+            for (RequirementId req : node_requirements[node]) {
+                for (NodeId provider : provided_by[req]) {
+                    if (provider == node) continue;
+                    dependents[provider].push_back(node);
+                    prerequisite_nodes[node].push_back(provider);
+                }
+            }
+        }
+        for (auto& edges : dependents) StringInterner::sort_unique(edges);
+        for (auto& edges : prerequisite_nodes) StringInterner::sort_unique(edges);
+
+        build_topological_order();
+        build_reachability();
+
+        next_observed = DynamicBitset(requirement_count);
+
+        // Node IDs are stable when specs are only appended, so discoveries
+        // carry over; observations are refilled on the next set_observed
+        for (SpeciesIndex index = 0; index < species.size(); ++index) {
+            std::vector<NodeId> known;
+            species[index].discovered.for_each_set([&](size_t node) {
+                if (node < nodes) known.push_back(static_cast<NodeId>(node));
+            });
+            reset_species(species[index]);
+            for (NodeId node : known) mark_discovered(index, node);
+        }
+    }
+
+    size_t node_count() const { return node_requirements.size(); }
+
+    // False when prerequisites form a cycle; such nodes are missing from
+    // the topological order and have no reachability set
+    bool is_acyclic() const { return topo_order.size() == node_count(); }
+    const std::vector<NodeId>& topological_order() const { return topo_order; }
+    const std::vector<NodeId>& prerequisites_of(NodeId node) const { return prerequisite_nodes[node]; }
+    const std::vector<NodeId>& dependents_of(NodeId node) const { return dependents[node]; }
+
+    // Every node that transitively depends on `node`
+    const DynamicBitset& downstream_of(NodeId node) const { return reachable[node]; }
+
+    SpeciesIndex get_species(const std::string& species_id) {
+        auto [it, inserted] = species_lookup.try_emplace(
+            species_id, static_cast<SpeciesIndex>(species.size()));
+        if (inserted) {
+            species.emplace_back();
+            reset_species(species.back());
+        }
+        return it->second;
+    }
+
+    // Replaces the species' observed requirements (current actions and
+    // environmental factors). Only requirements whose availability flips
+    // update the nodes that need them.
+    void set_observed(SpeciesIndex index, const std::vector<std::string>& observed) {
+        SpeciesState& state = species[index];
+        next_observed.clear();
+        for (const auto& value : observed) {
+            RequirementId req = requirement_ids.find(value);
+            if (req != StringInterner::INVALID_ID) next_observed.set(req);
+        }
+
+        const uint64_t* before = state.observed.data();
+        const uint64_t* after = next_observed.data();
+        const uint64_t* granted = state.granted.data();
+        for (size_t w = 0; w < next_observed.word_count(); ++w) {
+            // Granted requirements stay available regardless of observation
+            uint64_t flipped = (before[w] ^ after[w]) & ~granted[w];
+            while (flipped) {
+                size_t bit = static_cast<size_t>(__builtin_ctzll(flipped));
+                RequirementId req = static_cast<RequirementId>(w * 64 + bit);
+                if ((after[w] >> bit) & 1) {
+                    requirement_gained(state, req);
+                } else {
+                    requirement_lost(state, req);
+                }
+                flipped &= flipped - 1;
+            }
+        }
+        std::swap(state.observed, next_observed);
+    }
+
+    void mark_discovered(SpeciesIndex index, NodeId node) {
+        SpeciesState& state = species[index];
+        if (state.discovered.test(node)) return;
+        state.discovered.set(node);
+        state.frontier.reset(node);
+
+        for (RequirementId req : node_provides[node]) {
+            if (state.granted.test(req)) continue;
+            state.granted.set(req);
+            if (!state.observed.test(req)) requirement_gained(state, req);
+        }
+    }
+
+    bool is_discovered(SpeciesIndex index, NodeId node) const {
+        return species[index].discovered.test(node);
+    }
+
+    const DynamicBitset& discovered(SpeciesIndex index) const { return species[index].discovered; }
+
+    // Undiscovered nodes whose requirements are all currently met
+    const DynamicBitset& frontier(SpeciesIndex index) const { return species[index].frontier; }
+
+private:
+    void reset_species(SpeciesState& state) {
+        const size_t requirement_count = requirement_ids.size();
+        state.observed = DynamicBitset(requirement_count);
+        state.granted = DynamicBitset(requirement_count);
+        state.discovered = DynamicBitset(node_count());
+        state.frontier = DynamicBitset(node_count());
+        state.missing.resize(node_count());
+        for (NodeId node = 0; node < node_count(); ++node) {
+            state.missing[node] = static_cast<uint16_t>(node_requirements[node].size());
+            if (state.missing[node] == 0) state.frontier.set(node);
+        }
+    }
+
+    void requirement_gained(SpeciesState& state, RequirementId req) {
+        for (NodeId node : needed_by[req]) {
+            if (--state.missing[node] == 0 && !state.discovered.test(node)) {
+                state.frontier.set(node);
+            }
+        }
+    }
+
+    void requirement_lost(SpeciesState& state, RequirementId req) {
+        for (NodeId node : needed_by[req]) {
+            ++state.missing[node];
+            state.frontier.reset(node);
+        }
+    }
+
+    void build_topological_order() {
+        const size_t count = node_count();
+        std::vector<uint32_t> in_degree(count, 0);
+        for (NodeId node = 0; node < count; ++node) {
+            in_degree[node] = static_cast<uint32_t>(prerequisite_nodes[node].size());
+        }
+
+        topo_order.clear();
+        for (NodeId node = 0; node < count; ++node) {
+            if (in_degree[node] == 0) topo_order.push_back(node);
+        }
+        for (size_t i = 0; i < topo_order.size(); ++i) {
+            for (NodeId next : dependents[topo_order[i]]) {
+                if (--in_degree[next] == 0) topo_order.push_back(next);
+            }
+        }
+    }
+
+    void build_reachability() {
+        reachable.assign(node_count(), DynamicBitset(node_count()));
+        for (auto it = topo_order.rbegin(); it != topo_order.rend(); ++it) {
+            for (NodeId next : dependents[*it]) {
+                reachable[*it].set(next);
+                reachable[*it] |= reachable[next];
+            }
+        }
+    }
+};
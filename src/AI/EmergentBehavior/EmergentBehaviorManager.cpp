@@ -74,4 +74,42 @@ void EmergentBehaviorManager::update(float delta_time) {
             npc->update(delta_time);
         }
     }
-} 
\ No newline at end of file
+} 
+
+void EmergentBehaviorManager::save_section(Core::SaveSection& section) {
+    update_npc_positions();
+    std::vector<float> defense;
+    defense.reserve(npc_positions_x.size());
+    for (const auto& weak_npc : npcs) {
+        if (auto npc = weak_npc.lock()) {
+            defense.push_back(npc->get_defense());
+        }
+    }
+    section.put_array(npc_positions_x);
+    section.put_array(npc_positions_y);
+    section.put_array(defense);
+}
+
+bool EmergentBehaviorManager::load_section(Core::SaveSectionReader& section) {
+    std::vector<std::shared_ptr<NPCController>> live;
+    for (const auto& weak_npc : npcs) {
+        if (auto npc = weak_npc.lock()) {
+            live.push_back(std::move(npc));
+        }
+    }
+
+    std::vector<float> loaded_x, loaded_y, defense;
+    if (!section.get_array(loaded_x) || !section.get_array(loaded_y) || !section.get_array(defense)) {
+        return false;
+    }
+    if (loaded_x.size() != live.size() || loaded_y.size() != live.size() || defense.size() != live.size()) {
+        return false;
+    }
+
+    npc_positions_x = std::move(loaded_x);
+    npc_positions_y = std::move(loaded_y);
+    for (size_t i = 0; i < live.size(); ++i) {
+        live[i]->set_defense(defense[i]);
+    }
+    return true;
+}
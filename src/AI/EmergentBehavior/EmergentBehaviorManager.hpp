@@ -9,6 +9,7 @@
 #include "../Core/JobSystem.hpp"
 #include "../Core/SIMDHelper.hpp"
 #include "../Core/CacheOptimizer.hpp"
+#include "../../Core/SaveRegistry.hpp"
 
 class EmergentBehaviorManager {
 private:
@@ -22,6 +23,7 @@ private:
     
     std::vector<std::weak_ptr<NPCController>> npcs;
     std::unordered_map<WorldEvent::EventType, float> eventInfluence;
+    Core::SavedSection saved_npcs;
 
     static EmergentBehaviorManager* instance;
     
@@ -36,6 +38,10 @@ private:
         // Pre-allocate position vectors with cache alignment
         npc_positions_x.reserve(1024);
         npc_positions_y.reserve(1024);
+
+        saved_npcs.bind("npcs", 4,
+            [this](Core::SaveSection& section) { save_section(section); },
+            [this](Core::SaveSectionReader& section) { return load_section(section); });
     }
 
 public:
@@ -45,6 +51,13 @@ public:
     void process_event(const WorldEvent& event);
     void update(float delta_time);
     
+    // Binary save: position and defense columns of the live NPCs, in
+    // registration order. Loading needs the same NPCs registered; it sets
+    // their defense, while positions stay the controllers' own and are
+    // refreshed from them on the next batch.
+    void save_section(Core::SaveSection& section);
+    bool load_section(Core::SaveSectionReader& section);
+
     // New methods for spatial queries
     std::vector<std::shared_ptr<NPCController>> get_npcs_in_radius(float x, float y, float radius) {
         return spatialGrid->get_nearby_npcs(x, y, radius);
@@ -26,29 +26,24 @@ public:
     static VotingResult process_approval_voting(
         const std::vector<ExtendedVote>& votes) {
         
-        std::unordered_map<std::string, float> approval_counts;
+        thread_local VoteTally tally;
+        tally.clear();
         float total_voters = static_cast<float>(votes.size());
 
-        // Count approvals for each option
+        // Each approval is a unit ballot for that option
         for (const auto& vote : votes) {
             for (const auto& option : vote.approved_options) {
-                approval_counts[option] += 1.0f;
+                tally.add_ballot(vote.voter_id, option, 1.0f);
             }
         }
 
-        // Find most approved option
-        auto max_it = std::max_element(
-            approval_counts.begin(),
-            approval_counts.end(),
-            [](const auto& p1, const auto& p2) {
-                return p1.second < p2.second;
-            }
-        );
+        auto outcome = tally.plurality();
+        if (outcome.winner == VoteTally::NO_CHOICE) return VotingResult{};
 
         return VotingResult{
-            max_it->first,
-            max_it->second / total_voters,
-            max_it->second > (total_voters * 0.5f),
+            tally.proposal_name(outcome.winner),
+            outcome.winner_total / total_voters,
+            outcome.winner_total > (total_voters * 0.5f),
             {}
         };
     }
@@ -146,8 +141,9 @@ public:
         const std::vector<ExtendedVote>& votes) {
         
         // Weight votes by participation in deliberation
+        thread_local VoteTally tally;
+        tally.clear();
         float total_weight = 0.0f;
-        std::unordered_map<std::string, float> weighted_votes;
 
         for (const auto& vote : votes) {
             float weight = 1.0f;
@@ -157,24 +153,19 @@ public:
             weight *= (1.0f + vote.expertise_level);  // Expertise bonus
 
             for (const auto& [option, score] : vote.scores) {
-                weighted_votes[option] += score * weight;
+                tally.add_ballot(vote.voter_id, option, score * weight);
             }
             total_weight += weight;
         }
 
         // Find option with highest weighted score
-        auto max_it = std::max_element(
-            weighted_votes.begin(),
-            weighted_votes.end(),
-            [](const auto& p1, const auto& p2) {
-                return p1.second < p2.second;
-            }
-        );
+        auto outcome = tally.plurality();
+        if (outcome.winner == VoteTally::NO_CHOICE) return VotingResult{};
 
         return VotingResult{
-            max_it->first,
-            max_it->second / total_weight,
-            max_it->second > (total_weight * 0.6f),  // Higher threshold
+            tally.proposal_name(outcome.winner),
+            outcome.winner_total / total_weight,
+            outcome.winner_total > (total_weight * 0.6f),  // Higher threshold
             {}
         };
     }
@@ -0,0 +1,293 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <immintrin.h>
+#include "../Core/StringInterner.hpp"
+
+// Reusable tallying engine for work-group votes. Proposals and voters are
+// interned to dense IDs and ballots are stored as columns, so every voting
+// system sums into a flat per-proposal array instead of a string map.
+//
+// Ranked ballots of any length are packed back to back into one flat
+// choice array with per-ballot offsets and a cursor to the current
+// preference. Instant-runoff rounds only
+// re-route the ballots of the eliminated proposal. Liquid-democracy
+// delegations are resolved with union-find, and cycles are detected as
+// they are linked.
+//
+// One instance is meant to be cleared and reused across many small
+// elections so the buffers stay allocated.
+class VoteTally {
+public:
+    using ProposalId = StringInterner::Id;
+    using VoterId = StringInterner::Id;
+
+    static constexpr ProposalId NO_CHOICE = StringInterner::INVALID_ID;
+
+    struct Outcome {
+        ProposalId winner{NO_CHOICE};
+        float winner_total{0.0f};
+        // Weight still counted when the winner was decided
+        float total{0.0f};
+        bool majority{false};
+        size_t rounds{0};
+    };
+
+private:
+    StringInterner proposals;
+    StringInterner voters;
+
+    // Single-choice ballots
+    std::vector<ProposalId> ballot_proposal;
+    std::vector<float> ballot_weight;
+    std::vector<float> ballot_conviction;
+    std::vector<VoterId> ballot_voter;
+
+    // Ranked ballots; ballot b ranks ranked_choices[offsets[b], offsets[b + 1])
+    std::vector<ProposalId> ranked_choices;
+    std::vector<uint32_t> ranked_offsets{0};
+    std::vector<uint32_t> ranked_cursor;
+    std::vector<float> ranked_weight;
+
+    // Delegations for liquid democracy
+    std::vector<std::pair<VoterId, VoterId>> delegations;
+    std::vector<float> delegation_weight;
+
+    // Scratch
+    std::vector<float> sums;
+    std::vector<float> effective;
+    std::vector<uint8_t> eliminated;
+    std::vector<std::vector<uint32_t>> buckets;
+    std::vector<VoterId> parent;
+    std::vector<float> power;
+    std::vector<ProposalId> direct_choice;
+    std::vector<uint8_t> delegated;
+    std::vector<VoterId> cycle_voters;
+
+public:
+    // Drops ballots and IDs but keeps the buffers
+    void clear() {
+        proposals = StringInterner{};
+        voters = StringInterner{};
+        ballot_proposal.clear();
+        ballot_weight.clear();
+        ballot_conviction.clear();
+        ballot_voter.clear();
+        ranked_choices.clear();
+        ranked_offsets.assign(1, 0);
+        ranked_cursor.clear();
+        ranked_weight.clear();
+        delegations.clear();
+        delegation_weight.clear();
+        cycle_voters.clear();
+    }
+
+    ProposalId intern_proposal(const std::string& proposal_id) { return proposals.intern(proposal_id); }
+    const std::string& proposal_name(ProposalId id) const { return proposals.name(id); }
+    size_t proposal_count() const { return proposals.size(); }
+
+    void add_ballot(const std::string& voter_id, const std::string& proposal_id,
+                    float weight, float conviction_time = 0.0f) {
+        ballot_voter.push_back(voters.intern(voter_id));
+        ballot_proposal.push_back(proposals.intern(proposal_id));
+        ballot_weight.push_back(weight);
+        ballot_conviction.push_back(conviction_time);
+    }
+
+    // Every preference is kept, however long the ballot
+    void add_ranked_ballot(const std::vector<std::string>& ranked, float weight) {
+        for (const auto& choice : ranked) ranked_choices.push_back(proposals.intern(choice));
+        ranked_offsets.push_back(static_cast<uint32_t>(ranked_choices.size()));
+        ranked_cursor.push_back(0);
+        ranked_weight.push_back(weight);
+    }
+
+    void add_delegation(const std::string& voter_id, const std::string& delegate_id, float weight) {
+        delegations.push_back({voters.intern(voter_id), voters.intern(delegate_id)});
+        delegation_weight.push_back(weight);
+    }
+
+    // Per-proposal totals of the most recent tally
+    const std::vector<float>& totals() const { return sums; }
+
+    // Voters whose delegation closed a cycle in the last liquid tally;
+    // their chain's weight is not counted
+    const std::vector<VoterId>& delegation_cycles() const { return cycle_voters; }
+
+    Outcome plurality() {
+        return tally_weights(ballot_weight.data());
+    }
+
+    // Weight is the voice credits spent; a ballot counts sqrt(credits)
+    Outcome quadratic() {
+        const size_t count = ballot_weight.size();
+        effective.resize(count);
+        size_t i = 0;
+#if defined(__AVX__)
+        const __m256 zero = _mm256_setzero_ps();
+        for (; i + 8 <= count; i += 8) {
+            __m256 credits = _mm256_max_ps(_mm256_loadu_ps(&ballot_weight[i]), zero);
+            _mm256_storeu_ps(&effective[i], _mm256_sqrt_ps(credits));
+        }
+#endif
+        for (; i < count; ++i) effective[i] = std::sqrt(std::max(ballot_weight[i], 0.0f));
+        return tally_weights(effective.data());
+    }
+
+    Outcome conviction() {
+        const size_t count = ballot_weight.size();
+        effective.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            effective[i] = ballot_weight[i] * (1.0f + std::log1p(ballot_conviction[i]));
+        }
+        return tally_weights(effective.data());
+    }
+
+    // Instant runoff: eliminate the weakest proposal until one holds a
+    // majority of the ballots still in play. Ties break toward lower IDs.
+    Outcome ranked_choice() {
+        const size_t proposal_total = proposals.size();
+        const size_t ballots = ranked_weight.size();
+        sums.assign(proposal_total, 0.0f);
+        eliminated.assign(proposal_total, 1);
+        if (buckets.size() < proposal_total) buckets.resize(proposal_total);
+        for (size_t p = 0; p < proposal_total; ++p) buckets[p].clear();
+
+        // Only proposals that appear on some ballot are in the race
+        size_t remaining = 0;
+        for (ProposalId choice : ranked_choices) {
+            if (eliminated[choice]) {
+                eliminated[choice] = 0;
+                ++remaining;
+            }
+        }
+
+        Outcome outcome;
+        float active_total = 0.0f;
+        for (uint32_t ballot = 0; ballot < ballots; ++ballot) {
+            ranked_cursor[ballot] = 0;
+            active_total += route(ballot);
+        }
+
+        while (remaining > 0) {
+            ++outcome.rounds;
+            ProposalId leader = NO_CHOICE, weakest = NO_CHOICE;
+            for (ProposalId p = 0; p < proposal_total; ++p) {
+                if (eliminated[p]) continue;
+                if (leader == NO_CHOICE || sums[p] > sums[leader]) leader = p;
+                if (weakest == NO_CHOICE || sums[p] < sums[weakest]) weakest = p;
+            }
+
+            bool majority = sums[leader] > active_total * 0.5f;
+            if (majority || remaining == 1) {
+                outcome.winner = leader;
+                outcome.winner_total = sums[leader];
+                outcome.total = active_total;
+                outcome.majority = majority;
+                return outcome;
+            }
+
+            eliminated[weakest] = 1;
+            --remaining;
+            active_total -= sums[weakest];
+            sums[weakest] = 0.0f;
+
+            auto& moving = buckets[weakest];
+            for (uint32_t ballot : moving) active_total += route(ballot);
+            moving.clear();
+        }
+        return outcome;
+    }
+
+    // Delegated weight flows to the end of each delegation chain and is
+    // cast with that voter's direct ballot. A voter who votes directly
+    // keeps their own vote even if they also delegated.
+    Outcome liquid_democracy() {
+        const size_t voter_total = voters.size();
+        parent.resize(voter_total);
+        for (VoterId v = 0; v < voter_total; ++v) parent[v] = v;
+        power.assign(voter_total, 0.0f);
+        direct_choice.assign(voter_total, NO_CHOICE);
+        cycle_voters.clear();
+
+        for (size_t i = 0; i < ballot_voter.size(); ++i) {
+            direct_choice[ballot_voter[i]] = ballot_proposal[i];
+            power[ballot_voter[i]] += ballot_weight[i];
+        }
+
+        // Only a voter's first delegation counts
+        delegated.assign(voter_total, 0);
+        for (size_t i = 0; i < delegations.size(); ++i) {
+            auto [voter, delegate] = delegations[i];
+            if (direct_choice[voter] != NO_CHOICE || delegated[voter]) continue;
+            delegated[voter] = 1;
+            power[voter] += delegation_weight[i];
+
+            // The voter is still a root, so reaching it from the delegate
+            // means this link would close a cycle
+            if (find_root(delegate) == voter) {
+                cycle_voters.push_back(voter);
+                continue;
+            }
+            parent[voter] = delegate;
+        }
+
+        sums.assign(proposals.size(), 0.0f);
+        for (VoterId v = 0; v < voter_total; ++v) {
+            ProposalId choice = direct_choice[find_root(v)];
+            if (choice != NO_CHOICE) sums[choice] += power[v];
+        }
+        return pick_leader();
+    }
+
+private:
+    Outcome tally_weights(const float* weights) {
+        sums.assign(proposals.size(), 0.0f);
+        for (size_t i = 0; i < ballot_proposal.size(); ++i) {
+            sums[ballot_proposal[i]] += weights[i];
+        }
+        return pick_leader();
+    }
+
+    Outcome pick_leader() const {
+        Outcome outcome;
+        outcome.rounds = 1;
+        for (ProposalId p = 0; p < sums.size(); ++p) {
+            outcome.total += sums[p];
+            if (outcome.winner == NO_CHOICE || sums[p] > sums[outcome.winner]) outcome.winner = p;
+        }
+        if (outcome.winner != NO_CHOICE) {
+            outcome.winner_total = sums[outcome.winner];
+            outcome.majority = outcome.winner_total > outcome.total * 0.5f;
+        }
+        return outcome;
+    }
+
+    // Moves a ballot to its highest-ranked proposal still in the race;
+    // returns the weight it adds, or 0 when the ballot is exhausted
+    float route(uint32_t ballot) {
+        const ProposalId* row = ranked_choices.data() + ranked_offsets[ballot];
+        const uint32_t count = ranked_offsets[ballot + 1] - ranked_offsets[ballot];
+        uint32_t& cursor = ranked_cursor[ballot];
+        while (cursor < count && eliminated[row[cursor]]) ++cursor;
+        if (cursor == count) return 0.0f;
+
+        buckets[row[cursor]].push_back(ballot);
+        sums[row[cursor]] += ranked_weight[ballot];
+        return ranked_weight[ballot];
+    }
+
+    VoterId find_root(VoterId voter) {
+        VoterId root = voter;
+        while (parent[root] != root) root = parent[root];
+        while (parent[voter] != root) {
+            VoterId next = parent[voter];
+            parent[voter] = root;
+            voter = next;
+        }
+        return root;
+    }
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include "LaborOrganizationSystem.hpp"
+#include "VoteTally.hpp"
 #include <algorithm>
 #include <numeric>
 
@@ -21,6 +22,7 @@ public:
         std::vector<std::string> ranked_choices;
         float conviction_time{0.0f};
         bool is_delegated{false};
+        std::string delegate_id;  // Liquid democracy: who a delegated vote goes to
     };
 
     struct VotingResult {
@@ -63,137 +65,72 @@ public:
         }
     }
 
-private:
-    static VotingResult process_majority_vote(
-        const std::vector<Vote>& votes) {
-        
-        // Count votes for each proposal
-        std::unordered_map<std::string, float> vote_counts;
-        float total_votes = 0.0f;
-        
+    // Per-thread engine so thousands of small work-group votes reuse the
+    // same buffers; shared with VotingImplementation
+    static VoteTally& tally_for(const std::vector<Vote>& votes) {
+        thread_local VoteTally tally;
+        tally.clear();
         for (const auto& vote : votes) {
-            vote_counts[vote.proposal_id] += vote.weight;
-            total_votes += vote.weight;
-        }
-        
-        // Find proposal with most votes
-        auto max_it = std::max_element(
-            vote_counts.begin(),
-            vote_counts.end(),
-            [](const auto& p1, const auto& p2) {
-                return p1.second < p2.second;
+            if (!vote.ranked_choices.empty()) tally.add_ranked_ballot(vote.ranked_choices, vote.weight);
+            if (vote.is_delegated && !vote.delegate_id.empty()) {
+                tally.add_delegation(vote.voter_id, vote.delegate_id, vote.weight);
+            } else if (!vote.proposal_id.empty()) {
+                tally.add_ballot(vote.voter_id, vote.proposal_id, vote.weight, vote.conviction_time);
             }
-        );
-        
+        }
+        return tally;
+    }
+
+    static VotingResult to_result(const VoteTally& tally,
+                                  const VoteTally::Outcome& outcome,
+                                  const std::vector<Vote>& votes,
+                                  bool consensus) {
+        if (outcome.winner == VoteTally::NO_CHOICE || outcome.total <= 0.0f) {
+            return VotingResult{};
+        }
+        const std::string& winner = tally.proposal_name(outcome.winner);
         return VotingResult{
-            max_it->first,
-            max_it->second / total_votes,
-            max_it->second > (total_votes * 0.5f),
-            get_minority_concerns(votes, max_it->first)
+            winner,
+            outcome.winner_total / outcome.total,
+            consensus,
+            get_minority_concerns(votes, winner)
         };
     }
 
+private:
+    static VotingResult process_majority_vote(
+        const std::vector<Vote>& votes) {
+        
+        VoteTally& tally = tally_for(votes);
+        auto outcome = tally.plurality();
+        return to_result(tally, outcome, votes, outcome.majority);
+    }
+
     static VotingResult process_consensus(
         const std::vector<Vote>& votes,
         float threshold) {
         
-        // Check support level for each proposal
-        std::unordered_map<std::string, float> support_levels;
-        float total_weight = 0.0f;
-        
-        for (const auto& vote : votes) {
-            support_levels[vote.proposal_id] += vote.weight;
-            total_weight += vote.weight;
-        }
-        
-        // Find proposals meeting consensus threshold
-        std::vector<std::string> consensus_proposals;
-        for (const auto& [proposal, support] : support_levels) {
-            if ((support / total_weight) >= threshold) {
-                consensus_proposals.push_back(proposal);
-            }
-        }
-        
-        if (!consensus_proposals.empty()) {
-            return VotingResult{
-                consensus_proposals[0],
-                support_levels[consensus_proposals[0]] / total_weight,
-                true,
-                {}  // No minority concerns in consensus
-            };
+        // The leading proposal qualifies whenever any proposal does
+        VoteTally& tally = tally_for(votes);
+        auto outcome = tally.plurality();
+        if (outcome.total <= 0.0f || outcome.winner_total / outcome.total < threshold) {
+            return VotingResult{};
         }
         
-        return VotingResult{};
+        return VotingResult{
+            tally.proposal_name(outcome.winner),
+            outcome.winner_total / outcome.total,
+            true,
+            {}  // No minority concerns in consensus
+        };
     }
 
     static VotingResult process_ranked_choice(
         const std::vector<Vote>& votes) {
         
-        std::unordered_map<std::string, float> round_counts;
-        std::vector<std::string> eliminated;
-        
-        // Continue until we have a winner
-        while (true) {
-            round_counts.clear();
-            
-            // Count first choices that haven't been eliminated
-            for (const auto& vote : votes) {
-                for (const auto& choice : vote.ranked_choices) {
-                    if (std::find(eliminated.begin(), eliminated.end(), 
-                                choice) == eliminated.end()) {
-                        round_counts[choice] += vote.weight;
-                        break;
-                    }
-                }
-            }
-            
-            // Check for majority
-            float total = std::accumulate(
-                round_counts.begin(),
-                round_counts.end(),
-                0.0f,
-                [](float sum, const auto& pair) {
-                    return sum + pair.second;
-                }
-            );
-            
-            for (const auto& [proposal, count] : round_counts) {
-                if (count > total * 0.5f) {
-                    return VotingResult{
-                        proposal,
-                        count / total,
-                        true,
-                        get_minority_concerns(votes, proposal)
-                    };
-                }
-            }
-            
-            // Eliminate lowest scoring option
-            auto min_it = std::min_element(
-                round_counts.begin(),
-                round_counts.end(),
-                [](const auto& p1, const auto& p2) {
-                    return p1.second < p2.second;
-                }
-            );
-            
-            eliminated.push_back(min_it->first);
-            
-            if (eliminated.size() >= round_counts.size() - 1) {
-                // Only one option remains
-                for (const auto& [proposal, _] : round_counts) {
-                    if (std::find(eliminated.begin(), eliminated.end(), 
-                                proposal) == eliminated.end()) {
-                        return VotingResult{
-                            proposal,
-                            round_counts[proposal] / total,
-                            false,
-                            get_minority_concerns(votes, proposal)
-                        };
-                    }
-                }
-            }
-        }
+        VoteTally& tally = tally_for(votes);
+        auto outcome = tally.ranked_choice();
+        return to_result(tally, outcome, votes, outcome.majority);
     }
 
     static std::vector<std::string> get_minority_concerns(
@@ -2,6 +2,8 @@
 #include "../NPCController.hpp"
 #include <unordered_map>
 #include <functional>
+#include <random>
+#include "../../../Core/WorldSeed.hpp"
 
 class ActionSystem {
 public:
@@ -57,6 +59,7 @@ private:
         float impact;
     };
     std::vector<ActionHistory> recent_actions;
+    std::mt19937 rng{static_cast<std::mt19937::result_type>(Core::WorldSeed::get_instance().derive("npc_actions"))};
 
 public:
     ActionType decide_next_action(NPCController* npc) {
@@ -197,7 +200,7 @@ private:
             total_weight += weight;
         }
         
-        float random = static_cast<float>(rand()) / RAND_MAX * total_weight;
+        float random = std::uniform_real_distribution<float>(0.0f, total_weight)(rng);
         
         for (const auto& [action, weight] : weighted_actions) {
             random -= weight;
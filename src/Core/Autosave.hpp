@@ -0,0 +1,207 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "SaveArchive.hpp"
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Core {
+
+// Background autosave without stopping the world.
+//
+// The game loop calls at_tick_boundary() between ticks. When a save is
+// due, the capture callback copies every system's state into a
+// snapshot writer. Column sections are one flat copy per column; record
+// sections such as the map's waypoints walk their objects, but nothing
+// goes through Variant. The snapshot's buffers, the registry's section
+// names and the waypoints' sort buffers are kept between saves, so once
+// they have grown capturing allocates nothing. A worker thread then
+// hashes, compresses and writes the snapshot while the simulation runs
+// on. The live state and the snapshot form the double buffer. The worker
+// compresses on its own, at low priority where the platform allows, and
+// never queues on the pools the simulation kernels wait for.
+//
+// Only the first save in a chain is full. Later saves are deltas that
+// hold just the chunks whose contents changed and reference the
+// previous file for the rest. Every `deltas_per_full` saves a new full
+// save starts a fresh chain, and the files of the old chain are removed;
+// autosaves left by earlier sessions go once the first full save of this
+// one is on disk.
+//
+//   Autosave autosave(user_dir, [&](SaveWriter& writer) {
+//       voters.save_section(writer.add_section("voters"));
+//       climate->save_section(writer.add_section("climate"));
+//   });
+//   scheduler.schedule_every(300.0, [&] { autosave.request(); });
+//   // after each simulation tick:
+//   autosave.at_tick_boundary();
+class Autosave {
+public:
+    using Capture = std::function<void(SaveWriter&)>;
+
+    static constexpr uint32_t DEFAULT_DELTAS_PER_FULL = 8;
+
+private:
+    std::filesystem::path directory;
+    Capture capture;
+    uint32_t deltas_per_full;
+
+    // Worker-owned between a capture and the end of its write
+    SaveWriter snapshot;
+    SaveBaseline baseline;
+    std::vector<std::string> chain;  // Full save first, then its deltas
+    std::vector<std::filesystem::path> earlier;  // Autosaves from earlier sessions
+    uint64_t sequence{0};
+
+    std::thread worker;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    bool pending{false};   // A captured snapshot is waiting or being written
+    bool stopping{false};
+    bool failed{false};
+    std::string latest;
+    std::atomic<bool> requested{false};
+
+public:
+    Autosave(std::string save_directory, Capture capture_state, uint32_t deltas = DEFAULT_DELTAS_PER_FULL)
+        : directory(std::move(save_directory)), capture(std::move(capture_state)), deltas_per_full(deltas) {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        scan_earlier_saves();
+        worker = std::thread(&Autosave::run, this);
+    }
+
+    Autosave(const Autosave&) = delete;
+    Autosave& operator=(const Autosave&) = delete;
+
+    // Finishes the save in flight, if any
+    ~Autosave() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    // Safe from any thread, e.g. a GameScheduler timer. The snapshot is
+    // taken at the next tick boundary.
+    void request() { requested = true; }
+
+    // Takes the requested snapshot, unless the previous one is still
+    // being written; the request then carries over to a later tick
+    // rather than making the game loop wait. Returns true on capture.
+    bool at_tick_boundary() {
+        if (!requested) return false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (pending) return false;
+        }
+        requested = false;
+        capture(snapshot);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending = true;
+        }
+        wake.notify_one();
+        return true;
+    }
+
+    // Blocks until the save in flight is on disk; for quitting
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return !pending; });
+    }
+
+    bool is_writing() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return pending;
+    }
+
+    // Newest complete save, for SaveReader::open; empty before the first
+    std::string latest_save() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return latest;
+    }
+
+    bool last_save_failed() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return failed;
+    }
+
+private:
+    void run() {
+#if defined(__linux__)
+        // Per-thread on Linux: only the worker yields to the game
+        setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10);
+#endif
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [this] { return pending || stopping; });
+            if (!pending) return;
+
+            lock.unlock();
+            bool written = write_snapshot();
+            lock.lock();
+            failed = !written;
+            if (written) latest = chain.back();
+            pending = false;
+            idle.notify_all();
+        }
+    }
+
+    bool write_snapshot() {
+        std::string path = (directory / ("autosave_" + std::to_string(sequence++) + ".sav")).string();
+        bool full = chain.empty() || chain.size() > deltas_per_full;
+        bool written = full ? snapshot.write(path, nullptr, &baseline)
+                            : snapshot.write_delta(path, baseline, nullptr, &baseline);
+        if (!written) {
+            // Files are renamed into place only once complete, so the
+            // baseline still describes the last good save
+            return false;
+        }
+        if (full) {
+            // The new full save no longer needs the old chain
+            std::error_code error;
+            for (const auto& old : chain) std::filesystem::remove(old, error);
+            for (const auto& old : earlier) std::filesystem::remove(old, error);
+            chain.clear();
+            earlier.clear();
+        }
+        chain.push_back(path);
+        return true;
+    }
+
+    // Numbering continues after saves from earlier sessions, so a new
+    // chain never overwrites a file an older delta still references.
+    // Those saves stay loadable until this session has a full save.
+    void scan_earlier_saves() {
+        std::error_code error;
+        for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+            std::string name = it->path().filename().string();
+            if (name.rfind("autosave_", 0) != 0 || it->path().extension() != ".sav") continue;
+            char* digits_end = nullptr;
+            uint64_t number = std::strtoull(name.c_str() + 9, &digits_end, 10);
+            if (digits_end == name.c_str() + 9) continue;
+            sequence = std::max<uint64_t>(sequence, number + 1);
+            earlier.push_back(it->path());
+        }
+    }
+};
+
+} // namespace Core
@@ -0,0 +1,188 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Core {
+
+// Compression for save chunks. A byte-oriented LZ77 (LZ4-style token
+// stream, 64 KiB window) with an optional shuffle filter: for arrays of
+// 4- or 8-byte numbers the bytes are first regrouped by position within
+// the element, which turns slowly varying floats into long repeats.
+// Chunks that do not shrink are stored as-is, so decoding never costs
+// more than a copy.
+class ChunkCodec {
+public:
+    enum class Method : uint8_t { STORE = 0, LZ = 1, SHUFFLE_LZ = 2 };
+
+    // Encodes src into out (replacing its contents) and returns the
+    // method used. element_size > 1 enables the shuffle filter.
+    static Method compress(const uint8_t* src, size_t size, uint32_t element_size, std::vector<uint8_t>& out) {
+        std::vector<uint8_t> shuffled;
+        const uint8_t* input = src;
+        Method method = Method::LZ;
+        if (element_size > 1 && size >= element_size * 16) {
+            shuffled.resize(size);
+            shuffle(src, size, element_size, shuffled.data());
+            input = shuffled.data();
+            method = Method::SHUFFLE_LZ;
+        }
+        lz_compress(input, size, out);
+        if (out.size() >= size) {
+            out.assign(src, src + size);
+            return Method::STORE;
+        }
+        return method;
+    }
+
+    // Decodes exactly raw_size bytes into dst; false on corrupt input
+    static bool decompress(Method method, const uint8_t* src, size_t stored, uint32_t element_size,
+                           uint8_t* dst, size_t raw_size) {
+        switch (method) {
+            case Method::STORE:
+                if (stored != raw_size) return false;
+                std::memcpy(dst, src, raw_size);
+                return true;
+            case Method::LZ:
+                return lz_decompress(src, stored, dst, raw_size);
+            case Method::SHUFFLE_LZ: {
+                std::vector<uint8_t> shuffled(raw_size);
+                if (!lz_decompress(src, stored, shuffled.data(), raw_size)) return false;
+                unshuffle(shuffled.data(), raw_size, element_size, dst);
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static constexpr size_t MIN_MATCH = 4;
+    static constexpr size_t HASH_BITS = 14;
+    static constexpr size_t MAX_OFFSET = 65535;
+    // The last bytes are always literals, so the matcher can read 4 bytes
+    // ahead without bounds checks
+    static constexpr size_t TAIL_LITERALS = 8;
+
+    // Byte i of every element goes to plane i; a trailing partial element
+    // is copied unchanged
+    static void shuffle(const uint8_t* src, size_t size, uint32_t element_size, uint8_t* dst) {
+        size_t count = size / element_size;
+        for (size_t e = 0; e < count; ++e) {
+            for (uint32_t b = 0; b < element_size; ++b) {
+                dst[b * count + e] = src[e * element_size + b];
+            }
+        }
+        std::memcpy(dst + count * element_size, src + count * element_size, size - count * element_size);
+    }
+
+    static void unshuffle(const uint8_t* src, size_t size, uint32_t element_size, uint8_t* dst) {
+        size_t count = size / element_size;
+        for (size_t e = 0; e < count; ++e) {
+            for (uint32_t b = 0; b < element_size; ++b) {
+                dst[e * element_size + b] = src[b * count + e];
+            }
+        }
+        std::memcpy(dst + count * element_size, src + count * element_size, size - count * element_size);
+    }
+
+    static uint32_t read32(const uint8_t* at) {
+        uint32_t value;
+        std::memcpy(&value, at, sizeof(value));
+        return value;
+    }
+
+    static void write_length(std::vector<uint8_t>& out, size_t length) {
+        while (length >= 255) {
+            out.push_back(255);
+            length -= 255;
+        }
+        out.push_back(static_cast<uint8_t>(length));
+    }
+
+    // Sequence: token (literal length << 4 | match length - 4), extra
+    // literal length bytes, literals, 16-bit offset, extra match length
+    // bytes. The final sequence has literals only.
+    static void lz_compress(const uint8_t* src, size_t size, std::vector<uint8_t>& out) {
+        out.clear();
+        out.reserve(size / 2 + 16);
+        std::vector<uint32_t> table(size_t(1) << HASH_BITS, 0);
+
+        size_t anchor = 0;
+        size_t at = 1;
+        const size_t limit = size > TAIL_LITERALS + MIN_MATCH ? size - TAIL_LITERALS : 0;
+        while (at < limit) {
+            uint32_t sequence = read32(src + at);
+            uint32_t slot = (sequence * 2654435761u) >> (32 - HASH_BITS);
+            size_t candidate = table[slot];
+            table[slot] = static_cast<uint32_t>(at);
+            if (candidate == 0 || at - candidate > MAX_OFFSET || read32(src + candidate) != sequence) {
+                ++at;
+                continue;
+            }
+
+            size_t length = MIN_MATCH;
+            while (at + length < limit && src[candidate + length] == src[at + length]) ++length;
+
+            size_t literals = at - anchor;
+            size_t match_extra = length - MIN_MATCH;
+            out.push_back(static_cast<uint8_t>((std::min<size_t>(literals, 15) << 4) | std::min<size_t>(match_extra, 15)));
+            if (literals >= 15) write_length(out, literals - 15);
+            out.insert(out.end(), src + anchor, src + at);
+            size_t offset = at - candidate;
+            out.push_back(static_cast<uint8_t>(offset & 0xFF));
+            out.push_back(static_cast<uint8_t>(offset >> 8));
+            if (match_extra >= 15) write_length(out, match_extra - 15);
+
+            at += length;
+            anchor = at;
+        }
+
+        size_t literals = size - anchor;
+        out.push_back(static_cast<uint8_t>(std::min<size_t>(literals, 15) << 4));
+        if (literals >= 15) write_length(out, literals - 15);
+        out.insert(out.end(), src + anchor, src + size);
+    }
+
+    static bool read_length(const uint8_t*& at, const uint8_t* end, size_t& length) {
+        uint8_t next;
+        do {
+            if (at >= end) return false;
+            next = *at++;
+            length += next;
+        } while (next == 255);
+        return true;
+    }
+
+    static bool lz_decompress(const uint8_t* src, size_t stored, uint8_t* dst, size_t raw_size) {
+        const uint8_t* at = src;
+        const uint8_t* end = src + stored;
+        size_t written = 0;
+        while (at < end) {
+            uint8_t token = *at++;
+            size_t literals = token >> 4;
+            if (literals == 15 && !read_length(at, end, literals)) return false;
+            if (literals > static_cast<size_t>(end - at) || literals > raw_size - written) return false;
+            std::memcpy(dst + written, at, literals);
+            at += literals;
+            written += literals;
+            if (at == end) break;  // Final literal-only sequence
+
+            if (end - at < 2) return false;
+            size_t offset = at[0] | (static_cast<size_t>(at[1]) << 8);
+            at += 2;
+            size_t length = token & 0x0F;
+            if (length == 15 && !read_length(at, end, length)) return false;
+            length += MIN_MATCH;
+            if (offset == 0 || offset > written || length > raw_size - written) return false;
+            // Byte copy: matches may overlap their own output
+            const uint8_t* from = dst + written - offset;
+            for (size_t i = 0; i < length; ++i) dst[written + i] = from[i];
+            written += length;
+        }
+        return written == raw_size;
+    }
+};
+
+} // namespace Core
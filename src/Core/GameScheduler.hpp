@@ -0,0 +1,205 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Core {
+
+// Shared game-time deadline queue. Every expiry in the simulation lives
+// here: elections, effect durations, outbreak deadlines and voting
+// influences. Systems do not count their own timers down every tick; a
+// per-tick pass only applies what is active. TimeSystem advances the
+// clock once per frame with the scaled delta, so pausing or speeding up
+// time moves every deadline alike, and only due callbacks run.
+//
+// Deadlines span seconds to in-game years, so a min-heap keyed on
+// absolute game time is used rather than a fixed-resolution wheel.
+// Cancelling is lazy.
+class GameScheduler {
+public:
+    using TimerId = uint64_t;
+    using Callback = std::function<void()>;
+
+    static constexpr TimerId INVALID_TIMER = 0;
+
+private:
+    struct Deadline {
+        double due;
+        TimerId id;
+        bool operator>(const Deadline& other) const {
+            return due != other.due ? due > other.due : id > other.id;
+        }
+    };
+
+    struct Timer {
+        Callback callback;
+        double due;
+        double period;  // 0 for one-shot timers
+    };
+
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> queue;
+    std::unordered_map<TimerId, Timer> timers;
+    double current_time{0.0};
+    TimerId next_id{1};
+
+public:
+    static GameScheduler& get_instance() {
+        static GameScheduler instance;
+        return instance;
+    }
+
+    double now() const { return current_time; }
+    size_t size() const { return timers.size(); }
+
+    TimerId schedule_at(double time, Callback callback) {
+        return add(std::max(time, current_time), std::move(callback), 0.0);
+    }
+
+    TimerId schedule_in(double delay, Callback callback) {
+        return schedule_at(current_time + delay, std::move(callback));
+    }
+
+    // Fires every `period` seconds, first after `first_delay` (one period
+    // when negative). Catching up over a long frame fires once per period.
+    TimerId schedule_every(double period, Callback callback, double first_delay = -1.0) {
+        double first = first_delay < 0.0 ? period : first_delay;
+        return add(current_time + std::max(first, 0.0), std::move(callback),
+                   std::max(period, std::numeric_limits<double>::epsilon()));
+    }
+
+    // Returns false if the timer already fired (one-shot) or was cancelled
+    bool cancel(TimerId id) {
+        return timers.erase(id) > 0;
+    }
+
+    bool is_pending(TimerId id) const { return timers.count(id) > 0; }
+
+    // Seconds until the timer fires, or infinity if it is not pending
+    double time_until(TimerId id) const {
+        auto it = timers.find(id);
+        return it != timers.end() ? it->second.due - current_time
+                                  : std::numeric_limits<double>::infinity();
+    }
+
+    // Game time of the earliest pending deadline, or infinity
+    double next_due() {
+        drop_cancelled();
+        return queue.empty() ? std::numeric_limits<double>::infinity() : queue.top().due;
+    }
+
+    // Advances game time and runs every callback that came due, in due
+    // order. While a callback runs, now() reads its due time, so timers it
+    // schedules are relative to when it was meant to fire.
+    void advance(double delta) {
+        const double target = current_time + std::max(delta, 0.0);
+
+        while (true) {
+            drop_cancelled();
+            if (queue.empty() || queue.top().due > target) break;
+
+            Deadline deadline = queue.top();
+            queue.pop();
+            auto it = timers.find(deadline.id);
+            current_time = deadline.due;
+
+            if (it->second.period > 0.0) {
+                it->second.due += it->second.period;
+                queue.push({it->second.due, deadline.id});
+                // Copy: the callback may cancel its own timer
+                Callback callback = it->second.callback;
+                callback();
+            } else {
+                Callback callback = std::move(it->second.callback);
+                timers.erase(it);
+                callback();
+            }
+        }
+        current_time = target;
+    }
+
+    // Drops every timer; used when a game is unloaded
+    void clear() {
+        timers.clear();
+        queue = {};
+    }
+
+private:
+    TimerId add(double due, Callback callback, double period) {
+        TimerId id = next_id++;
+        timers.emplace(id, Timer{std::move(callback), due, period});
+        queue.push({due, id});
+        return id;
+    }
+
+    void drop_cancelled() {
+        while (!queue.empty()) {
+            auto it = timers.find(queue.top().id);
+            // Entries are stale once cancelled or superseded by a reschedule
+            if (it != timers.end() && it->second.due == queue.top().due) break;
+            queue.pop();
+        }
+    }
+};
+
+// Timers a system owns on the shared scheduler. Fired one-shot timers
+// forget themselves and the rest are cancelled when the owner goes away,
+// so callbacks capturing the owner never outlive it.
+class ScheduledTimers {
+public:
+    using Handle = uint64_t;
+
+private:
+    std::unordered_map<Handle, GameScheduler::TimerId> timers;
+    Handle next_handle{1};
+
+public:
+    ScheduledTimers() = default;
+    ScheduledTimers(const ScheduledTimers&) = delete;
+    ScheduledTimers& operator=(const ScheduledTimers&) = delete;
+    ~ScheduledTimers() { clear(); }
+
+    size_t size() const { return timers.size(); }
+
+    Handle schedule_in(double delay, GameScheduler::Callback callback) {
+        Handle handle = next_handle++;
+        timers[handle] = GameScheduler::get_instance().schedule_in(
+            delay, [this, handle, callback = std::move(callback)]() {
+                timers.erase(handle);
+                callback();
+            });
+        return handle;
+    }
+
+    Handle schedule_every(double period, GameScheduler::Callback callback, double first_delay = -1.0) {
+        Handle handle = next_handle++;
+        timers[handle] = GameScheduler::get_instance().schedule_every(period, std::move(callback), first_delay);
+        return handle;
+    }
+
+    bool cancel(Handle handle) {
+        auto it = timers.find(handle);
+        if (it == timers.end()) return false;
+        GameScheduler::get_instance().cancel(it->second);
+        timers.erase(it);
+        return true;
+    }
+
+    double time_until(Handle handle) const {
+        auto it = timers.find(handle);
+        return it != timers.end() ? GameScheduler::get_instance().time_until(it->second)
+                                  : std::numeric_limits<double>::infinity();
+    }
+
+    void clear() {
+        auto& scheduler = GameScheduler::get_instance();
+        for (const auto& [handle, timer] : timers) scheduler.cancel(timer);
+        timers.clear();
+    }
+};
+
+}  // namespace Core
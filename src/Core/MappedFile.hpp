@@ -0,0 +1,125 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#define CORE_MAPPED_FILE_READ_FALLBACK 1
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Core {
+
+// Read-only view of a whole file. On POSIX systems the file is mapped, so
+// opening is O(1) and pages are loaded on first touch; elsewhere it is
+// read into memory once.
+class MappedFile {
+private:
+    const uint8_t* bytes{nullptr};
+    size_t length{0};
+#if defined(CORE_MAPPED_FILE_READ_FALLBACK)
+    std::vector<uint8_t> buffer;
+#endif
+
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const std::string& path) {
+        close();
+#if defined(CORE_MAPPED_FILE_READ_FALLBACK)
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) return false;
+        buffer.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(buffer.data()), buffer.size())) {
+            buffer.clear();
+            return false;
+        }
+        bytes = buffer.data();
+        length = buffer.size();
+        return true;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) return false;
+        bytes = static_cast<const uint8_t*>(mapped);
+        length = static_cast<size_t>(info.st_size);
+        return true;
+#endif
+    }
+
+    void close() {
+#if defined(CORE_MAPPED_FILE_READ_FALLBACK)
+        buffer.clear();
+#else
+        if (bytes) munmap(const_cast<uint8_t*>(bytes), length);
+#endif
+        bytes = nullptr;
+        length = 0;
+    }
+
+    bool is_open() const { return bytes != nullptr; }
+    const uint8_t* data() const { return bytes; }
+    size_t size() const { return length; }
+
+    // Writes through a temporary and renames, so readers never map a
+    // half-written file. Each call gets its own temporary, so concurrent
+    // writers of one path cannot interleave; the last rename wins.
+    static bool write_atomic(const std::string& path, const void* data, size_t size) {
+        return write_atomic(path, {{data, size}});
+    }
+
+    // Gathers several buffers into one file, so callers need not
+    // concatenate them in memory first
+    static bool write_atomic(const std::string& path, const std::vector<std::pair<const void*, size_t>>& parts) {
+        static std::atomic<uint64_t> next_temporary{0};
+        std::string temporary = path + "." + std::to_string(process_id()) + "." +
+                                std::to_string(next_temporary.fetch_add(1, std::memory_order_relaxed)) + ".tmp";
+        bool written;
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file) return false;
+            for (const auto& [data, size] : parts) {
+                file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            }
+            written = static_cast<bool>(file);
+        }
+#if defined(CORE_MAPPED_FILE_READ_FALLBACK)
+        if (written) std::remove(path.c_str());
+#endif
+        if (written && std::rename(temporary.c_str(), path.c_str()) == 0) return true;
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+private:
+    static long process_id() {
+#if defined(_WIN32)
+        return static_cast<long>(_getpid());
+#else
+        return static_cast<long>(getpid());
+#endif
+    }
+};
+
+} // namespace Core
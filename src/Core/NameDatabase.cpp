@@ -1,5 +1,6 @@
 #include "NameDatabase.hpp"
 #include <godot_cpp/classes/file_access.hpp>
+#include "WorldSeed.hpp"
 
 void NameDatabase::_bind_methods() {
     ClassDB::bind_method(D_METHOD("load_from_file", "file_path"), &NameDatabase::load_from_file);
@@ -10,7 +11,7 @@ void NameDatabase::_bind_methods() {
     ClassDB::bind_method(D_METHOD("get_random_culture_name"), &NameDatabase::get_random_culture_name);
 }
 
-NameDatabase::NameDatabase() : gen(rd()) {}
+NameDatabase::NameDatabase() : gen(static_cast<uint32_t>(Core::WorldSeed::get_instance().derive("names"))) {}
 
 void NameDatabase::load_from_file(const String& file_path) {
     Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
@@ -15,7 +15,6 @@ private:
     Array group_names;
     Array culture_names;
     
-    std::random_device rd;
     std::mt19937 gen;
 
 protected:
@@ -0,0 +1,273 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "MappedFile.hpp"
+
+namespace Core {
+
+// Append-only record of everything that feeds a run from outside the
+// simulation: the world seed (see WorldSeed), player inputs and external
+// events, stamped with the fixed simulation tick they apply to. State
+// checksums can be logged alongside, so a replay finds the first tick at
+// which it diverges.
+//
+//   Header | record...
+//   record = varint tick delta | kind | varint channel | varint size | payload
+//
+// Records are length-prefixed and written in tick order, so a log cut
+// short by a crash still replays up to its last whole record.
+namespace ReplayFormat {
+    constexpr char MAGIC[8] = {'G', 'A', 'M', 'E', 'R', 'P', 'L', 'Y'};
+    constexpr uint32_t VERSION = 1;
+
+    enum class Kind : uint8_t {
+        INPUT = 1,     // Player input; channel and payload are game-defined
+        EVENT = 2,     // External event, e.g. one injected through a singleton
+        CHECKSUM = 3,  // 8-byte state hash taken after the tick was simulated
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t ticks_per_second;
+        uint64_t world_seed;
+    };
+
+    static_assert(sizeof(Header) == 24, "replay header layout");
+}
+
+class ReplayRecorder {
+private:
+    static constexpr size_t FLUSH_BYTES = 64 * 1024;
+
+    std::FILE* file{nullptr};
+    std::vector<uint8_t> buffer;
+    uint64_t last_tick{0};
+    std::mutex mutex;
+
+public:
+    ReplayRecorder() = default;
+    ReplayRecorder(const ReplayRecorder&) = delete;
+    ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+    ~ReplayRecorder() { close(); }
+
+    bool open(const std::string& path, uint64_t world_seed, uint32_t ticks_per_second) {
+        close();
+        file = std::fopen(path.c_str(), "wb");
+        if (!file) return false;
+        ReplayFormat::Header header{};
+        std::memcpy(header.magic, ReplayFormat::MAGIC, sizeof(header.magic));
+        header.version = ReplayFormat::VERSION;
+        header.ticks_per_second = ticks_per_second;
+        header.world_seed = world_seed;
+        last_tick = 0;
+        return std::fwrite(&header, sizeof(header), 1, file) == 1;
+    }
+
+    bool is_open() const { return file != nullptr; }
+
+    // Inputs and events for a tick are recorded before it is simulated,
+    // its checksum after. A record for a tick earlier than the last one
+    // is refused rather than moved, since replaying it on a later tick
+    // would desync. Thread-safe, so network or UI threads can record
+    // directly.
+    bool record(uint64_t tick, ReplayFormat::Kind kind, uint32_t channel, const void* data, size_t size) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!file || tick < last_tick) return false;
+        put_varint(tick - last_tick);
+        last_tick = tick;
+        buffer.push_back(static_cast<uint8_t>(kind));
+        put_varint(channel);
+        put_varint(size);
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+        if (buffer.size() >= FLUSH_BYTES) write_buffer();
+        return true;
+    }
+
+    bool record_input(uint64_t tick, uint32_t channel, const void* data, size_t size) {
+        return record(tick, ReplayFormat::Kind::INPUT, channel, data, size);
+    }
+
+    bool record_event(uint64_t tick, uint32_t type, std::string_view payload) {
+        return record(tick, ReplayFormat::Kind::EVENT, type, payload.data(), payload.size());
+    }
+
+    bool record_checksum(uint64_t tick, uint64_t state_hash) {
+        return record(tick, ReplayFormat::Kind::CHECKSUM, 0, &state_hash, sizeof(state_hash));
+    }
+
+    // Pushes buffered records to the OS so they survive a crash
+    void flush() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (file) write_buffer();
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!file) return;
+        write_buffer();
+        std::fclose(file);
+        file = nullptr;
+    }
+
+private:
+    void put_varint(uint64_t value) {
+        while (value >= 0x80) {
+            buffer.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back(static_cast<uint8_t>(value));
+    }
+
+    void write_buffer() {
+        if (!buffer.empty()) std::fwrite(buffer.data(), 1, buffer.size(), file);
+        buffer.clear();
+        std::fflush(file);
+    }
+};
+
+class ReplayReader {
+public:
+    struct Record {
+        uint64_t tick;
+        ReplayFormat::Kind kind;
+        uint32_t channel;
+        const uint8_t* data;  // Points into the mapped log
+        size_t size;
+    };
+
+private:
+    MappedFile file;
+    ReplayFormat::Header header{};
+    size_t cursor{0};
+    uint64_t tick{0};
+    bool truncated{false};
+
+public:
+    bool open(const std::string& path) {
+        cursor = 0;
+        tick = 0;
+        truncated = false;
+        if (!file.open(path) || file.size() < sizeof(header)) return false;
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, ReplayFormat::MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != ReplayFormat::VERSION) {
+            file.close();
+            return false;
+        }
+        cursor = sizeof(header);
+        return true;
+    }
+
+    uint64_t world_seed() const { return header.world_seed; }
+    uint32_t ticks_per_second() const { return header.ticks_per_second; }
+
+    // True once next() stopped at a partial record, e.g. after a crash
+    bool is_truncated() const { return truncated; }
+
+    bool next(Record& record) {
+        if (!file.is_open() || cursor >= file.size()) return false;
+        size_t at = cursor;
+        uint64_t delta, channel, size;
+        if (!get_varint(at, delta) || at >= file.size()) return stop();
+        uint8_t kind = file.data()[at++];
+        if (!get_varint(at, channel) || !get_varint(at, size) || size > file.size() - at) return stop();
+
+        tick += delta;
+        record.tick = tick;
+        record.kind = static_cast<ReplayFormat::Kind>(kind);
+        record.channel = static_cast<uint32_t>(channel);
+        record.data = file.data() + at;
+        record.size = static_cast<size_t>(size);
+        cursor = at + record.size;
+        return true;
+    }
+
+private:
+    bool stop() {
+        truncated = true;
+        cursor = file.size();
+        return false;
+    }
+
+    bool get_varint(size_t& at, uint64_t& value) const {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (at >= file.size()) return false;
+            uint8_t byte = file.data()[at++];
+            value |= uint64_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+};
+
+// Drives a headless simulation from a log as fast as it can step: no
+// frame pacing, only ticks that apply the logged inputs and events.
+// Set WorldSeed from reader.world_seed() before creating the systems.
+class ReplayPlayer {
+public:
+    struct Hooks {
+        std::function<void(const ReplayReader::Record&)> apply;  // Inputs and events
+        std::function<void(uint64_t tick)> step;                 // One fixed tick
+        std::function<uint64_t()> checksum;                      // Optional
+    };
+
+    struct Result {
+        uint64_t ticks{0};  // Ticks simulated
+        bool desynced{false};
+        uint64_t desync_tick{0};
+        uint64_t expected{0};
+        uint64_t actual{0};
+        bool truncated{false};
+    };
+
+    // Replays through the last logged tick, or stops at the first
+    // checksum mismatch
+    static Result run(ReplayReader& reader, const Hooks& hooks) {
+        Result result;
+        ReplayReader::Record record;
+        bool has_record = reader.next(record);
+        uint64_t tick = 0;
+        std::vector<ReplayReader::Record> checksums;
+        while (has_record) {
+            checksums.clear();
+            for (; has_record && record.tick == tick; has_record = reader.next(record)) {
+                if (record.kind == ReplayFormat::Kind::CHECKSUM) {
+                    checksums.push_back(record);
+                } else if (hooks.apply) {
+                    hooks.apply(record);
+                }
+            }
+            hooks.step(tick);
+            ++result.ticks;
+
+            for (const auto& logged : checksums) {
+                if (!hooks.checksum || logged.size != sizeof(uint64_t)) continue;
+                uint64_t expected;
+                std::memcpy(&expected, logged.data, sizeof(expected));
+                uint64_t actual = hooks.checksum();
+                if (actual != expected) {
+                    result.desynced = true;
+                    result.desync_tick = tick;
+                    result.expected = expected;
+                    result.actual = actual;
+                    result.truncated = reader.is_truncated();
+                    return result;
+                }
+            }
+            ++tick;
+        }
+        result.truncated = reader.is_truncated();
+        return result;
+    }
+};
+
+} // namespace Core
@@ -0,0 +1,512 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <future>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "ChunkCodec.hpp"
+#include "MappedFile.hpp"
+#include "../AI/Core/ThreadPool.hpp"
+
+namespace Core {
+
+// Binary save file: one section per system (waypoints, climate grid,
+// node stat columns, voters...), each split into fixed-size chunks that
+// are compressed independently.
+//
+//   Header | chunk data ... | SectionEntry[section_count] | ChunkEntry[...]
+//
+// The directory sits at the end so the writer can stream chunks out; the
+// header points at it. Readers map the file and parse only the directory,
+// so a section costs nothing until it is loaded, and any byte range of a
+// section can be read by decoding just the chunks that overlap it.
+// Multi-byte values are stored in host byte order.
+namespace SaveFormat {
+    constexpr char MAGIC[8] = {'G', 'A', 'M', 'E', 'S', 'A', 'V', 'E'};
+    constexpr uint32_t VERSION = 2;
+    constexpr size_t CHUNK_SIZE = 256 * 1024;
+    constexpr size_t NAME_SIZE = 32;
+
+    // Chunk method for delta saves: identical to the same chunk of the
+    // same section in the base file named by BASE_SECTION
+    constexpr uint8_t BASE_CHUNK = 0xFF;
+    constexpr const char* BASE_SECTION = "@base";
+    constexpr int MAX_BASE_DEPTH = 64;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t section_count;
+        uint64_t directory_offset;
+        uint64_t chunk_count;
+    };
+
+    struct SectionEntry {
+        char name[NAME_SIZE];
+        uint64_t raw_size;
+        uint64_t first_chunk;
+        uint32_t chunk_count;
+        uint32_t element_size;
+    };
+
+    struct ChunkEntry {
+        uint64_t offset;
+        uint64_t raw_hash;  // Of the decoded bytes; matches mean unchanged
+        uint32_t stored_size;
+        uint32_t raw_size;
+        uint32_t checksum;
+        uint8_t method;
+        uint8_t padding[3];
+    };
+
+    static_assert(sizeof(Header) == 32, "save header layout");
+    static_assert(sizeof(SectionEntry) == 56, "save section entry layout");
+    static_assert(sizeof(ChunkEntry) == 32, "save chunk entry layout");
+
+    inline uint64_t hash(const uint8_t* data, size_t size) {
+        uint64_t value = 0x9E3779B97F4A7C15ull ^ size;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            value = (value ^ word) * 0xFF51AFD7ED558CCDull;
+            value ^= value >> 32;
+        }
+        for (; i < size; ++i) {
+            value = (value ^ data[i]) * 0x100000001B3ull;
+        }
+        return value;
+    }
+
+    // Catches truncated or corrupted chunks before they are decoded
+    inline uint32_t checksum(const uint8_t* data, size_t size) {
+        uint64_t value = hash(data, size);
+        return static_cast<uint32_t>(value ^ (value >> 32));
+    }
+}
+
+// Append-only byte buffer for one section. Arrays are padded to their
+// element alignment so numeric columns land on element boundaries, which
+// keeps the codec's shuffle filter effective.
+class SaveSection {
+private:
+    std::string name;
+    uint32_t element_size;
+    std::vector<uint8_t> bytes;
+
+    friend class SaveWriter;
+
+public:
+    SaveSection(std::string section_name, uint32_t element) : name(std::move(section_name)), element_size(element) {}
+
+    const std::string& get_name() const { return name; }
+    size_t size() const { return bytes.size(); }
+    void reserve(size_t capacity) { bytes.reserve(capacity); }
+
+    template<typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "save values must be trivially copyable");
+        const uint8_t* raw = reinterpret_cast<const uint8_t*>(&value);
+        bytes.insert(bytes.end(), raw, raw + sizeof(T));
+    }
+
+    template<typename T>
+    void put_array(const T* values, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "save values must be trivially copyable");
+        put<uint64_t>(count);
+        bytes.resize((bytes.size() + alignof(T) - 1) / alignof(T) * alignof(T), 0);
+        const uint8_t* raw = reinterpret_cast<const uint8_t*>(values);
+        bytes.insert(bytes.end(), raw, raw + count * sizeof(T));
+    }
+
+    template<typename T>
+    void put_array(const std::vector<T>& values) { put_array(values.data(), values.size()); }
+
+    void put_string(std::string_view value) { put_array(value.data(), value.size()); }
+};
+
+// Sequential reader over a loaded section. Reads past the end or with
+// implausible counts fail and leave the reader in the failed state, so
+// callers can read a whole record and check ok() once.
+class SaveSectionReader {
+private:
+    std::vector<uint8_t> bytes;
+    size_t cursor{0};
+    bool failed{false};
+
+    friend class SaveReader;
+
+public:
+    bool ok() const { return !failed; }
+    bool at_end() const { return cursor == bytes.size(); }
+    size_t size() const { return bytes.size(); }
+
+    template<typename T>
+    bool get(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "save values must be trivially copyable");
+        if (failed || bytes.size() - cursor < sizeof(T)) return fail();
+        std::memcpy(&value, bytes.data() + cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+
+    template<typename T>
+    bool get_array(std::vector<T>& values) {
+        uint64_t count = 0;
+        if (!get(count)) return false;
+        size_t start = (cursor + alignof(T) - 1) / alignof(T) * alignof(T);
+        if (start > bytes.size() || count > (bytes.size() - start) / sizeof(T)) return fail();
+        values.resize(static_cast<size_t>(count));
+        std::memcpy(values.data(), bytes.data() + start, values.size() * sizeof(T));
+        cursor = start + values.size() * sizeof(T);
+        return true;
+    }
+
+    bool get_string(std::string& value) {
+        std::vector<char> characters;
+        if (!get_array(characters)) return false;
+        value.assign(characters.begin(), characters.end());
+        return true;
+    }
+
+private:
+    bool fail() {
+        failed = true;
+        return false;
+    }
+};
+
+// Chunk hashes of the last file written, so the next save can be a delta
+// against it
+struct SaveBaseline {
+    std::string path;
+    std::unordered_map<std::string, std::vector<uint64_t>> chunk_hashes;
+};
+
+// Collects sections and writes them as one file. Sections are
+// independent, so once they have all been added each can be filled by a
+// different job. write() then compresses every chunk of every section in
+// parallel and streams the result to disk without assembling the file.
+class SaveWriter {
+private:
+    std::deque<SaveSection> sections;  // Deque so handed-out references stay valid
+
+public:
+    // element_size is the width of the section's dominant numeric type
+    // (4 for float columns); 1 disables the shuffle filter. Adding a
+    // section that already exists empties it but keeps its capacity, so
+    // a writer reused for every autosave stops allocating.
+    SaveSection& add_section(const std::string& name, uint32_t element_size = 4) {
+        std::string_view section_name = std::string_view(name).substr(0, SaveFormat::NAME_SIZE - 1);
+        for (auto& section : sections) {
+            if (section.name == section_name) {
+                section.bytes.clear();
+                section.element_size = element_size;
+                return section;
+            }
+        }
+        return sections.emplace_back(std::string(section_name), element_size);
+    }
+
+    // Drops every section not named; invalidates handed-out references
+    void keep_sections(const std::vector<std::string>& names) {
+        for (auto it = sections.begin(); it != sections.end();) {
+            if (std::find(names.begin(), names.end(), it->name) == names.end()) {
+                it = sections.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    bool write(const std::string& path, ThreadPool* pool = nullptr, SaveBaseline* record = nullptr) {
+        return write_file(path, nullptr, pool, record);
+    }
+
+    // Writes only the chunks whose contents differ from `base`; the rest
+    // are references that readers resolve through the base file, which
+    // must stay next to the delta
+    bool write_delta(const std::string& path, const SaveBaseline& base, ThreadPool* pool = nullptr,
+                     SaveBaseline* record = nullptr) {
+        return write_file(path, &base, pool, record);
+    }
+
+private:
+    bool write_file(const std::string& path, const SaveBaseline* base, ThreadPool* pool, SaveBaseline* record) {
+        struct Job {
+            const SaveSection* section;
+            size_t index;
+            size_t begin;
+            size_t size;
+            const std::vector<uint64_t>* base_hashes;
+            uint64_t raw_hash{0};
+            std::vector<uint8_t> stored;
+            uint8_t method{0};
+        };
+
+        std::vector<const SaveSection*> written;
+        SaveSection base_section(SaveFormat::BASE_SECTION, 1);
+        if (base) {
+            base_section.put_string(std::filesystem::path(base->path).filename().string());
+            written.push_back(&base_section);
+        }
+        for (const auto& section : sections) written.push_back(&section);
+
+        std::vector<Job> jobs;
+        std::vector<SaveFormat::SectionEntry> directory;
+        for (const SaveSection* section : written) {
+            const std::vector<uint64_t>* base_hashes = nullptr;
+            if (base && section != &base_section) {
+                auto found = base->chunk_hashes.find(section->name);
+                if (found != base->chunk_hashes.end()) base_hashes = &found->second;
+            }
+            SaveFormat::SectionEntry entry{};
+            std::memcpy(entry.name, section->name.data(), section->name.size());
+            entry.raw_size = section->bytes.size();
+            entry.first_chunk = jobs.size();
+            entry.element_size = section->element_size;
+            for (size_t begin = 0; begin < section->bytes.size(); begin += SaveFormat::CHUNK_SIZE) {
+                size_t size = std::min(SaveFormat::CHUNK_SIZE, section->bytes.size() - begin);
+                jobs.push_back({section, begin / SaveFormat::CHUNK_SIZE, begin, size, base_hashes, 0, {}, 0});
+            }
+            entry.chunk_count = static_cast<uint32_t>(jobs.size() - entry.first_chunk);
+            directory.push_back(entry);
+        }
+
+        auto compress = [&jobs](size_t index) {
+            Job& job = jobs[index];
+            const uint8_t* raw = job.section->bytes.data() + job.begin;
+            job.raw_hash = SaveFormat::hash(raw, job.size);
+            if (job.base_hashes && job.index < job.base_hashes->size() &&
+                (*job.base_hashes)[job.index] == job.raw_hash) {
+                job.method = SaveFormat::BASE_CHUNK;
+                return;
+            }
+            job.method = static_cast<uint8_t>(ChunkCodec::compress(raw, job.size, job.section->element_size, job.stored));
+        };
+        if (pool && jobs.size() > 1) {
+            std::vector<std::future<void>> pending;
+            pending.reserve(jobs.size());
+            for (size_t i = 0; i < jobs.size(); ++i) pending.push_back(pool->enqueue(compress, i));
+            for (auto& job : pending) job.get();
+        } else {
+            for (size_t i = 0; i < jobs.size(); ++i) compress(i);
+        }
+
+        SaveFormat::Header header{};
+        std::memcpy(header.magic, SaveFormat::MAGIC, sizeof(header.magic));
+        header.version = SaveFormat::VERSION;
+        header.section_count = static_cast<uint32_t>(directory.size());
+        header.chunk_count = jobs.size();
+
+        std::vector<SaveFormat::ChunkEntry> chunks;
+        chunks.reserve(jobs.size());
+        std::vector<std::pair<const void*, size_t>> parts;
+        parts.reserve(jobs.size() + 3);
+        parts.emplace_back(&header, sizeof(header));
+        uint64_t offset = sizeof(header);
+        for (const auto& job : jobs) {
+            SaveFormat::ChunkEntry chunk{};
+            chunk.offset = offset;
+            chunk.raw_hash = job.raw_hash;
+            chunk.stored_size = static_cast<uint32_t>(job.stored.size());
+            chunk.raw_size = static_cast<uint32_t>(job.size);
+            chunk.checksum = SaveFormat::checksum(job.stored.data(), job.stored.size());
+            chunk.method = job.method;
+            chunks.push_back(chunk);
+            if (!job.stored.empty()) parts.emplace_back(job.stored.data(), job.stored.size());
+            offset += job.stored.size();
+        }
+        header.directory_offset = offset;
+        parts.emplace_back(directory.data(), directory.size() * sizeof(SaveFormat::SectionEntry));
+        parts.emplace_back(chunks.data(), chunks.size() * sizeof(SaveFormat::ChunkEntry));
+        if (!MappedFile::write_atomic(path, parts)) return false;
+
+        if (record) {
+            record->path = path;
+            record->chunk_hashes.clear();
+            for (const auto& job : jobs) record->chunk_hashes[job.section->name].push_back(job.raw_hash);
+        }
+        return true;
+    }
+};
+
+// Maps a save file and decodes sections on demand. A delta save opens
+// its base file as well; chains of deltas resolve recursively.
+class SaveReader {
+private:
+    MappedFile file;
+    std::vector<SaveFormat::SectionEntry> sections;
+    std::vector<SaveFormat::ChunkEntry> chunks;
+    std::unique_ptr<SaveReader> base;
+
+public:
+    bool open(const std::string& path) { return open(path, 0); }
+
+    bool has_section(std::string_view name) const { return find(name) != nullptr; }
+
+    std::vector<std::string> section_names() const {
+        std::vector<std::string> names;
+        for (const auto& section : sections) {
+            if (section.name != std::string_view(SaveFormat::BASE_SECTION)) names.emplace_back(section.name);
+        }
+        return names;
+    }
+
+    uint64_t section_size(std::string_view name) const {
+        const SaveFormat::SectionEntry* section = find(name);
+        return section ? section->raw_size : 0;
+    }
+
+    // Decodes a whole section, chunks in parallel when a pool is given
+    bool load(std::string_view name, SaveSectionReader& reader, ThreadPool* pool = nullptr) const {
+        reader = SaveSectionReader();
+        const SaveFormat::SectionEntry* section = find(name);
+        if (!section) return false;
+        reader.bytes.resize(static_cast<size_t>(section->raw_size));
+
+        bool decoded = true;
+        if (pool && section->chunk_count > 1) {
+            std::vector<std::future<bool>> pending;
+            for (uint32_t i = 0; i < section->chunk_count; ++i) {
+                pending.push_back(pool->enqueue([this, section, &reader, i]() {
+                    return decode(*section, i, reader.bytes.data() + size_t(i) * SaveFormat::CHUNK_SIZE);
+                }));
+            }
+            for (auto& chunk : pending) decoded = chunk.get() && decoded;
+        } else {
+            for (uint32_t i = 0; i < section->chunk_count && decoded; ++i) {
+                decoded = decode(*section, i, reader.bytes.data() + size_t(i) * SaveFormat::CHUNK_SIZE);
+            }
+        }
+        if (!decoded) reader = SaveSectionReader();
+        return decoded;
+    }
+
+    // Random access: decodes only the chunks overlapping [offset, offset + size)
+    bool read(std::string_view name, uint64_t offset, void* destination, size_t size) const {
+        const SaveFormat::SectionEntry* section = find(name);
+        if (!section || offset > section->raw_size || size > section->raw_size - offset) return false;
+
+        uint8_t* out = static_cast<uint8_t*>(destination);
+        std::vector<uint8_t> scratch;
+        while (size > 0) {
+            uint32_t index = static_cast<uint32_t>(offset / SaveFormat::CHUNK_SIZE);
+            size_t within = static_cast<size_t>(offset % SaveFormat::CHUNK_SIZE);
+            size_t raw = chunks[section->first_chunk + index].raw_size;
+            size_t take = std::min(size, raw - within);
+            if (within == 0 && take == raw) {
+                if (!decode(*section, index, out)) return false;
+            } else {
+                scratch.resize(raw);
+                if (!decode(*section, index, scratch.data())) return false;
+                std::memcpy(out, scratch.data() + within, take);
+            }
+            out += take;
+            offset += take;
+            size -= take;
+        }
+        return true;
+    }
+
+private:
+    bool open(const std::string& path, int depth) {
+        sections.clear();
+        chunks.clear();
+        base.reset();
+        if (!file.open(path) || file.size() < sizeof(SaveFormat::Header)) return false;
+
+        SaveFormat::Header header;
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, SaveFormat::MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != SaveFormat::VERSION) {
+            return fail();
+        }
+        uint64_t directory_size = header.section_count * uint64_t(sizeof(SaveFormat::SectionEntry)) +
+                                  header.chunk_count * uint64_t(sizeof(SaveFormat::ChunkEntry));
+        if (header.directory_offset > file.size() || directory_size != file.size() - header.directory_offset) {
+            return fail();
+        }
+
+        const uint8_t* at = file.data() + header.directory_offset;
+        sections.resize(header.section_count);
+        std::memcpy(sections.data(), at, sections.size() * sizeof(SaveFormat::SectionEntry));
+        chunks.resize(static_cast<size_t>(header.chunk_count));
+        std::memcpy(chunks.data(), at + sections.size() * sizeof(SaveFormat::SectionEntry),
+                    chunks.size() * sizeof(SaveFormat::ChunkEntry));
+
+        bool references_base = false;
+        for (auto& section : sections) {
+            section.name[SaveFormat::NAME_SIZE - 1] = '\0';
+            uint64_t raw = 0;
+            if (section.first_chunk + section.chunk_count > chunks.size()) return fail();
+            for (uint32_t i = 0; i < section.chunk_count; ++i) {
+                const auto& chunk = chunks[section.first_chunk + i];
+                if (chunk.offset > header.directory_offset ||
+                    chunk.stored_size > header.directory_offset - chunk.offset ||
+                    chunk.raw_size > SaveFormat::CHUNK_SIZE ||
+                    (i + 1 < section.chunk_count && chunk.raw_size != SaveFormat::CHUNK_SIZE)) {
+                    return fail();
+                }
+                references_base = references_base || chunk.method == SaveFormat::BASE_CHUNK;
+                raw += chunk.raw_size;
+            }
+            if (raw != section.raw_size) return fail();
+        }
+        return !references_base || open_base(path, depth);
+    }
+
+    // The base is named relative to the delta's own directory
+    bool open_base(const std::string& path, int depth) {
+        SaveSectionReader reader;
+        std::string name;
+        if (depth >= SaveFormat::MAX_BASE_DEPTH || !load(SaveFormat::BASE_SECTION, reader) ||
+            !reader.get_string(name)) {
+            return fail();
+        }
+        base = std::make_unique<SaveReader>();
+        if (!base->open((std::filesystem::path(path).parent_path() / name).string(), depth + 1)) return fail();
+        return true;
+    }
+
+    bool fail() {
+        sections.clear();
+        chunks.clear();
+        base.reset();
+        file.close();
+        return false;
+    }
+
+    const SaveFormat::SectionEntry* find(std::string_view name) const {
+        for (const auto& section : sections) {
+            if (name == section.name) return &section;
+        }
+        return nullptr;
+    }
+
+    bool decode(const SaveFormat::SectionEntry& section, uint32_t index, uint8_t* out) const {
+        const SaveFormat::ChunkEntry& chunk = chunks[section.first_chunk + index];
+        if (chunk.method == SaveFormat::BASE_CHUNK) {
+            // The base must hold the very bytes this chunk was hashed from
+            const SaveFormat::SectionEntry* original = base ? base->find(section.name) : nullptr;
+            if (!original || index >= original->chunk_count) return false;
+            const SaveFormat::ChunkEntry& source = base->chunks[original->first_chunk + index];
+            if (source.raw_hash != chunk.raw_hash || source.raw_size != chunk.raw_size) return false;
+            return base->decode(*original, index, out);
+        }
+        const uint8_t* stored = file.data() + chunk.offset;
+        if (SaveFormat::checksum(stored, chunk.stored_size) != chunk.checksum) return false;
+        return ChunkCodec::decompress(static_cast<ChunkCodec::Method>(chunk.method), stored, chunk.stored_size,
+                                      section.element_size, out, chunk.raw_size);
+    }
+};
+
+} // namespace Core
@@ -0,0 +1,141 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "SaveArchive.hpp"
+
+namespace Core {
+
+// The sections that make up a binary save. Every system with saveable
+// state registers one section here (through a SavedSection member), so
+// saving, autosaving and loading need no list of systems.
+//
+// Keys must be unique; systems with several instances append their
+// instance key, e.g. "voters:North". Keys longer than a section name
+// allows are shortened with a hash of the full key. Main thread only.
+class SaveRegistry {
+public:
+    using Save = std::function<void(SaveSection&)>;
+    using Load = std::function<bool(SaveSectionReader&)>;
+    using Id = uint64_t;
+
+    static constexpr Id INVALID_ID = 0;
+
+private:
+    struct Entry {
+        Id id;
+        std::string name;
+        uint32_t element_size;
+        Save save;
+        Load load;
+    };
+
+    std::vector<Entry> entries;  // In registration order
+    std::vector<std::string> names;  // entries[i].name, kept for capture()
+    Id next_id{1};
+
+    SaveRegistry() = default;
+
+public:
+    static SaveRegistry& get_instance() {
+        static SaveRegistry instance;
+        return instance;
+    }
+
+    // INVALID_ID if another section already uses the key
+    Id add(std::string_view key, uint32_t element_size, Save save, Load load) {
+        std::string name = section_name(key);
+        for (const auto& entry : entries) {
+            if (entry.name == name) return INVALID_ID;
+        }
+        Id id = next_id++;
+        names.push_back(name);
+        entries.push_back({id, std::move(name), element_size, std::move(save), std::move(load)});
+        return id;
+    }
+
+    void remove(Id id) {
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->id == id) {
+                names.erase(names.begin() + (it - entries.begin()));
+                entries.erase(it);
+                return;
+            }
+        }
+    }
+
+    size_t size() const { return entries.size(); }
+
+    // Fills one writer section per entry. Sections of systems that have
+    // since gone away are dropped, so a writer can be reused across saves.
+    void capture(SaveWriter& writer) const {
+        for (const auto& entry : entries) {
+            entry.save(writer.add_section(entry.name, entry.element_size));
+        }
+        writer.keep_sections(names);
+    }
+
+    bool save(const std::string& path, ThreadPool* pool = nullptr) const {
+        SaveWriter writer;
+        capture(writer);
+        return writer.write(path, pool);
+    }
+
+    // Loads every registered section the file has. Sections missing from
+    // an older save leave their system as it is; false if the file cannot
+    // be opened or any section fails to decode or load.
+    bool load(const std::string& path, ThreadPool* pool = nullptr) const {
+        SaveReader reader;
+        return reader.open(path) && load(reader, pool);
+    }
+
+    bool load(const SaveReader& reader, ThreadPool* pool = nullptr) const {
+        bool loaded = true;
+        SaveSectionReader section;
+        for (const auto& entry : entries) {
+            if (!reader.has_section(entry.name)) continue;
+            loaded = reader.load(entry.name, section, pool) && entry.load(section) && loaded;
+        }
+        return loaded;
+    }
+
+    static std::string section_name(std::string_view key) {
+        if (key.size() < SaveFormat::NAME_SIZE) return std::string(key);
+        char suffix[18];
+        std::snprintf(suffix, sizeof(suffix), "#%016llx",
+                      static_cast<unsigned long long>(
+                          SaveFormat::hash(reinterpret_cast<const uint8_t*>(key.data()), key.size())));
+        return std::string(key.substr(0, SaveFormat::NAME_SIZE - 1 - 17)) + suffix;
+    }
+};
+
+// A system's registration, removed again when the system goes away
+class SavedSection {
+private:
+    SaveRegistry::Id id{SaveRegistry::INVALID_ID};
+
+public:
+    SavedSection() = default;
+    SavedSection(const SavedSection&) = delete;
+    SavedSection& operator=(const SavedSection&) = delete;
+    ~SavedSection() { reset(); }
+
+    // Replaces any earlier registration; false if the key is taken
+    bool bind(std::string_view key, uint32_t element_size, SaveRegistry::Save save, SaveRegistry::Load load) {
+        reset();
+        id = SaveRegistry::get_instance().add(key, element_size, std::move(save), std::move(load));
+        return id != SaveRegistry::INVALID_ID;
+    }
+
+    void reset() {
+        if (id != SaveRegistry::INVALID_ID) SaveRegistry::get_instance().remove(id);
+        id = SaveRegistry::INVALID_ID;
+    }
+
+    bool is_bound() const { return id != SaveRegistry::INVALID_ID; }
+};
+
+} // namespace Core
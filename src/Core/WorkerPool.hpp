@@ -0,0 +1,20 @@
+#pragma once
+#include "../AI/Core/ThreadPool.hpp"
+
+namespace Core {
+
+// The one thread pool the simulation systems fan their work out on.
+// Systems borrow it by reference, the way JobSystem takes a ThreadPool&,
+// instead of each starting hardware_concurrency workers of its own.
+//
+// Work queued here must not block on other work queued here; callers wait
+// for their futures from the main thread or from their own thread.
+class WorkerPool {
+public:
+    static ThreadPool& get_instance() {
+        static ThreadPool pool;
+        return pool;
+    }
+};
+
+} // namespace Core
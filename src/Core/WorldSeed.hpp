@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace Core {
+
+// Root of all simulation randomness. Each system seeds its generator
+// from derive() with its own stream name instead of calling randomize()
+// or reading std::random_device, so one 64-bit world seed reproduces a
+// whole run. Stream seeds depend only on the world seed and the name, not
+// on construction order.
+//
+// A fresh seed is drawn at startup; replays (see ReplayLog) set the
+// recorded one before the simulation systems are created.
+class WorldSeed {
+private:
+    uint64_t seed;
+
+    WorldSeed() : seed((uint64_t(std::random_device{}()) << 32) ^ std::random_device{}()) {}
+
+public:
+    static WorldSeed& get_instance() {
+        static WorldSeed instance;
+        return instance;
+    }
+
+    uint64_t get() const { return seed; }
+    void set(uint64_t world_seed) { seed = world_seed; }
+
+    // FNV-1a of the stream name, mixed with the world seed (splitmix64)
+    uint64_t derive(std::string_view stream) const {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (char c : stream) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001B3ull;
+        }
+        return mix(seed ^ hash);
+    }
+
+    // Stream for one of several instances of a system, so siblings do not
+    // draw identical sequences: derive("health", node path)
+    uint64_t derive(std::string_view stream, std::string_view instance) const {
+        std::string name(stream);
+        name += ':';
+        name.append(instance);
+        return derive(name);
+    }
+
+    // Counter-based draw for rolls that have no generator of their own:
+    // a pure function of a derive()d stream, an entity and a tick, so the
+    // result does not depend on which thread rolls or in what order.
+    // Several rolls for one entity in one tick fold a roll index into the
+    // entity.
+    static uint64_t draw(uint64_t stream, uint64_t entity, uint64_t tick) {
+        return mix(mix(stream ^ mix(entity)) ^ tick);
+    }
+
+    // The top 24 bits of a draw as a float in [0, 1)
+    static float unit(uint64_t bits) {
+        return static_cast<float>(bits >> 40) * (1.0f / 16777216.0f);
+    }
+
+private:
+    // splitmix64 finaliser
+    static uint64_t mix(uint64_t value) {
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+};
+
+} // namespace Core
@@ -0,0 +1,425 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "../Core/MappedFile.hpp"
+
+namespace Data {
+
+// Compiled form of one parsed data file.
+//
+// Layout (little-endian, every section 8-byte aligned):
+//   Header
+//   Node[node_count]        fixed 16-byte records, node 0 is the root
+//   uint32[string_count+1]  string offsets into the string bytes
+//   char[string_bytes]      deduplicated strings, not terminated
+//
+// Arrays and dictionaries point at a contiguous run of child nodes;
+// dictionaries store key/value pairs sorted by key, so lookups binary
+// search without hashing. The file is mapped and read in place.
+struct DataCacheFormat {
+    static constexpr char MAGIC[8] = {'G', 'D', 'C', 'A', 'C', 'H', 'E', '\0'};
+    // Bump whenever the layout or the conversion rules change
+    static constexpr uint32_t VERSION = 2;
+
+    enum class Type : uint8_t { NIL, BOOL, INT, FLOAT, STRING, ARRAY, DICTIONARY };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t source_hash;
+        uint64_t node_count;
+        uint64_t string_count;
+        uint64_t string_bytes;
+    };
+
+    struct Node {
+        Type type;
+        uint8_t padding[3];
+        uint32_t count;  // STRING: string index; ARRAY: elements; DICTIONARY: pairs
+        union {
+            int64_t integer;
+            double real;
+            uint64_t first;  // ARRAY / DICTIONARY: index of the first child
+        };
+    };
+    static_assert(sizeof(Node) == 16, "cache nodes are fixed 16-byte records");
+
+    static size_t align8(size_t value) { return (value + 7) & ~static_cast<size_t>(7); }
+
+    // FNV-1a, used to key caches on their source bytes
+    static uint64_t hash_bytes(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ull) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        uint64_t hash = seed;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+};
+
+// Builds a cache image. Reserve a slot for the root, then fill slots
+// top-down; set_array/set_dictionary return the first of their child
+// slots (dictionaries use two per entry: key then value). Streaming
+// builders instead append each finished block of children and write the
+// root into slot 0 last.
+class DataCacheWriter {
+private:
+    using Format = DataCacheFormat;
+
+    std::vector<Format::Node> nodes;
+    // Strings are kept exactly as they are written out: one byte arena
+    // plus offsets. An open-addressing index (id + 1, 0 is empty) finds
+    // duplicates without allocating.
+    std::string string_bytes;
+    std::vector<uint32_t> string_offsets{0};
+    std::vector<uint32_t> string_hashes;
+    std::vector<uint32_t> string_index = std::vector<uint32_t>(1024, 0);
+
+public:
+    uint32_t reserve(size_t count) {
+        uint32_t first = static_cast<uint32_t>(nodes.size());
+        Format::Node empty{};
+        nodes.resize(nodes.size() + count, empty);
+        return first;
+    }
+
+    void set_null(uint32_t slot) { nodes[slot].type = Format::Type::NIL; }
+    void set_bool(uint32_t slot, bool value) {
+        nodes[slot].type = Format::Type::BOOL;
+        nodes[slot].integer = value ? 1 : 0;
+    }
+    void set_int(uint32_t slot, int64_t value) {
+        nodes[slot].type = Format::Type::INT;
+        nodes[slot].integer = value;
+    }
+    void set_float(uint32_t slot, double value) {
+        nodes[slot].type = Format::Type::FLOAT;
+        nodes[slot].real = value;
+    }
+    void set_string(uint32_t slot, std::string_view value) {
+        nodes[slot].type = Format::Type::STRING;
+        nodes[slot].count = intern(value);
+    }
+    uint32_t set_array(uint32_t slot, size_t count) {
+        uint32_t first = reserve(count);
+        nodes[slot].type = Format::Type::ARRAY;
+        nodes[slot].count = static_cast<uint32_t>(count);
+        nodes[slot].first = first;
+        return first;
+    }
+    uint32_t set_dictionary(uint32_t slot, size_t count) {
+        uint32_t first = reserve(count * 2);
+        nodes[slot].type = Format::Type::DICTIONARY;
+        nodes[slot].count = static_cast<uint32_t>(count);
+        nodes[slot].first = first;
+        return first;
+    }
+
+    // Streaming writers build nodes themselves: strings go through intern,
+    // and a container's finished children are appended as one block
+    uint32_t intern(std::string_view value) {
+        uint32_t hash = static_cast<uint32_t>(Format::hash_bytes(value.data(), value.size()));
+        size_t mask = string_index.size() - 1;
+        for (size_t at = hash & mask;; at = (at + 1) & mask) {
+            uint32_t entry = string_index[at];
+            if (entry == 0) {
+                uint32_t id = static_cast<uint32_t>(string_hashes.size());
+                string_index[at] = id + 1;
+                string_hashes.push_back(hash);
+                string_bytes.append(value);
+                string_offsets.push_back(static_cast<uint32_t>(string_bytes.size()));
+                if (string_hashes.size() * 2 > string_index.size()) grow_index();
+                return id;
+            }
+            if (string_hashes[entry - 1] == hash && string(entry - 1) == value) return entry - 1;
+        }
+    }
+    uint32_t append(const Format::Node* block, size_t count) {
+        uint32_t first = static_cast<uint32_t>(nodes.size());
+        nodes.insert(nodes.end(), block, block + count);
+        return first;
+    }
+    void set_node(uint32_t slot, const Format::Node& node) { nodes[slot] = node; }
+
+    // Sorts every dictionary by key and serialises the image. Keys that
+    // are not strings sort after string keys and are only reachable by
+    // iteration.
+    std::vector<uint8_t> finish(uint64_t source_hash) {
+        for (auto& node : nodes) {
+            if (node.type != Format::Type::DICTIONARY || node.count < 2) continue;
+            sort_pairs(node);
+        }
+
+        Format::Header header{};
+        std::memcpy(header.magic, Format::MAGIC, sizeof(header.magic));
+        header.version = Format::VERSION;
+        header.source_hash = source_hash;
+        header.node_count = nodes.size();
+        header.string_count = string_hashes.size();
+        header.string_bytes = string_bytes.size();
+
+        size_t nodes_at = Format::align8(sizeof(header));
+        size_t offsets_at = nodes_at + nodes.size() * sizeof(Format::Node);
+        size_t bytes_at = Format::align8(offsets_at + string_offsets.size() * sizeof(uint32_t));
+        std::vector<uint8_t> image(bytes_at + string_bytes.size(), 0);
+
+        std::memcpy(image.data(), &header, sizeof(header));
+        if (!nodes.empty()) std::memcpy(image.data() + nodes_at, nodes.data(), nodes.size() * sizeof(Format::Node));
+        std::memcpy(image.data() + offsets_at, string_offsets.data(), string_offsets.size() * sizeof(uint32_t));
+        if (!string_bytes.empty()) std::memcpy(image.data() + bytes_at, string_bytes.data(), string_bytes.size());
+        return image;
+    }
+
+private:
+    std::string_view string(uint32_t id) const {
+        return std::string_view(string_bytes).substr(string_offsets[id], string_offsets[id + 1] - string_offsets[id]);
+    }
+
+    void grow_index() {
+        std::vector<uint32_t> grown(string_index.size() * 2, 0);
+        size_t mask = grown.size() - 1;
+        for (uint32_t id = 0; id < string_hashes.size(); ++id) {
+            size_t at = string_hashes[id] & mask;
+            while (grown[at] != 0) at = (at + 1) & mask;
+            grown[at] = id + 1;
+        }
+        string_index = std::move(grown);
+    }
+
+    void sort_pairs(const Format::Node& dictionary) {
+        std::vector<std::pair<Format::Node, Format::Node>> pairs(dictionary.count);
+        for (uint32_t i = 0; i < dictionary.count; ++i) {
+            pairs[i] = {nodes[dictionary.first + 2 * i], nodes[dictionary.first + 2 * i + 1]};
+        }
+        std::stable_sort(pairs.begin(), pairs.end(), [this](const auto& a, const auto& b) {
+            bool a_string = a.first.type == Format::Type::STRING;
+            bool b_string = b.first.type == Format::Type::STRING;
+            if (a_string != b_string) return a_string;
+            return a_string && string(a.first.count) < string(b.first.count);
+        });
+        for (uint32_t i = 0; i < dictionary.count; ++i) {
+            nodes[dictionary.first + 2 * i] = pairs[i].first;
+            nodes[dictionary.first + 2 * i + 1] = pairs[i].second;
+        }
+    }
+};
+
+// Zero-copy reader over a mapped cache image
+class DataCache {
+public:
+    using Format = DataCacheFormat;
+    using Type = Format::Type;
+
+    class Value {
+    private:
+        const DataCache* cache{nullptr};
+        const Format::Node* node{nullptr};
+
+    public:
+        Value() = default;
+        Value(const DataCache* owner, const Format::Node* target) : cache(owner), node(target) {}
+
+        bool is_valid() const { return node != nullptr; }
+        Type type() const { return node ? node->type : Type::NIL; }
+
+        bool as_bool() const { return node && node->integer != 0; }
+        int64_t as_int() const {
+            return type() == Type::FLOAT ? static_cast<int64_t>(node->real) : node ? node->integer : 0;
+        }
+        double as_float() const {
+            return type() == Type::INT ? static_cast<double>(node->integer) : type() == Type::FLOAT ? node->real : 0.0;
+        }
+        std::string_view as_string() const {
+            return type() == Type::STRING ? cache->string(node->count) : std::string_view();
+        }
+
+        // Elements for arrays, pairs for dictionaries
+        size_t size() const {
+            return type() == Type::ARRAY || type() == Type::DICTIONARY ? node->count : 0;
+        }
+        Value at(size_t index) const {
+            return index < size() && type() == Type::ARRAY ? cache->node(node->first + index) : Value();
+        }
+        Value key_at(size_t index) const {
+            return index < size() && type() == Type::DICTIONARY ? cache->node(node->first + 2 * index) : Value();
+        }
+        Value value_at(size_t index) const {
+            return index < size() && type() == Type::DICTIONARY ? cache->node(node->first + 2 * index + 1) : Value();
+        }
+
+        Value find(std::string_view key) const {
+            if (type() != Type::DICTIONARY) return Value();
+            size_t lo = 0;
+            size_t hi = node->count;
+            while (lo < hi) {
+                size_t mid = (lo + hi) / 2;
+                Value candidate = key_at(mid);
+                if (candidate.type() != Type::STRING || key < candidate.as_string()) {
+                    hi = mid;
+                } else if (candidate.as_string() < key) {
+                    lo = mid + 1;
+                } else {
+                    return value_at(mid);
+                }
+            }
+            return Value();
+        }
+
+        // Structural hash of the subtree; equal values hash equally across
+        // caches since dictionary keys are stored sorted
+        uint64_t hash(uint64_t seed = 0xcbf29ce484222325ull) const {
+            Type kind = type();
+            uint64_t hash = Format::hash_bytes(&kind, sizeof(kind), seed);
+            switch (kind) {
+                case Type::BOOL:
+                case Type::INT:
+                    return Format::hash_bytes(&node->integer, sizeof(node->integer), hash);
+                case Type::FLOAT:
+                    return Format::hash_bytes(&node->real, sizeof(node->real), hash);
+                case Type::STRING: {
+                    std::string_view text = as_string();
+                    return Format::hash_bytes(text.data(), text.size(), hash);
+                }
+                case Type::ARRAY:
+                case Type::DICTIONARY: {
+                    size_t count = kind == Type::ARRAY ? size() : size() * 2;
+                    hash = Format::hash_bytes(&node->count, sizeof(node->count), hash);
+                    for (size_t i = 0; i < count; ++i) {
+                        hash = cache->node(node->first + i).hash(hash);
+                    }
+                    return hash;
+                }
+                default:
+                    return hash;
+            }
+        }
+    };
+
+private:
+    Core::MappedFile file;
+    std::vector<uint8_t> owned;  // Images kept in memory when they could not be written
+    const Format::Header* header{nullptr};
+    const Format::Node* nodes{nullptr};
+    const uint32_t* string_offsets{nullptr};
+    const char* string_bytes{nullptr};
+
+public:
+    // Maps the cache and validates it against the expected source hash.
+    // A missing, stale, truncated or older-version cache returns false
+    // and the caller rebuilds it.
+    bool open(const std::string& path, uint64_t expected_hash) {
+        close();
+        if (!file.open(path)) return fail();
+        return attach(file.data(), file.size(), expected_hash);
+    }
+
+    // Adopts an image from DataCacheWriter::finish without touching disk
+    bool open_image(std::vector<uint8_t> image, uint64_t expected_hash) {
+        close();
+        owned = std::move(image);
+        return attach(owned.data(), owned.size(), expected_hash);
+    }
+
+    void close() {
+        file.close();
+        owned.clear();
+        header = nullptr;
+        nodes = nullptr;
+        string_offsets = nullptr;
+        string_bytes = nullptr;
+    }
+
+    bool is_open() const { return header != nullptr; }
+    Value root() const { return is_open() ? Value(this, nodes) : Value(); }
+    size_t node_count() const { return is_open() ? header->node_count : 0; }
+
+    static bool write(const std::string& path, const std::vector<uint8_t>& image) {
+        return Core::MappedFile::write_atomic(path, image.data(), image.size());
+    }
+
+private:
+    bool attach(const uint8_t* data, size_t size, uint64_t expected_hash) {
+        if (size < sizeof(Format::Header)) return fail();
+        header = reinterpret_cast<const Format::Header*>(data);
+        if (std::memcmp(header->magic, Format::MAGIC, sizeof(header->magic)) != 0 ||
+            header->version != Format::VERSION || header->source_hash != expected_hash ||
+            header->node_count == 0) {
+            return fail();
+        }
+        // Counts that could not fit in the file would overflow the offsets
+        if (header->node_count > size / sizeof(Format::Node) ||
+            header->string_count >= size / sizeof(uint32_t) || header->string_bytes > size) {
+            return fail();
+        }
+
+        size_t nodes_at = Format::align8(sizeof(Format::Header));
+        size_t offsets_at = nodes_at + header->node_count * sizeof(Format::Node);
+        size_t bytes_at = Format::align8(offsets_at + (header->string_count + 1) * sizeof(uint32_t));
+        if (bytes_at + header->string_bytes != size) return fail();
+
+        nodes = reinterpret_cast<const Format::Node*>(data + nodes_at);
+        string_offsets = reinterpret_cast<const uint32_t*>(data + offsets_at);
+        string_bytes = reinterpret_cast<const char*>(data + bytes_at);
+        return validate() || fail();
+    }
+
+    Value node(size_t index) const { return Value(this, nodes + index); }
+
+    std::string_view string(uint32_t index) const {
+        return std::string_view(string_bytes + string_offsets[index],
+                                string_offsets[index + 1] - string_offsets[index]);
+    }
+
+    bool fail() {
+        close();
+        return false;
+    }
+
+    // Bounds-checks every reference once so readers can index freely
+    bool validate() const {
+        for (uint64_t i = 0; i <= header->string_count; ++i) {
+            if (string_offsets[i] > header->string_bytes || (i > 0 && string_offsets[i] < string_offsets[i - 1])) {
+                return false;
+            }
+        }
+        // Every node but the root belongs to exactly one container, which
+        // makes the graph reachable from the root a tree whatever order the
+        // writer laid it out in
+        std::vector<uint8_t> claimed(header->node_count, 0);
+        claimed[0] = 1;
+        for (uint64_t i = 0; i < header->node_count; ++i) {
+            const Format::Node& n = nodes[i];
+            switch (n.type) {
+                case Type::NIL: case Type::BOOL: case Type::INT: case Type::FLOAT:
+                    break;
+                case Type::STRING:
+                    if (n.count >= header->string_count) return false;
+                    break;
+                case Type::ARRAY:
+                case Type::DICTIONARY: {
+                    uint64_t span = n.type == Type::ARRAY ? n.count : 2ull * n.count;
+                    if (span == 0) break;
+                    if (span > header->node_count || n.first > header->node_count - span) return false;
+                    for (uint64_t child = n.first; child < n.first + span; ++child) {
+                        if (claimed[child]) return false;
+                        claimed[child] = 1;
+                    }
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace Data
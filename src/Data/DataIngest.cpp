@@ -0,0 +1,782 @@
+#include "DataIngest.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <istream>
+#include <limits>
+#include <sstream>
+#include <streambuf>
+#include <unordered_map>
+#include "yaml-cpp/eventhandler.h"
+#include "yaml-cpp/parser.h"
+#include "yaml-cpp/exceptions.h"
+#include "toml++/toml.h"
+#include "tinyxml2.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace Data {
+
+namespace {
+
+// First byte in [at, end) that ends a plain run of a JSON string: a quote,
+// a backslash or a control character. Most strings are long plain runs,
+// so they are scanned a vector at a time. This is the only vectorised
+// part of the JSON reader; structure and numbers go byte by byte.
+const char* find_string_special(const char* at, const char* end) {
+#if defined(__AVX2__)
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+    while (end - at >= 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(at));
+        __m256i hits = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, quote), _mm256_cmpeq_epi8(bytes, backslash)),
+            _mm256_cmpeq_epi8(_mm256_min_epu8(bytes, control), bytes));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            return at + __builtin_ctz(mask);
+        }
+        at += 32;
+    }
+#elif defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    while (end - at >= 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(at));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash)),
+            _mm_cmpeq_epi8(_mm_min_epu8(bytes, control), bytes));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            return at + __builtin_ctz(mask);
+        }
+        at += 16;
+    }
+#endif
+    while (at < end) {
+        unsigned char c = static_cast<unsigned char>(*at);
+        if (c == '"' || c == '\\' || c < 0x20) {
+            return at;
+        }
+        ++at;
+    }
+    return end;
+}
+
+void append_utf8(std::string& out, uint32_t code) {
+    if (code < 0x80) {
+        out += static_cast<char>(code);
+    } else if (code < 0x800) {
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (code >> 18));
+        out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+bool parse_double(std::string_view text, double& value) {
+    // strtod needs a terminated buffer; numbers in data files are short
+    char buffer[64];
+    if (text.empty() || text.size() >= sizeof(buffer)) {
+        return false;
+    }
+    std::memcpy(buffer, text.data(), text.size());
+    buffer[text.size()] = '\0';
+    char* end = nullptr;
+    value = std::strtod(buffer, &end);
+    return end == buffer + text.size();
+}
+
+// Single pass over the source with an explicit container stack, so deep
+// documents cannot overflow the call stack. Strings without escapes are
+// handed to the sink as views into the source.
+class JsonReader {
+private:
+    const char* begin;
+    const char* at;
+    const char* end;
+    DataSink& sink;
+    IngestError& error;
+    std::string scratch;
+
+    // Bit 0: object; bit 1: no member read yet
+    enum : uint8_t { OBJECT = 1, FIRST = 2 };
+    std::vector<uint8_t> stack;
+
+public:
+    JsonReader(std::string_view source, DataSink& target, IngestError& error_out)
+        : begin(source.data()), at(source.data()), end(source.data() + source.size()),
+          sink(target), error(error_out) {}
+
+    bool read() {
+        if (end - at >= 3 && std::memcmp(at, "\xEF\xBB\xBF", 3) == 0) {
+            at += 3;
+        }
+        skip_whitespace();
+        if (!read_value()) {
+            return false;
+        }
+        while (!stack.empty()) {
+            skip_whitespace();
+            if (at == end) {
+                return fail("unexpected end of input");
+            }
+            bool object = stack.back() & OBJECT;
+            bool first = stack.back() & FIRST;
+            stack.back() &= ~FIRST;
+
+            if (*at == (object ? '}' : ']')) {
+                ++at;
+                stack.pop_back();
+                object ? sink.end_object() : sink.end_array();
+                continue;
+            }
+            if (!first) {
+                if (*at != ',') {
+                    return fail(object ? "expected ',' or '}'" : "expected ',' or ']'");
+                }
+                ++at;
+                skip_whitespace();
+            }
+            if (object) {
+                std::string_view name;
+                if (at == end || *at != '"') {
+                    return fail("expected a member name");
+                }
+                if (!read_string(name)) {
+                    return false;
+                }
+                sink.key(name);
+                skip_whitespace();
+                if (at == end || *at != ':') {
+                    return fail("expected ':'");
+                }
+                ++at;
+                skip_whitespace();
+            }
+            if (!read_value()) {
+                return false;
+            }
+        }
+        skip_whitespace();
+        return at == end || fail("unexpected characters after the document");
+    }
+
+private:
+    void skip_whitespace() {
+        while (at < end && (*at == ' ' || *at == '\n' || *at == '\r' || *at == '\t')) {
+            ++at;
+        }
+    }
+
+    bool fail(const char* message) {
+        error.message = message;
+        error.line = 1 + static_cast<size_t>(std::count(begin, at, '\n'));
+        return false;
+    }
+
+    bool literal(const char* word, size_t length) {
+        if (static_cast<size_t>(end - at) < length || std::memcmp(at, word, length) != 0) {
+            return fail("invalid literal");
+        }
+        at += length;
+        return true;
+    }
+
+    // Scalars go straight to the sink; containers are opened and pushed
+    bool read_value() {
+        if (at == end) {
+            return fail("unexpected end of input");
+        }
+        switch (*at) {
+            case '{':
+                ++at;
+                sink.begin_object();
+                stack.push_back(OBJECT | FIRST);
+                return true;
+            case '[':
+                ++at;
+                sink.begin_array();
+                stack.push_back(FIRST);
+                return true;
+            case '"': {
+                std::string_view text;
+                if (!read_string(text)) {
+                    return false;
+                }
+                sink.string(text);
+                return true;
+            }
+            case 't':
+                if (!literal("true", 4)) return false;
+                sink.boolean(true);
+                return true;
+            case 'f':
+                if (!literal("false", 5)) return false;
+                sink.boolean(false);
+                return true;
+            case 'n':
+                if (!literal("null", 4)) return false;
+                sink.null();
+                return true;
+            default:
+                if (*at == '-' || (*at >= '0' && *at <= '9')) {
+                    return read_number();
+                }
+                return fail("unexpected character");
+        }
+    }
+
+    bool read_number() {
+        const char* start = at;
+        bool integral = true;
+        if (*at == '-') ++at;
+        const char* digits = at;
+        while (at < end && *at >= '0' && *at <= '9') ++at;
+        if (at == digits) return fail("invalid number");
+        if (at < end && *at == '.') {
+            integral = false;
+            ++at;
+            const char* fraction = at;
+            while (at < end && *at >= '0' && *at <= '9') ++at;
+            if (at == fraction) return fail("invalid number");
+        }
+        if (at < end && (*at == 'e' || *at == 'E')) {
+            integral = false;
+            ++at;
+            if (at < end && (*at == '+' || *at == '-')) ++at;
+            const char* exponent = at;
+            while (at < end && *at >= '0' && *at <= '9') ++at;
+            if (at == exponent) return fail("invalid number");
+        }
+
+        if (integral) {
+            int64_t value = 0;
+            auto [last, status] = std::from_chars(start, at, value);
+            if (status == std::errc() && last == at) {
+                sink.integer(value);
+                return true;
+            }
+            // Out of int64 range: keep it as a float like other JSON readers
+        }
+        double value = 0.0;
+        if (!parse_double(std::string_view(start, at - start), value)) {
+            return fail("invalid number");
+        }
+        sink.real(value);
+        return true;
+    }
+
+    bool read_hex4(uint32_t& code) {
+        if (end - at < 4) return fail("truncated \\u escape");
+        code = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = *at++;
+            code <<= 4;
+            if (c >= '0' && c <= '9') code |= c - '0';
+            else if (c >= 'a' && c <= 'f') code |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') code |= c - 'A' + 10;
+            else return fail("invalid \\u escape");
+        }
+        return true;
+    }
+
+    // `at` is on the opening quote. Unescaped strings are returned as a
+    // view into the source; escaped ones are decoded into scratch.
+    bool read_string(std::string_view& out) {
+        const char* start = ++at;
+        const char* stop = find_string_special(at, end);
+        if (stop < end && *stop == '"') {
+            out = std::string_view(start, stop - start);
+            at = stop + 1;
+            return true;
+        }
+
+        scratch.assign(start, stop);
+        at = stop;
+        while (true) {
+            if (at == end) return fail("unterminated string");
+            char c = *at;
+            if (c == '"') {
+                ++at;
+                out = scratch;
+                return true;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) return fail("control character in string");
+
+            // Backslash escape
+            if (++at == end) return fail("unterminated string");
+            switch (*at++) {
+                case '"': scratch += '"'; break;
+                case '\\': scratch += '\\'; break;
+                case '/': scratch += '/'; break;
+                case 'b': scratch += '\b'; break;
+                case 'f': scratch += '\f'; break;
+                case 'n': scratch += '\n'; break;
+                case 'r': scratch += '\r'; break;
+                case 't': scratch += '\t'; break;
+                case 'u': {
+                    uint32_t code;
+                    if (!read_hex4(code)) return false;
+                    if (code >= 0xD800 && code <= 0xDBFF) {
+                        uint32_t low;
+                        if (end - at < 2 || at[0] != '\\' || at[1] != 'u') return fail("unpaired surrogate");
+                        at += 2;
+                        if (!read_hex4(low)) return false;
+                        if (low < 0xDC00 || low > 0xDFFF) return fail("unpaired surrogate");
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                        return fail("unpaired surrogate");
+                    }
+                    append_utf8(scratch, code);
+                    break;
+                }
+                default:
+                    return fail("invalid escape");
+            }
+
+            stop = find_string_special(at, end);
+            scratch.append(at, stop);
+            at = stop;
+        }
+    }
+};
+
+// Read-only streambuf over the source, so yaml-cpp reads it in place
+class ViewBuffer : public std::streambuf {
+public:
+    explicit ViewBuffer(std::string_view source) {
+        char* data = const_cast<char*>(source.data());
+        setg(data, data, data + source.size());
+    }
+};
+
+// Turns yaml-cpp's events into sink events. Anchored nodes are recorded as
+// they stream past so aliases can replay them.
+class YamlHandler : public YAML::EventHandler {
+private:
+    enum class Kind : uint8_t { NIL, SCALAR, BEGIN_SEQUENCE, BEGIN_MAP, END };
+    struct Event {
+        Kind kind;
+        bool plain;
+        std::string text;
+    };
+    struct Capture {
+        YAML::anchor_t anchor;
+        size_t depth;
+        std::vector<Event> events;
+    };
+
+    DataSink& sink;
+    std::vector<bool> expecting_key;  // One entry per open container; false for sequences
+    std::vector<uint8_t> is_map;
+    std::vector<Capture> captures;
+    std::unordered_map<YAML::anchor_t, std::vector<Event>> anchors;
+
+public:
+    std::string failure;
+    size_t failure_line{0};
+
+    explicit YamlHandler(DataSink& target) : sink(target) {}
+
+    void OnDocumentStart(const YAML::Mark&) override {}
+    void OnDocumentEnd() override {}
+
+    void OnNull(const YAML::Mark&, YAML::anchor_t anchor) override {
+        handle({Kind::NIL, true, std::string()}, anchor);
+    }
+    void OnAlias(const YAML::Mark& mark, YAML::anchor_t anchor) override {
+        auto it = anchors.find(anchor);
+        if (it == anchors.end()) {
+            return unsupported(mark, "alias to an unfinished anchor");
+        }
+        std::vector<Event> events = it->second;
+        for (const Event& event : events) {
+            handle(event, YAML::NullAnchor);
+        }
+    }
+    void OnScalar(const YAML::Mark&, const std::string& tag, YAML::anchor_t anchor, const std::string& value) override {
+        // Plain scalars carry the "?" tag; quoted ones are always strings
+        handle({Kind::SCALAR, tag == "?", value}, anchor);
+    }
+    void OnSequenceStart(const YAML::Mark& mark, const std::string&, YAML::anchor_t anchor, YAML::EmitterStyle::value) override {
+        if (at_key()) return unsupported(mark, "collection used as a mapping key");
+        handle({Kind::BEGIN_SEQUENCE, false, std::string()}, anchor);
+    }
+    void OnSequenceEnd() override { handle({Kind::END, false, std::string()}, YAML::NullAnchor); }
+    void OnMapStart(const YAML::Mark& mark, const std::string&, YAML::anchor_t anchor, YAML::EmitterStyle::value) override {
+        if (at_key()) return unsupported(mark, "collection used as a mapping key");
+        handle({Kind::BEGIN_MAP, false, std::string()}, anchor);
+    }
+    void OnMapEnd() override { handle({Kind::END, false, std::string()}, YAML::NullAnchor); }
+
+private:
+    bool at_key() const { return !expecting_key.empty() && expecting_key.back(); }
+
+    void unsupported(const YAML::Mark& mark, const char* what) {
+        if (failure.empty()) {
+            failure = what;
+            failure_line = static_cast<size_t>(mark.line) + 1;
+        }
+    }
+
+    void handle(const Event& event, YAML::anchor_t anchor) {
+        if (!failure.empty()) {
+            return;
+        }
+        if ((event.kind == Kind::BEGIN_MAP || event.kind == Kind::BEGIN_SEQUENCE) && at_key()) {
+            failure = "collection used as a mapping key";
+            return;
+        }
+        for (auto& capture : captures) {
+            capture.events.push_back(event);
+        }
+        if (anchor != YAML::NullAnchor) {
+            if (event.kind == Kind::BEGIN_MAP || event.kind == Kind::BEGIN_SEQUENCE) {
+                captures.push_back({anchor, is_map.size(), {event}});
+            } else {
+                anchors[anchor] = {event};
+            }
+        }
+
+        switch (event.kind) {
+            case Kind::NIL:
+                if (at_key()) {
+                    sink.key(std::string_view());
+                } else {
+                    sink.null();
+                }
+                break;
+            case Kind::SCALAR:
+                if (at_key()) {
+                    sink.key(event.text);
+                } else if (event.plain) {
+                    emit_scalar(sink, event.text, ScalarRules::YAML);
+                } else {
+                    sink.string(event.text);
+                }
+                break;
+            case Kind::BEGIN_SEQUENCE:
+            case Kind::BEGIN_MAP: {
+                bool map = event.kind == Kind::BEGIN_MAP;
+                map ? sink.begin_object() : sink.begin_array();
+                is_map.push_back(map);
+                expecting_key.push_back(map);
+                return;
+            }
+            case Kind::END: {
+                is_map.back() ? sink.end_object() : sink.end_array();
+                is_map.pop_back();
+                expecting_key.pop_back();
+                while (!captures.empty() && captures.back().depth == is_map.size()) {
+                    anchors[captures.back().anchor] = std::move(captures.back().events);
+                    captures.pop_back();
+                }
+                break;
+            }
+        }
+
+        // A finished key or value flips what the enclosing map expects next
+        if (!is_map.empty() && is_map.back()) {
+            expecting_key.back() = !expecting_key.back();
+        }
+    }
+};
+
+void walk_toml(const toml::node& node, DataSink& sink) {
+    if (const toml::table* table = node.as_table()) {
+        sink.begin_object();
+        for (auto&& [name, value] : *table) {
+            sink.key(name.str());
+            walk_toml(value, sink);
+        }
+        sink.end_object();
+    } else if (const toml::array* array = node.as_array()) {
+        sink.begin_array();
+        for (const toml::node& value : *array) {
+            walk_toml(value, sink);
+        }
+        sink.end_array();
+    } else if (const auto* text = node.as_string()) {
+        sink.string(text->get());
+    } else if (const auto* number = node.as_integer()) {
+        sink.integer(number->get());
+    } else if (const auto* number = node.as_floating_point()) {
+        sink.real(number->get());
+    } else if (const auto* flag = node.as_boolean()) {
+        sink.boolean(flag->get());
+    } else {
+        // Dates and times are kept in their TOML spelling
+        std::ostringstream text;
+        node.visit([&text](const auto& value) { text << value; });
+        sink.string(text.str());
+    }
+}
+
+// Elements become objects: attributes and child elements are members,
+// repeated child names collect into arrays, and text-only elements become
+// scalars. An element whose children all share one name that is its own
+// name without a trailing "s" (<buildings><building/>...) is an array.
+void walk_xml(const tinyxml2::XMLElement& element, DataSink& sink) {
+    const tinyxml2::XMLElement* first_child = element.FirstChildElement();
+    const tinyxml2::XMLAttribute* attribute = element.FirstAttribute();
+    const char* text = element.GetText();
+
+    if (!first_child && !attribute) {
+        text ? emit_scalar(sink, text, ScalarRules::XML) : sink.null();
+        return;
+    }
+
+    std::vector<std::pair<std::string_view, int>> names;
+    for (const auto* child = first_child; child; child = child->NextSiblingElement()) {
+        std::string_view name = child->Name();
+        auto it = std::find_if(names.begin(), names.end(), [name](const auto& entry) { return entry.first == name; });
+        if (it == names.end()) {
+            names.push_back({name, 1});
+        } else {
+            ++it->second;
+        }
+    }
+
+    std::string_view own_name = element.Name();
+    if (!attribute && names.size() == 1 &&
+        (names[0].second > 1 || (own_name.size() == names[0].first.size() + 1 && own_name.back() == 's' &&
+                                 own_name.substr(0, names[0].first.size()) == names[0].first))) {
+        sink.begin_array();
+        for (const auto* child = first_child; child; child = child->NextSiblingElement()) {
+            walk_xml(*child, sink);
+        }
+        sink.end_array();
+        return;
+    }
+
+    sink.begin_object();
+    for (; attribute; attribute = attribute->Next()) {
+        sink.key(attribute->Name());
+        emit_scalar(sink, attribute->Value(), ScalarRules::XML);
+    }
+    if (text && first_child == nullptr) {
+        sink.key("text");
+        emit_scalar(sink, text, ScalarRules::XML);
+    }
+    for (const auto& [name, count] : names) {
+        std::string name_text(name);
+        sink.key(name);
+        if (count > 1) {
+            sink.begin_array();
+        }
+        for (const auto* child = element.FirstChildElement(name_text.c_str()); child;
+             child = child->NextSiblingElement(name_text.c_str())) {
+            walk_xml(*child, sink);
+        }
+        if (count > 1) {
+            sink.end_array();
+        }
+    }
+    sink.end_object();
+}
+
+} // namespace
+
+void emit_scalar(DataSink& sink, std::string_view text, ScalarRules rules) {
+    if (text.empty()) {
+        return sink.null();
+    }
+    if (rules == ScalarRules::XML) {
+        if (text == "true") return sink.boolean(true);
+        if (text == "false") return sink.boolean(false);
+    } else {
+        if (text == "~" || text == "null" || text == "Null" || text == "NULL") {
+            return sink.null();
+        }
+        static constexpr std::string_view TRUE_WORDS[] = {"true", "True", "TRUE", "yes", "Yes", "YES", "on", "On", "ON"};
+        static constexpr std::string_view FALSE_WORDS[] = {"false", "False", "FALSE", "no", "No", "NO", "off", "Off", "OFF"};
+        for (std::string_view word : TRUE_WORDS) {
+            if (text == word) return sink.boolean(true);
+        }
+        for (std::string_view word : FALSE_WORDS) {
+            if (text == word) return sink.boolean(false);
+        }
+    }
+
+    const char* start = text.data() + (text[0] == '+' ? 1 : 0);
+    const char* stop = text.data() + text.size();
+    int64_t integer = 0;
+    if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        auto [last, status] = std::from_chars(text.data() + 2, stop, integer, 16);
+        if (status == std::errc() && last == stop) return sink.integer(integer);
+    } else {
+        auto [last, status] = std::from_chars(start, stop, integer);
+        if (status == std::errc() && last == stop) return sink.integer(integer);
+    }
+
+    if (rules == ScalarRules::YAML) {
+        if (text == ".inf" || text == ".Inf" || text == "+.inf") return sink.real(std::numeric_limits<double>::infinity());
+        if (text == "-.inf" || text == "-.Inf") return sink.real(-std::numeric_limits<double>::infinity());
+        if (text == ".nan" || text == ".NaN") return sink.real(std::numeric_limits<double>::quiet_NaN());
+    }
+    // strtod also accepts words like "inf" and hex floats; data files mean
+    // those as text
+    bool numeric = std::all_of(text.begin(), text.end(), [](char c) {
+        return (c >= '0' && c <= '9') || c == '.' || c == '-' || c == '+' || c == 'e' || c == 'E';
+    });
+    double real = 0.0;
+    if (numeric && parse_double(text, real)) {
+        return sink.real(real);
+    }
+    sink.string(text);
+}
+
+bool ingest(std::string_view source, DataFormat format, DataSink& sink, IngestError& error) {
+    switch (format) {
+        case DataFormat::JSON:
+            return JsonReader(source, sink, error).read();
+
+        case DataFormat::YAML: {
+            ViewBuffer buffer(source);
+            std::istream stream(&buffer);
+            YamlHandler handler(sink);
+            try {
+                YAML::Parser parser(stream);
+                if (!parser.HandleNextDocument(handler)) {
+                    error.message = "empty YAML document";
+                    return false;
+                }
+            } catch (const YAML::Exception& e) {
+                error.message = e.msg;
+                error.line = static_cast<size_t>(e.mark.line) + 1;
+                return false;
+            }
+            if (!handler.failure.empty()) {
+                error.message = handler.failure;
+                error.line = handler.failure_line;
+                return false;
+            }
+            return true;
+        }
+
+        case DataFormat::TOML: {
+            try {
+                toml::table table = toml::parse(source);
+                walk_toml(table, sink);
+                return true;
+            } catch (const toml::parse_error& e) {
+                error.message = std::string(e.description());
+                error.line = e.source().begin.line;
+                return false;
+            }
+        }
+
+        case DataFormat::XML: {
+            tinyxml2::XMLDocument document;
+            if (document.Parse(source.data(), source.size()) != tinyxml2::XML_SUCCESS || !document.RootElement()) {
+                error.message = document.ErrorStr() ? document.ErrorStr() : "invalid XML";
+                error.line = document.ErrorLineNum() > 0 ? static_cast<size_t>(document.ErrorLineNum()) : 0;
+                return false;
+            }
+            walk_xml(*document.RootElement(), sink);
+            return true;
+        }
+
+        case DataFormat::UNKNOWN:
+            break;
+    }
+    error.message = "unrecognised data format";
+    return false;
+}
+
+DataFormat sniff_format(std::string_view source) {
+    size_t at = source.compare(0, 3, "\xEF\xBB\xBF") == 0 ? 3 : 0;
+    // Skip blank lines and '#' comments, which YAML and TOML share
+    while (at < source.size()) {
+        char c = source[at];
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            ++at;
+        } else if (c == '#') {
+            at = source.find('\n', at);
+            if (at == std::string_view::npos) return DataFormat::UNKNOWN;
+        } else {
+            break;
+        }
+    }
+    if (at >= source.size()) {
+        return DataFormat::UNKNOWN;
+    }
+
+    size_t line_end = std::min(source.find('\n', at), source.size());
+    std::string_view line = source.substr(at, line_end - at);
+    while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) {
+        line.remove_suffix(1);
+    }
+
+    switch (line[0]) {
+        case '{':
+            return DataFormat::JSON;
+        case '<':
+            return DataFormat::XML;
+        case '[':
+            // "[section]" or "[[array]]" headers are TOML; anything else
+            // opening with a bracket is a JSON array
+            return line.back() == ']' && line.find_first_of("\",{") == std::string_view::npos
+                ? DataFormat::TOML : DataFormat::JSON;
+        case '-':
+            return DataFormat::YAML;
+    }
+    size_t equals = line.find('=');
+    size_t colon = line.find(':');
+    if (equals != std::string_view::npos && (colon == std::string_view::npos || equals < colon)) {
+        return DataFormat::TOML;
+    }
+    if (colon != std::string_view::npos) {
+        return DataFormat::YAML;
+    }
+    return DataFormat::UNKNOWN;
+}
+
+std::unique_ptr<DataCache> compile_cache(std::string_view source, const std::string& cache_path,
+                                         DataFormat format, IngestError& error) {
+    uint64_t hash = DataCacheFormat::hash_bytes(reinterpret_cast<const uint8_t*>(source.data()), source.size());
+    auto cache = std::make_unique<DataCache>();
+    if (cache->open(cache_path, hash)) {
+        return cache;
+    }
+
+    if (format == DataFormat::UNKNOWN) {
+        format = sniff_format(source);
+    }
+    if (format == DataFormat::UNKNOWN) {
+        error = {"unrecognised data format", 0};
+        return nullptr;
+    }
+    DataCacheWriter writer;
+    CacheBuilder builder(writer);
+    if (!ingest(source, format, builder, error)) {
+        return nullptr;
+    }
+    if (builder.get_root_type() != DataCache::Type::DICTIONARY) {
+        error = {"data file root must be a dictionary", 0};
+        return nullptr;
+    }
+    std::vector<uint8_t> image = writer.finish(hash);
+
+    std::error_code ignored;
+    std::filesystem::create_directories(std::filesystem::path(cache_path).parent_path(), ignored);
+    DataCache::write(cache_path, image);
+    return cache->open_image(std::move(image), hash) ? std::move(cache) : nullptr;
+}
+
+} // namespace Data
@@ -0,0 +1,150 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "DataCache.hpp"
+
+namespace Data {
+
+enum class DataFormat {
+    JSON,
+    YAML,
+    TOML,
+    XML,
+    UNKNOWN
+};
+
+// Streaming (SAX-style) receiver for parsed data. Every format reports
+// the same events, so one sink serves JSON, YAML, TOML and XML. Object
+// members arrive as key() followed by exactly one value. Strings passed
+// to a sink are only valid for the duration of the call.
+class DataSink {
+public:
+    virtual ~DataSink() = default;
+
+    virtual void null() = 0;
+    virtual void boolean(bool value) = 0;
+    virtual void integer(int64_t value) = 0;
+    virtual void real(double value) = 0;
+    virtual void string(std::string_view value) = 0;
+
+    virtual void begin_array() = 0;
+    virtual void end_array() = 0;
+    virtual void begin_object() = 0;
+    virtual void key(std::string_view name) = 0;
+    virtual void end_object() = 0;
+};
+
+// Writes events straight into a DataCacheWriter. Only the children of
+// containers that are still open are held; a container's children are
+// flushed as one block when it closes, so no document tree is built.
+class CacheBuilder : public DataSink {
+private:
+    using Node = DataCacheFormat::Node;
+    using Type = DataCacheFormat::Type;
+
+    DataCacheWriter& writer;
+    std::vector<Node> pending;   // Children of open containers, innermost last
+    std::vector<size_t> starts;  // Where each open container's children begin
+    bool has_root{false};
+    Type root_type{Type::NIL};
+
+public:
+    explicit CacheBuilder(DataCacheWriter& target) : writer(target) { writer.reserve(1); }
+
+    bool is_complete() const { return has_root && starts.empty(); }
+    Type get_root_type() const { return root_type; }
+
+    void null() override { push(make(Type::NIL)); }
+    void boolean(bool value) override {
+        Node node = make(Type::BOOL);
+        node.integer = value ? 1 : 0;
+        push(node);
+    }
+    void integer(int64_t value) override {
+        Node node = make(Type::INT);
+        node.integer = value;
+        push(node);
+    }
+    void real(double value) override {
+        Node node = make(Type::FLOAT);
+        node.real = value;
+        push(node);
+    }
+    void string(std::string_view value) override {
+        Node node = make(Type::STRING);
+        node.count = writer.intern(value);
+        push(node);
+    }
+
+    void begin_array() override { starts.push_back(pending.size()); }
+    void end_array() override { close(Type::ARRAY); }
+    void begin_object() override { starts.push_back(pending.size()); }
+    void key(std::string_view name) override { string(name); }
+    void end_object() override { close(Type::DICTIONARY); }
+
+private:
+    static Node make(Type type) {
+        Node node{};
+        node.type = type;
+        return node;
+    }
+
+    void push(const Node& node) {
+        if (starts.empty()) {
+            writer.set_node(0, node);
+            has_root = true;
+            root_type = node.type;
+        } else {
+            pending.push_back(node);
+        }
+    }
+
+    void close(Type type) {
+        size_t start = starts.back();
+        starts.pop_back();
+        size_t children = pending.size() - start;
+        Node node = make(type);
+        node.count = static_cast<uint32_t>(type == Type::DICTIONARY ? children / 2 : children);
+        node.first = children > 0 ? writer.append(pending.data() + start, children) : 0;
+        pending.resize(start);
+        push(node);
+    }
+};
+
+struct IngestError {
+    std::string message;
+    size_t line{0};  // 1-based, 0 if unknown
+};
+
+// Parses `source` and streams it into `sink`. JSON is read by a
+// hand-written single-pass reader; YAML uses yaml-cpp's event parser;
+// TOML and XML are walked straight from their parsers' trees without a
+// Variant in between.
+bool ingest(std::string_view source, DataFormat format, DataSink& sink, IngestError& error);
+
+// Guesses the format from the first meaningful characters, for files
+// whose extension does not say. Returns UNKNOWN rather than guessing.
+DataFormat sniff_format(std::string_view source);
+
+// Compiled form of `source`: the cache at native path `cache_path` if it
+// was built from the same bytes, otherwise a fresh parse (UNKNOWN formats
+// are sniffed) that is also written there. Uses no engine API, so any
+// thread may call it. Null with `error` set if the bytes do not parse to
+// a dictionary; a cache that cannot be written only costs the next load
+// a parse.
+std::unique_ptr<DataCache> compile_cache(std::string_view source, const std::string& cache_path,
+                                         DataFormat format, IngestError& error);
+
+// Which words an untyped scalar may spell. YAML plain scalars follow
+// YAML 1.1 (yes/no/on/off, ~, .inf, .nan); XML text and attributes only
+// know true/false, numbers, and empty text as null.
+enum class ScalarRules { YAML, XML };
+
+// Emits an untyped scalar as null, bool, integer, float or string,
+// whichever it spells under `rules`
+void emit_scalar(DataSink& sink, std::string_view text, ScalarRules rules);
+
+} // namespace Data
@@ -1,21 +1,65 @@
 #include "DataProcessor.hpp"
+#include <godot_cpp/classes/dir_access.hpp>
 #include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
+#include <algorithm>
 #include "yaml-cpp/yaml.h"
 #include "toml++/toml.h"
 #include "tinyxml2.h"
 
 namespace Data {
 
+namespace {
+
+// Letters, digits, '.', '_' and '-'; anything that could name another
+// directory becomes "_"
+String cache_component(const String& component) {
+    String clean;
+    for (int64_t i = 0; i < component.length(); i++) {
+        char32_t c = component[i];
+        bool keep = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                    c == '.' || c == '_' || c == '-';
+        clean += keep ? String::chr(c) : String("_");
+    }
+    return clean.is_empty() || clean == "." || clean == ".." ? String("_") : clean;
+}
+
+// Cache name of a data file: its owner ("base" or "mods/<id>") followed
+// by the source path, scheme included, one sanitised component per
+// directory. Files with the same name in different folders or mods get
+// their own caches, and no key can leave the cache directory.
+String cache_key(const String& source_path, const String& mod_id) {
+    String key = mod_id.is_empty() ? String("base") : String("mods").path_join(cache_component(mod_id));
+    PackedStringArray components = source_path.simplify_path().replace("://", "/").split("/", false);
+    for (int64_t i = 0; i < components.size(); i++) {
+        key = key.path_join(cache_component(components[i]));
+    }
+    return key;
+}
+
+} // namespace
+
 void DataProcessor::_bind_methods() {
     ClassDB::bind_method(D_METHOD("load_base_data", "base_path"), &DataProcessor::load_base_data);
     ClassDB::bind_method(D_METHOD("load_mod", "mod_path"), &DataProcessor::load_mod);
     ClassDB::bind_method(D_METHOD("unload_mod", "mod_id"), &DataProcessor::unload_mod);
+    ClassDB::bind_method(D_METHOD("set_mod_enabled", "mod_id", "enabled"), &DataProcessor::set_mod_enabled);
+    ClassDB::bind_method(D_METHOD("is_mod_enabled", "mod_id"), &DataProcessor::is_mod_enabled);
+    ClassDB::bind_method(D_METHOD("get_mod_load_order"), &DataProcessor::get_mod_load_order);
+    ClassDB::bind_method(D_METHOD("get_record_source", "table", "id"), &DataProcessor::get_record_source);
+    ClassDB::bind_method(D_METHOD("set_hot_reload", "enabled"), &DataProcessor::set_hot_reload);
+    ClassDB::bind_method(D_METHOD("is_hot_reload_enabled"), &DataProcessor::is_hot_reload_enabled);
+    ClassDB::bind_method(D_METHOD("apply_reloads"), &DataProcessor::apply_reloads);
     ClassDB::bind_method(D_METHOD("get_data", "category", "key"), &DataProcessor::get_data);
     ClassDB::bind_method(D_METHOD("get_all_events"), &DataProcessor::get_all_events);
     ClassDB::bind_method(D_METHOD("get_all_candidates"), &DataProcessor::get_all_candidates);
+    ClassDB::bind_method(D_METHOD("get_event", "event_id"), &DataProcessor::get_event);
+    ClassDB::bind_method(D_METHOD("get_candidate", "name"), &DataProcessor::get_candidate);
     ClassDB::bind_method(D_METHOD("scan_for_mods"), &DataProcessor::scan_for_mods);
     ClassDB::bind_method(D_METHOD("get_available_mods"), &DataProcessor::get_available_mods);
+
+    ADD_SIGNAL(MethodInfo("records_changed", PropertyInfo(Variant::ARRAY, "records")));
 }
 
 DataProcessor::DataProcessor() {}
@@ -34,25 +78,148 @@ Error DataProcessor::load_base_data(const String& base_path) {
     
     for (const String& file : core_files) {
         String full_path = base_path.path_join(file);
-        Ref<FileAccess> f = FileAccess::open(full_path, FileAccess::READ);
-        
-        if (f.is_valid()) {
-            String content = f->get_as_text();
-            Variant parsed = JSON::parse_string(content);
-            
-            if (parsed.get_type() == Variant::DICTIONARY) {
-                String category = file.get_basename().to_lower();
-                loaded_data[category] = parsed;
-            } else {
-                UtilityFunctions::print("Failed to parse ", full_path);
-                err = FAILED;
+        if (!FileAccess::file_exists(full_path)) {
+            continue;
+        }
+
+        String category = file.get_basename().to_lower();
+        std::unique_ptr<DataCache> cache = load_cached(full_path, cache_file(full_path, ""), DataFormat::JSON);
+        if (cache) {
+            base_data.push_back({category, std::move(cache), full_path});
+            if (watcher) {
+                watcher->watch(full_path, "");
             }
+        } else {
+            UtilityFunctions::print("Failed to parse ", full_path);
+            err = FAILED;
         }
     }
-    
+
+    std::vector<const DataCache*> files;
+    for (const auto& entry : base_data) {
+        files.push_back(entry.cache.get());
+    }
+    resolver.set_base(std::move(files));
+    resolve_mods();
     return err;
 }
 
+void DataProcessor::resolve_mods() {
+    std::vector<ModResolver::RecordKey> changed;
+    resolver.resolve(registry, changed);
+    for (const auto& mod_id : resolver.unresolved_mods()) {
+        UtilityFunctions::print("Mod ", String::utf8(mod_id.c_str()), " has missing or circular dependencies");
+    }
+    emit_records_changed(changed);
+}
+
+Ref<EventData> DataProcessor::get_event(const String& event_id) const {
+    RecordId record = registry.find_event(event_id.utf8().get_data());
+    if (record == INVALID_RECORD) {
+        return Ref<EventData>();
+    }
+    Ref<EventData> view;
+    view.instantiate();
+    view->bind(this, &registry, record);
+    return view;
+}
+
+Ref<CandidateData> DataProcessor::get_candidate(const String& name) const {
+    RecordId record = registry.find_candidate(name.utf8().get_data());
+    if (record == INVALID_RECORD) {
+        return Ref<CandidateData>();
+    }
+    Ref<CandidateData> view;
+    view.instantiate();
+    view->bind(this, &registry, record);
+    return view;
+}
+
+// Returns the compiled form of a data file, parsing the source only when
+// no cache matches its current bytes. The source is read through
+// FileAccess so res:// files inside an exported pack work too.
+std::unique_ptr<DataCache> DataProcessor::load_cached(const String& source_path, const std::string& cache_path, DataFormat format) {
+    PackedByteArray source = FileAccess::get_file_as_bytes(source_path);
+    if (source.is_empty()) {
+        return nullptr;
+    }
+    std::string_view bytes(reinterpret_cast<const char*>(source.ptr()), source.size());
+    IngestError error;
+    std::unique_ptr<DataCache> cache = compile_cache(bytes, cache_path, format, error);
+    if (!cache) {
+        UtilityFunctions::print("Failed to parse ", source_path, ":", static_cast<int64_t>(error.line), ": ",
+                                String::utf8(error.message.c_str()));
+    }
+    return cache;
+}
+
+std::string DataProcessor::cache_file(const String& source_path, const String& mod_id) const {
+    String directory = ProjectSettings::get_singleton()->globalize_path(cache_dir);
+    return directory.path_join(cache_key(source_path, mod_id) + ".bin").utf8().get_data();
+}
+
+const DataCache* DataProcessor::find_base_category(const String& category) const {
+    for (const auto& entry : base_data) {
+        if (entry.category == category) {
+            return entry.cache.get();
+        }
+    }
+    return nullptr;
+}
+
+Variant DataProcessor::to_variant(const DataCache::Value& value) {
+    switch (value.type()) {
+        case DataCache::Type::BOOL:
+            return value.as_bool();
+        case DataCache::Type::INT:
+            return value.as_int();
+        case DataCache::Type::FLOAT:
+            return value.as_float();
+        case DataCache::Type::STRING: {
+            std::string_view text = value.as_string();
+            return String::utf8(text.data(), static_cast<int>(text.size()));
+        }
+        case DataCache::Type::ARRAY: {
+            Array array;
+            for (size_t i = 0; i < value.size(); i++) {
+                array.push_back(to_variant(value.at(i)));
+            }
+            return array;
+        }
+        case DataCache::Type::DICTIONARY: {
+            Dictionary dictionary;
+            for (size_t i = 0; i < value.size(); i++) {
+                dictionary[to_variant(value.key_at(i))] = to_variant(value.value_at(i));
+            }
+            return dictionary;
+        }
+        default:
+            return Variant();
+    }
+}
+
+Variant DataProcessor::get_data(const String& category, const String& key) const {
+    if (const DataCache* cache = find_base_category(category)) {
+        DataCache::Value value = cache->root().find(key.utf8().get_data());
+        if (value.is_valid()) {
+            return to_variant(value);
+        }
+    }
+    if (loaded_data.has(category)) {
+        Dictionary data = loaded_data[category];
+        return data.get(key, Variant());
+    }
+    return Variant();
+}
+
+Array DataProcessor::get_all_events() const {
+    return get_data("eventdefinitions", "events");
+}
+
+Array DataProcessor::get_all_candidates() const {
+    return get_data("candidatedefinitions", "candidates");
+}
+
 Error DataProcessor::load_mod(const String& mod_path) {
     // Load mod manifest
     String manifest_path = mod_path.path_join("manifest.json");
@@ -72,27 +239,193 @@ Error DataProcessor::load_mod(const String& mod_path) {
     
     // Load mod data files
     Array data_files = manifest.get("data_files", Array());
-    Dictionary mod_content;
+    std::vector<CachedCategory> mod_content;
     
     for (int i = 0; i < data_files.size(); i++) {
         String file_path = mod_path.path_join(data_files[i]);
-        Ref<FileAccess> data_file = FileAccess::open(file_path, FileAccess::READ);
-        
-        if (data_file.is_valid()) {
-            String file_content = data_file->get_as_text();
-            Variant parsed = JSON::parse_string(file_content);
-            
-            if (parsed.get_type() == Variant::DICTIONARY) {
-                String category = file_path.get_basename().to_lower();
-                mod_content[category] = parsed;
-            }
+        std::unique_ptr<DataCache> cache = compile_file(file_path, mod_id);
+        if (cache) {
+            mod_content.push_back({file_path.get_file().get_basename().to_lower(), std::move(cache), file_path});
         }
     }
     
-    mod_data[mod_id] = mod_content;
+    add_mod(mod_id, manifest.get("dependencies", PackedStringArray()), std::move(mod_content));
+    return OK;
+}
+
+std::unique_ptr<DataCache> DataProcessor::compile_file(const String& file_path, const String& mod_id) {
+    if (!FileAccess::file_exists(file_path)) {
+        return nullptr;
+    }
+    // An empty mod id is base data
+    return load_cached(file_path, cache_file(file_path, mod_id), detect_format(file_path));
+}
+
+void DataProcessor::add_mod(const String& mod_id, const PackedStringArray& dependencies,
+                            std::vector<CachedCategory> categories, bool resolve) {
+    std::string id = mod_id.utf8().get_data();
+    mod_data[id] = std::move(categories);
+
+    std::vector<std::string> needs;
+    for (const String& dependency : dependencies) {
+        needs.push_back(dependency.utf8().get_data());
+    }
+    std::vector<const DataCache*> files;
+    for (const auto& entry : mod_data[id]) {
+        files.push_back(entry.cache.get());
+    }
+    resolver.add_mod(id, std::move(needs), std::move(files));
+    if (watcher) {
+        for (const auto& entry : mod_data[id]) {
+            watcher->watch(entry.source, mod_id);
+        }
+    }
+
+    if (resolve) {
+        resolve_mods();
+    }
+}
+
+void DataProcessor::unload_mod(const String& mod_id) {
+    std::string id = mod_id.utf8().get_data();
+    if (mod_data.erase(id) > 0) {
+        if (watcher) {
+            watcher->unwatch_mod(mod_id);
+        }
+        resolver.remove_mod(id);
+        resolve_mods();
+    }
+}
+
+Error DataProcessor::set_mod_enabled(const String& mod_id, bool enabled) {
+    std::vector<ModResolver::RecordKey> changed;
+    std::vector<std::string> blocking = resolver.set_enabled(mod_id.utf8().get_data(), enabled, registry, changed);
+    if (!blocking.empty()) {
+        for (const auto& other : blocking) {
+            UtilityFunctions::print("Cannot ", enabled ? "enable " : "disable ", mod_id, ": blocked by ",
+                                    String::utf8(other.c_str()));
+        }
+        return ERR_CANT_RESOLVE;
+    }
+
+    emit_records_changed(changed);
     return OK;
 }
 
+void DataProcessor::emit_records_changed(const std::vector<ModResolver::RecordKey>& changed) {
+    if (changed.empty()) {
+        return;
+    }
+    Array records;
+    for (const auto& key : changed) {
+        Dictionary record;
+        record["table"] = RECORD_TABLES[static_cast<size_t>(key.kind)];
+        record["id"] = String::utf8(key.id.c_str());
+        records.push_back(record);
+    }
+    emit_signal("records_changed", records);
+}
+
+void DataProcessor::set_hot_reload(bool enabled) {
+    if (!enabled) {
+        watcher.reset();
+        return;
+    }
+    if (watcher) {
+        return;
+    }
+    watcher = std::make_unique<DataWatcher>(this);
+    for (const auto& entry : base_data) {
+        watcher->watch(entry.source, "");
+    }
+    for (const auto& [mod_id, categories] : mod_data) {
+        for (const auto& entry : categories) {
+            watcher->watch(entry.source, String::utf8(mod_id.c_str()));
+        }
+    }
+    watcher->start();
+}
+
+void DataProcessor::_process(double delta) {
+    apply_reloads();
+}
+
+// Applies every reload that finished since the last call in one go, so
+// systems see either none or all of a batch of edits
+void DataProcessor::apply_reloads() {
+    if (!watcher) {
+        return;
+    }
+    std::vector<DataWatcher::Reload> ready = watcher->take_reloads();
+    if (ready.empty()) {
+        return;
+    }
+
+    // Replaced caches stay mapped until the resolver points at the new ones
+    std::vector<std::unique_ptr<DataCache>> retired;
+    std::vector<ModResolver::RecordKey> changed;
+    for (auto& reload : ready) {
+        if (reload.failed) {
+            UtilityFunctions::print("Hot reload: could not parse ", reload.path, ":",
+                                    static_cast<int64_t>(reload.error.line), ": ",
+                                    String::utf8(reload.error.message.c_str()));
+            continue;
+        }
+        std::string mod_id = reload.mod_id.utf8().get_data();
+        std::vector<CachedCategory>* categories = &base_data;
+        if (!mod_id.empty()) {
+            auto mod = mod_data.find(mod_id);
+            if (mod == mod_data.end()) {
+                continue;
+            }
+            categories = &mod->second;
+        }
+
+        auto entry = std::find_if(categories->begin(), categories->end(),
+                                  [&reload](const CachedCategory& category) { return category.source == reload.path; });
+        if (entry != categories->end()) {
+            retired.push_back(std::move(entry->cache));
+            if (reload.cache) {
+                entry->cache = std::move(reload.cache);
+            } else {
+                categories->erase(entry);
+            }
+        } else if (reload.cache) {
+            categories->push_back({reload.path.get_file().get_basename().to_lower(), std::move(reload.cache), reload.path});
+        }
+
+        std::vector<const DataCache*> files;
+        for (const auto& category : *categories) {
+            files.push_back(category.cache.get());
+        }
+        resolver.reload_layer(mod_id, std::move(files), reload.edited, registry, changed);
+        UtilityFunctions::print("Reloaded ", reload.path, " (", static_cast<int64_t>(reload.edited.size()), " records edited)");
+    }
+    emit_records_changed(changed);
+}
+
+bool DataProcessor::is_mod_enabled(const String& mod_id) const {
+    return resolver.is_active(mod_id.utf8().get_data());
+}
+
+PackedStringArray DataProcessor::get_mod_load_order() const {
+    PackedStringArray order;
+    for (const auto& mod_id : resolver.load_order()) {
+        order.push_back(String::utf8(mod_id.c_str()));
+    }
+    return order;
+}
+
+Variant DataProcessor::get_record_source(const String& table, const String& id) const {
+    for (size_t k = 0; k < static_cast<size_t>(RecordKind::COUNT); ++k) {
+        if (table == RECORD_TABLES[k]) {
+            const std::string* source = resolver.provenance(static_cast<RecordKind>(k), id.utf8().get_data());
+            return source ? Variant(String::utf8(source->c_str())) : Variant();
+        }
+    }
+    return Variant();
+}
+
 Dictionary DataProcessor::process_genetic_data(const Array& raw_data) {
     Dictionary result;
     Dictionary species_markers;
@@ -136,48 +469,32 @@ DataFormat DataProcessor::detect_format(const String& file_path) const {
     if (extension == "yaml" || extension == "yml") return DataFormat::YAML;
     if (extension == "toml") return DataFormat::TOML;
     if (extension == "xml") return DataFormat::XML;
-    
-    // Default to YAML if unknown
-    return DataFormat::YAML;
+
+    // Callers sniff the content rather than guess from here
+    return DataFormat::UNKNOWN;
 }
 
+// Same streaming front-end as the caches; the Variant is built from the
+// compiled image so both paths agree on types
 Variant DataProcessor::parse_data(const String& content, DataFormat format) {
-    switch (format) {
-        case DataFormat::JSON: {
-            return JSON::parse_string(content);
-        }
-        
-        case DataFormat::YAML: {
-            try {
-                YAML::Node yaml = YAML::Load(content.utf8().get_data());
-                return convert_yaml_to_variant(yaml);
-            } catch (const YAML::Exception& e) {
-                UtilityFunctions::print("YAML parsing error: ", e.what());
-                return Variant();
-            }
-        }
-        
-        case DataFormat::TOML: {
-            try {
-                toml::table tbl = toml::parse(content.utf8().get_data());
-                return convert_toml_to_variant(tbl);
-            } catch (const toml::parse_error& e) {
-                UtilityFunctions::print("TOML parsing error: ", e.what());
-                return Variant();
-            }
-        }
-        
-        case DataFormat::XML: {
-            tinyxml2::XMLDocument doc;
-            if (doc.Parse(content.utf8().get_data()) == tinyxml2::XML_SUCCESS) {
-                return convert_xml_to_variant(doc.RootElement());
-            }
-            UtilityFunctions::print("XML parsing error");
-            return Variant();
-        }
+    CharString text = content.utf8();
+    std::string_view bytes(text.get_data(), text.length());
+    if (format == DataFormat::UNKNOWN) {
+        format = sniff_format(bytes);
     }
-    
-    return Variant();
+
+    DataCacheWriter writer;
+    CacheBuilder builder(writer);
+    IngestError error;
+    if (!ingest(bytes, format, builder, error)) {
+        UtilityFunctions::print("Parse error at line ", static_cast<int64_t>(error.line), ": ", String::utf8(error.message.c_str()));
+        return Variant();
+    }
+    DataCache cache;
+    if (!cache.open_image(writer.finish(0), 0)) {
+        return Variant();
+    }
+    return to_variant(cache.root());
 }
 
 String DataProcessor::serialize_data(const Variant& data, DataFormat format) {
@@ -207,59 +524,15 @@ String DataProcessor::serialize_data(const Variant& data, DataFormat format) {
             doc.Print(&printer);
             return String(printer.CStr());
         }
-    }
-    
-    return String();
-}
 
-// Helper conversion functions
-Variant DataProcessor::convert_yaml_to_variant(const YAML::Node& node) {
-    switch (node.Type()) {
-        case YAML::NodeType::Null:
-            return Variant();
-            
-        case YAML::NodeType::Scalar: {
-            // Try to parse as different types
-            try {
-                return node.as<int>();
-            } catch (...) {
-                try {
-                    return node.as<float>();
-                } catch (...) {
-                    try {
-                        return node.as<bool>();
-                    } catch (...) {
-                        return String(node.as<std::string>().c_str());
-                    }
-                }
-            }
-        }
-            
-        case YAML::NodeType::Sequence: {
-            Array arr;
-            for (const auto& item : node) {
-                arr.push_back(convert_yaml_to_variant(item));
-            }
-            return arr;
+        case DataFormat::UNKNOWN: {
+            return String();
         }
-            
-        case YAML::NodeType::Map: {
-            Dictionary dict;
-            for (const auto& it : node) {
-                String key = convert_yaml_to_variant(it.first);
-                Variant value = convert_yaml_to_variant(it.second);
-                dict[key] = value;
-            }
-            return dict;
-        }
-            
-        default:
-            return Variant();
     }
+    
+    return String();
 }
 
-// Similar conversion functions for TOML and XML...
-
 Error DataProcessor::load_mod_data(const String& path, DataFormat format) {
     Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
     if (!f.is_valid()) {
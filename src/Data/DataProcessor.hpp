@@ -1,37 +1,91 @@
 #pragma once
 #include <godot_cpp/classes/node.hpp>
 #include "DataTypes.hpp"
+#include "DataCache.hpp"
+#include "DataIngest.hpp"
+#include "ModResolver.hpp"
+#include "DataWatcher.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace Data {
 
-enum class DataFormat {
-    JSON,
-    YAML,
-    TOML,
-    XML
-};
-
 class DataProcessor : public godot::Node {
     GDCLASS(DataProcessor, Node)
 
+public:
+    struct CachedCategory {
+        String category;
+        std::unique_ptr<DataCache> cache;
+        String source;  // File the cache was compiled from
+    };
+
 private:
+    // Parsed data is compiled into binary caches under cache_dir, keyed by
+    // a hash of the source bytes, and read in place; Variants are only
+    // built for the subtrees callers ask for
+    String cache_dir = "user://data_cache";
+    std::vector<CachedCategory> base_data;
+    std::unordered_map<std::string, std::vector<CachedCategory>> mod_data;
     Dictionary loaded_data;
-    Dictionary mod_data;
+
+    // Typed records: base data overridden by enabled mods in dependency
+    // order, with the winning layer of every record tracked by the resolver
+    GameDataRegistry registry;
+    ModResolver resolver;
     Vector<String> mod_paths;
     
     // Helper methods for different formats
     Variant parse_data(const String& content, DataFormat format);
     String serialize_data(const Variant& data, DataFormat format);
 
+    std::unique_ptr<DataCache> load_cached(const String& source_path, const std::string& cache_path, DataFormat format);
+    const DataCache* find_base_category(const String& category) const;
+    static Variant to_variant(const DataCache::Value& value);
+    void emit_records_changed(const std::vector<ModResolver::RecordKey>& changed);
+
+    // Declared last so the worker stops before the caches it reads go away
+    std::unique_ptr<DataWatcher> watcher;
+
 public:
     DataProcessor();
     
     // Core data loading
     Error load_base_data(const String& base_path);
     Error load_mod(const String& mod_path);
+    // Pieces of load_mod for the background pipeline: compile_file is safe
+    // to call from worker threads, add_mod runs on the main thread. Pass
+    // resolve = false when adding a batch and call resolve_mods() once;
+    // add_mod frees a replaced mod's caches at once, so until then mod
+    // toggles and reloads resolve everything and record sources read null.
+    // resolve_mods() emits records_changed for every record it changed.
+    std::unique_ptr<DataCache> compile_file(const String& file_path, const String& mod_id);
+    void add_mod(const String& mod_id, const PackedStringArray& dependencies,
+                 std::vector<CachedCategory> categories, bool resolve = true);
     void unload_mod(const String& mod_id);
+    void resolve_mods();
+
+    // Re-resolves only the records the mod defines; fails with
+    // ERR_CANT_RESOLVE if dependencies are off or dependents are still on
+    Error set_mod_enabled(const String& mod_id, bool enabled);
+    bool is_mod_enabled(const String& mod_id) const;
+    PackedStringArray get_mod_load_order() const;
+
+    // Hot reload: edited data files are recompiled in the background and
+    // swapped in by apply_reloads(), which _process calls once per frame
+    void set_hot_reload(bool enabled);
+    bool is_hot_reload_enabled() const { return watcher != nullptr; }
+    void apply_reloads();
+    void _process(double delta) override;
+    // Mod supplying a record, "" for base data, null if undefined
+    Variant get_record_source(const String& table, const String& id) const;
     
     // Data access methods
+    const GameDataRegistry& get_registry() const { return registry; }
+    Ref<EventData> get_event(const String& event_id) const;
+    Ref<CandidateData> get_candidate(const String& name) const;
     Variant get_data(const String& category, const String& key) const;
     Array get_all_events() const;
     Array get_all_candidates() const;
@@ -50,8 +104,13 @@ public:
     Error load_mod_data(const String& path, DataFormat format = DataFormat::YAML);
     Error save_mod_data(const String& path, const Dictionary& data, DataFormat format = DataFormat::YAML);
     
-    // Format detection
+    // Format detection by extension; UNKNOWN means the content is sniffed
     DataFormat detect_format(const String& file_path) const;
+    // Native path of a data file's cache; "" mod id for base data
+    std::string cache_file(const String& source_path, const String& mod_id) const;
+
+    void set_cache_dir(const String& path) { cache_dir = path; }
+    String get_cache_dir() const { return cache_dir; }
 };
 
 } 
\ No newline at end of file
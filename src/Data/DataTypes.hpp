@@ -2,61 +2,135 @@
 #include <godot_cpp/classes/resource.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/core/object.hpp>
+#include "GameDataRegistry.hpp"
 
 namespace Data {
 
+// Script-facing views over registry records. Nothing is copied when a
+// view is bound; getters convert to Godot types only when called.
+inline String registry_text(const GameDataRegistry* registry, TextId id) {
+    const std::string& text = registry->text(id);
+    return String::utf8(text.data(), static_cast<int>(text.size()));
+}
+
+// Views hold their owner (the DataProcessor whose registry they read) by
+// instance id, a weak reference: once the owner is freed, or its registry
+// was cleared and renumbered, the view reads as unbound instead of
+// touching the registry
+inline bool registry_alive(uint64_t owner_id, const GameDataRegistry* registry, uint32_t generation) {
+    return registry && ObjectDB::get_instance(owner_id) != nullptr && registry->generation() == generation;
+}
+
+inline Dictionary registry_stats(const GameDataRegistry* registry, Span<StatValue> span) {
+    Dictionary stats;
+    for (const auto& entry : registry->view(span)) {
+        stats[registry_text(registry, entry.stat)] = entry.value;
+    }
+    return stats;
+}
+
 class EventData : public godot::Resource {
     GDCLASS(EventData, Resource)
 private:
-    String id;
-    String title_key;
-    String description;
-    Dictionary conditions;
-    Array choices;
+    const GameDataRegistry* registry = nullptr;
+    RecordId record = INVALID_RECORD;
+    uint64_t owner_id = 0;
+    uint32_t generation = 0;
+
+    const EventRecord& data() const { return registry->event(record); }
 
 protected:
     static void _bind_methods();
 
 public:
     EventData();
-    
-    void set_id(const String& p_id) { id = p_id; }
-    String get_id() const { return id; }
-    
-    void set_title_key(const String& p_key) { title_key = p_key; }
-    String get_title_key() const { return title_key; }
-    
-    void set_description(const String& p_desc) { description = p_desc; }
-    String get_description() const { return description; }
-    
-    void set_conditions(const Dictionary& p_conditions) { conditions = p_conditions; }
-    Dictionary get_conditions() const { return conditions; }
-    
-    void set_choices(const Array& p_choices) { choices = p_choices; }
-    Array get_choices() const { return choices; }
+
+    void bind(const Object* owner, const GameDataRegistry* p_registry, RecordId p_record) {
+        owner_id = owner->get_instance_id();
+        registry = p_registry;
+        generation = p_registry->generation();
+        record = p_record;
+    }
+    bool is_bound() const {
+        return registry_alive(owner_id, registry, generation) && registry->is_live(RecordKind::EVENT, record);
+    }
+    RecordId get_record() const { return record; }
+
+    String get_id() const { return is_bound() ? registry_text(registry, data().id) : String(); }
+    String get_title_key() const { return is_bound() ? registry_text(registry, data().title_key) : String(); }
+    String get_description() const { return is_bound() ? registry_text(registry, data().description) : String(); }
+
+    Dictionary get_conditions() const {
+        Dictionary conditions;
+        if (is_bound()) {
+            for (const auto& entry : registry->view(data().conditions)) {
+                String stat = registry_text(registry, entry.stat);
+                if (entry.is_number()) {
+                    conditions[stat] = entry.number;
+                } else {
+                    conditions[stat] = registry_text(registry, entry.expression);
+                }
+            }
+        }
+        return conditions;
+    }
+
+    Array get_choices() const {
+        Array choices;
+        if (!is_bound()) {
+            return choices;
+        }
+        for (const auto& choice : registry->view(data().choices)) {
+            Array next_events;
+            for (RecordId next : registry->view(choice.next_events)) {
+                if (next != INVALID_RECORD) {
+                    next_events.push_back(registry_text(registry, registry->event(next).id));
+                }
+            }
+            Dictionary outcome;
+            outcome["effects"] = registry_stats(registry, choice.effects);
+            outcome["triggerNextEvents"] = next_events;
+
+            Dictionary entry;
+            entry["choiceText"] = registry_text(registry, choice.text);
+            entry["outcome"] = outcome;
+            choices.push_back(entry);
+        }
+        return choices;
+    }
 };
 
 class CandidateData : public godot::Resource {
     GDCLASS(CandidateData, Resource)
 private:
-    String name;
-    String election_type;
-    Dictionary platform;
+    const GameDataRegistry* registry = nullptr;
+    RecordId record = INVALID_RECORD;
+    uint64_t owner_id = 0;
+    uint32_t generation = 0;
+
+    const CandidateRecord& data() const { return registry->candidate(record); }
 
 protected:
     static void _bind_methods();
 
 public:
     CandidateData();
-    
-    void set_name(const String& p_name) { name = p_name; }
-    String get_name() const { return name; }
-    
-    void set_election_type(const String& p_type) { election_type = p_type; }
-    String get_election_type() const { return election_type; }
-    
-    void set_platform(const Dictionary& p_platform) { platform = p_platform; }
-    Dictionary get_platform() const { return platform; }
+
+    void bind(const Object* owner, const GameDataRegistry* p_registry, RecordId p_record) {
+        owner_id = owner->get_instance_id();
+        registry = p_registry;
+        generation = p_registry->generation();
+        record = p_record;
+    }
+    bool is_bound() const {
+        return registry_alive(owner_id, registry, generation) && registry->is_live(RecordKind::CANDIDATE, record);
+    }
+    RecordId get_record() const { return record; }
+
+    String get_name() const { return is_bound() ? registry_text(registry, data().name) : String(); }
+    String get_election_type() const { return is_bound() ? registry_text(registry, data().election_type) : String(); }
+    Dictionary get_platform() const { return is_bound() ? registry_stats(registry, data().platform) : Dictionary(); }
 };
 
-} 
\ No newline at end of file
+}
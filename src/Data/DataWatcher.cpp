@@ -0,0 +1,274 @@
+#include "DataWatcher.hpp"
+#include "DataProcessor.hpp"
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <unordered_set>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace Data {
+
+bool DataWatcher::start() {
+    if (running) {
+        return false;
+    }
+    if (worker.joinable()) {
+        worker.join();
+    }
+#if defined(__linux__)
+    inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify < 0) {
+        UtilityFunctions::print("Hot reload unavailable: inotify_init1 failed");
+        return false;
+    }
+#endif
+    running = true;
+    worker = std::thread(&DataWatcher::run, this);
+    return true;
+}
+
+void DataWatcher::stop() {
+    running = false;
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void DataWatcher::watch(const String& path, const String& mod_id) {
+    WatchedFile file;
+    file.path = path;
+    file.mod_id = mod_id;
+    file.native_path = ProjectSettings::get_singleton()->globalize_path(path).utf8().get_data();
+    file.cache_path = processor->cache_file(path, mod_id);
+    file.format = processor->detect_format(path);
+
+    std::lock_guard<std::mutex> lock(watch_mutex);
+    for (const auto& existing : files) {
+        if (existing.native_path == file.native_path) {
+            return;
+        }
+    }
+    files.push_back(std::move(file));
+    files_changed = true;
+}
+
+void DataWatcher::unwatch_mod(const String& mod_id) {
+    std::lock_guard<std::mutex> lock(watch_mutex);
+    files.erase(std::remove_if(files.begin(), files.end(),
+                               [&mod_id](const WatchedFile& file) { return file.mod_id == mod_id; }),
+                files.end());
+    files_changed = true;
+}
+
+std::vector<DataWatcher::Reload> DataWatcher::take_reloads() {
+    std::lock_guard<std::mutex> lock(results_mutex);
+    std::vector<Reload> ready = std::move(reloads);
+    reloads.clear();
+    return ready;
+}
+
+void DataWatcher::run() {
+    using Clock = std::chrono::steady_clock;
+    std::unordered_set<std::string> dirty;
+    Clock::time_point last_change;
+
+#if defined(__linux__)
+    // Directories are watched rather than files, since editors usually
+    // save by writing a temporary file and renaming it over the original
+    std::unordered_map<int, std::string> directories;
+    std::unordered_set<std::string> watched_directories;
+    alignas(inotify_event) char buffer[4096];
+#endif
+
+    while (running) {
+        std::vector<WatchedFile> work;
+        {
+            std::lock_guard<std::mutex> lock(watch_mutex);
+            if (files_changed) {
+                files_changed = false;
+                for (auto& file : files) {
+                    if (!file.hashed) {
+                        file.hashed = true;
+                        file.modified = modified_time(file.native_path);
+                        work.push_back(file);
+                    }
+#if defined(__linux__)
+                    std::string directory = std::filesystem::path(file.native_path).parent_path().string();
+                    if (watched_directories.insert(directory).second) {
+                        int wd = inotify_add_watch(inotify, directory.c_str(),
+                                                   IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_MOVED_FROM);
+                        if (wd >= 0) {
+                            directories[wd] = directory;
+                        }
+                    }
+#endif
+                }
+            }
+        }
+
+        // New files get a baseline so their first edit can be diffed
+        for (auto& file : work) {
+            IngestError ignored;
+            if (std::unique_ptr<DataCache> cache = compile(file, ignored)) {
+                hash_records(*cache, file.record_hashes);
+            }
+            std::lock_guard<std::mutex> lock(watch_mutex);
+            if (WatchedFile* watched = find_file(file.native_path)) {
+                watched->record_hashes = std::move(file.record_hashes);
+            }
+        }
+
+#if defined(__linux__)
+        pollfd descriptor{inotify, POLLIN, 0};
+        if (poll(&descriptor, 1, dirty.empty() ? POLL_MS : DEBOUNCE_MS) > 0) {
+            ssize_t length;
+            while ((length = read(inotify, buffer, sizeof(buffer))) > 0) {
+                for (char* at = buffer; at < buffer + length;) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(at);
+                    auto directory = directories.find(event->wd);
+                    if (event->len > 0 && directory != directories.end()) {
+                        dirty.insert((std::filesystem::path(directory->second) / event->name).string());
+                        last_change = Clock::now();
+                    }
+                    at += sizeof(inotify_event) + event->len;
+                }
+            }
+        }
+#else
+        std::this_thread::sleep_for(std::chrono::milliseconds(dirty.empty() ? POLL_MS : DEBOUNCE_MS));
+        {
+            std::lock_guard<std::mutex> lock(watch_mutex);
+            for (const auto& file : files) {
+                if (modified_time(file.native_path) != file.modified) {
+                    dirty.insert(file.native_path);
+                    last_change = Clock::now();
+                }
+            }
+        }
+#endif
+
+        if (dirty.empty() || Clock::now() - last_change < std::chrono::milliseconds(DEBOUNCE_MS)) {
+            continue;
+        }
+        work.clear();
+        {
+            std::lock_guard<std::mutex> lock(watch_mutex);
+            for (auto& file : files) {
+                if (dirty.count(file.native_path) > 0) {
+                    file.modified = modified_time(file.native_path);
+                    work.push_back(file);
+                }
+            }
+        }
+        dirty.clear();
+
+        for (auto& file : work) {
+            Reload result;
+            if (!reload(file, result)) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(watch_mutex);
+            WatchedFile* watched = find_file(file.native_path);
+            if (!watched) {
+                continue;  // Unwatched while it was compiling
+            }
+            watched->record_hashes = std::move(file.record_hashes);
+            std::lock_guard<std::mutex> results_lock(results_mutex);
+            reloads.push_back(std::move(result));
+        }
+    }
+
+#if defined(__linux__)
+    close(inotify);
+    inotify = -1;
+#endif
+}
+
+DataWatcher::WatchedFile* DataWatcher::find_file(const std::string& native_path) {
+    for (auto& file : files) {
+        if (file.native_path == native_path) {
+            return &file;
+        }
+    }
+    return nullptr;
+}
+
+// Runs on a copy of the watched entry without watch_mutex held; the caller
+// writes the new record hashes back
+bool DataWatcher::reload(WatchedFile& file, Reload& result) {
+    result.mod_id = file.mod_id;
+    result.path = file.path;
+    std::unique_ptr<DataCache> cache = compile(file, result.error);
+    bool removed = !std::filesystem::exists(file.native_path);
+    if (!cache && !removed) {
+        // Keep the last good version while the file is mid-edit or broken
+        result.failed = true;
+        return true;
+    }
+
+    std::unordered_map<std::string, uint64_t> hashes;
+    if (cache) {
+        hash_records(*cache, hashes);
+    }
+
+    auto edit = [&result](const std::string& key) {
+        result.edited.push_back({static_cast<RecordKind>(key[0]), key.substr(1)});
+    };
+    for (const auto& [key, hash] : hashes) {
+        auto previous = file.record_hashes.find(key);
+        if (previous == file.record_hashes.end() || previous->second != hash) {
+            edit(key);
+        }
+    }
+    for (const auto& [key, hash] : file.record_hashes) {
+        if (hashes.count(key) == 0) {
+            edit(key);
+        }
+    }
+    file.record_hashes = std::move(hashes);
+    result.cache = std::move(cache);
+    return true;
+}
+
+// Reads the file with plain I/O; res:// and user:// were resolved to
+// native paths by watch()
+std::unique_ptr<DataCache> DataWatcher::compile(const WatchedFile& file, IngestError& error) {
+    std::ifstream stream(file.native_path, std::ios::binary);
+    if (!stream) {
+        error = {"could not open the file", 0};
+        return nullptr;
+    }
+    std::string source((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    if (source.empty()) {
+        error = {"file is empty", 0};
+        return nullptr;
+    }
+    return compile_cache(source, file.cache_path, file.format, error);
+}
+
+// Keys match ModResolver: record kind byte followed by the record id
+void DataWatcher::hash_records(const DataCache& cache, std::unordered_map<std::string, uint64_t>& hashes) {
+    GameDataRegistry::for_each_record(cache.root(),
+        [&hashes](RecordKind kind, std::string_view id, const DataCache::Value& record) {
+            std::string key(1, static_cast<char>(kind));
+            key.append(id);
+            hashes[key] = record.hash();
+        });
+}
+
+int64_t DataWatcher::modified_time(const std::string& native_path) {
+    std::error_code error;
+    auto time = std::filesystem::last_write_time(native_path, error);
+    return error ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+} // namespace Data
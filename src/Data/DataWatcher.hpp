@@ -0,0 +1,98 @@
+#pragma once
+#include <godot_cpp/variant/string.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "DataCache.hpp"
+#include "DataIngest.hpp"
+#include "ModResolver.hpp"
+
+namespace Data {
+
+class DataProcessor;
+
+// Hot reload of data files. A worker thread waits for file changes
+// (inotify on Linux, modification times elsewhere), recompiles only the
+// files that changed and diffs their records against the previous version
+// by structural hash. The main thread collects finished reloads with
+// take_reloads() and applies them all at once between ticks, so systems
+// never see a half-applied edit.
+//
+// The worker uses no engine API: watch() resolves every path on the main
+// thread, files are read and compiled with plain file I/O, and problems
+// travel back in the reloads for the main thread to report.
+class DataWatcher {
+public:
+    struct Reload {
+        String mod_id;  // Empty for base data
+        String path;
+        std::unique_ptr<DataCache> cache;  // Null if the file was removed
+        std::vector<ModResolver::RecordKey> edited;  // Added, changed or removed records
+        // Set if the file no longer parses; the last good version stays
+        // and nothing else is filled in
+        IngestError error;
+        bool failed{false};
+    };
+
+private:
+    struct WatchedFile {
+        String path;
+        String mod_id;
+        std::string native_path;
+        std::string cache_path;
+        DataFormat format{DataFormat::UNKNOWN};
+        std::unordered_map<std::string, uint64_t> record_hashes;
+        int64_t modified{0};
+        bool hashed{false};
+    };
+
+    DataProcessor* processor;
+    std::thread worker;
+    std::atomic<bool> running{false};
+#if defined(__linux__)
+    int inotify{-1};  // Opened by start(), closed by the worker
+#endif
+
+    // Only held to copy entries in and out; files are compiled on copies
+    // so watch() and unwatch_mod() never wait on a parse
+    std::mutex watch_mutex;
+    std::vector<WatchedFile> files;  // Guarded by watch_mutex
+    bool files_changed{false};
+
+    std::mutex results_mutex;
+    std::vector<Reload> reloads;
+
+    // Quiet period before a changed file is reparsed, so an editor's
+    // write-then-rename counts as one change
+    static constexpr int DEBOUNCE_MS = 100;
+    static constexpr int POLL_MS = 250;
+
+public:
+    explicit DataWatcher(DataProcessor* data_processor) : processor(data_processor) {}
+    ~DataWatcher() { stop(); }
+
+    bool start();
+    void stop();
+    bool is_running() const { return running; }
+
+    // Main thread only; paths may be res:// or user:// paths
+    void watch(const String& path, const String& mod_id);
+    void unwatch_mod(const String& mod_id);
+
+    std::vector<Reload> take_reloads();
+
+private:
+    void run();
+    bool reload(WatchedFile& file, Reload& result);
+    static std::unique_ptr<DataCache> compile(const WatchedFile& file, IngestError& error);
+    WatchedFile* find_file(const std::string& native_path);  // Caller holds watch_mutex
+    static void hash_records(const DataCache& cache, std::unordered_map<std::string, uint64_t>& hashes);
+    static int64_t modified_time(const std::string& native_path);
+};
+
+} // namespace Data
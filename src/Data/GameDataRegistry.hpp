@@ -0,0 +1,551 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "DataCache.hpp"
+#include "../AI/Core/StringInterner.hpp"
+
+namespace Data {
+
+using TextId = StringInterner::Id;   // Interned string (ids, names, stat keys)
+using RecordId = uint32_t;           // Index into one record table
+constexpr RecordId INVALID_RECORD = static_cast<RecordId>(-1);
+
+enum class RecordKind : uint8_t { EVENT, CANDIDATE, ELECTION, BUILDING, ACTION, COUNT };
+
+// Top-level key of each record table in a data file
+constexpr const char* RECORD_TABLES[] = {"events", "candidates", "elections", "buildings", "actions"};
+
+// Run of elements in one of the registry's shared pools. The tag keeps
+// lists of TextIds and RecordIds (both uint32_t) apart.
+template<typename T, typename Tag = void>
+struct Span {
+    uint32_t first{0};
+    uint32_t count{0};
+};
+
+using TextList = Span<TextId, struct TextListTag>;
+
+template<typename T>
+struct SpanView {
+    const T* items;
+    size_t count;
+    const T* begin() const { return items; }
+    const T* end() const { return items + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](size_t i) const { return items[i]; }
+};
+
+struct StatValue {
+    TextId stat;
+    float value;
+};
+
+// Raw condition expression ("min 60", "> 75"), compiled by the event
+// systems. Conditions given as a bare number keep the number, with
+// expression set to StringInterner::INVALID_ID.
+struct ConditionEntry {
+    TextId stat;
+    TextId expression;
+    double number;
+
+    bool is_number() const { return expression == StringInterner::INVALID_ID; }
+};
+
+struct EventChoiceRecord {
+    TextId text;
+    Span<StatValue> effects;
+    Span<RecordId> next_events;  // Event records; INVALID_RECORD if undefined
+};
+
+struct EventRecord {
+    TextId id;
+    TextId title_key;
+    TextId description;
+    Span<ConditionEntry> conditions;
+    Span<EventChoiceRecord> choices;
+};
+
+struct CandidateRecord {
+    TextId name;
+    TextId election_type;
+    Span<StatValue> platform;
+};
+
+struct ElectionRecord {
+    TextId title;
+    TextId type;
+    float frequency_in_years;
+    TextList applicable_regions;
+};
+
+struct BuildingUpgradeRecord {
+    int32_t level;
+    Span<StatValue> cost;
+    Span<StatValue> effects;
+};
+
+struct BuildingRecord {
+    TextId id;
+    TextId name;
+    TextId description;
+    float space_required;
+    Span<StatValue> cost;
+    Span<StatValue> effects;
+    Span<BuildingUpgradeRecord> upgrades;
+};
+
+struct ActionRecord {
+    TextId id;
+    TextId name;
+    TextId description;
+    Span<StatValue> required_resources;
+    Span<RecordId> required_buildings;  // Building records
+    Span<StatValue> effects;
+    Span<RecordId> unlock_buildings;    // Building records
+};
+
+// Typed game data. Parsed files are converted once into POD records in
+// contiguous tables with interned strings; gameplay code resolves an ID
+// to a RecordId at setup and then indexes arrays. Cross references
+// (next events, required buildings) are stored as RecordIds and resolved
+// after every ingest, so files can arrive in any order.
+//
+// A record whose id is already present replaces the existing one in place
+// and keeps its RecordId. Erased records keep their slot (flagged dead in
+// the all_* tables) so an id that comes back gets the same RecordId.
+// retire_all() starts a full rebuild the same way: ids ingested again
+// keep their RecordIds and generation() is unchanged. clear() renumbers
+// everything and bumps generation(), so holders of a RecordId can tell
+// that it no longer names the same record.
+//
+// Replaced and erased records leave their old spans behind in the pools.
+// resolve_references() compacts the pools once they have doubled since
+// the last compaction, so SpanViews do not survive an ingest batch.
+class GameDataRegistry {
+private:
+    template<typename T>
+    struct Table {
+        std::vector<T> records;
+        std::vector<uint8_t> live;
+        std::vector<RecordId> by_text;  // TextId -> RecordId
+
+        RecordId find(TextId id) const {
+            RecordId record = id < by_text.size() ? by_text[id] : INVALID_RECORD;
+            return record != INVALID_RECORD && live[record] ? record : INVALID_RECORD;
+        }
+        RecordId upsert(TextId id, const T& record) {
+            if (id >= by_text.size()) by_text.resize(static_cast<size_t>(id) + 1, INVALID_RECORD);
+            if (by_text[id] != INVALID_RECORD) {
+                records[by_text[id]] = record;
+                live[by_text[id]] = 1;
+            } else {
+                by_text[id] = static_cast<RecordId>(records.size());
+                records.push_back(record);
+                live.push_back(1);
+            }
+            return by_text[id];
+        }
+        bool erase(TextId id) {
+            RecordId record = find(id);
+            if (record == INVALID_RECORD) return false;
+            live[record] = 0;
+            records[record] = T{};
+            return true;
+        }
+        void retire_all() {
+            std::fill(live.begin(), live.end(), 0);
+            std::fill(records.begin(), records.end(), T{});
+        }
+    };
+
+    StringInterner texts;
+
+    Table<EventRecord> events;
+    Table<CandidateRecord> candidates;
+    Table<ElectionRecord> elections;
+    Table<BuildingRecord> buildings;
+    Table<ActionRecord> actions;
+
+    // Shared pools the spans point into
+    std::vector<StatValue> stat_pool;
+    std::vector<ConditionEntry> condition_pool;
+    std::vector<EventChoiceRecord> choice_pool;
+    std::vector<BuildingUpgradeRecord> upgrade_pool;
+    std::vector<RecordId> reference_pool;
+    std::vector<TextId> text_pool;
+
+    // Name behind every reference_pool slot, so references can be
+    // re-resolved whenever records appear or disappear
+    std::vector<TextId> reference_names;
+
+    static constexpr size_t COMPACT_MIN_ELEMENTS = 4096;
+    size_t compacted_elements{0};
+    uint32_t generation_count{0};
+
+public:
+    // --- Lookup --------------------------------------------------------
+
+    TextId find_text(std::string_view value) const { return texts.find(std::string(value)); }
+    const std::string& text(TextId id) const { return texts.name(id); }
+
+    RecordId find_event(std::string_view id) const { return events.find(find_text(id)); }
+    RecordId find_candidate(std::string_view name) const { return candidates.find(find_text(name)); }
+    RecordId find_election(std::string_view type) const { return elections.find(find_text(type)); }
+    RecordId find_building(std::string_view id) const { return buildings.find(find_text(id)); }
+    RecordId find_action(std::string_view id) const { return actions.find(find_text(id)); }
+
+    const EventRecord& event(RecordId id) const { return events.records[id]; }
+    const CandidateRecord& candidate(RecordId id) const { return candidates.records[id]; }
+    const ElectionRecord& election(RecordId id) const { return elections.records[id]; }
+    const BuildingRecord& building(RecordId id) const { return buildings.records[id]; }
+    const ActionRecord& action(RecordId id) const { return actions.records[id]; }
+
+    const std::vector<EventRecord>& all_events() const { return events.records; }
+    const std::vector<CandidateRecord>& all_candidates() const { return candidates.records; }
+    const std::vector<ElectionRecord>& all_elections() const { return elections.records; }
+    const std::vector<BuildingRecord>& all_buildings() const { return buildings.records; }
+    const std::vector<ActionRecord>& all_actions() const { return actions.records; }
+
+    uint32_t generation() const { return generation_count; }
+
+    // Elements held by the span pools, live or not
+    size_t pool_elements() const {
+        return stat_pool.size() + condition_pool.size() + choice_pool.size() + upgrade_pool.size() +
+               reference_pool.size() + text_pool.size();
+    }
+
+    bool is_live(RecordKind kind, RecordId id) const {
+        switch (kind) {
+            case RecordKind::EVENT: return id < events.live.size() && events.live[id];
+            case RecordKind::CANDIDATE: return id < candidates.live.size() && candidates.live[id];
+            case RecordKind::ELECTION: return id < elections.live.size() && elections.live[id];
+            case RecordKind::BUILDING: return id < buildings.live.size() && buildings.live[id];
+            case RecordKind::ACTION: return id < actions.live.size() && actions.live[id];
+            default: return false;
+        }
+    }
+
+    SpanView<StatValue> view(Span<StatValue> span) const { return {stat_pool.data() + span.first, span.count}; }
+    SpanView<ConditionEntry> view(Span<ConditionEntry> span) const { return {condition_pool.data() + span.first, span.count}; }
+    SpanView<EventChoiceRecord> view(Span<EventChoiceRecord> span) const { return {choice_pool.data() + span.first, span.count}; }
+    SpanView<BuildingUpgradeRecord> view(Span<BuildingUpgradeRecord> span) const { return {upgrade_pool.data() + span.first, span.count}; }
+    SpanView<RecordId> view(Span<RecordId> span) const { return {reference_pool.data() + span.first, span.count}; }
+    SpanView<TextId> view(TextList span) const { return {text_pool.data() + span.first, span.count}; }
+
+    // Value of `stat` in a stat list, or `fallback` if absent
+    float stat(Span<StatValue> span, TextId stat_id, float fallback = 0.0f) const {
+        for (const auto& entry : view(span)) {
+            if (entry.stat == stat_id) return entry.value;
+        }
+        return fallback;
+    }
+
+    // --- Loading -------------------------------------------------------
+
+    // Calls fn(kind, id, record) for every record in a parsed file. Tables
+    // are arrays of records, or dictionaries keyed by record id (the YAML
+    // buildings layout). Events, buildings and actions are keyed by "id",
+    // candidates by "name" and elections by "type".
+    template<typename F>
+    static void for_each_record(const DataCache::Value& root, F&& fn) {
+        for (size_t k = 0; k < static_cast<size_t>(RecordKind::COUNT); ++k) {
+            RecordKind kind = static_cast<RecordKind>(k);
+            DataCache::Value table = root.find(RECORD_TABLES[k]);
+            if (table.type() == DataCache::Type::ARRAY) {
+                for (size_t i = 0; i < table.size(); ++i) {
+                    DataCache::Value record = table.at(i);
+                    fn(kind, record.find(key_field(kind)).as_string(), record);
+                }
+            } else if (table.type() == DataCache::Type::DICTIONARY) {
+                for (size_t i = 0; i < table.size(); ++i) {
+                    fn(kind, table.key_at(i).as_string(), table.value_at(i));
+                }
+            }
+        }
+    }
+
+    static const char* key_field(RecordKind kind) {
+        switch (kind) {
+            case RecordKind::CANDIDATE: return "name";
+            case RecordKind::ELECTION: return "type";
+            default: return "id";
+        }
+    }
+
+    // Converts every record in a parsed file and resolves references
+    void ingest(const DataCache::Value& root) {
+        for_each_record(root, [this](RecordKind kind, std::string_view id, const DataCache::Value& record) {
+            ingest_record(kind, id, record);
+        });
+        resolve_references();
+    }
+
+    // Adds or replaces one record. Call resolve_references() after a batch.
+    void ingest_record(RecordKind kind, std::string_view id, const DataCache::Value& record) {
+        switch (kind) {
+            case RecordKind::EVENT: ingest_event(record, id); break;
+            case RecordKind::CANDIDATE: ingest_candidate(record, id); break;
+            case RecordKind::ELECTION: ingest_election(record, id); break;
+            case RecordKind::BUILDING: ingest_building(record, id); break;
+            case RecordKind::ACTION: ingest_action(record, id); break;
+            default: break;
+        }
+    }
+
+    bool erase(RecordKind kind, std::string_view id) {
+        TextId text = find_text(id);
+        if (text == StringInterner::INVALID_ID) return false;
+        switch (kind) {
+            case RecordKind::EVENT: return events.erase(text);
+            case RecordKind::CANDIDATE: return candidates.erase(text);
+            case RecordKind::ELECTION: return elections.erase(text);
+            case RecordKind::BUILDING: return buildings.erase(text);
+            case RecordKind::ACTION: return actions.erase(text);
+            default: return false;
+        }
+    }
+
+    // Points every reference of a live record at the live record of its
+    // name, or INVALID_RECORD if there is none. Compacts the pools first
+    // when enough of them is garbage.
+    void resolve_references() {
+        if (pool_elements() >= COMPACT_MIN_ELEMENTS && pool_elements() >= 2 * compacted_elements) compact();
+
+        for (RecordId id = 0; id < events.records.size(); ++id) {
+            if (!events.live[id]) continue;
+            for (const auto& choice : view(events.records[id].choices)) resolve(choice.next_events, events);
+        }
+        for (RecordId id = 0; id < actions.records.size(); ++id) {
+            if (!actions.live[id]) continue;
+            resolve(actions.records[id].required_buildings, buildings);
+            resolve(actions.records[id].unlock_buildings, buildings);
+        }
+    }
+
+    // Copies every live span into fresh pools and drops the rest
+    void compact() {
+        Pools fresh;
+        for (auto& event : events.records) {
+            event.conditions = fresh.move(event.conditions, condition_pool, fresh.conditions);
+            std::vector<EventChoiceRecord> choices(view(event.choices).begin(), view(event.choices).end());
+            for (auto& choice : choices) {
+                choice.effects = fresh.move(choice.effects, stat_pool, fresh.stats);
+                choice.next_events = fresh.move_references(choice.next_events, *this);
+            }
+            event.choices = fresh.append(choices, fresh.choices);
+        }
+        for (auto& candidate : candidates.records) {
+            candidate.platform = fresh.move(candidate.platform, stat_pool, fresh.stats);
+        }
+        for (auto& election : elections.records) {
+            election.applicable_regions = fresh.move(election.applicable_regions, text_pool, fresh.texts);
+        }
+        for (auto& building : buildings.records) {
+            building.cost = fresh.move(building.cost, stat_pool, fresh.stats);
+            building.effects = fresh.move(building.effects, stat_pool, fresh.stats);
+            std::vector<BuildingUpgradeRecord> upgrades(view(building.upgrades).begin(), view(building.upgrades).end());
+            for (auto& upgrade : upgrades) {
+                upgrade.cost = fresh.move(upgrade.cost, stat_pool, fresh.stats);
+                upgrade.effects = fresh.move(upgrade.effects, stat_pool, fresh.stats);
+            }
+            building.upgrades = fresh.append(upgrades, fresh.upgrades);
+        }
+        for (auto& action : actions.records) {
+            action.required_resources = fresh.move(action.required_resources, stat_pool, fresh.stats);
+            action.required_buildings = fresh.move_references(action.required_buildings, *this);
+            action.effects = fresh.move(action.effects, stat_pool, fresh.stats);
+            action.unlock_buildings = fresh.move_references(action.unlock_buildings, *this);
+        }
+
+        stat_pool.swap(fresh.stats);
+        condition_pool.swap(fresh.conditions);
+        choice_pool.swap(fresh.choices);
+        upgrade_pool.swap(fresh.upgrades);
+        reference_pool.swap(fresh.references);
+        reference_names.swap(fresh.reference_names);
+        text_pool.swap(fresh.texts);
+        compacted_elements = pool_elements();
+    }
+
+    // Marks every record dead but keeps its slot, for a rebuild that
+    // ingests the full record set again. Everything in the pools is then
+    // garbage, so the next resolve_references() compacts.
+    void retire_all() {
+        events.retire_all();
+        candidates.retire_all();
+        elections.retire_all();
+        buildings.retire_all();
+        actions.retire_all();
+        compacted_elements = 0;
+    }
+
+    void clear() {
+        uint32_t next_generation = generation_count + 1;
+        *this = GameDataRegistry();
+        generation_count = next_generation;
+    }
+
+private:
+    using Value = DataCache::Value;
+    using Type = DataCache::Type;
+
+    struct Pools {
+        std::vector<StatValue> stats;
+        std::vector<ConditionEntry> conditions;
+        std::vector<EventChoiceRecord> choices;
+        std::vector<BuildingUpgradeRecord> upgrades;
+        std::vector<RecordId> references;
+        std::vector<TextId> reference_names;
+        std::vector<TextId> texts;
+
+        template<typename SpanT, typename T>
+        static SpanT move(SpanT span, const std::vector<T>& from, std::vector<T>& to) {
+            SpanT moved{static_cast<uint32_t>(to.size()), span.count};
+            to.insert(to.end(), from.begin() + span.first, from.begin() + span.first + span.count);
+            return moved;
+        }
+
+        template<typename T>
+        static Span<T> append(const std::vector<T>& items, std::vector<T>& to) {
+            Span<T> span{static_cast<uint32_t>(to.size()), static_cast<uint32_t>(items.size())};
+            to.insert(to.end(), items.begin(), items.end());
+            return span;
+        }
+
+        Span<RecordId> move_references(Span<RecordId> span, const GameDataRegistry& registry) {
+            move(span, registry.reference_names, reference_names);
+            return move(span, registry.reference_pool, references);
+        }
+    };
+
+    template<typename T>
+    void resolve(Span<RecordId> span, const Table<T>& targets) {
+        for (uint32_t slot = span.first; slot < span.first + span.count; ++slot) {
+            reference_pool[slot] = targets.find(reference_names[slot]);
+        }
+    }
+
+    TextId intern(std::string_view value) { return texts.intern(std::string(value)); }
+    TextId intern_field(const Value& record, std::string_view key) { return intern(record.find(key).as_string()); }
+
+    Span<StatValue> stats(const Value& map) {
+        Span<StatValue> span{static_cast<uint32_t>(stat_pool.size()), 0};
+        for (size_t i = 0; i < map.size(); ++i) {
+            Value value = map.value_at(i);
+            if (value.type() != Type::INT && value.type() != Type::FLOAT) continue;
+            stat_pool.push_back({intern(map.key_at(i).as_string()), static_cast<float>(value.as_float())});
+            ++span.count;
+        }
+        return span;
+    }
+
+    Span<RecordId> references(const Value& list) {
+        Span<RecordId> span{static_cast<uint32_t>(reference_pool.size()), static_cast<uint32_t>(list.size())};
+        for (size_t i = 0; i < list.size(); ++i) {
+            reference_names.push_back(intern(list.at(i).as_string()));
+            reference_pool.push_back(INVALID_RECORD);
+        }
+        return span;
+    }
+
+    void ingest_event(const Value& record, std::string_view key) {
+        EventRecord event{};
+        event.id = intern(key);
+        event.title_key = intern_field(record, "titleKey");
+        event.description = intern_field(record, "description");
+
+        Value conditions = record.find("conditions");
+        event.conditions = {static_cast<uint32_t>(condition_pool.size()), static_cast<uint32_t>(conditions.size())};
+        for (size_t i = 0; i < conditions.size(); ++i) {
+            Value expression = conditions.value_at(i);
+            TextId stat = intern(conditions.key_at(i).as_string());
+            if (expression.type() == Type::STRING) {
+                condition_pool.push_back({stat, intern(expression.as_string()), 0.0});
+            } else {
+                double number = expression.type() == Type::BOOL ? (expression.as_bool() ? 1.0 : 0.0)
+                                                                : expression.as_float();
+                condition_pool.push_back({stat, StringInterner::INVALID_ID, number});
+            }
+        }
+
+        // Choices are built first so their spans are contiguous
+        Value choices = record.find("choices");
+        std::vector<EventChoiceRecord> built;
+        for (size_t i = 0; i < choices.size(); ++i) {
+            Value choice = choices.at(i);
+            Value outcome = choice.find("outcome");
+            built.push_back({intern_field(choice, "choiceText"), stats(outcome.find("effects")),
+                             references(outcome.find("triggerNextEvents"))});
+        }
+        event.choices = {static_cast<uint32_t>(choice_pool.size()), static_cast<uint32_t>(built.size())};
+        choice_pool.insert(choice_pool.end(), built.begin(), built.end());
+
+        events.upsert(event.id, event);
+    }
+
+    void ingest_candidate(const Value& record, std::string_view key) {
+        CandidateRecord candidate{};
+        candidate.name = intern(key);
+        candidate.election_type = intern_field(record, "election_type");
+        candidate.platform = stats(record.find("platform"));
+        candidates.upsert(candidate.name, candidate);
+    }
+
+    // Elections are keyed by type ("Mayor", "President")
+    void ingest_election(const Value& record, std::string_view key) {
+        ElectionRecord election{};
+        election.title = intern_field(record, "title");
+        election.type = intern(key);
+        election.frequency_in_years = static_cast<float>(record.find("frequency_in_years").as_float());
+        Value regions = record.find("applicable_regions");
+        election.applicable_regions = {static_cast<uint32_t>(text_pool.size()), static_cast<uint32_t>(regions.size())};
+        for (size_t i = 0; i < regions.size(); ++i) text_pool.push_back(intern(regions.at(i).as_string()));
+        elections.upsert(election.type, election);
+    }
+
+    void ingest_building(const Value& record, std::string_view key) {
+        BuildingRecord building{};
+        building.id = intern(key);
+        building.name = intern_field(record, "name");
+        building.description = intern_field(record, "description");
+        building.space_required = static_cast<float>(record.find("space_required").as_float());
+        building.cost = stats(record.find("cost"));
+        building.effects = stats(record.find("effects"));
+
+        Value upgrades = record.find("upgrades");
+        std::vector<BuildingUpgradeRecord> built;
+        for (size_t i = 0; i < upgrades.size(); ++i) {
+            Value upgrade = upgrades.at(i);
+            built.push_back({static_cast<int32_t>(upgrade.find("level").as_int()),
+                             stats(upgrade.find("cost")), stats(upgrade.find("effects"))});
+        }
+        building.upgrades = {static_cast<uint32_t>(upgrade_pool.size()), static_cast<uint32_t>(built.size())};
+        upgrade_pool.insert(upgrade_pool.end(), built.begin(), built.end());
+
+        buildings.upsert(building.id, building);
+    }
+
+    void ingest_action(const Value& record, std::string_view key) {
+        ActionRecord action{};
+        action.id = intern(key);
+        action.name = intern_field(record, "name");
+        action.description = intern_field(record, "description");
+
+        Value requirements = record.find("requirements");
+        action.required_resources = stats(requirements.find("resources"));
+        action.required_buildings = references(requirements.find("buildings"));
+
+        Value effects = record.find("effects");
+        action.effects = stats(effects);
+        action.unlock_buildings = references(effects.find("unlock_buildings"));
+
+        actions.upsert(action.id, action);
+    }
+
+};
+
+} // namespace Data
@@ -0,0 +1,206 @@
+#include "ModLoadPipeline.hpp"
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/json.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+namespace Data {
+
+bool ModLoadPipeline::start(const Vector<String>& search_paths) {
+    if (running) {
+        return false;
+    }
+    if (coordinator.joinable()) {
+        coordinator.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(results_mutex);
+        pending = Update();
+    }
+    cancelled = false;
+    running = true;
+    coordinator = std::thread(&ModLoadPipeline::run, this, search_paths);
+    return true;
+}
+
+void ModLoadPipeline::cancel() {
+    cancelled = true;
+    if (coordinator.joinable()) {
+        coordinator.join();
+    }
+    running = false;
+}
+
+ModLoadPipeline::Update ModLoadPipeline::poll() {
+    std::lock_guard<std::mutex> lock(results_mutex);
+    Update update = std::move(pending);
+    pending = Update();
+    pending.progress = update.progress;
+    pending.finished = update.finished;
+    return update;
+}
+
+void ModLoadPipeline::run(Vector<String> search_paths) {
+    // Stage 1: list mod directories, one task per search path
+    publish_progress(Stage::SCANNING, 0, search_paths.size());
+    std::vector<std::future<std::vector<String>>> scans;
+    for (const String& search_path : search_paths) {
+        scans.push_back(pool.enqueue(&ModLoadPipeline::scan_directory, search_path));
+    }
+    std::vector<String> mod_paths;
+    for (size_t i = 0; i < scans.size(); i++) {
+        std::vector<String> found = scans[i].get();
+        mod_paths.insert(mod_paths.end(), found.begin(), found.end());
+        publish_progress(Stage::SCANNING, static_cast<int>(i + 1), static_cast<int>(scans.size()));
+    }
+
+    if (cancelled) {
+        return finish(0);
+    }
+
+    // Stage 2: parse manifests. A mod id found more than once keeps its
+    // first copy in search path order; the copies would otherwise compile
+    // to the same cache files in stage 3.
+    std::vector<std::future<Dictionary>> manifests;
+    for (const String& mod_path : mod_paths) {
+        manifests.push_back(pool.enqueue(&ModLoadPipeline::read_manifest, mod_path));
+    }
+    std::vector<ModSource> mods;
+    Dictionary seen_ids;
+    for (size_t i = 0; i < manifests.size(); i++) {
+        Dictionary manifest = manifests[i].get();
+        if (!manifest.is_empty() && seen_ids.has(manifest["id"])) {
+            UtilityFunctions::print("Skipping duplicate mod ", manifest["id"], " at ", mod_paths[i],
+                                    "; using ", seen_ids[manifest["id"]]);
+        } else if (!manifest.is_empty()) {
+            seen_ids[manifest["id"]] = mod_paths[i];
+            mods.push_back({mod_paths[i], manifest});
+            std::lock_guard<std::mutex> lock(results_mutex);
+            pending.manifests.push_back(manifest);
+        }
+        publish_progress(Stage::MANIFESTS, static_cast<int>(i + 1), static_cast<int>(manifests.size()));
+    }
+
+    if (cancelled) {
+        return finish(0);
+    }
+
+    // Stage 3: compile every data file of every mod in parallel; a mod is
+    // handed over as soon as its last file finishes
+    struct ModState {
+        LoadedMod loaded;
+        std::vector<std::unique_ptr<DataCache>> files;
+        std::vector<String> categories;
+        std::vector<String> sources;
+        std::atomic<int> remaining{0};
+    };
+    std::vector<std::unique_ptr<ModState>> states;
+    int total_files = 0;
+    for (const ModSource& mod : mods) {
+        auto state = std::make_unique<ModState>();
+        state->loaded.mod_id = mod.manifest.get("id", "");
+        Array data_files = mod.manifest.get("data_files", Array());
+        state->files.resize(data_files.size());
+        for (int i = 0; i < data_files.size(); i++) {
+            state->categories.push_back(String(data_files[i]).get_file().get_basename().to_lower());
+            state->sources.push_back(mod.path.path_join(data_files[i]));
+        }
+        state->remaining = data_files.size();
+        total_files += data_files.size();
+        states.push_back(std::move(state));
+    }
+
+    // Guarded by results_mutex so published counts never go backwards
+    int completed = 0;
+    auto finish_mod = [this](ModState& state) {
+        for (size_t i = 0; i < state.files.size(); i++) {
+            if (state.files[i]) {
+                state.loaded.categories.push_back({state.categories[i], std::move(state.files[i]), state.sources[i]});
+            }
+        }
+        std::lock_guard<std::mutex> lock(results_mutex);
+        pending.mods.push_back(std::move(state.loaded));
+    };
+
+    std::vector<std::future<void>> parses;
+    for (size_t m = 0; m < mods.size(); m++) {
+        ModState& state = *states[m];
+        if (state.files.empty()) {
+            finish_mod(state);
+            continue;
+        }
+        Array data_files = mods[m].manifest.get("data_files", Array());
+        for (int i = 0; i < data_files.size(); i++) {
+            String file_path = mods[m].path.path_join(data_files[i]);
+            parses.push_back(pool.enqueue([this, &state, &completed, &finish_mod, file_path, i, total_files]() {
+                if (!cancelled) {
+                    state.files[i] = processor->compile_file(file_path, state.loaded.mod_id);
+                }
+                {
+                    std::lock_guard<std::mutex> lock(results_mutex);
+                    pending.progress = {Stage::PARSING, ++completed, total_files};
+                }
+                if (--state.remaining == 0 && !cancelled) {
+                    finish_mod(state);
+                }
+            }));
+        }
+    }
+    for (auto& parse : parses) {
+        parse.wait();
+    }
+    finish(total_files);
+}
+
+void ModLoadPipeline::finish(int total_files) {
+    {
+        std::lock_guard<std::mutex> lock(results_mutex);
+        pending.progress = {Stage::DONE, total_files, total_files};
+        pending.finished = true;
+    }
+    running = false;
+}
+
+std::vector<String> ModLoadPipeline::scan_directory(const String& search_path) {
+    std::vector<String> found;
+    Ref<DirAccess> dir = DirAccess::open(search_path);
+    if (dir.is_null()) {
+        return found;
+    }
+    dir->list_dir_begin();
+    for (String entry = dir->get_next(); !entry.is_empty(); entry = dir->get_next()) {
+        if (dir->current_is_dir() && !entry.begins_with(".")) {
+            String mod_path = search_path.path_join(entry);
+            if (FileAccess::file_exists(mod_path.path_join("manifest.json"))) {
+                found.push_back(mod_path);
+            }
+        }
+    }
+    dir->list_dir_end();
+    return found;
+}
+
+// Same validation as ModManager::load_mod_manifest
+Dictionary ModLoadPipeline::read_manifest(const String& mod_path) {
+    Ref<FileAccess> f = FileAccess::open(mod_path.path_join("manifest.json"), FileAccess::READ);
+    if (f.is_null()) {
+        return Dictionary();
+    }
+    Variant parsed = JSON::parse_string(f->get_as_text());
+    if (parsed.get_type() != Variant::DICTIONARY) {
+        return Dictionary();
+    }
+    Dictionary manifest = parsed;
+    if (!manifest.has("id") || !manifest.has("name") || !manifest.has("version")) {
+        return Dictionary();
+    }
+    manifest["path"] = mod_path;
+    return manifest;
+}
+
+void ModLoadPipeline::publish_progress(Stage stage, int completed, int total) {
+    std::lock_guard<std::mutex> lock(results_mutex);
+    pending.progress = {stage, completed, total};
+}
+
+} // namespace Data
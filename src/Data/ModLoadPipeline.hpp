@@ -0,0 +1,80 @@
+#pragma once
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "DataProcessor.hpp"
+#include "../Core/WorkerPool.hpp"
+
+namespace Data {
+
+// Background mod loading in three stages, each fanned out over the shared
+// worker pool: scan the search paths, parse every manifest, then compile every
+// data file of every mod. A coordinator thread drives the stages; the
+// main thread only calls poll() to collect manifests and finished mods,
+// so it never waits on disk or parsing.
+class ModLoadPipeline {
+public:
+    enum class Stage : uint8_t { IDLE, SCANNING, MANIFESTS, PARSING, DONE };
+
+    struct Progress {
+        Stage stage{Stage::IDLE};
+        int completed{0};
+        int total{0};
+    };
+
+    struct LoadedMod {
+        String mod_id;
+        std::vector<DataProcessor::CachedCategory> categories;
+    };
+
+    // What became available since the previous poll
+    struct Update {
+        std::vector<Dictionary> manifests;
+        std::vector<LoadedMod> mods;
+        Progress progress;
+        bool finished{false};
+    };
+
+private:
+    struct ModSource {
+        String path;
+        Dictionary manifest;
+    };
+
+    DataProcessor* processor;
+    ThreadPool& pool;
+    std::thread coordinator;
+    std::atomic<bool> running{false};
+    std::atomic<bool> cancelled{false};
+
+    std::mutex results_mutex;
+    Update pending;
+
+public:
+    explicit ModLoadPipeline(DataProcessor* data_processor,
+                             ThreadPool& thread_pool = Core::WorkerPool::get_instance())
+        : processor(data_processor), pool(thread_pool) {}
+    ~ModLoadPipeline() { cancel(); }
+
+    // Returns false if a load is already running
+    bool start(const Vector<String>& search_paths);
+    // Stops after the tasks in flight and joins the coordinator
+    void cancel();
+    bool is_running() const { return running; }
+
+    Update poll();
+
+private:
+    void run(Vector<String> search_paths);
+    static std::vector<String> scan_directory(const String& search_path);
+    static Dictionary read_manifest(const String& mod_path);
+
+    void publish_progress(Stage stage, int completed, int total);
+    void finish(int total_files);
+};
+
+} // namespace Data
@@ -11,6 +11,11 @@ void ModManager::_bind_methods() {
     ADD_SIGNAL(MethodInfo("mod_loaded", PropertyInfo(Variant::STRING, "mod_name")));
     ADD_SIGNAL(MethodInfo("mod_enabled", PropertyInfo(Variant::STRING, "mod_name")));
     ADD_SIGNAL(MethodInfo("mod_disabled", PropertyInfo(Variant::STRING, "mod_name")));
+    ADD_SIGNAL(MethodInfo("mod_load_progress", PropertyInfo(Variant::INT, "stage"),
+                          PropertyInfo(Variant::INT, "completed"), PropertyInfo(Variant::INT, "total")));
+    ADD_SIGNAL(MethodInfo("mod_load_failed", PropertyInfo(Variant::STRING, "mod_name"),
+                          PropertyInfo(Variant::ARRAY, "missing_dependencies")));
+    ADD_SIGNAL(MethodInfo("mods_loaded"));
     
     // Register methods
     ClassDB::bind_method(D_METHOD("add_mod_search_path", "path"), &ModManager::add_mod_search_path);
@@ -20,6 +25,9 @@ void ModManager::_bind_methods() {
     ClassDB::bind_method(D_METHOD("get_mod_info", "mod_id"), &ModManager::get_mod_info);
     ClassDB::bind_method(D_METHOD("get_active_mods"), &ModManager::get_active_mods);
     ClassDB::bind_method(D_METHOD("get_available_mods"), &ModManager::get_available_mods);
+    ClassDB::bind_method(D_METHOD("set_data_processor", "processor"), &ModManager::set_data_processor);
+    ClassDB::bind_method(D_METHOD("load_mods_async"), &ModManager::load_mods_async);
+    ClassDB::bind_method(D_METHOD("is_loading_mods"), &ModManager::is_loading_mods);
 }
 
 ModManager::ModManager() {
@@ -80,12 +88,7 @@ Dictionary ModManager::load_mod_manifest(const String& manifest_path) {
             // Validate required fields
             if (manifest.has("id") && manifest.has("name") && manifest.has("version")) {
                 mod_info = manifest;
-                String mod_id = manifest["id"];
-                
-                // Store metadata for later use
-                if (!active_mods.has(mod_id)) {
-                    active_mods[mod_id] = Dictionary();
-                }
+                register_manifest(manifest);
             }
         }
     }
@@ -93,20 +96,166 @@ Dictionary ModManager::load_mod_manifest(const String& manifest_path) {
     return mod_info;
 }
 
+void ModManager::register_manifest(const Dictionary& manifest) {
+    String mod_id = manifest["id"];
+    
+    // Store metadata for later use
+    if (!active_mods.has(mod_id)) {
+        active_mods[mod_id] = manifest.duplicate();
+    }
+}
+
+void ModManager::set_data_processor(DataProcessor* processor) {
+    if (processor == data_processor) {
+        return;
+    }
+    if (load_pipeline) {
+        load_pipeline->cancel();
+        load_pipeline.reset();
+    }
+    waiting_mods.clear();
+    data_processor = processor;
+}
+
+Error ModManager::load_mods_async() {
+    if (!data_processor) {
+        set_data_processor(Object::cast_to<DataProcessor>(get_node_or_null(NodePath("../DataProcessor"))));
+    }
+    if (!data_processor) {
+        return ERR_UNCONFIGURED;
+    }
+    if (!load_pipeline) {
+        load_pipeline = std::make_unique<ModLoadPipeline>(data_processor);
+    }
+    if (!load_pipeline->start(mod_search_paths)) {
+        return ERR_BUSY;
+    }
+    waiting_mods.clear();
+    last_progress = ModLoadPipeline::Progress();
+    return OK;
+}
+
+bool ModManager::is_loading_mods() const {
+    return load_pipeline && (load_pipeline->is_running() || !waiting_mods.empty());
+}
+
+void ModManager::_process(double delta) {
+    poll_mod_loading();
+}
+
+// Main-thread half of the pipeline: registers manifests, merges mods whose
+// dependencies are in, and reports progress. Never waits on the workers.
+void ModManager::poll_mod_loading() {
+    if (!load_pipeline) {
+        return;
+    }
+    ModLoadPipeline::Update update = load_pipeline->poll();
+
+    for (const Dictionary& manifest : update.manifests) {
+        register_manifest(manifest);
+    }
+    for (auto& mod : update.mods) {
+        waiting_mods.push_back(std::move(mod));
+    }
+    merge_ready_mods();
+
+    const auto& progress = update.progress;
+    if (progress.stage != last_progress.stage || progress.completed != last_progress.completed) {
+        last_progress = progress;
+        emit_signal("mod_load_progress", static_cast<int>(progress.stage), progress.completed, progress.total);
+    }
+
+    if (update.finished) {
+        // Whatever is still waiting has a missing or circular dependency
+        for (const auto& mod : waiting_mods) {
+            emit_signal("mod_load_failed", mod.mod_id, check_mod_dependencies(mod.mod_id));
+            UtilityFunctions::print("Could not load mod ", mod.mod_id, ": unresolved dependencies");
+        }
+        waiting_mods.clear();
+        load_pipeline.reset();
+        emit_signal("mods_loaded");
+    }
+}
+
+bool ModManager::dependencies_merged(const String& mod_id) const {
+    Dictionary mod_info = active_mods[mod_id];
+    Array dependencies = mod_info.get("dependencies", Array());
+    for (int i = 0; i < dependencies.size(); i++) {
+        String dep_id = dependencies[i];
+        if (!active_mods.has(dep_id) || !Dictionary(active_mods[dep_id]).get("loaded", false)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Repeats until no waiting mod becomes ready, so a chain of mods that
+// arrived out of order merges in one poll; the overrides are resolved once
+// for the whole batch. Merged mods are enabled unless disable_mod was
+// called while they were loading, in which case they are switched off
+// again once the batch is resolved.
+void ModManager::merge_ready_mods() {
+    bool merged = true;
+    bool any_merged = false;
+    std::vector<String> disabled;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < waiting_mods.size(); i++) {
+            if (!dependencies_merged(waiting_mods[i].mod_id)) {
+                continue;
+            }
+            ModLoadPipeline::LoadedMod mod = std::move(waiting_mods[i]);
+            waiting_mods.erase(waiting_mods.begin() + i);
+            Dictionary mod_data = active_mods[mod.mod_id];
+            data_processor->add_mod(mod.mod_id, mod_data.get("dependencies", PackedStringArray()),
+                                    std::move(mod.categories), false);
+
+            mod_data["loaded"] = true;
+            if (mod_data.get("enabled", true)) {
+                mod_data["enabled"] = true;
+            } else {
+                disabled.push_back(mod.mod_id);
+            }
+            emit_signal("mod_loaded", mod.mod_id);
+            merged = true;
+            any_merged = true;
+            break;
+        }
+    }
+    if (any_merged) {
+        data_processor->resolve_mods();
+    }
+    // Dependents merged after their dependencies, so they go off first. A
+    // dependent that stays on keeps its dependency on, which then reports
+    // enabled.
+    for (auto it = disabled.rbegin(); it != disabled.rend(); ++it) {
+        if (data_processor->set_mod_enabled(*it, false) != OK) {
+            Dictionary mod_data = active_mods[*it];
+            mod_data["enabled"] = true;
+        }
+    }
+}
+
 Error ModManager::enable_mod(const String& mod_id) {
     if (!active_mods.has(mod_id)) {
         return ERR_DOES_NOT_EXIST;
     }
     
-    Array dependencies = check_mod_dependencies(mod_id);
-    if (!dependencies.is_empty()) {
-        return ERR_CANT_RESOLVE;
-    }
-    
     Dictionary mod_info = get_mod_info(mod_id);
     if (mod_info.is_empty()) {
         return ERR_INVALID_DATA;
     }
+
+    // Loaded mods are switched in the data processor, which only
+    // re-resolves the records this mod defines
+    if (data_processor && mod_info.get("loaded", false)) {
+        Error err = data_processor->set_mod_enabled(mod_id, true);
+        if (err != OK) {
+            return err;
+        }
+    } else if (!check_mod_dependencies(mod_id).is_empty()) {
+        return ERR_CANT_RESOLVE;
+    }
     
     // Enable the mod
     Dictionary& mod_data = active_mods[mod_id];
@@ -121,6 +270,10 @@ Error ModManager::enable_mod(const String& mod_id) {
 void ModManager::disable_mod(const String& mod_id) {
     if (active_mods.has(mod_id)) {
         Dictionary& mod_data = active_mods[mod_id];
+        if (data_processor && mod_data.get("loaded", false) &&
+            data_processor->set_mod_enabled(mod_id, false) != OK) {
+            return;
+        }
         mod_data["enabled"] = false;
         
         emit_signal("mod_disabled", mod_id);
@@ -1,6 +1,9 @@
 #pragma once
 #include <godot_cpp/classes/node.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
+#include <memory>
+#include <vector>
+#include "ModLoadPipeline.hpp"
 
 namespace Data {
 
@@ -12,6 +15,18 @@ private:
     Dictionary mod_load_order;
     Vector<String> mod_search_paths;
 
+    // Background loading: mods parsed by the pipeline wait here until
+    // every dependency has been merged, then merge in that order
+    DataProcessor* data_processor = nullptr;
+    std::unique_ptr<ModLoadPipeline> load_pipeline;
+    std::vector<ModLoadPipeline::LoadedMod> waiting_mods;
+    ModLoadPipeline::Progress last_progress;
+
+    Dictionary load_mod_manifest(const String& manifest_path);
+    void register_manifest(const Dictionary& manifest);
+    bool dependencies_merged(const String& mod_id) const;
+    void merge_ready_mods();
+
 protected:
     static void _bind_methods();
 
@@ -20,6 +35,15 @@ public:
     
     void add_mod_search_path(const String& path);
     Array discover_mods();
+
+    // Scans, parses and merges every mod off the main thread; progress
+    // arrives through the mod_load_progress signal from _process. Without
+    // an explicit processor the sibling DataProcessor node is used.
+    void set_data_processor(DataProcessor* processor);
+    Error load_mods_async();
+    bool is_loading_mods() const;
+    void _process(double delta) override;
+    void poll_mod_loading();
     Error enable_mod(const String& mod_id);
     void disable_mod(const String& mod_id);
     
@@ -0,0 +1,451 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "DataCache.hpp"
+#include "GameDataRegistry.hpp"
+
+namespace Data {
+
+// Layered override resolution for base data and mods.
+//
+// Mods are topologically sorted by dependency once, when the set of known
+// mods changes; ties keep registration order, and mods in a cycle or with
+// a dependency that is not installed never become active. Every record
+// keeps the stack of layers that define it, so the effective record is
+// the one from the highest active layer and its provenance is known.
+//
+// A mod is active while it is enabled, resolvable and every dependency is
+// active. Enabling or disabling a mod does not re-sort or reload
+// anything: only the records of the mods whose activity changed are
+// re-resolved and written into the registry, and the caller gets the
+// list of records whose winner changed. The enabled flag is only ever
+// set by the caller, so a mod switched off by its dependency comes back
+// with it.
+//
+// set_base, add_mod and remove_mod only register files. Until the next
+// resolve() the record stacks may point into caches the caller has
+// already freed, so while a resolve is pending set_enabled and
+// reload_layer fall back to a full resolve, and provenance/overrides
+// report nothing.
+class ModResolver {
+public:
+    static constexpr uint32_t BASE_LAYER = 0;
+    static constexpr uint32_t NO_LAYER = static_cast<uint32_t>(-1);
+
+    struct RecordKey {
+        RecordKind kind;
+        std::string id;
+    };
+
+private:
+    struct Layer {
+        std::string mod_id;  // Empty for the base layer
+        std::vector<std::string> dependencies;
+        std::vector<const DataCache*> files;
+        bool enabled{true};     // As the caller set it
+        bool resolvable{true};  // False for cycles and missing dependencies
+        bool active{true};      // Enabled, resolvable and dependencies active
+        uint32_t rank{0};       // Position in the load order; base is 0
+        uint32_t serial{0};     // Changes whenever the layer's files do
+        std::vector<uint32_t> touched;  // Records this layer defines
+    };
+
+    struct Contribution {
+        uint32_t layer;
+        DataCache::Value record;
+    };
+
+    struct RecordStack {
+        RecordKind kind;
+        std::string id;
+        std::vector<Contribution> contributions;
+        uint32_t winner{NO_LAYER};
+        uint32_t winner_serial{0};  // Serial of the winning layer when written
+    };
+
+    std::vector<Layer> layers{Layer{}};
+    std::unordered_map<std::string, uint32_t> layer_of;
+    std::vector<std::string> order;
+    std::vector<std::string> unresolved;
+
+    std::vector<RecordStack> records;
+    std::unordered_map<std::string, uint32_t> record_of;
+    uint32_t next_serial{1};
+    bool resolve_pending{false};
+
+public:
+    void set_base(std::vector<const DataCache*> files) {
+        layers[BASE_LAYER].files = std::move(files);
+        layers[BASE_LAYER].serial = next_serial++;
+        resolve_pending = true;
+    }
+
+    bool is_resolve_pending() const { return resolve_pending; }
+
+    // Registers or replaces a mod; takes effect on the next resolve()
+    void add_mod(const std::string& mod_id, std::vector<std::string> dependencies,
+                 std::vector<const DataCache*> files, bool enabled = true) {
+        auto [it, inserted] = layer_of.try_emplace(mod_id, static_cast<uint32_t>(layers.size()));
+        if (inserted) layers.emplace_back();
+        Layer& layer = layers[it->second];
+        layer.mod_id = mod_id;
+        layer.dependencies = std::move(dependencies);
+        layer.files = std::move(files);
+        layer.enabled = enabled;
+        layer.serial = next_serial++;
+        resolve_pending = true;
+    }
+
+    void remove_mod(const std::string& mod_id) {
+        auto it = layer_of.find(mod_id);
+        if (it == layer_of.end()) return;
+        layers.erase(layers.begin() + it->second);
+        layer_of.clear();
+        for (uint32_t i = 1; i < layers.size(); ++i) layer_of[layers[i].mod_id] = i;
+        resolve_pending = true;
+    }
+
+    // Sorts the mods and rebuilds every record stack and the registry.
+    // Records whose winning layer or content differs from before are
+    // appended to `changed`, including records that no longer exist.
+    void resolve(GameDataRegistry& registry, std::vector<RecordKey>& changed) {
+        // Serials are compared, never the old contributions, which may
+        // point into caches that are gone
+        std::unordered_map<std::string, uint32_t> previous;
+        for (const auto& stack : records) {
+            if (stack.winner != NO_LAYER) previous.emplace(record_key(stack.kind, stack.id), stack.winner_serial);
+        }
+
+        sort_layers();
+        update_activity();
+
+        records.clear();
+        record_of.clear();
+        for (uint32_t l = 0; l < layers.size(); ++l) {
+            Layer& layer = layers[l];
+            layer.touched.clear();
+            for (const DataCache* file : layer.files) {
+                GameDataRegistry::for_each_record(file->root(),
+                    [this, l](RecordKind kind, std::string_view id, const DataCache::Value& record) {
+                        contribute(l, kind, id, record);
+                    });
+            }
+        }
+
+        // Rebuilt in place, so records that survive keep their RecordIds
+        // and bound views stay valid
+        registry.retire_all();
+        for (auto& stack : records) {
+            set_winner(stack, pick_winner(stack));
+            if (stack.winner == NO_LAYER) continue;
+            registry.ingest_record(stack.kind, stack.id, contribution(stack, stack.winner).record);
+
+            auto before = previous.find(record_key(stack.kind, stack.id));
+            if (before == previous.end() || before->second != stack.winner_serial) {
+                changed.push_back({stack.kind, stack.id});
+            }
+            if (before != previous.end()) previous.erase(before);
+        }
+        for (const auto& [key, serial] : previous) {
+            changed.push_back({static_cast<RecordKind>(key[0]), key.substr(1)});
+        }
+        registry.resolve_references();
+        resolve_pending = false;
+    }
+
+    // Toggles a mod and re-resolves only the records of the mods that
+    // switch on or off with it. Returns the mods blocking the change
+    // (dependencies that are not active, or active dependents when
+    // disabling); on success the list is empty and the records whose
+    // effective source changed are appended to `changed`.
+    std::vector<std::string> set_enabled(const std::string& mod_id, bool enabled,
+                                         GameDataRegistry& registry, std::vector<RecordKey>& changed) {
+        std::vector<std::string> blocking;
+        auto it = layer_of.find(mod_id);
+        if (it == layer_of.end()) {
+            blocking.push_back(mod_id);
+            return blocking;
+        }
+        Layer& layer = layers[it->second];
+        if (layer.enabled == enabled) return blocking;
+
+        if (enabled) {
+            for (const auto& dependency : layer.dependencies) {
+                if (!is_active(dependency)) blocking.push_back(dependency);
+            }
+            if (!layer.resolvable && blocking.empty()) blocking.push_back(mod_id);
+        } else {
+            for (uint32_t l = 1; l < layers.size(); ++l) {
+                const Layer& other = layers[l];
+                if (other.active && std::find(other.dependencies.begin(), other.dependencies.end(), mod_id)
+                                    != other.dependencies.end()) {
+                    blocking.push_back(other.mod_id);
+                }
+            }
+        }
+        if (!blocking.empty()) return blocking;
+
+        layer.enabled = enabled;
+        if (resolve_pending) {
+            resolve(registry, changed);
+            return blocking;
+        }
+        std::vector<uint32_t> affected;
+        for (uint32_t l : update_activity()) {
+            affected.insert(affected.end(), layers[l].touched.begin(), layers[l].touched.end());
+        }
+        std::sort(affected.begin(), affected.end());
+        affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+        for (uint32_t index : affected) {
+            RecordStack& stack = records[index];
+            uint32_t winner = pick_winner(stack);
+            if (winner == stack.winner) continue;
+            set_winner(stack, winner);
+            if (winner == NO_LAYER) {
+                registry.erase(stack.kind, stack.id);
+            } else {
+                registry.ingest_record(stack.kind, stack.id, contribution(stack, winner).record);
+            }
+            changed.push_back({stack.kind, stack.id});
+        }
+        registry.resolve_references();
+        return blocking;
+    }
+
+    // Swaps the files of one layer ("" is base) after a hot reload. The
+    // layer's stacks are re-pointed at the new files, but the registry is
+    // only touched for records whose winner moved or whose content is in
+    // `edited`; those are appended to `changed`.
+    void reload_layer(const std::string& mod_id, std::vector<const DataCache*> files,
+                      const std::vector<RecordKey>& edited, GameDataRegistry& registry,
+                      std::vector<RecordKey>& changed) {
+        uint32_t l = BASE_LAYER;
+        if (!mod_id.empty()) {
+            auto it = layer_of.find(mod_id);
+            if (it == layer_of.end()) return;
+            l = it->second;
+        }
+        Layer& layer = layers[l];
+        if (resolve_pending) {
+            layer.files = std::move(files);
+            layer.serial = next_serial++;
+            resolve(registry, changed);
+            return;
+        }
+
+        std::vector<uint32_t> affected = std::move(layer.touched);
+        layer.touched.clear();
+        for (uint32_t index : affected) {
+            auto& contributions = records[index].contributions;
+            contributions.erase(std::remove_if(contributions.begin(), contributions.end(),
+                                               [l](const Contribution& entry) { return entry.layer == l; }),
+                                contributions.end());
+        }
+        layer.files = std::move(files);
+        layer.serial = next_serial++;
+        for (const DataCache* file : layer.files) {
+            GameDataRegistry::for_each_record(file->root(),
+                [this, l](RecordKind kind, std::string_view id, const DataCache::Value& record) {
+                    contribute(l, kind, id, record);
+                });
+        }
+
+        std::unordered_set<std::string> edited_keys;
+        for (const auto& key : edited) edited_keys.insert(record_key(key.kind, key.id));
+        affected.insert(affected.end(), layer.touched.begin(), layer.touched.end());
+        std::sort(affected.begin(), affected.end());
+        affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+
+        for (uint32_t index : affected) {
+            RecordStack& stack = records[index];
+            uint32_t winner = pick_winner(stack);
+            bool edited_here = winner == l && edited_keys.count(record_key(stack.kind, stack.id)) > 0;
+            if (winner == stack.winner && !edited_here) {
+                // Same content under the layer's new serial
+                set_winner(stack, winner);
+                continue;
+            }
+            set_winner(stack, winner);
+            if (winner == NO_LAYER) {
+                registry.erase(stack.kind, stack.id);
+            } else {
+                registry.ingest_record(stack.kind, stack.id, contribution(stack, winner).record);
+            }
+            changed.push_back({stack.kind, stack.id});
+        }
+        registry.resolve_references();
+    }
+
+    bool is_active(const std::string& mod_id) const {
+        auto it = layer_of.find(mod_id);
+        return it != layer_of.end() && layers[it->second].active;
+    }
+
+    // The caller's setting, whether or not the mod is active
+    bool is_enabled(const std::string& mod_id) const {
+        auto it = layer_of.find(mod_id);
+        return it != layer_of.end() && layers[it->second].enabled;
+    }
+
+    // Mod that supplies the effective record; empty for base data, or
+    // nullptr if no active layer defines it
+    const std::string* provenance(RecordKind kind, std::string_view id) const {
+        if (resolve_pending) return nullptr;
+        auto it = record_of.find(record_key(kind, id));
+        if (it == record_of.end() || records[it->second].winner == NO_LAYER) return nullptr;
+        return &layers[records[it->second].winner].mod_id;
+    }
+
+    // Every layer defining a record, lowest to highest priority
+    std::vector<std::string> overrides(RecordKind kind, std::string_view id) const {
+        std::vector<std::string> result;
+        if (resolve_pending) return result;
+        auto it = record_of.find(record_key(kind, id));
+        if (it == record_of.end()) return result;
+        std::vector<uint32_t> defining;
+        for (const auto& entry : records[it->second].contributions) defining.push_back(entry.layer);
+        std::sort(defining.begin(), defining.end(),
+                  [this](uint32_t a, uint32_t b) { return layers[a].rank < layers[b].rank; });
+        for (uint32_t l : defining) result.push_back(layers[l].mod_id);
+        return result;
+    }
+
+    const std::vector<std::string>& load_order() const { return order; }
+    // Mods left out of the order by a cycle or a missing dependency
+    const std::vector<std::string>& unresolved_mods() const { return unresolved; }
+
+private:
+    static std::string record_key(RecordKind kind, std::string_view id) {
+        std::string key(1, static_cast<char>(kind));
+        key.append(id);
+        return key;
+    }
+
+    // Kahn's algorithm over installed mods, ties broken by registration
+    void sort_layers() {
+        const uint32_t count = static_cast<uint32_t>(layers.size());
+        std::vector<std::vector<uint32_t>> dependents(count);
+        std::vector<uint32_t> pending(count, 0);
+        std::vector<uint8_t> missing(count, 0);
+        for (uint32_t l = 1; l < count; ++l) {
+            for (const auto& dependency : layers[l].dependencies) {
+                auto it = layer_of.find(dependency);
+                if (it == layer_of.end()) {
+                    missing[l] = 1;
+                } else {
+                    dependents[it->second].push_back(l);
+                    ++pending[l];
+                }
+            }
+        }
+
+        std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ready;
+        for (uint32_t l = 1; l < count; ++l) {
+            if (pending[l] == 0) ready.push(l);
+        }
+        order.clear();
+        std::vector<uint8_t> placed(count, 0);
+        uint32_t rank = 1;
+        while (!ready.empty()) {
+            uint32_t l = ready.top();
+            ready.pop();
+            placed[l] = 1;
+            layers[l].rank = rank++;
+            order.push_back(layers[l].mod_id);
+            for (uint32_t dependent : dependents[l]) {
+                if (--pending[dependent] == 0) ready.push(dependent);
+            }
+        }
+
+        // A mod is resolvable if it was placed and everything it needs is
+        unresolved.clear();
+        for (uint32_t l = 1; l < count; ++l) {
+            layers[l].resolvable = placed[l] && !missing[l];
+        }
+        for (const auto& mod_id : order) {
+            Layer& layer = layers[layer_of[mod_id]];
+            for (const auto& dependency : layer.dependencies) {
+                auto it = layer_of.find(dependency);
+                if (it != layer_of.end() && !layers[it->second].resolvable) layer.resolvable = false;
+            }
+        }
+        for (uint32_t l = 1; l < count; ++l) {
+            if (!layers[l].resolvable) {
+                if (!placed[l]) layers[l].rank = 0;
+                unresolved.push_back(layers[l].mod_id);
+            }
+        }
+    }
+
+    // Recomputes every mod's activity in load order, where dependencies
+    // come first; returns the layers that switched on or off
+    std::vector<uint32_t> update_activity() {
+        std::vector<uint32_t> switched;
+        for (uint32_t l = 1; l < layers.size(); ++l) {
+            if (!layers[l].resolvable && layers[l].active) {
+                layers[l].active = false;
+                switched.push_back(l);
+            }
+        }
+        for (const auto& mod_id : order) {
+            uint32_t l = layer_of[mod_id];
+            Layer& layer = layers[l];
+            bool active = layer.enabled && layer.resolvable;
+            for (const auto& dependency : layer.dependencies) {
+                auto it = layer_of.find(dependency);
+                active = active && it != layer_of.end() && layers[it->second].active;
+            }
+            if (active != layer.active) {
+                layer.active = active;
+                switched.push_back(l);
+            }
+        }
+        return switched;
+    }
+
+    void contribute(uint32_t layer, RecordKind kind, std::string_view id, const DataCache::Value& record) {
+        auto [it, inserted] = record_of.try_emplace(record_key(kind, id), static_cast<uint32_t>(records.size()));
+        if (inserted) records.push_back({kind, std::string(id), {}, NO_LAYER});
+        RecordStack& stack = records[it->second];
+
+        // Within one layer the later file wins
+        for (auto& entry : stack.contributions) {
+            if (entry.layer == layer) {
+                entry.record = record;
+                return;
+            }
+        }
+        stack.contributions.push_back({layer, record});
+        layers[layer].touched.push_back(it->second);
+    }
+
+    void set_winner(RecordStack& stack, uint32_t winner) const {
+        stack.winner = winner;
+        stack.winner_serial = winner == NO_LAYER ? 0 : layers[winner].serial;
+    }
+
+    uint32_t pick_winner(const RecordStack& stack) const {
+        uint32_t winner = NO_LAYER;
+        for (const auto& entry : stack.contributions) {
+            const Layer& layer = layers[entry.layer];
+            bool active = entry.layer == BASE_LAYER || layer.active;
+            if (active && (winner == NO_LAYER || layer.rank > layers[winner].rank)) winner = entry.layer;
+        }
+        return winner;
+    }
+
+    static const Contribution& contribution(const RecordStack& stack, uint32_t layer) {
+        for (const auto& entry : stack.contributions) {
+            if (entry.layer == layer) return entry;
+        }
+        return stack.contributions.front();
+    }
+};
+
+} // namespace Data
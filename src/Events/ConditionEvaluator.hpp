@@ -1,53 +1,253 @@
 #pragma once
 #include <immintrin.h>
-#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+// Minimal allocator so column storage starts on a 32-byte boundary and
+// aligned AVX loads are valid
+template<typename T, size_t Alignment = 32>
+struct AlignedAllocator {
+    using value_type = T;
+    template<typename U> struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() = default;
+    template<typename U> AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t count) {
+        size_t bytes = (count * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+        void* memory = std::aligned_alloc(Alignment, bytes);
+        if (!memory) throw std::bad_alloc();
+        return static_cast<T*>(memory);
+    }
+    void deallocate(T* pointer, size_t) { std::free(pointer); }
+
+    template<typename U> bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template<typename U> bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
 
+// Batched predicate engine. State variables are stored as one aligned
+// column per variable with a lane per region. Conditions are leaves
+// (variable, operator, threshold) combined into AND/OR trees; evaluating
+// a set of roots produces a bitmask per root with one bit per region.
+//
+// Regions are processed in blocks of 64 (one mask word, eight AVX
+// compares per leaf). Within a block an AND stops at the first child that
+// clears every bit and an OR at the first that sets every bit, and leaf
+// results are memoised per block so conditions shared by many events are
+// compared once.
 class ConditionEvaluator {
+public:
+    using NodeId = uint32_t;
+    enum class Op : uint8_t { LT, LE, GT, GE, EQ, NE };
+
+    static constexpr size_t SIMD_BATCH_SIZE = 8;
+    static constexpr size_t BLOCK = 64;
+
 private:
-    struct ConditionData {
-        alignas(32) std::vector<float> values;
-        alignas(32) std::vector<float> thresholds;
-        std::vector<uint8_t> operators; // 0: <, 1: >, 2: ==, 3: !=
+    enum class Kind : uint8_t { LEAF, ALL, ANY };
+
+    struct Node {
+        Kind kind;
+        Op op;
+        uint32_t variable;   // Leaves
+        float threshold;     // Leaves
+        uint32_t first;      // Children in `children`
+        uint32_t count;
     };
 
-    std::unordered_map<std::string, ConditionData> condition_cache;
-    static constexpr size_t SIMD_BATCH_SIZE = 8;
+    std::unordered_map<std::string, uint32_t> variable_ids;
+    std::vector<float, AlignedAllocator<float>> values;  // variable-major, `stride` lanes each
+    size_t region_count{0};
+    size_t stride{0};
+
+    std::vector<Node> nodes;
+    std::vector<NodeId> children;
+    // Identical leaves share a node so the memo below catches them
+    std::unordered_map<uint64_t, NodeId> leaf_ids;
+
+    // Per-block leaf memo
+    std::vector<uint64_t> leaf_word;
+    std::vector<uint32_t> leaf_stamp;
+    uint32_t stamp{0};
+
+    std::vector<uint64_t> results;
+    size_t result_roots{0};
 
 public:
-    bool evaluate_conditions_simd(const std::vector<std::string>& conditions) {
-        alignas(32) float results[8];
-        
-        for (size_t i = 0; i < conditions.size(); i += SIMD_BATCH_SIZE) {
-            size_t batch_size = std::min(SIMD_BATCH_SIZE, conditions.size() - i);
-            
-            __m256 values = _mm256_load_ps(&condition_cache[conditions[i]].values[0]);
-            __m256 thresholds = _mm256_load_ps(&condition_cache[conditions[i]].thresholds[0]);
-            
-            __m256 comparison;
-            switch (condition_cache[conditions[i]].operators[0]) {
-                case 0: // <
-                    comparison = _mm256_cmp_ps(values, thresholds, _CMP_LT_OQ);
-                    break;
-                case 1: // >
-                    comparison = _mm256_cmp_ps(values, thresholds, _CMP_GT_OQ);
-                    break;
-                case 2: // ==
-                    comparison = _mm256_cmp_ps(values, thresholds, _CMP_EQ_OQ);
-                    break;
-                case 3: // !=
-                    comparison = _mm256_cmp_ps(values, thresholds, _CMP_NEQ_OQ);
-                    break;
+    // Regions are padded to a whole block; padding lanes never report true
+    void set_region_count(size_t count) {
+        size_t new_stride = (count + BLOCK - 1) / BLOCK * BLOCK;
+        std::vector<float, AlignedAllocator<float>> resized(variable_ids.size() * new_stride, 0.0f);
+        for (size_t v = 0; v < variable_ids.size(); ++v) {
+            for (size_t r = 0; r < std::min(count, region_count); ++r) {
+                resized[v * new_stride + r] = values[v * stride + r];
             }
-            
-            _mm256_store_ps(results, comparison);
-            
-            for (size_t j = 0; j < batch_size; ++j) {
-                if (results[j] == 0) return false;
+        }
+        values.swap(resized);
+        region_count = count;
+        stride = new_stride;
+    }
+
+    size_t get_region_count() const { return region_count; }
+    size_t words_per_mask() const { return stride / BLOCK; }
+
+    uint32_t variable(const std::string& name) {
+        auto [it, inserted] = variable_ids.try_emplace(name, static_cast<uint32_t>(variable_ids.size()));
+        if (inserted) values.resize(variable_ids.size() * stride, 0.0f);
+        return it->second;
+    }
+
+    void set_value(uint32_t variable, size_t region, float value) {
+        values[variable * stride + region] = value;
+    }
+
+    // Direct access for bulk refreshes; `get_region_count()` lanes are live
+    float* column(uint32_t variable) { return values.data() + variable * stride; }
+
+    NodeId add_condition(const std::string& name, Op op, float threshold) {
+        uint32_t id = variable(name);
+        uint32_t bits;
+        std::memcpy(&bits, &threshold, sizeof(bits));
+        uint64_t key = (static_cast<uint64_t>(id) << 40) | (static_cast<uint64_t>(op) << 32) | bits;
+        auto [it, inserted] = leaf_ids.try_emplace(key, static_cast<NodeId>(nodes.size()));
+        if (inserted) nodes.push_back({Kind::LEAF, op, id, threshold, 0, 0});
+        return it->second;
+    }
+
+    NodeId add_all(const std::vector<NodeId>& operands) { return add_group(Kind::ALL, operands); }
+    NodeId add_any(const std::vector<NodeId>& operands) { return add_group(Kind::ANY, operands); }
+
+    // Evaluates every root over every region in one sweep; mask i belongs
+    // to roots[i]
+    void evaluate(const std::vector<NodeId>& roots) {
+        const size_t words = words_per_mask();
+        result_roots = roots.size();
+        results.assign(result_roots * words, 0);
+        leaf_word.resize(nodes.size());
+        leaf_stamp.assign(nodes.size(), 0);
+        stamp = 0;
+
+        for (size_t block = 0; block < words; ++block) {
+            ++stamp;
+            const uint64_t valid = valid_mask(block);
+            for (size_t root = 0; root < roots.size(); ++root) {
+                results[root * words + block] = evaluate_node(roots[root], block, valid);
             }
         }
-        
+    }
+
+    const uint64_t* mask(size_t root_index) const { return results.data() + root_index * words_per_mask(); }
+
+    bool holds(size_t root_index, size_t region) const {
+        return (mask(root_index)[region / BLOCK] >> (region % BLOCK)) & 1u;
+    }
+
+    // True if the root's condition holds for every region
+    bool holds_everywhere(size_t root_index) const {
+        const uint64_t* words = mask(root_index);
+        for (size_t block = 0; block < words_per_mask(); ++block) {
+            if (words[block] != valid_mask(block)) return false;
+        }
         return true;
     }
-}; 
\ No newline at end of file
+
+    void clear_conditions() {
+        nodes.clear();
+        children.clear();
+        leaf_ids.clear();
+        results.clear();
+        result_roots = 0;
+    }
+
+private:
+    NodeId add_group(Kind kind, const std::vector<NodeId>& operands) {
+        Node node{kind, Op::EQ, 0, 0.0f, static_cast<uint32_t>(children.size()),
+                  static_cast<uint32_t>(operands.size())};
+        children.insert(children.end(), operands.begin(), operands.end());
+        nodes.push_back(node);
+        return static_cast<NodeId>(nodes.size() - 1);
+    }
+
+    uint64_t valid_mask(size_t block) const {
+        size_t live = region_count - std::min(region_count, block * BLOCK);
+        return live >= BLOCK ? ~0ull : (1ull << live) - 1;
+    }
+
+    uint64_t evaluate_node(NodeId id, size_t block, uint64_t valid) {
+        const Node& node = nodes[id];
+        switch (node.kind) {
+            case Kind::LEAF:
+                if (leaf_stamp[id] != stamp) {
+                    leaf_stamp[id] = stamp;
+                    leaf_word[id] = compare_block(values.data() + node.variable * stride + block * BLOCK,
+                                                  node.op, node.threshold) & valid;
+                }
+                return leaf_word[id];
+            case Kind::ALL: {
+                uint64_t word = valid;
+                for (uint32_t c = 0; c < node.count && word != 0; ++c) {
+                    word &= evaluate_node(children[node.first + c], block, valid);
+                }
+                return word;
+            }
+            case Kind::ANY: {
+                uint64_t word = 0;
+                for (uint32_t c = 0; c < node.count && word != valid; ++c) {
+                    word |= evaluate_node(children[node.first + c], block, valid);
+                }
+                return word;
+            }
+        }
+        return 0;
+    }
+
+    // One bit per lane for 64 lanes starting at a 32-byte aligned address
+    static uint64_t compare_block(const float* lanes, Op op, float threshold) {
+#if defined(__AVX__)
+        switch (op) {
+            case Op::LT: return compare_lanes<_CMP_LT_OQ>(lanes, threshold);
+            case Op::LE: return compare_lanes<_CMP_LE_OQ>(lanes, threshold);
+            case Op::GT: return compare_lanes<_CMP_GT_OQ>(lanes, threshold);
+            case Op::GE: return compare_lanes<_CMP_GE_OQ>(lanes, threshold);
+            case Op::EQ: return compare_lanes<_CMP_EQ_OQ>(lanes, threshold);
+            case Op::NE: return compare_lanes<_CMP_NEQ_UQ>(lanes, threshold);
+        }
+        return 0;
+#else
+        uint64_t word = 0;
+        for (size_t lane = 0; lane < BLOCK; ++lane) {
+            float value = lanes[lane];
+            bool result = false;
+            switch (op) {
+                case Op::LT: result = value < threshold; break;
+                case Op::LE: result = value <= threshold; break;
+                case Op::GT: result = value > threshold; break;
+                case Op::GE: result = value >= threshold; break;
+                case Op::EQ: result = value == threshold; break;
+                case Op::NE: result = value != threshold; break;
+            }
+            word |= static_cast<uint64_t>(result) << lane;
+        }
+        return word;
+#endif
+    }
+
+#if defined(__AVX__)
+    template<int Predicate>
+    static uint64_t compare_lanes(const float* lanes, float threshold) {
+        const __m256 bound = _mm256_set1_ps(threshold);
+        uint64_t word = 0;
+        for (size_t group = 0; group < BLOCK / SIMD_BATCH_SIZE; ++group) {
+            __m256 comparison = _mm256_cmp_ps(_mm256_load_ps(lanes + group * SIMD_BATCH_SIZE), bound, Predicate);
+            word |= static_cast<uint64_t>(_mm256_movemask_ps(comparison)) << (group * SIMD_BATCH_SIZE);
+        }
+        return word;
+    }
+#endif
+};
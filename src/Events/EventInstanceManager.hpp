@@ -0,0 +1,176 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Live event instances for EventSystem.
+//
+// Events are identified by dense integer ids (their index in the event
+// table), and each event has at most one live instance: triggering an
+// active event refreshes its lifetime instead of stacking a duplicate.
+// Instances sit in a generation-indexed slot map. Handles stay O(1) to
+// check after the instance behind them has expired, and iteration runs
+// over a packed array.
+//
+// Trigger jobs do not touch the active set. Each job appends to its own
+// emission buffer without locking, and merge() folds the buffers in
+// emitter order at the sync point once the jobs are done. The result
+// does not depend on which thread ran which job. The active set is
+// bounded; emissions beyond the bound are dropped and counted.
+class EventInstanceManager {
+public:
+    using EventId = uint32_t;
+
+    struct Handle {
+        uint32_t slot{INVALID_SLOT};
+        uint32_t generation{0};
+
+        bool operator==(const Handle& other) const { return slot == other.slot && generation == other.generation; }
+        bool operator!=(const Handle& other) const { return !(*this == other); }
+    };
+
+    struct Instance {
+        EventId event;
+        float lifetime;  // Seconds left
+    };
+
+    static constexpr uint32_t INVALID_SLOT = std::numeric_limits<uint32_t>::max();
+
+private:
+    struct Slot {
+        uint32_t dense{INVALID_SLOT};  // Index into instances, INVALID_SLOT when free
+        uint32_t generation{0};
+    };
+
+    struct Emission {
+        EventId event;
+        float lifetime;
+    };
+
+    std::vector<Instance> instances;        // Packed live instances
+    std::vector<uint32_t> instance_slots;   // Slot of each packed instance
+    std::vector<Slot> slots;
+    std::vector<uint32_t> free_slots;
+    std::vector<uint32_t> slot_by_event;    // Live slot per event id
+    std::vector<std::vector<Emission>> emissions;
+    size_t max_active;
+    uint64_t dropped{0};
+
+public:
+    explicit EventInstanceManager(size_t max_active_instances) : max_active(max_active_instances) {
+        instances.reserve(max_active);
+        instance_slots.reserve(max_active);
+    }
+
+    size_t size() const { return instances.size(); }
+    size_t capacity() const { return max_active; }
+    uint64_t dropped_count() const { return dropped; }
+    const std::vector<Instance>& active() const { return instances; }
+
+    // Grows the id space as events are registered
+    void reserve_events(size_t event_count) {
+        if (slot_by_event.size() < event_count) slot_by_event.resize(event_count, INVALID_SLOT);
+    }
+
+    // Starts (or refreshes) an instance immediately; main thread only
+    Handle activate(EventId event, float lifetime) {
+        if (event >= slot_by_event.size()) return {};
+        uint32_t slot = slot_by_event[event];
+        if (slot != INVALID_SLOT) {
+            Instance& instance = instances[slots[slot].dense];
+            instance.lifetime = std::max(instance.lifetime, lifetime);
+            return {slot, slots[slot].generation};
+        }
+        if (instances.size() >= max_active) {
+            ++dropped;
+            return {};
+        }
+
+        if (free_slots.empty()) {
+            free_slots.push_back(static_cast<uint32_t>(slots.size()));
+            slots.emplace_back();
+        }
+        slot = free_slots.back();
+        free_slots.pop_back();
+        slots[slot].dense = static_cast<uint32_t>(instances.size());
+        instances.push_back({event, lifetime});
+        instance_slots.push_back(slot);
+        slot_by_event[event] = slot;
+        return {slot, slots[slot].generation};
+    }
+
+    // Null once the instance has expired, even if its slot was reused
+    const Instance* get(Handle handle) const {
+        if (handle.slot >= slots.size() || slots[handle.slot].generation != handle.generation ||
+            slots[handle.slot].dense == INVALID_SLOT) {
+            return nullptr;
+        }
+        return &instances[slots[handle.slot].dense];
+    }
+
+    bool is_active(EventId event) const {
+        return event < slot_by_event.size() && slot_by_event[event] != INVALID_SLOT;
+    }
+
+    // One buffer per job of the coming parallel pass; call before
+    // scheduling the jobs. Emissions of a pass that was never merged are
+    // discarded, including those in buffers this pass does not use.
+    void begin_emission(size_t emitters) {
+        if (emissions.size() < emitters) emissions.resize(emitters);
+        for (auto& buffer : emissions) buffer.clear();
+    }
+
+    // Safe to call concurrently as long as each job uses its own emitter
+    void emit(size_t emitter, EventId event, float lifetime) {
+        emissions[emitter].push_back({event, lifetime});
+    }
+
+    // The sync point: applies every buffered emission in emitter order
+    void merge() {
+        for (auto& buffer : emissions) {
+            for (const Emission& emission : buffer) activate(emission.event, emission.lifetime);
+            buffer.clear();
+        }
+    }
+
+    // Ages every instance and removes the expired ones, calling
+    // on_expired(event) for each. Removal swaps the last instance into
+    // the hole, so the packed array stays dense.
+    template<typename F>
+    void expire(float delta, F&& on_expired) {
+        for (size_t i = 0; i < instances.size();) {
+            instances[i].lifetime -= delta;
+            if (instances[i].lifetime > 0.0f) {
+                ++i;
+                continue;
+            }
+            EventId event = instances[i].event;
+            remove(i);
+            on_expired(event);
+        }
+    }
+
+    void clear() {
+        while (!instances.empty()) remove(instances.size() - 1);
+    }
+
+private:
+    void remove(size_t dense) {
+        uint32_t slot = instance_slots[dense];
+        slot_by_event[instances[dense].event] = INVALID_SLOT;
+        slots[slot].dense = INVALID_SLOT;
+        ++slots[slot].generation;
+        free_slots.push_back(slot);
+
+        size_t last = instances.size() - 1;
+        if (dense != last) {
+            instances[dense] = instances[last];
+            instance_slots[dense] = instance_slots[last];
+            slots[instance_slots[dense]].dense = static_cast<uint32_t>(dense);
+        }
+        instances.pop_back();
+        instance_slots.pop_back();
+    }
+};
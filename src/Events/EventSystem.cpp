@@ -1,45 +1,194 @@
 #include "EventSystem.hpp"
+#include <godot_cpp/variant/utility_functions.hpp>
 #include <immintrin.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include "../Core/WorldSeed.hpp"
 
-void EventSystem::process_event_batch_simd(size_t start_idx, size_t count) {
-    alignas(32) float probabilities[8];
-    alignas(32) float thresholds[8];
-    
-    for (size_t i = 0; i < count; i += 8) {
-        // Load 8 probabilities at once
-        __m256 prob_vec = _mm256_load_ps(&event_probabilities[start_idx + i]);
-        __m256 thresh_vec = _mm256_set1_ps(0.5f); // Example threshold
-        
-        // Compare probabilities with thresholds
-        __m256 result = _mm256_cmp_ps(prob_vec, thresh_vec, _CMP_GT_OQ);
-        
-        _mm256_store_ps(probabilities, prob_vec);
-        _mm256_store_ps(thresholds, result);
-        
-        // Process results
-        for (int j = 0; j < 8 && i + j < count; ++j) {
-            if (thresholds[j] != 0) {
-                // Event should trigger
-                auto* instance = event_pool.allocate();
-                instance->data = &event_database[std::to_string(start_idx + i + j)];
-                instance->is_active = true;
-                active_events.push_back(instance);
+EventSystem::EventSystem() : rng(Core::WorldSeed::get_instance().derive("events")) {
+    conditions.set_region_count(1);
+}
+
+EventSystem::~EventSystem() {}
+
+void EventSystem::register_event(const std::string& id, const EventData& data) {
+    auto existing = event_ids.find(id);
+    if (existing != event_ids.end()) {
+        events[existing->second] = data;
+        events[existing->second].id = id;
+        event_probabilities[existing->second] = data.probability;
+        conditions_stale = true;
+        return;
+    }
+
+    auto event = static_cast<EventInstanceManager::EventId>(events.size());
+    event_ids.emplace(id, event);
+    events.push_back(data);
+    events.back().id = id;
+    event_probabilities.resize((events.size() + 7) / 8 * 8, 0.0f);
+    event_probabilities[event] = data.probability;
+    condition_roots.push_back(compile_conditions(id, data.required_conditions));
+    conditions_met.push_back(0);
+    instances.reserve_events(events.size());
+}
+
+void EventSystem::set_region_count(size_t count) {
+    conditions.set_region_count(count);
+}
+
+void EventSystem::set_state(const std::string& variable, size_t region, float value) {
+    if (region < conditions.get_region_count()) {
+        conditions.set_value(conditions.variable(variable), region, value);
+    }
+}
+
+// Each condition is "variable <op> number" with op one of < <= > >= == !=,
+// or a bare variable name meaning "> 0". Variable names are letters,
+// digits, '_' and '.'. An unparsable condition ("a = 5") never holds, so
+// its event stays quiet instead of firing unconditionally.
+ConditionEvaluator::NodeId EventSystem::compile_conditions(const std::string& event_id,
+                                                           const std::vector<std::string>& required) {
+    static const std::pair<const char*, ConditionEvaluator::Op> OPERATORS[] = {
+        {"<=", ConditionEvaluator::Op::LE}, {">=", ConditionEvaluator::Op::GE},
+        {"==", ConditionEvaluator::Op::EQ}, {"!=", ConditionEvaluator::Op::NE},
+        {"<", ConditionEvaluator::Op::LT}, {">", ConditionEvaluator::Op::GT},
+    };
+    auto trim = [](std::string text) {
+        text.erase(0, text.find_first_not_of(" \t"));
+        text.erase(text.find_last_not_of(" \t") + 1);
+        return text;
+    };
+
+    std::vector<ConditionEvaluator::NodeId> leaves;
+    for (const auto& condition : required) {
+        size_t split = std::string::npos;
+        ConditionEvaluator::Op op = ConditionEvaluator::Op::GT;
+        size_t op_length = 0;
+        for (const auto& [symbol, symbol_op] : OPERATORS) {
+            split = condition.find(symbol);
+            if (split != std::string::npos) {
+                op = symbol_op;
+                op_length = std::char_traits<char>::length(symbol);
+                break;
             }
         }
+
+        std::string variable = trim(condition.substr(0, split));
+        float threshold = 0.0f;
+        bool valid = !variable.empty() &&
+            std::all_of(variable.begin(), variable.end(), [](unsigned char c) {
+                return std::isalnum(c) || c == '_' || c == '.';
+            });
+        if (valid && split != std::string::npos) {
+            std::string operand = trim(condition.substr(split + op_length));
+            char* end = nullptr;
+            threshold = std::strtof(operand.c_str(), &end);
+            valid = !operand.empty() && end && *end == '\0';
+        }
+        if (!valid) {
+            godot::UtilityFunctions::push_warning("Event ", event_id.c_str(),
+                                                  " has an unparsable condition: ", condition.c_str());
+            return conditions.add_any({});
+        }
+        leaves.push_back(conditions.add_condition(variable, op, threshold));
+    }
+    return conditions.add_all(leaves);
+}
+
+void EventSystem::rebuild_conditions() {
+    conditions.clear_conditions();
+    for (size_t event = 0; event < events.size(); ++event) {
+        condition_roots[event] = compile_conditions(events[event].id, events[event].required_conditions);
+    }
+    conditions_stale = false;
+}
+
+void EventSystem::evaluate_conditions() {
+    if (conditions_stale) rebuild_conditions();
+    conditions.evaluate(condition_roots);
+    const size_t words = conditions.words_per_mask();
+    for (size_t event = 0; event < condition_roots.size(); ++event) {
+        const uint64_t* mask = conditions.mask(event);
+        uint64_t any = 0;
+        for (size_t word = 0; word < words; ++word) any |= mask[word];
+        conditions_met[event] = any != 0;
+    }
+}
+
+void EventSystem::trigger_event(const std::string& event_id) {
+    auto event = event_ids.find(event_id);
+    if (event != event_ids.end()) {
+        instances.activate(event->second, events[event->second].duration);
+    }
+}
+
+bool EventSystem::is_event_active(const std::string& event_id) const {
+    auto event = event_ids.find(event_id);
+    return event != event_ids.end() && instances.is_active(event->second);
+}
+
+// Uniform in [0, 1) from this update's seed and the event id (splitmix64)
+static float event_roll(uint64_t seed, EventInstanceManager::EventId event) {
+    uint64_t value = seed + (event + 1) * 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    value ^= value >> 31;
+    return static_cast<float>(value >> 40) * (1.0f / 16777216.0f);
+}
+
+// Active events are skipped rather than re-emitted, so an instance runs
+// for its duration and then expires; the active set is only read here,
+// since merge() applies emissions after the jobs finish
+void EventSystem::try_emit(EventInstanceManager::EventId event, size_t emitter) {
+    if (conditions_met[event] && !instances.is_active(event) &&
+        event_roll(roll_seed, event) < event_probabilities[event]) {
+        instances.emit(emitter, event, events[event].duration);
+    }
+}
+
+void EventSystem::process_event_batch_simd(size_t start_idx, size_t count, size_t emitter) {
+    size_t i = 0;
+#if defined(__AVX__)
+    const __m256 zero = _mm256_setzero_ps();
+    for (; i < count; i += 8) {
+        // Only events that can fire at all are rolled; padding lanes hold
+        // probability 0. Unaligned load: alignas on the vector member does
+        // not align its heap buffer
+        __m256 prob_vec = _mm256_loadu_ps(&event_probabilities[start_idx + i]);
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(prob_vec, zero, _CMP_GT_OQ)));
+        while (mask) {
+            size_t lane = static_cast<size_t>(__builtin_ctz(mask));
+            mask &= mask - 1;
+            if (i + lane < count) try_emit(static_cast<EventInstanceManager::EventId>(start_idx + i + lane), emitter);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        auto event = static_cast<EventInstanceManager::EventId>(start_idx + i);
+        if (event_probabilities[event] > 0.0f) try_emit(event, emitter);
     }
 }
 
 void EventSystem::update_events_parallel(float delta) {
-    const size_t event_count = event_probabilities.size();
-    
-    for (size_t i = 0; i < event_count; i += BATCH_SIZE) {
+    instances.expire(delta, [](EventInstanceManager::EventId) {});
+    evaluate_conditions();
+    roll_seed = rng();
+
+    const size_t event_count = events.size();
+    const size_t batches = (event_count + BATCH_SIZE - 1) / BATCH_SIZE;
+    instances.begin_emission(batches);
+
+    for (size_t batch = 0; batch < batches; ++batch) {
+        size_t start = batch * BATCH_SIZE;
         job_system->schedule_job(
-            [this, i]() {
-                process_event_batch_simd(i, std::min(BATCH_SIZE, event_probabilities.size() - i));
+            [this, start, event_count, batch]() {
+                process_event_batch_simd(start, std::min(BATCH_SIZE, event_count - start), batch);
             },
             JobSystem::Priority::MEDIUM
         );
     }
-    
+
     job_system->process_jobs();
-} 
\ No newline at end of file
+    instances.merge();
+}
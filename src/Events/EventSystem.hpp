@@ -4,39 +4,55 @@
 #include <vector>
 #include <unordered_map>
 #include <functional>
+#include <random>
 #include "../Core/JobSystem.hpp"
-#include "../Core/ObjectPool.hpp"
+#include "EventInstanceManager.hpp"
+#include "ConditionEvaluator.hpp"
 
 class EventSystem : public godot::Node {
     GDCLASS(EventSystem, Node)
 
 private:
+    static constexpr size_t BATCH_SIZE = 64;
+    static constexpr size_t MAX_ACTIVE_EVENTS = 4096;
+
     struct EventData {
         alignas(16) std::string id;
         alignas(16) std::string title_key;
-        float probability{0.0f};
+        float probability{0.0f};  // Chance to start per update while inactive
+        float duration{30.0f};  // Seconds an instance stays active
         std::vector<std::string> required_conditions;
         std::vector<std::function<void()>> effects;
     };
 
-    struct EventInstance {
-        const EventData* data;
-        float lifetime{0.0f};
-        bool is_active{false};
-    };
+    // Indexed by dense EventId; event_probabilities is padded with zeros
+    // to a multiple of 8 so the SIMD pass never reads past its end
+    std::vector<EventData> events;
+    std::unordered_map<std::string, EventInstanceManager::EventId> event_ids;
 
-    // Object pool for event instances to avoid allocations
-    ObjectPool<EventInstance> event_pool;
-    
     // SIMD-aligned probability data for batch processing
     alignas(32) std::vector<float> event_probabilities;
     alignas(32) std::vector<float> condition_weights;
-    
-    std::unordered_map<std::string, EventData> event_database;
-    std::vector<EventInstance*> active_events;
-    
+
+    EventInstanceManager instances{MAX_ACTIVE_EVENTS};
+
+    // required_conditions compile to one AND root per event over the
+    // per-region state columns. An event may fire while its conditions
+    // hold in at least one region; conditions_met is refreshed on the main
+    // thread before the batches run. Re-registering an event marks the
+    // trees stale and they are rebuilt once before the next evaluation,
+    // so replaced conditions do not pile up in the evaluator.
+    ConditionEvaluator conditions;
+    std::vector<ConditionEvaluator::NodeId> condition_roots;
+    std::vector<uint8_t> conditions_met;
+    bool conditions_stale{false};
+
+    // Rolls are a hash of this update's seed and the event id, so they do
+    // not depend on which job handles which batch
+    std::mt19937_64 rng;
+    uint64_t roll_seed{0};
+
     std::unique_ptr<JobSystem> job_system;
-    static constexpr size_t BATCH_SIZE = 64;
 
 protected:
     static void _bind_methods();
@@ -50,7 +66,18 @@ public:
     void trigger_event(const std::string& event_id);
     void batch_process_events();
 
+    size_t get_active_count() const { return instances.size(); }
+    bool is_event_active(const std::string& event_id) const;
+
+    // State read by required_conditions, one lane per region
+    void set_region_count(size_t count);
+    void set_state(const std::string& variable, size_t region, float value);
+
 private:
-    void process_event_batch_simd(size_t start_idx, size_t count);
-    bool check_conditions_simd(const std::vector<std::string>& conditions);
+    void process_event_batch_simd(size_t start_idx, size_t count, size_t emitter);
+    void try_emit(EventInstanceManager::EventId event, size_t emitter);
+    ConditionEvaluator::NodeId compile_conditions(const std::string& event_id,
+                                                  const std::vector<std::string>& required);
+    void rebuild_conditions();
+    void evaluate_conditions();
 }; 
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "ClimateSystem.hpp"
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
+#include "../Core/WorldSeed.hpp"
 
 using namespace godot;
 
@@ -22,7 +23,8 @@ void ClimateSystem::_bind_methods() {
     ClassDB::bind_method(D_METHOD("get_resource_concentration", "position"), &ClimateSystem::get_resource_concentration);
 }
 
-ClimateSystem::ClimateSystem() {
+ClimateSystem::ClimateSystem()
+    : rng(static_cast<uint32_t>(Core::WorldSeed::get_instance().derive("climate"))) {
     // Initialize SIMD-aligned data
     temperatures.resize(1024, 20.0f);
     pollution_levels.resize(1024, 0.0f);
@@ -33,6 +35,45 @@ ClimateSystem::ClimateSystem() {
     for (auto& row : climate_grid) {
         row.resize(32);
     }
+
+    bind_save_section("climate");
+}
+
+// Keyed by node path once in the tree, so several climates draw
+// different streams and save to different sections
+void ClimateSystem::_ready() {
+    std::string path = String(get_path()).utf8().get_data();
+    rng.seed(static_cast<std::mt19937::result_type>(Core::WorldSeed::get_instance().derive("climate", path)));
+    bind_save_section("climate:" + path);
+}
+
+void ClimateSystem::bind_save_section(const std::string& key) {
+    saved_climate.bind(key, 4,
+        [this](Core::SaveSection& section) { save_section(section); },
+        [this](Core::SaveSectionReader& section) { return load_section(section); });
+}
+
+void ClimateSystem::save_section(Core::SaveSection& section) const {
+    section.put_array(temperatures);
+    section.put_array(pollution_levels);
+    section.put_array(radiation_values);
+}
+
+bool ClimateSystem::load_section(Core::SaveSectionReader& section) {
+    std::vector<float> loaded_temperatures, loaded_pollution, loaded_radiation;
+    if (!section.get_array(loaded_temperatures) || !section.get_array(loaded_pollution) ||
+        !section.get_array(loaded_radiation)) {
+        return false;
+    }
+    // The batch update walks all three columns in lockstep
+    if (loaded_pollution.size() != loaded_temperatures.size() ||
+        loaded_radiation.size() != loaded_temperatures.size()) {
+        return false;
+    }
+    temperatures = std::move(loaded_temperatures);
+    pollution_levels = std::move(loaded_pollution);
+    radiation_values = std::move(loaded_radiation);
+    return true;
 }
 
 void ClimateSystem::update_climate(float delta) {
@@ -45,7 +86,7 @@ void ClimateSystem::simulate_resource_extraction(float delta) {
             (1.0f + site.extraction_rate / 100.0f) *
             (1.0f + site.total_extracted / 10000.0f);
         
-        if (UtilityFunctions::randf() < accident_chance) {
+        if (std::uniform_real_distribution<float>(0.0f, 1.0f)(rng) < accident_chance) {
             create_industrial_accident(site);
         }
         
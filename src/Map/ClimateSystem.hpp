@@ -2,6 +2,8 @@
 #include <godot_cpp/classes/node3d.hpp>
 #include <godot_cpp/core/class_db.hpp>
 #include "../Core/JobSystem.hpp"
+#include "../Core/SaveRegistry.hpp"
+#include <random>
 #include <unordered_map>
 
 class ClimateSystem : public godot::Node3D {
@@ -86,6 +88,8 @@ private:
     };
     
     std::vector<ExtractionSite> neofuel_sites;
+    std::mt19937 rng;
+    Core::SavedSection saved_climate;
     
     // Constants for simulation
     static constexpr float NEOFUEL_ACCIDENT_BASE_CHANCE = 0.001f;
@@ -98,6 +102,8 @@ protected:
 
 public:
     ClimateSystem();
+
+    void _ready() override;
     
     void update_climate(float delta);
     void simulate_resource_extraction(float delta);
@@ -118,6 +124,10 @@ public:
     void remove_extraction_site(const godot::Vector2& position);
     float get_resource_concentration(const godot::Vector2& position) const;
 
+    // Binary save: the SIMD columns as one "climate:<node path>" section
+    void save_section(Core::SaveSection& section) const;
+    bool load_section(Core::SaveSectionReader& section);
+
     // Original functionality restored
     void update_climate_simd(float delta_time) {
         const size_t grid_size = climate_grid.size() * climate_grid[0].size();
@@ -138,6 +148,8 @@ public:
     }
 
 private:
+    void bind_save_section(const std::string& key);
+
     void update_climate_batch_simd(size_t start_idx, size_t count, float delta_time) {
         for (size_t i = 0; i < count; i += 8) {
             __m256 temps = _mm256_load_ps(&temperatures[start_idx + i]);
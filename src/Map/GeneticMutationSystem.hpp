@@ -1,6 +1,7 @@
 #pragma once
 #include "SpeciesEvolutionSystem.hpp"
 #include <random>
+#include "../Core/WorldSeed.hpp"
 
 class GeneticMutationSystem {
 private:
@@ -18,7 +19,7 @@ private:
     static constexpr float BASE_MUTATION_RATE = 0.001f;  // 0.1% per generation
     static constexpr float STRESS_MUTATION_MULTIPLIER = 2.0f;
     
-    std::mt19937 rng{std::random_device{}()};
+    std::mt19937 rng{static_cast<std::mt19937::result_type>(Core::WorldSeed::get_instance().derive("genetic_mutation"))};
 
 public:
     void process_mutations_simd(Species* species, float environmental_stress) {
@@ -2,6 +2,7 @@
 #include "MarineEcosystemSystem.hpp"
 #include "../Core/JobSystem.hpp"
 #include <random>
+#include "../Core/WorldSeed.hpp"
 
 class SpeciesEvolutionSystem {
 private:
@@ -93,7 +94,7 @@ private:
     std::vector<Species> undiscovered_species;
     std::unordered_map<std::string, Trait> trait_database;
     
-    std::mt19937 rng{std::random_device{}()};
+    std::mt19937 rng{static_cast<std::mt19937::result_type>(Core::WorldSeed::get_instance().derive("species_evolution"))};
 
 public:
     void update_species_evolution(float delta_time, const OceanSystem& ocean) {
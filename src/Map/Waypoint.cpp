@@ -0,0 +1,86 @@
+#include "Waypoint.hpp"
+#include <algorithm>
+
+using namespace godot;
+
+// Events and resources are written in sorted order, so an unchanged
+// waypoint produces the same bytes and delta saves can skip its chunk
+void Waypoint::save_section(Core::SaveSection& section) const {
+    section.put(id);
+    section.put_string(waypoint_name);
+
+    saved_connections.clear();
+    for (const auto& connected : connected_waypoints) {
+        saved_connections.push_back(connected ? connected->get_id() : -1);
+    }
+    section.put_array(saved_connections);
+
+    saved_events.clear();
+    for (const auto& event : active_events) saved_events.push_back(&event);
+    std::sort(saved_events.begin(), saved_events.end(),
+              [](const std::string* a, const std::string* b) { return *a < *b; });
+    section.put<uint64_t>(saved_events.size());
+    for (const auto* event : saved_events) section.put_string(*event);
+
+    saved_resources.clear();
+    for (const auto& [name, data] : resources) saved_resources.emplace_back(&name, &data);
+    std::sort(saved_resources.begin(), saved_resources.end(),
+              [](const auto& a, const auto& b) { return *a.first < *b.first; });
+    section.put<uint64_t>(saved_resources.size());
+    for (const auto& [name, data] : saved_resources) {
+        section.put_string(*name);
+        section.put(data->amount);
+        section.put(data->production_rate);
+        section.put(data->consumption_rate);
+    }
+}
+
+// Connections are map topology, which map generation rebuilds from the
+// world seed; the saved ids are only checked against it
+bool Waypoint::read_section(Core::SaveSectionReader& section, SavedRecord& record) const {
+    int32_t loaded_id = 0;
+    std::vector<int32_t> connection_ids;
+    if (!section.get(loaded_id) || !section.get_string(record.name) || !section.get_array(connection_ids)) {
+        return false;
+    }
+    if (loaded_id != id || connection_ids.size() != connected_waypoints.size()) return false;
+    for (size_t i = 0; i < connection_ids.size(); ++i) {
+        const auto& connected = connected_waypoints[i];
+        if (connection_ids[i] != (connected ? connected->get_id() : -1)) return false;
+    }
+
+    uint64_t event_count = 0;
+    section.get(event_count);
+    record.events.clear();
+    std::string text;
+    for (uint64_t i = 0; i < event_count && section.ok(); ++i) {
+        if (section.get_string(text)) record.events.insert(text);
+    }
+
+    uint64_t resource_count = 0;
+    section.get(resource_count);
+    record.resources.clear();
+    for (uint64_t i = 0; i < resource_count && section.ok(); ++i) {
+        ResourceData data{};
+        section.get_string(text);
+        section.get(data.amount);
+        section.get(data.production_rate);
+        section.get(data.consumption_rate);
+        record.resources[text] = data;
+    }
+    return section.ok();
+}
+
+void Waypoint::apply_section(SavedRecord&& record) {
+    waypoint_name = std::move(record.name);
+    active_events = std::move(record.events);
+    resources = std::move(record.resources);
+}
+
+// Nothing is changed unless the whole record reads and matches
+bool Waypoint::load_section(Core::SaveSectionReader& section) {
+    SavedRecord record;
+    if (!read_section(section, record)) return false;
+    apply_section(std::move(record));
+    return true;
+}
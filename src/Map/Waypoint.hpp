@@ -7,6 +7,7 @@
 #include "TerrainFeature.hpp"
 #include "PopulationCharacteristics.hpp"
 #include "../Core/SIMDHelper.hpp"
+#include "../Core/SaveArchive.hpp"
 
 class Waypoint : public godot::Node3D {
     GDCLASS(Waypoint, Node3D)
@@ -34,6 +35,12 @@ private:
     };
     std::unordered_map<std::string, ResourceData> resources;
 
+    // save_section's sort buffers, kept so autosaves after the first
+    // allocate nothing here
+    mutable std::vector<int32_t> saved_connections;
+    mutable std::vector<const std::string*> saved_events;
+    mutable std::vector<std::pair<const std::string*, const ResourceData*>> saved_resources;
+
 protected:
     static void _bind_methods();
 
@@ -60,11 +67,28 @@ public:
     const std::string& get_name() const { return waypoint_name; }
     WaypointStats* get_stats() const { return stats.get(); }
     PopulationCharacteristics* get_population() const { return population.get(); }
+    const std::vector<std::shared_ptr<Waypoint>>& get_connected_waypoints() const { return connected_waypoints; }
     
     // Serialization
     Dictionary serialize() const;
     void deserialize(const Dictionary& data);
 
+    // Binary save: one record per waypoint in the "waypoints" section
+    // (id, name, connections, events, resources); the population goes
+    // to its own section
+    void save_section(Core::SaveSection& section) const;
+    bool load_section(Core::SaveSectionReader& section);
+
+    // A decoded record, so a caller loading many waypoints can read them
+    // all before changing any
+    struct SavedRecord {
+        std::string name;
+        std::unordered_set<std::string> events;
+        std::unordered_map<std::string, ResourceData> resources;
+    };
+    bool read_section(Core::SaveSectionReader& section, SavedRecord& record) const;
+    void apply_section(SavedRecord&& record);
+
 private:
     void update_node_logic(float delta_time);
     void check_and_trigger_events();
@@ -1,6 +1,7 @@
 #pragma once
 #include "Waypoint.hpp"
 #include <random>
+#include "../Core/WorldSeed.hpp"
 
 class WaypointEvolution {
 private:
@@ -64,8 +65,8 @@ public:
 
         // Roguelite-like trait: Random Mutations
         add_trait("Chaos Adaptation", [](Waypoint* w) {
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
+            static std::mt19937 gen(static_cast<std::mt19937::result_type>(
+                Core::WorldSeed::get_instance().derive("waypoint_evolution")));
             std::uniform_real_distribution<> dis(0.8f, 1.2f);
             
             // Random stat mutations
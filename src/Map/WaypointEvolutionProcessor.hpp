@@ -2,6 +2,7 @@
 #include "WaypointEvolution.hpp"
 #include "WaypointEvolutionTraits.hpp"
 #include "../Core/JobSystem.hpp"
+#include "../Core/WorldSeed.hpp"
 #include <unordered_set>
 
 class WaypointEvolutionProcessor {
@@ -26,6 +27,12 @@ private:
     TraitNetwork trait_network;
     std::unique_ptr<JobSystem> job_system;
 
+    // Emergence rolls are WorldSeed draws keyed by waypoint, pattern and
+    // how many times that waypoint has been processed, so they replay
+    // whatever order the waypoints are processed in
+    uint64_t emergence_stream{Core::WorldSeed::get_instance().derive("waypoint_emergence")};
+    std::unordered_map<int32_t, uint64_t> processed_steps;
+
 public:
     void initialize_emergence_patterns() {
         // Cultural-Economic Patterns
@@ -67,6 +74,7 @@ public:
 
     void process_emergent_behaviors_simd(Waypoint* waypoint, float delta_time) {
         const size_t pattern_count = trait_network.potential_patterns.size();
+        const uint64_t step = processed_steps[waypoint->get_id()]++;
         
         // Load environmental and social factors
         __m256 environment = _mm256_set1_ps(waypoint->get_stats()->get_stat("EnvironmentalHealth"));
@@ -93,23 +101,23 @@ public:
             // Trigger emergent behaviors
             for (size_t j = 0; j < 8 && i + j < pattern_count; ++j) {
                 if (results[j] != 0) {
-                    trigger_emergence(waypoint, i + j);
+                    trigger_emergence(waypoint, i + j, step);
                 }
             }
         }
     }
 
 private:
-    void trigger_emergence(Waypoint* waypoint, size_t pattern_index) {
+    void trigger_emergence(Waypoint* waypoint, size_t pattern_index, uint64_t step) {
         const auto& pattern = trait_network.potential_patterns[pattern_index];
         
         // Verify trait requirements
         if (verify_trait_combination(waypoint, pattern.required_traits)) {
             // Roll for emergence chance
-            static thread_local std::mt19937 gen{std::random_device{}()};
-            std::uniform_real_distribution<float> dis(0.0f, 1.0f);
+            uint64_t entity = (uint64_t(uint32_t(waypoint->get_id())) << 32) | pattern_index;
+            float roll = Core::WorldSeed::unit(Core::WorldSeed::draw(emergence_stream, entity, step));
             
-            if (dis(gen) < pattern.emergence_chance) {
+            if (roll < pattern.emergence_chance) {
                 pattern.emergence_effect(waypoint);
                 propagate_emergence_effects(waypoint);
             }
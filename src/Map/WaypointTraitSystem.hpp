@@ -1,7 +1,7 @@
 #pragma once
 #include "WaypointEvolutionProcessor.hpp"
+#include "../Core/WorldSeed.hpp"
 #include <unordered_set>
-#include <random>
 
 class WaypointTraitSystem {
 private:
@@ -30,6 +30,12 @@ private:
     std::unordered_map<std::string, std::unordered_map<std::string, TraitInteraction>> trait_interactions;
     std::unordered_map<std::string, TraitCategory::Type> trait_categories;
 
+    // Interaction rolls are WorldSeed draws keyed by waypoint, roll index
+    // and how many times that waypoint has evolved, so they replay
+    // whatever order the waypoints evolve in
+    uint64_t interaction_stream{Core::WorldSeed::get_instance().derive("waypoint_traits")};
+    std::unordered_map<int32_t, uint64_t> evolution_steps;
+
 public:
     void initialize_trait_system() {
         // Cultural Traits
@@ -110,6 +116,8 @@ public:
 
     void process_trait_evolution(Waypoint* waypoint, float delta_time) {
         const size_t trait_count = trait_strengths.size();
+        const uint64_t step = evolution_steps[waypoint->get_id()]++;
+        uint32_t rolls = 0;
         
         // Load environmental and social factors using SIMD
         __m256 environment = _mm256_set1_ps(waypoint->get_stat("EnvironmentalHealth"));
@@ -132,12 +140,12 @@ public:
             _mm256_store_ps(&trait_strengths[i], strengths);
             
             // Check for trait interactions
-            check_trait_interactions(waypoint, i);
+            check_trait_interactions(waypoint, i, step, rolls);
         }
     }
 
 private:
-    void check_trait_interactions(Waypoint* waypoint, size_t trait_index) {
+    void check_trait_interactions(Waypoint* waypoint, size_t trait_index, uint64_t step, uint32_t& rolls) {
         // Check for potential trait combinations
         const auto& active_traits = waypoint->get_active_traits();
         
@@ -149,10 +157,10 @@ private:
                         auto interaction_it = it->second.find(trait2);
                         if (interaction_it != it->second.end()) {
                             // Roll for interaction
-                            static thread_local std::mt19937 gen{std::random_device{}()};
-                            std::uniform_real_distribution<float> dis(0.0f, 1.0f);
+                            uint64_t entity = (uint64_t(uint32_t(waypoint->get_id())) << 32) | rolls++;
+                            float roll = Core::WorldSeed::unit(Core::WorldSeed::draw(interaction_stream, entity, step));
                             
-                            if (dis(gen) < interaction_it->second.mutation_chance) {
+                            if (roll < interaction_it->second.mutation_chance) {
                                 interaction_it->second.interaction_effect(waypoint);
                             }
                         }
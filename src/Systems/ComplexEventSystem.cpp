@@ -6,22 +6,76 @@
 #include <Json.hpp>
 #include <GodotGlobal.hpp>
 #include "EventManager.h"
+#include "../Core/WorldSeed.hpp"
+#include <algorithm>
 
 namespace Systems {
 
 using namespace godot;
 
+namespace {
+
+// State compiled conditions may read: the economy's prosperity, and the
+// mean of a node stat over every node. STATE_MEANS names the simulation's
+// mean for the rows the node simulation owns.
+const char *const STATE_VARIABLES[] = {
+    "economic_prosperity",
+    "population_density",
+    "resource_availability",
+    "cultural_development",
+    "environmental_health",
+    "medical_resources",
+    "health_risk",
+    "technological_level",
+};
+
+float NodeStats::*const STATE_FIELDS[] = {
+    nullptr,
+    &NodeStats::population_density,
+    &NodeStats::resource_availability,
+    &NodeStats::cultural_development,
+    &NodeStats::environmental_health,
+    &NodeStats::medical_resources,
+    &NodeStats::health_risk,
+    &NodeStats::technological_level,
+};
+
+float NodeStatMeans::*const STATE_MEANS[] = {
+    nullptr,
+    &NodeStatMeans::population_density,
+    &NodeStatMeans::resource_availability,
+    nullptr,
+    &NodeStatMeans::environmental_health,
+    &NodeStatMeans::medical_resources,
+    &NodeStatMeans::health_risk,
+    &NodeStatMeans::technological_level,
+};
+
+constexpr uint32_t STATE_COUNT = sizeof(STATE_VARIABLES) / sizeof(STATE_VARIABLES[0]);
+
+uint32_t state_row(const std::string &name) {
+    for (uint32_t row = 0; row < STATE_COUNT; ++row) {
+        if (name == STATE_VARIABLES[row]) return row;
+    }
+    return STATE_COUNT;
+}
+
+} // namespace
+
 void ComplexEventSystem::_register_methods() {
     register_method("_process", &ComplexEventSystem::update_system);
+    register_method("load_events", &ComplexEventSystem::load_events);
+    register_method("set_state", &ComplexEventSystem::set_state);
     register_signal<ComplexEventSystem>("event_triggered", "game_event", GODOT_VARIANT_TYPE_OBJECT);
 }
 
 ComplexEventSystem::ComplexEventSystem() {
     rnd = godot::RandomNumberGenerator::_new();
+    rnd->set_seed(Core::WorldSeed::get_instance().derive("complex_events"));
 }
 
 ComplexEventSystem::~ComplexEventSystem() {
-    // Cleanup if needed
+    if (simulation) simulation->set_means_handler(nullptr);
 }
 
 void ComplexEventSystem::_init() {
@@ -40,13 +94,27 @@ void ComplexEventSystem::load_events(const godot::String &file_path) {
         if (result.error == godot::JSONParseResult::Error::OK) {
             godot::Dictionary event_data = result.result;
             godot::Array events = event_data["events"];
+            clear_events();
 
             for(int i = 0; i < events.size(); i++) {
                 godot::Dictionary evt = events[i];
                 ComplexGameEvent *game_event = ComplexGameEvent::_new();
                 game_event->from_dictionary(evt);
                 all_events.append(game_event);
+
+                godot::Dictionary conditions = evt.has("conditions") ? godot::Dictionary(evt["conditions"]) : godot::Dictionary();
+                PredicateProgram program = compile_conditions(conditions);
+                EventEntry entry{game_event, EventEligibility::INVALID_EVENT};
+                if (program.compiled) {
+                    float weight = evt.has("weight") ? float(evt["weight"]) : 1.0f;
+                    entry.slot = eligibility.add_event(program, weight);
+                    indexed_events.push_back(game_event);
+                } else {
+                    dynamic_events.push_back(game_event);
+                }
+                events_by_id[game_event->get_id().utf8().get_data()] = entry;
             }
+            refresh_state();
             Godot::print("Events loaded successfully.");
         } else {
             Godot::print_err("Error parsing event definitions: " + result.error_string);
@@ -56,6 +124,33 @@ void ComplexEventSystem::load_events(const godot::String &file_path) {
     }
 }
 
+// Drops the loaded events and their compiled conditions; pushed state
+// values stay
+void ComplexEventSystem::clear_events() {
+    all_events.clear();
+    eligibility.clear();
+    state_sources.clear();
+    indexed_events.clear();
+    dynamic_events.clear();
+    events_by_id.clear();
+}
+
+void ComplexEventSystem::attach_simulation(NodeSimulationSystem *node_simulation) {
+    if (simulation) simulation->set_means_handler(nullptr);
+    simulation = node_simulation;
+    if (!simulation) return;
+    simulation->set_means_handler([this](const NodeStatMeans &means) {
+        for (uint32_t row = 0; row < STATE_COUNT; ++row) {
+            if (STATE_MEANS[row]) push_state(row, means.*STATE_MEANS[row]);
+        }
+    });
+}
+
+void ComplexEventSystem::set_state(godot::String name, float value) {
+    uint32_t row = state_row(name.utf8().get_data());
+    if (row < STATE_COUNT) push_state(row, value);
+}
+
 void ComplexEventSystem::update_system(float delta_time) {
     if (should_trigger_event()) {
         ComplexGameEvent *new_event = select_random_eligible_event();
@@ -67,26 +162,115 @@ void ComplexEventSystem::update_system(float delta_time) {
     // Update active events if needed
 }
 
+// Keys name a stat from the state table, compared with an expression such
+// as ">= 40" or a bare value. Anything else (time phase, weather, custom
+// evaluators) leaves the event on the conditions_is_met path.
+PredicateProgram ComplexEventSystem::compile_conditions(const godot::Dictionary &conditions) {
+    PredicateProgram program;
+    godot::Array keys = conditions.keys();
+    for (int i = 0; i < keys.size(); i++) {
+        godot::String key = keys[i];
+        godot::Variant value = conditions[key];
+        std::string name = key.utf8().get_data();
+
+        uint32_t row = state_row(name);
+        if (row == STATE_COUNT) {
+            program.compiled = false;
+            continue;
+        }
+        uint32_t variable = eligibility.variable(name);
+        if (std::find(state_sources.begin(), state_sources.end(), std::make_pair(variable, row)) == state_sources.end()) {
+            state_sources.emplace_back(variable, row);
+        }
+
+        if (value.get_type() == godot::Variant::REAL || value.get_type() == godot::Variant::INT) {
+            eligibility.add_clause(program, name, PredicateOp::GE, float(value));
+            continue;
+        }
+
+        // Density levels ("high", ...) are words, so they stay with
+        // EventCondition on the conditions_is_met path
+        godot::String text = value;
+        if (!eligibility.add_condition(program, name, text.utf8().get_data(), false)) {
+            Godot::print_err("Event condition not compiled, checking it at runtime: " + key + " = " + text);
+        }
+    }
+    return program;
+}
+
+// Reads every variable a compiled condition uses, once when events load;
+// the owners push changes after that
+void ComplexEventSystem::refresh_state() {
+    for (const auto &[variable, row] : state_sources) {
+        eligibility.set_value(variable, read_state(row));
+    }
+}
+
+// Unchanged values cost one comparison in the index
+void ComplexEventSystem::push_state(uint32_t row, float value) {
+    for (const auto &[variable, source] : state_sources) {
+        if (source == row) eligibility.set_value(variable, value);
+    }
+}
+
+float ComplexEventSystem::read_state(uint32_t row) const {
+    if (STATE_FIELDS[row] == nullptr) {
+        return game_manager->get_economy_system()->get_economic_prosperity();
+    }
+    if (simulation && STATE_MEANS[row]) {
+        return simulation->get_stat_means().*STATE_MEANS[row];
+    }
+    int count = game_manager->nodes.size();
+    if (count == 0) {
+        return 0.0f;
+    }
+    float sum = 0.0f;
+    for (int i = 0; i < count; i++) {
+        sum += game_manager->nodes[i]->get_stats()->*STATE_FIELDS[row];
+    }
+    return sum / count;
+}
+
 bool ComplexEventSystem::should_trigger_event() {
     float chance = rnd->randf();
     return chance < 0.01f; // 1% chance each update
 }
 
+// Indexed events come from the maintained eligible set; only events whose
+// conditions could not be compiled are tested here, each with weight 1
 ComplexGameEvent* ComplexEventSystem::select_random_eligible_event() {
-    godot::Array eligible_events;
-    for(int i = 0; i < all_events.size(); i++) {
-        ComplexGameEvent *game_event = Object::cast_to<ComplexGameEvent>(all_events[i]);
-        if(game_event && game_event->conditions_is_met(game_manager)) {
-            eligible_events.append(game_event);
+    std::vector<ComplexGameEvent*> eligible_dynamic;
+    for (auto *game_event : dynamic_events) {
+        if (game_event->conditions_is_met(game_manager)) {
+            eligible_dynamic.push_back(game_event);
         }
     }
 
-    if(eligible_events.size() > 0) {
-        int index = rnd->randi_range(0, eligible_events.size() - 1);
-        return Object::cast_to<ComplexGameEvent>(eligible_events[index]);
+    double indexed_weight = eligibility.eligible_weight();
+    double total = indexed_weight + static_cast<double>(eligible_dynamic.size());
+    if (total <= 0.0) {
+        return nullptr;
     }
 
-    return nullptr;
+    double target = rnd->randf() * total;
+    if (target < indexed_weight) {
+        EventEligibility::EventId event = eligibility.sample([this]() { return rnd->randf(); });
+        if (event != EventEligibility::INVALID_EVENT) {
+            return indexed_events[event];
+        }
+    }
+    if (eligible_dynamic.empty()) {
+        return nullptr;
+    }
+    size_t index = std::min(static_cast<size_t>(target - indexed_weight), eligible_dynamic.size() - 1);
+    return eligible_dynamic[index];
+}
+
+bool ComplexEventSystem::is_eligible(const EventEntry &entry) {
+    if (entry.slot != EventEligibility::INVALID_EVENT) {
+        return eligibility.is_eligible(entry.slot);
+    }
+    return entry.event->conditions_is_met(game_manager);
 }
 
 void ComplexEventSystem::trigger_event(ComplexGameEvent *game_event) {
@@ -116,16 +300,9 @@ void ComplexEventSystem::handle_player_choice(ComplexGameEvent *game_event, Play
     godot::Array next_event_ids = choice->get_outcome()->get_trigger_next_events();
     for(int i = 0; i < next_event_ids.size(); i++) {
         godot::String next_event_id = next_event_ids[i];
-        ComplexGameEvent *next_event = nullptr;
-        for(int j = 0; j < all_events.size(); j++) {
-            ComplexGameEvent *evt = Object::cast_to<ComplexGameEvent>(all_events[j]);
-            if(evt && evt->get_id() == next_event_id && evt->conditions_is_met(game_manager)) {
-                next_event = evt;
-                break;
-            }
-        }
-        if(next_event) {
-            trigger_event(next_event);
+        auto it = events_by_id.find(next_event_id.utf8().get_data());
+        if(it != events_by_id.end() && is_eligible(it->second)) {
+            trigger_event(it->second.event);
         }
     }
 
@@ -133,28 +310,57 @@ void ComplexEventSystem::handle_player_choice(ComplexGameEvent *game_event, Play
     Godot::print("Player chose: " + choice->get_choice_text());
 }
 
+// Effects that touch every node already visit every node, so they push
+// the new mean from the same loop. Stats the simulation holds go to its
+// columns.
 void ComplexEventSystem::apply_effect(const godot::String &stat_name, float value) {
     godot::String stat = stat_name.to_lower();
     if(stat == "morale") {
-        for(int i = 0; i < game_manager->nodes.size(); i++) {
-            NodeStats *stats = game_manager->nodes[i]->get_stats();
-            stats->economic_prosperity = Math::clamp(stats->economic_prosperity + value, 0.0f, 100.0f);
+        if (simulation) {
+            NodeStatColumns &columns = simulation->get_stats();
+            for (size_t i = 0; i < columns.size(); i++) {
+                columns.modify(&NodeStatColumns::economic_prosperity, i, value);
+            }
+        } else {
+            for(int i = 0; i < game_manager->nodes.size(); i++) {
+                NodeStats *stats = game_manager->nodes[i]->get_stats();
+                stats->economic_prosperity = Math::clamp(stats->economic_prosperity + value, 0.0f, 100.0f);
+            }
         }
     }
     else if(stat == "resourceavailability") {
-        for(int i = 0; i < game_manager->nodes.size(); i++) {
-            NodeStats *stats = game_manager->nodes[i]->get_stats();
-            stats->resource_availability = Math::clamp(stats->resource_availability + value, 0.0f, 100.0f);
+        float sum = 0.0f;
+        size_t count = 0;
+        if (simulation) {
+            NodeStatColumns &columns = simulation->get_stats();
+            count = columns.size();
+            for (size_t i = 0; i < count; i++) {
+                columns.modify(&NodeStatColumns::resource_availability, i, value);
+                sum += columns.resource_availability[i];
+            }
+        } else {
+            count = game_manager->nodes.size();
+            for(int i = 0; i < game_manager->nodes.size(); i++) {
+                NodeStats *stats = game_manager->nodes[i]->get_stats();
+                stats->resource_availability = Math::clamp(stats->resource_availability + value, 0.0f, 100.0f);
+                sum += stats->resource_availability;
+            }
         }
+        push_state(state_row("resource_availability"), count ? sum / count : 0.0f);
     }
     else if(stat == "economicprosperity") {
         game_manager->get_economy_system()->set_economic_prosperity(game_manager->get_economy_system()->get_economic_prosperity() + value);
+        push_state(state_row("economic_prosperity"), game_manager->get_economy_system()->get_economic_prosperity());
     }
     else if(stat == "culturaldevelopment") {
+        float sum = 0.0f;
         for(int i = 0; i < game_manager->nodes.size(); i++) {
             NodeStats *stats = game_manager->nodes[i]->get_stats();
             stats->cultural_development = Math::clamp(stats->cultural_development + value, 0.0f, 100.0f);
+            sum += stats->cultural_development;
         }
+        int count = game_manager->nodes.size();
+        push_state(state_row("cultural_development"), count ? sum / count : 0.0f);
     }
     else {
         Godot::print_err("Unknown effect stat: " + stat_name);
@@ -9,6 +9,12 @@
 #include "GameManager.h"
 #include "NameDatabase.h"
 #include "LocalizationManager.h"
+#include "EventEligibility.hpp"
+#include "NodeSimulationSystem.hpp"
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace Systems {
 
@@ -23,6 +29,32 @@ private:
     NameDatabase *name_database;
     LocalizationManager *localization_manager;
 
+    // Events with compiled conditions live in the eligibility index,
+    // slot for slot with indexed_events; the rest are checked with
+    // conditions_is_met when an event is selected. Only conditions on
+    // the state table are compiled. Its values are read once when events
+    // load; after that the owners push them as they change: the attached
+    // simulation its column means each tick, apply_effect what it
+    // changes, and anything else through set_state.
+    EventEligibility eligibility;
+    NodeSimulationSystem *simulation{nullptr};
+    // (eligibility variable, row in the readable state table)
+    std::vector<std::pair<uint32_t, uint32_t>> state_sources;
+    std::vector<ComplexGameEvent*> indexed_events;
+    std::vector<ComplexGameEvent*> dynamic_events;
+    struct EventEntry {
+        ComplexGameEvent *event;
+        EventEligibility::EventId slot;  // INVALID_EVENT for dynamic events
+    };
+    std::unordered_map<std::string, EventEntry> events_by_id;
+
+    PredicateProgram compile_conditions(const godot::Dictionary &conditions);
+    bool is_eligible(const EventEntry &entry);
+    void refresh_state();
+    float read_state(uint32_t row) const;
+    void push_state(uint32_t row, float value);
+    void clear_events();
+
 public:
     static void _register_methods();
 
@@ -31,7 +63,11 @@ public:
 
     void _init(); // Called by Godot
 
+    // Replaces every loaded event
     void load_events(const godot::String &file_path);
+    void attach_simulation(NodeSimulationSystem *node_simulation);
+    // Pushes a state table value ("health_risk", ...); unknown names are ignored
+    void set_state(godot::String name, float value);
     void update_system(float delta_time);
     bool should_trigger_event();
     ComplexGameEvent* select_random_eligible_event();
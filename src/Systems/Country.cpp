@@ -11,11 +11,16 @@ using namespace godot;
 
 void Country::_register_methods() {
     register_method("initialize_elections", &Country::initialize_elections);
-    register_method("handle_elections", &Country::handle_elections);
+    register_method("get_time_until_election", &Country::get_time_until_election);
 }
 
 Country::Country() {}
-Country::~Country() {}
+Country::~Country() {
+    auto& scheduler = Core::GameScheduler::get_instance();
+    for (auto timer : election_timers) {
+        scheduler.cancel(timer);
+    }
+}
 
 void Country::_init() {
     // Initialization if needed
@@ -44,37 +49,35 @@ void Country::initialize_elections() {
 
     national_elections.append(presidential_election);
 
-    // Initialize regional elections
-    for(int i = 0; i < regions.size(); i++) {
-        Region *region = Object::cast_to<Region>(regions[i]);
-        if(region) {
-            region->initialize_elections();
-        }
-    }
-}
-
-void Country::handle_elections() {
-    for(int i = 0; i < national_elections.size(); i++) {
+    auto& scheduler = Core::GameScheduler::get_instance();
+    for(int i = static_cast<int>(election_timers.size()); i < national_elections.size(); i++) {
         Election *election = Object::cast_to<Election>(national_elections[i]);
         if(election) {
-            if(election->get_next_election_time() <= 0.0f) {
-                conduct_election(i);
-                election->set_next_election_time(election->get_frequency_in_years() * 3600.0f); // Set next election time
-            } else {
-                election->set_next_election_time(election->get_next_election_time() - 3600.0f); // Advance time
-            }
+            election_timers.push_back(scheduler.schedule_every(
+                election->get_frequency_in_years() * 3600.0,
+                [this, i]() { conduct_election(i); },
+                election->get_next_election_time()));
+        } else {
+            election_timers.push_back(Core::GameScheduler::INVALID_TIMER);
         }
     }
 
-    // Handle regional elections
+    // Initialize regional elections; each region schedules its own
     for(int i = 0; i < regions.size(); i++) {
         Region *region = Object::cast_to<Region>(regions[i]);
         if(region) {
-            region->handle_elections();
+            region->initialize_elections();
         }
     }
 }
 
+double Country::get_time_until_election(int election_index) const {
+    if(election_index < 0 || election_index >= static_cast<int>(election_timers.size())) {
+        return -1.0;
+    }
+    return Core::GameScheduler::get_instance().time_until(election_timers[election_index]);
+}
+
 void Country::conduct_election(int election_index) {
     Election *election = Object::cast_to<Election>(national_elections[election_index]);
     if(election) {
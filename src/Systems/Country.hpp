@@ -9,6 +9,8 @@
 
 #include "Region.h"
 #include "Election.h"
+#include "../Core/GameScheduler.hpp"
+#include <vector>
 
 namespace Systems {
 
@@ -19,6 +21,7 @@ private:
     godot::String name;
     godot::Array regions; // Array of Region instances
     godot::Array national_elections; // Array of Election instances
+    std::vector<Core::GameScheduler::TimerId> election_timers; // One per national election
 
 public:
     static void _register_methods();
@@ -29,8 +32,9 @@ public:
     void _init(); // Called by Godot
 
     void initialize_regions();
+    // National and regional elections run from GameScheduler deadlines
     void initialize_elections();
-    void handle_elections();
+    double get_time_until_election(int election_index) const;
     void conduct_election(int election_index);
     godot::Array load_candidates(const godot::String &type);
 };
@@ -1,4 +1,5 @@
 #include "DynamicEffectsSystem.hpp"
+#include "../Core/WorldSeed.hpp"
 #include <Math.hpp>
 #include <algorithm>
 
@@ -8,13 +9,14 @@ using namespace godot;
 
 void DynamicEffectsSystem::_register_methods() {
     register_method("update", &DynamicEffectsSystem::update);
-    register_method("add_effect", &DynamicEffectsSystem::add_effect);
+    register_method("add_effect", &DynamicEffectsSystem::add_stat_effect);
     register_method("remove_effect", &DynamicEffectsSystem::remove_effect);
+    register_method("has_effect", &DynamicEffectsSystem::has_effect);
 }
 
 DynamicEffectsSystem::DynamicEffectsSystem() {
     rng.instance();
-    rng->randomize();
+    rng->set_seed(Core::WorldSeed::get_instance().derive("dynamic_effects"));
 }
 
 DynamicEffectsSystem::~DynamicEffectsSystem() {}
@@ -30,53 +32,89 @@ void DynamicEffectsSystem::update(float delta_time) {
     check_emergent_effects(delta_time);
 }
 
-void DynamicEffectsSystem::add_effect(const String& name, float duration, float intensity,
-                                    std::function<void(float, float)> effect) {
-    DynamicEffect new_effect{name, duration, intensity, effect};
-    active_effects.push_back(new_effect);
+bool DynamicEffectsSystem::add_effect(const String& name, float duration, float intensity,
+                                      const std::vector<EffectTerm>& terms, EffectCurve curve) {
+    std::string key = name.utf8().get_data();
+    if (!active_effects.add(key, duration, intensity, terms, curve)) return false;
+    effect_expiries[key] = effect_timers.schedule_in(duration, [this, key]() {
+        effect_expiries.erase(key);
+        active_effects.remove(key);
+    });
+    return true;
+}
+
+bool DynamicEffectsSystem::add_stat_effect(const String& name, float duration, float intensity,
+                                           int stat, float rate) {
+    if (stat < 0 || stat >= static_cast<int>(EffectStat::COUNT)) return false;
+    return add_effect(name, duration, intensity, {{static_cast<EffectStat>(stat), rate}});
 }
 
 void DynamicEffectsSystem::remove_effect(const String& name) {
-    active_effects.erase(
-        std::remove_if(active_effects.begin(), active_effects.end(),
-            [&name](const DynamicEffect& effect) { return effect.name == name; }),
-        active_effects.end()
-    );
+    std::string key = name.utf8().get_data();
+    auto expiry = effect_expiries.find(key);
+    if (expiry != effect_expiries.end()) {
+        effect_timers.cancel(expiry->second);
+        effect_expiries.erase(expiry);
+    }
+    active_effects.remove(key);
+}
+
+bool DynamicEffectsSystem::has_effect(const String& name) const {
+    return active_effects.is_active(name.utf8().get_data());
 }
 
+// One kernel pass over every effect row, then one GameState write per
+// stat; expiry happens on the scheduler, not here
 void DynamicEffectsSystem::update_active_effects(float delta_time) {
-    for (auto it = active_effects.begin(); it != active_effects.end();) {
-        it->duration -= delta_time;
-        if (it->duration <= 0) {
-            it = active_effects.erase(it);
-        } else {
-            it->apply_effect(delta_time, it->intensity);
-            ++it;
-        }
+    EffectStore::StatDeltas deltas{};
+    active_effects.step(delta_time, deltas);
+    for (size_t stat = 0; stat < deltas.size(); ++stat) {
+        if (deltas[stat] != 0.0f) apply_stat_delta(static_cast<EffectStat>(stat), deltas[stat]);
+    }
+}
+
+void DynamicEffectsSystem::apply_stat_delta(EffectStat stat, float delta) {
+    auto* game_state = GameState::get_instance();
+    switch (stat) {
+        case EffectStat::PUBLIC_HEALTH:
+            game_state->modify_public_health(delta);
+            break;
+        case EffectStat::ECONOMIC_PRODUCTIVITY:
+            game_state->modify_economic_productivity(delta);
+            break;
+        case EffectStat::PUBLIC_WELFARE:
+            game_state->modify_public_welfare(delta);
+            break;
+        case EffectStat::WEALTH_INEQUALITY:
+            game_state->modify_wealth_inequality(delta);
+            break;
+        case EffectStat::TOURISM_REVENUE:
+            game_state->modify_tourism_revenue(delta);
+            break;
+        default:
+            break;
     }
 }
 
 void DynamicEffectsSystem::check_emergent_effects(float delta_time) {
     auto* game_state = GameState::get_instance();
     
-    // Check for environmental crisis
+    // Check for environmental crisis; re-adding an active key is a no-op
     if (game_state->get_air_pollution() > 75.0f && 
         game_state->get_public_health() < 40.0f) {
-        add_effect("environmental_crisis", 300.0f, 1.5f,
-            [](float dt, float intensity) {
-                GameState::get_instance()->modify_public_health(-0.2f * intensity * dt);
-                GameState::get_instance()->modify_economic_productivity(-0.15f * intensity * dt);
-            });
+        add_effect("environmental_crisis", 300.0f, 1.5f, {
+            {EffectStat::PUBLIC_HEALTH, -0.2f},
+            {EffectStat::ECONOMIC_PRODUCTIVITY, -0.15f}
+        });
     }
 
     // Check for economic boom
     if (game_state->get_economic_productivity() > 80.0f && 
         game_state->get_public_research_progress() > 70.0f) {
-        add_effect("economic_boom", 200.0f, 1.2f,
-            [](float dt, float intensity) {
-                GameState::get_instance()->modify_economic_productivity(0.1f * intensity * dt);
-                GameState::get_instance()->modify_public_welfare(0.05f * intensity * dt);
-            });
+        add_effect("economic_boom", 200.0f, 1.2f, {
+            {EffectStat::ECONOMIC_PRODUCTIVITY, 0.1f},
+            {EffectStat::PUBLIC_WELFARE, 0.05f}
+        });
     }
 }
 
@@ -4,9 +4,12 @@
 #include <Godot.hpp>
 #include <Node.hpp>
 #include "ISystem.hpp"
+#include "EffectStore.hpp"
 #include "../Core/GameState.hpp"
+#include "../Core/GameScheduler.hpp"
+#include <string>
+#include <unordered_map>
 #include <vector>
-#include <functional>
 
 namespace Systems {
 
@@ -14,14 +17,10 @@ class DynamicEffectsSystem : public godot::Node, public ISystem {
     GODOT_CLASS(DynamicEffectsSystem, godot::Node)
 
 private:
-    struct DynamicEffect {
-        godot::String name;
-        float duration;
-        float intensity;
-        std::function<void(float, float)> apply_effect;
-    };
-
-    std::vector<DynamicEffect> active_effects;
+    EffectStore active_effects;
+    // Effect durations run on the shared GameScheduler
+    Core::ScheduledTimers effect_timers;
+    std::unordered_map<std::string, Core::ScheduledTimers::Handle> effect_expiries;
     godot::Ref<godot::RandomNumberGenerator> rng;
 
 public:
@@ -33,9 +32,15 @@ public:
     void _init();
     void update(float delta_time) override;
 
-    void add_effect(const godot::String& name, float duration, float intensity, 
-                   std::function<void(float, float)> effect);
+    // Returns false if an effect with this name is already active
+    bool add_effect(const godot::String& name, float duration, float intensity,
+                    const std::vector<EffectTerm>& terms,
+                    EffectCurve curve = EffectCurve::CONSTANT);
+    // Single-stat form for scripts; stat is an EffectStat value
+    bool add_stat_effect(const godot::String& name, float duration, float intensity,
+                         int stat, float rate);
     void remove_effect(const godot::String& name);
+    bool has_effect(const godot::String& name) const;
 
 private:
     void update_traffic_effects(float delta_time);
@@ -43,6 +48,7 @@ private:
     void update_economy_effects(float delta_time);
     void update_research_effects(float delta_time);
     void update_active_effects(float delta_time);
+    void apply_stat_delta(EffectStat stat, float delta);
     void check_emergent_effects(float delta_time);
 };
 
@@ -1,5 +1,7 @@
 #include "EconomySystem.hpp"
 #include "../Events/EventManager.hpp"
+#include "../Core/WorldSeed.hpp"
+#include <algorithm>
 #include <cmath>
 
 namespace Systems {
@@ -8,6 +10,7 @@ using namespace godot;
 
 void EconomySystem::_register_methods() {
     register_method("_init", &EconomySystem::_init);
+    register_method("_ready", &EconomySystem::_ready);
     register_method("update", &EconomySystem::update);
 }
 
@@ -16,14 +19,36 @@ EconomySystem::~EconomySystem() {}
 
 void EconomySystem::_init() {
     rng.instance();
-    rng->randomize();
+    rng->set_seed(Core::WorldSeed::get_instance().derive("economy"));
+}
+
+// Keyed by node path once in the tree, so several economies draw
+// different streams
+void EconomySystem::_ready() {
+    rng->set_seed(Core::WorldSeed::get_instance().derive("economy", String(get_path()).utf8().get_data()));
 }
 
 void EconomySystem::set_nodes(const std::vector<Node*>& node_list) {
-    nodes = node_list;
+    if (simulation) {
+        simulation->set_nodes(node_list);
+    } else {
+        nodes = node_list;
+    }
+}
+
+void EconomySystem::attach_simulation(NodeSimulationSystem* node_simulation) {
+    simulation = node_simulation;
+    if (simulation) {
+        // Nodes set before attaching move over to the simulation
+        if (!nodes.empty()) simulation->set_nodes(nodes);
+        nodes.clear();
+        simulation->set_event_handler(NodeEventKind::ECONOMIC_BOOM,
+            [this](size_t node_index) { trigger_economic_event(node_index); });
+    }
 }
 
 void EconomySystem::update(float delta_time) {
+    if (simulation) return;  // Rules run in NodeSimulationSystem's fused kernel
     for (auto* node : nodes) {
         update_economy(node, delta_time);
     }
@@ -63,4 +88,25 @@ void EconomySystem::trigger_economic_event(Node* node) {
     EventManager::get_instance()->trigger_event(market_boom);
 }
 
+// Kernel events carry a column index; the effect changes the columns,
+// which are authoritative while attached
+void EconomySystem::trigger_economic_event(size_t node_index) {
+    if (!simulation || node_index >= simulation->get_stats().size()) return;
+
+    GameEvent* market_boom = GameEvent::_new();
+    market_boom->set_name("Market Boom");
+
+    NodeSimulationSystem* columns = simulation;
+    Node* node = simulation->get_node_at(node_index);
+    String where = node ? node->get_name() : String::num_int64(static_cast<int64_t>(node_index));
+    market_boom->set_effect([columns, node_index, where]() {
+        columns->get_stats().modify(&NodeStatColumns::economic_prosperity, node_index, 20.0f);
+        columns->get_stats().modify(&NodeStatColumns::resource_availability, node_index, 10.0f);
+        Godot::print(String("Market Boom in {0}! Economic Prosperity and Resources increased.")
+            .format(Array::make(where)));
+    });
+
+    EventManager::get_instance()->trigger_event(market_boom);
+}
+
 } // namespace Systems 
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "ISystem.hpp"
 #include "../Models/Node.hpp"
 #include "../Events/GameEvent.hpp"
+#include "NodeSimulationSystem.hpp"
 
 namespace Systems {
 
@@ -15,8 +16,12 @@ class EconomySystem : public godot::Node, public ISystem {
     GODOT_CLASS(EconomySystem, godot::Node)
 
 private:
+    // Only used unattached; an attached simulation holds the node list
     std::vector<Node*> nodes;
     godot::Ref<godot::RandomNumberGenerator> rng;
+    // When attached, per-node rules run in the fused kernel on the
+    // simulation's stat columns
+    NodeSimulationSystem* simulation{nullptr};
 
 public:
     static void _register_methods();
@@ -25,12 +30,15 @@ public:
     ~EconomySystem();
 
     void _init();
+    void _ready();
     void set_nodes(const std::vector<Node*>& node_list);
+    void attach_simulation(NodeSimulationSystem* node_simulation);
     void update(float delta_time) override;
 
 private:
     void update_economy(Node* node, float delta_time);
     void trigger_economic_event(Node* node);
+    void trigger_economic_event(size_t node_index);
 };
 
 } // namespace Systems
@@ -0,0 +1,180 @@
+#ifndef EFFECTSTORE_HPP
+#define EFFECTSTORE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <immintrin.h>
+#include "../AI/Core/StringInterner.hpp"
+
+namespace Systems {
+
+// Game stats a timed effect can push on
+enum class EffectStat : uint8_t {
+    PUBLIC_HEALTH,
+    ECONOMIC_PRODUCTIVITY,
+    PUBLIC_WELFARE,
+    WEALTH_INEQUALITY,
+    TOURISM_REVENUE,
+    COUNT
+};
+
+// How an effect's strength evolves over its lifetime
+enum class EffectCurve : uint8_t {
+    CONSTANT,      // Full rate throughout
+    LINEAR_DECAY,  // Full rate fading to zero at expiry
+    LINEAR_RAMP    // Zero rising to full rate at expiry
+};
+
+struct EffectTerm {
+    EffectStat stat;
+    float rate;  // Stat change per second at intensity 1
+};
+
+// Timed effects stored as plain records, one row per (effect, stat term),
+// in column form. A step evaluates every row with the same arithmetic
+// (rate * curve(t) * dt, 8 rows per AVX step) and sums the results per
+// stat. Effects are keyed by name; adding a key that is already active is
+// ignored, so a condition that holds for many ticks triggers the effect
+// once. The store does not expire anything itself: the owner removes an
+// effect when its GameScheduler deadline fires, and the curve saturates
+// at full age until then.
+class EffectStore {
+public:
+    static constexpr size_t STAT_COUNT = static_cast<size_t>(EffectStat::COUNT);
+    using StatDeltas = std::array<float, STAT_COUNT>;
+    // The clock is float to match the kernel lanes; it is shifted back to
+    // zero periodically so long sessions keep sub-millisecond resolution
+    static constexpr float REBASE_AFTER = 4096.0f;
+
+private:
+    StringInterner keys;
+    std::vector<uint32_t> key_rows;  // Active rows per key
+
+    // Row columns. The curve is a + b * t over normalised age t in [0, 1].
+    std::vector<uint32_t> key;
+    std::vector<uint8_t> stat;
+    std::vector<float> rate;  // Pre-multiplied by intensity
+    std::vector<float> curve_a;
+    std::vector<float> curve_b;
+    std::vector<float> start;
+    std::vector<float> inv_duration;
+
+    std::vector<float> contribution;
+    float clock{0.0f};
+
+public:
+    size_t size() const { return key.size(); }
+    float now() const { return clock; }
+
+    bool is_active(const std::string& name) const {
+        uint32_t id = keys.find(name);
+        return id != StringInterner::INVALID_ID && key_rows[id] > 0;
+    }
+
+    // Returns false when an effect with this key is already active
+    bool add(const std::string& name, float duration, float intensity,
+             const std::vector<EffectTerm>& terms,
+             EffectCurve curve = EffectCurve::CONSTANT) {
+        uint32_t id = keys.intern(name);
+        if (id >= key_rows.size()) key_rows.resize(static_cast<size_t>(id) + 1, 0);
+        if (key_rows[id] > 0 || terms.empty() || duration <= 0.0f) return false;
+
+        float a = curve == EffectCurve::LINEAR_RAMP ? 0.0f : 1.0f;
+        float b = curve == EffectCurve::LINEAR_DECAY ? -1.0f
+                : curve == EffectCurve::LINEAR_RAMP ? 1.0f : 0.0f;
+        for (const auto& term : terms) {
+            key.push_back(id);
+            stat.push_back(static_cast<uint8_t>(term.stat));
+            rate.push_back(term.rate * intensity);
+            curve_a.push_back(a);
+            curve_b.push_back(b);
+            start.push_back(clock);
+            inv_duration.push_back(1.0f / duration);
+        }
+        key_rows[id] += static_cast<uint32_t>(terms.size());
+        return true;
+    }
+
+    size_t remove(const std::string& name) {
+        uint32_t id = keys.find(name);
+        if (id == StringInterner::INVALID_ID || key_rows[id] == 0) return 0;
+        size_t removed = 0;
+        for (size_t row = key.size(); row-- > 0;) {
+            if (key[row] == id) {
+                swap_remove(row);
+                ++removed;
+            }
+        }
+        return removed;
+    }
+
+    // Advances the effect clock by dt and adds every active row's stat
+    // change into deltas
+    void step(float dt, StatDeltas& deltas) {
+        if (clock > REBASE_AFTER) rebase();
+        clock += dt;
+        const size_t count = key.size();
+        contribution.resize(count);
+
+        size_t row = 0;
+#if defined(__AVX2__) && defined(__FMA__)
+        const __m256 now = _mm256_set1_ps(clock);
+        const __m256 step_dt = _mm256_set1_ps(dt);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        for (; row + 8 <= count; row += 8) {
+            __m256 age = _mm256_mul_ps(_mm256_sub_ps(now, _mm256_loadu_ps(&start[row])),
+                                       _mm256_loadu_ps(&inv_duration[row]));
+            __m256 t = _mm256_min_ps(_mm256_max_ps(age, zero), one);
+            __m256 factor = _mm256_fmadd_ps(_mm256_loadu_ps(&curve_b[row]), t,
+                                            _mm256_loadu_ps(&curve_a[row]));
+            __m256 amount = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&rate[row]), factor), step_dt);
+            _mm256_storeu_ps(&contribution[row], amount);
+        }
+#endif
+        for (; row < count; ++row) {
+            float t = std::min(std::max((clock - start[row]) * inv_duration[row], 0.0f), 1.0f);
+            contribution[row] = rate[row] * (curve_a[row] + curve_b[row] * t) * dt;
+        }
+
+        for (row = 0; row < count; ++row) {
+            deltas[stat[row]] += contribution[row];
+        }
+    }
+
+private:
+    void rebase() {
+        for (size_t row = 0; row < key.size(); ++row) {
+            start[row] -= clock;
+        }
+        clock = 0.0f;
+    }
+
+    void swap_remove(size_t row) {
+        --key_rows[key[row]];
+        size_t last = key.size() - 1;
+        if (row != last) {
+            key[row] = key[last];
+            stat[row] = stat[last];
+            rate[row] = rate[last];
+            curve_a[row] = curve_a[last];
+            curve_b[row] = curve_b[last];
+            start[row] = start[last];
+            inv_duration[row] = inv_duration[last];
+        }
+        key.pop_back();
+        stat.pop_back();
+        rate.pop_back();
+        curve_a.pop_back();
+        curve_b.pop_back();
+        start.pop_back();
+        inv_duration.pop_back();
+    }
+};
+
+} // namespace Systems
+
+#endif // EFFECTSTORE_HPP
@@ -0,0 +1,295 @@
+#ifndef EPIDEMICMODEL_HPP
+#define EPIDEMICMODEL_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <unordered_map>
+#include <vector>
+#include "../AI/Core/ThreadPool.hpp"
+
+namespace Systems {
+
+// Metapopulation SIR / SEIR model over the waypoint contact graph.
+//
+// Each outbreak keeps compartment fractions (S, E, I, R) only for the
+// nodes it has reached. A step gathers infection pressure for the
+// outbreak's active nodes and their neighbours along weighted edges, so
+// the cost follows the infected frontier rather than the whole map.
+// Nodes whose E + I drops below a threshold leave the active set, and an
+// outbreak with no active nodes is finished. Outbreaks are independent
+// and are stepped in parallel on a thread pool.
+class EpidemicModel {
+public:
+    using NodeIndex = uint32_t;
+    using OutbreakId = uint32_t;
+
+    // E + I below this retires a node from the active set
+    static constexpr float ACTIVE_THRESHOLD = 1e-4f;
+    // New infections below this do not seed an untouched node
+    static constexpr float SEED_THRESHOLD = 1e-5f;
+
+    struct ContactEdge {
+        NodeIndex a;
+        NodeIndex b;
+        float weight;
+    };
+
+    struct Parameters {
+        float transmission{0.2f};  // beta: infections per unit pressure per second
+        float incubation{0.0f};    // sigma: E -> I per second; 0 gives SIR
+        float recovery{0.02f};     // gamma: I -> R per second
+        float self_contact{1.0f};  // weight of a node's own infected on itself
+    };
+
+    struct Compartments {
+        float susceptible{1.0f};
+        float exposed{0.0f};
+        float infected{0.0f};
+        float recovered{0.0f};
+    };
+
+    struct Incidence {
+        NodeIndex node;
+        float new_infections;  // Fraction of the node's population this step
+    };
+
+private:
+    struct Outbreak {
+        OutbreakId id;
+        Parameters params;
+        std::unordered_map<NodeIndex, uint32_t> slot_of;
+        std::vector<NodeIndex> slot_node;
+        std::vector<Compartments> state;
+        std::vector<uint32_t> active;
+        std::vector<Incidence> incidence;
+
+        // Scratch for one step
+        std::vector<NodeIndex> candidates;
+        std::vector<float> pressure;
+        std::unordered_map<NodeIndex, uint32_t> candidate_of;
+    };
+
+    // Symmetric CSR adjacency
+    std::vector<uint32_t> offsets{0};
+    std::vector<NodeIndex> neighbours;
+    std::vector<float> weights;
+
+    // Per-node transmission scale, written on the main thread before a
+    // step; pool workers only read it
+    std::vector<float> susceptibility;
+
+    // Scratch for frontier()
+    std::vector<NodeIndex> frontier_nodes;
+    std::vector<uint8_t> frontier_mark;
+
+    std::vector<Outbreak> outbreaks;
+    OutbreakId next_id{1};
+
+public:
+    // Edges with an endpoint outside [0, node_count) or with a == b are
+    // dropped; returns how many were kept
+    size_t set_contact_graph(size_t node_count, const std::vector<ContactEdge>& edges) {
+        auto valid = [node_count](const ContactEdge& edge) {
+            return edge.a < node_count && edge.b < node_count && edge.a != edge.b;
+        };
+        std::vector<uint32_t> degree(node_count + 1, 0);
+        for (const auto& edge : edges) {
+            if (!valid(edge)) continue;
+            ++degree[edge.a];
+            ++degree[edge.b];
+        }
+        offsets.assign(node_count + 1, 0);
+        for (size_t i = 0; i < node_count; ++i) offsets[i + 1] = offsets[i] + degree[i];
+
+        neighbours.resize(offsets.back());
+        weights.resize(offsets.back());
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (const auto& edge : edges) {
+            if (!valid(edge)) continue;
+            neighbours[cursor[edge.a]] = edge.b;
+            weights[cursor[edge.a]++] = edge.weight;
+            neighbours[cursor[edge.b]] = edge.a;
+            weights[cursor[edge.b]++] = edge.weight;
+        }
+        susceptibility.resize(node_count, 1.0f);
+        return neighbours.size() / 2;
+    }
+
+    size_t node_count() const { return offsets.size() - 1; }
+
+    // Scales transmission into each node (density, medical care, ...).
+    // One entry per node, 1 by default; refresh it before step() from the
+    // main thread, since step() reads it on pool workers. A step only reads
+    // the entries of frontier() nodes.
+    std::vector<float>& susceptibility_column() { return susceptibility; }
+
+    // Nodes the next step can touch: every outbreak's active nodes and
+    // their neighbours, each listed once. Costs the frontier's size, not
+    // the map's.
+    const std::vector<NodeIndex>& frontier() {
+        frontier_nodes.clear();
+        frontier_mark.resize(node_count(), 0);
+        auto add = [this](NodeIndex node) {
+            if (node >= frontier_mark.size() || frontier_mark[node]) return;
+            frontier_mark[node] = 1;
+            frontier_nodes.push_back(node);
+        };
+        for (const auto& outbreak : outbreaks) {
+            for (uint32_t slot : outbreak.active) {
+                NodeIndex node = outbreak.slot_node[slot];
+                add(node);
+                if (node >= node_count()) continue;
+                for (uint32_t e = offsets[node]; e < offsets[node + 1]; ++e) add(neighbours[e]);
+            }
+        }
+        for (NodeIndex node : frontier_nodes) frontier_mark[node] = 0;
+        return frontier_nodes;
+    }
+
+    OutbreakId start_outbreak(NodeIndex origin, const Parameters& params,
+                              float initial_infected = 0.01f) {
+        outbreaks.emplace_back();
+        Outbreak& outbreak = outbreaks.back();
+        outbreak.id = next_id++;
+        outbreak.params = params;
+        uint32_t slot = slot_for(outbreak, origin);
+        Compartments& c = outbreak.state[slot];
+        c.susceptible = 1.0f - initial_infected;
+        (params.incubation > 0.0f ? c.exposed : c.infected) = initial_infected;
+        outbreak.active.push_back(slot);
+        return outbreak.id;
+    }
+
+    void end_outbreak(OutbreakId id) {
+        for (size_t i = 0; i < outbreaks.size(); ++i) {
+            if (outbreaks[i].id == id) {
+                outbreaks[i] = std::move(outbreaks.back());
+                outbreaks.pop_back();
+                return;
+            }
+        }
+    }
+
+    size_t outbreak_count() const { return outbreaks.size(); }
+
+    // Compartments of a node in an outbreak; untouched nodes are all S
+    Compartments compartments(OutbreakId id, NodeIndex node) const {
+        for (const auto& outbreak : outbreaks) {
+            if (outbreak.id != id) continue;
+            auto it = outbreak.slot_of.find(node);
+            if (it != outbreak.slot_of.end()) return outbreak.state[it->second];
+        }
+        return {};
+    }
+
+    // Advances every outbreak by dt. on_incidence(outbreak, node, amount)
+    // receives new infections; finished outbreaks are removed and their
+    // IDs appended to `finished`.
+    template<typename F>
+    void step(float dt, ThreadPool* pool, F&& on_incidence, std::vector<OutbreakId>& finished) {
+        if (!pool || outbreaks.size() <= 1) {
+            for (auto& outbreak : outbreaks) step_outbreak(outbreak, dt);
+        } else {
+            std::vector<std::future<void>> pending;
+            pending.reserve(outbreaks.size());
+            for (auto& outbreak : outbreaks) {
+                pending.push_back(pool->enqueue([this, &outbreak, dt]() { step_outbreak(outbreak, dt); }));
+            }
+            for (auto& future : pending) future.wait();
+        }
+
+        for (size_t i = outbreaks.size(); i-- > 0;) {
+            for (const auto& hit : outbreaks[i].incidence) {
+                on_incidence(outbreaks[i].id, hit.node, hit.new_infections);
+            }
+            if (outbreaks[i].active.empty()) {
+                finished.push_back(outbreaks[i].id);
+                outbreaks[i] = std::move(outbreaks.back());
+                outbreaks.pop_back();
+            }
+        }
+    }
+
+private:
+    static uint32_t slot_for(Outbreak& outbreak, NodeIndex node) {
+        auto [it, inserted] = outbreak.slot_of.try_emplace(
+            node, static_cast<uint32_t>(outbreak.slot_node.size()));
+        if (inserted) {
+            outbreak.slot_node.push_back(node);
+            outbreak.state.emplace_back();
+        }
+        return it->second;
+    }
+
+    float infected_at(const Outbreak& outbreak, NodeIndex node) const {
+        auto it = outbreak.slot_of.find(node);
+        return it != outbreak.slot_of.end() ? outbreak.state[it->second].infected : 0.0f;
+    }
+
+    void step_outbreak(Outbreak& outbreak, float dt) const {
+        const Parameters& p = outbreak.params;
+        outbreak.incidence.clear();
+
+        // Infected nodes push pressure onto themselves and their neighbours
+        outbreak.candidates.clear();
+        outbreak.pressure.clear();
+        outbreak.candidate_of.clear();
+        auto add_pressure = [&outbreak](NodeIndex node, float amount) {
+            auto [it, inserted] = outbreak.candidate_of.try_emplace(
+                node, static_cast<uint32_t>(outbreak.candidates.size()));
+            if (inserted) {
+                outbreak.candidates.push_back(node);
+                outbreak.pressure.push_back(0.0f);
+            }
+            outbreak.pressure[it->second] += amount;
+        };
+
+        for (uint32_t slot : outbreak.active) {
+            NodeIndex node = outbreak.slot_node[slot];
+            float infected = outbreak.state[slot].infected;
+            add_pressure(node, p.self_contact * infected);
+            if (infected <= 0.0f || node >= node_count()) continue;
+            for (uint32_t e = offsets[node]; e < offsets[node + 1]; ++e) {
+                add_pressure(neighbours[e], weights[e] * infected);
+            }
+        }
+
+        // Update every candidate from the pre-step infected values
+        std::vector<uint32_t> next_active;
+        next_active.reserve(outbreak.active.size());
+        for (size_t c = 0; c < outbreak.candidates.size(); ++c) {
+            NodeIndex node = outbreak.candidates[c];
+            float scale = node < susceptibility.size() ? susceptibility[node] : 1.0f;
+
+            auto known = outbreak.slot_of.find(node);
+            float susceptible = known != outbreak.slot_of.end()
+                ? outbreak.state[known->second].susceptible : 1.0f;
+            float new_infections = std::min(susceptible,
+                p.transmission * scale * susceptible * outbreak.pressure[c] * dt);
+            if (known == outbreak.slot_of.end() && new_infections < SEED_THRESHOLD) continue;
+
+            uint32_t slot = slot_for(outbreak, node);
+            Compartments& s = outbreak.state[slot];
+            float onset = p.incubation > 0.0f ? std::min(s.exposed, p.incubation * s.exposed * dt) : 0.0f;
+            float recoveries = std::min(s.infected, p.recovery * s.infected * dt);
+
+            s.susceptible -= new_infections;
+            if (p.incubation > 0.0f) {
+                s.exposed += new_infections - onset;
+                s.infected += onset - recoveries;
+            } else {
+                s.infected += new_infections - recoveries;
+            }
+            s.recovered += recoveries;
+
+            if (new_infections > 0.0f) outbreak.incidence.push_back({node, new_infections});
+            if (s.exposed + s.infected >= ACTIVE_THRESHOLD) next_active.push_back(slot);
+        }
+        outbreak.active.swap(next_active);
+    }
+};
+
+} // namespace Systems
+
+#endif // EPIDEMICMODEL_HPP
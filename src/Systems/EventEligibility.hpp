@@ -0,0 +1,323 @@
+#ifndef EVENTELIGIBILITY_HPP
+#define EVENTELIGIBILITY_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "../AI/Core/StringInterner.hpp"
+
+namespace Systems {
+
+enum class PredicateOp : uint8_t { LT, LE, GT, GE, EQ, NE };
+
+// One comparison of a state variable against a constant. Categorical
+// values (time phase, weather, ...) are interned and compared by ID.
+struct PredicateClause {
+    uint32_t variable;
+    PredicateOp op;
+    float operand;
+};
+
+// An event's conditions compiled to a conjunction of clauses. Conditions
+// that cannot be compiled (custom evaluators, unparsable expressions)
+// clear `compiled`, and the caller evaluates that event the slow way.
+struct PredicateProgram {
+    std::vector<PredicateClause> clauses;
+    bool compiled{true};
+};
+
+// Keeps the set of events whose conditions currently hold.
+//
+// Every clause is indexed under the variable it reads, sorted by operand.
+// When a variable moves from `old` to `new`, only clauses whose operand
+// lies between the two can change truth, so an update re-checks that
+// range and adjusts each affected event's count of failing clauses.
+// Events reaching zero join the eligible set; the set is bucketed by
+// weight (powers of two) so a weighted draw picks a bucket and then
+// rejection-samples inside it, O(1) expected regardless of event count.
+class EventEligibility {
+public:
+    using EventId = uint32_t;
+    static constexpr EventId INVALID_EVENT = static_cast<EventId>(-1);
+
+private:
+    struct VariableIndex {
+        float value{0.0f};
+        std::vector<uint32_t> ordered;   // LT/LE/GT/GE clauses by operand
+        std::vector<uint32_t> equality;  // EQ/NE clauses by operand
+        bool dirty{false};
+    };
+
+    struct Bucket {
+        int exponent;  // Weights in [2^(exponent-1), 2^exponent)
+        std::vector<EventId> members;
+        double total{0.0};
+    };
+
+    StringInterner variable_names;
+    StringInterner symbols;
+    std::vector<VariableIndex> variables;
+
+    // Clause columns
+    std::vector<EventId> clause_event;
+    std::vector<PredicateOp> clause_op;
+    std::vector<float> clause_operand;
+    std::vector<uint8_t> clause_true;
+
+    // Event columns
+    std::vector<float> event_weight;
+    std::vector<uint32_t> event_failing;
+    std::vector<int32_t> event_bucket;  // -1 while ineligible
+    std::vector<uint32_t> event_position;
+
+    std::vector<Bucket> buckets;
+    double total_weight{0.0};
+    size_t eligible{0};
+
+public:
+    uint32_t variable(const std::string& name) {
+        uint32_t id = variable_names.intern(name);
+        if (id >= variables.size()) variables.resize(static_cast<size_t>(id) + 1);
+        return id;
+    }
+
+    // Categorical values as clause operands; IDs stay exact in a float
+    // up to 2^24 distinct symbols. 0 is left for unset variables, so a
+    // variable nothing has pushed yet matches no symbol.
+    float symbol(const std::string& value) {
+        return static_cast<float>(symbols.intern(value)) + 1.0f;
+    }
+
+    // Compiles `expression` against `name` into the program. Accepted
+    // forms: "<op> number" with op one of < <= > >= == != (or =), a bare
+    // number meaning ">=", and (with allow_symbols) a bare or "=="/"!="
+    // prefixed word compared as a symbol. Returns false and marks the
+    // program uncompiled otherwise.
+    bool add_condition(PredicateProgram& program, const std::string& name,
+                       const std::string& expression, bool allow_symbols = true) {
+        size_t begin = expression.find_first_not_of(" \t");
+        if (begin == std::string::npos) return fail(program);
+
+        PredicateOp op = PredicateOp::GE;
+        bool explicit_op = true;
+        const char* text = expression.c_str() + begin;
+        if (text[0] == '<' && text[1] == '=') { op = PredicateOp::LE; text += 2; }
+        else if (text[0] == '>' && text[1] == '=') { op = PredicateOp::GE; text += 2; }
+        else if (text[0] == '=' && text[1] == '=') { op = PredicateOp::EQ; text += 2; }
+        else if (text[0] == '!' && text[1] == '=') { op = PredicateOp::NE; text += 2; }
+        else if (text[0] == '<') { op = PredicateOp::LT; text += 1; }
+        else if (text[0] == '>') { op = PredicateOp::GT; text += 1; }
+        else if (text[0] == '=') { op = PredicateOp::EQ; text += 1; }
+        else explicit_op = false;
+
+        std::string operand(text);
+        operand.erase(0, operand.find_first_not_of(" \t"));
+        operand.erase(operand.find_last_not_of(" \t") + 1);
+        if (operand.empty()) return fail(program);
+
+        char* end = nullptr;
+        float number = std::strtof(operand.c_str(), &end);
+        if (end && *end == '\0') {
+            program.clauses.push_back({variable(name), op, number});
+            return true;
+        }
+
+        // Words only support equality
+        if (!allow_symbols) return fail(program);
+        if (explicit_op && op != PredicateOp::EQ && op != PredicateOp::NE) return fail(program);
+        if (!explicit_op) op = PredicateOp::EQ;
+        program.clauses.push_back({variable(name), op, symbol(operand)});
+        return true;
+    }
+
+    void add_clause(PredicateProgram& program, const std::string& name, PredicateOp op, float operand) {
+        program.clauses.push_back({variable(name), op, operand});
+    }
+
+    // Registers an event; it joins the eligible set at once if its
+    // clauses hold for the current values
+    EventId add_event(const PredicateProgram& program, float weight = 1.0f) {
+        EventId event = static_cast<EventId>(event_weight.size());
+        event_weight.push_back(weight);
+        event_failing.push_back(0);
+        event_bucket.push_back(-1);
+        event_position.push_back(0);
+
+        for (const auto& clause : program.clauses) {
+            uint32_t id = static_cast<uint32_t>(clause_event.size());
+            VariableIndex& index = variables[clause.variable];
+            bool holds = test(clause.op, index.value, clause.operand);
+            clause_event.push_back(event);
+            clause_op.push_back(clause.op);
+            clause_operand.push_back(clause.operand);
+            clause_true.push_back(holds ? 1 : 0);
+            if (!holds) ++event_failing[event];
+
+            bool equality = clause.op == PredicateOp::EQ || clause.op == PredicateOp::NE;
+            (equality ? index.equality : index.ordered).push_back(id);
+            index.dirty = true;
+        }
+
+        if (event_failing[event] == 0) insert_eligible(event);
+        return event;
+    }
+
+    void set_value(uint32_t id, float value) {
+        VariableIndex& index = variables[id];
+        float old = index.value;
+        if (old == value) return;
+        index.value = value;
+        if (index.dirty) sort_index(index);
+
+        float lo = std::min(old, value);
+        float hi = std::max(old, value);
+        auto by_operand = [this](uint32_t clause, float x) { return clause_operand[clause] < x; };
+        auto first = std::lower_bound(index.ordered.begin(), index.ordered.end(), lo, by_operand);
+        for (auto it = first; it != index.ordered.end() && clause_operand[*it] <= hi; ++it) {
+            refresh_clause(*it, value);
+        }
+        for (float probe : {old, value}) {
+            auto it = std::lower_bound(index.equality.begin(), index.equality.end(), probe, by_operand);
+            for (; it != index.equality.end() && clause_operand[*it] == probe; ++it) {
+                refresh_clause(*it, value);
+            }
+        }
+    }
+
+    void set_value(const std::string& name, float value) { set_value(variable(name), value); }
+    void set_symbol(const std::string& name, const std::string& value) {
+        set_value(variable(name), symbol(value));
+    }
+
+    bool is_eligible(EventId event) const { return event_bucket[event] >= 0; }
+    size_t event_count() const { return event_weight.size(); }
+    size_t eligible_count() const { return eligible; }
+    double eligible_weight() const { return total_weight; }
+
+    // Weighted draw from the eligible set; `uniform` returns values in
+    // [0, 1). Returns INVALID_EVENT when nothing is eligible.
+    template<typename Uniform>
+    EventId sample(Uniform&& uniform) const {
+        if (eligible == 0 || total_weight <= 0.0) return INVALID_EVENT;
+
+        double target = uniform() * total_weight;
+        const Bucket* chosen = nullptr;
+        for (const auto& bucket : buckets) {
+            if (bucket.members.empty()) continue;
+            chosen = &bucket;
+            if (target < bucket.total) break;
+            target -= bucket.total;
+        }
+
+        // Every member weighs at least half the bucket bound, so each
+        // attempt is accepted with probability >= 1/2
+        const float bound = std::ldexp(1.0f, chosen->exponent);
+        const size_t count = chosen->members.size();
+        for (;;) {
+            size_t pick = std::min(static_cast<size_t>(uniform() * count), count - 1);
+            EventId event = chosen->members[pick];
+            if (uniform() * bound < event_weight[event]) return event;
+        }
+    }
+
+    void clear() {
+        for (auto& index : variables) {
+            index.ordered.clear();
+            index.equality.clear();
+            index.dirty = false;
+        }
+        clause_event.clear();
+        clause_op.clear();
+        clause_operand.clear();
+        clause_true.clear();
+        event_weight.clear();
+        event_failing.clear();
+        event_bucket.clear();
+        event_position.clear();
+        buckets.clear();
+        total_weight = 0.0;
+        eligible = 0;
+    }
+
+private:
+    static bool fail(PredicateProgram& program) {
+        program.compiled = false;
+        return false;
+    }
+
+    static bool test(PredicateOp op, float value, float operand) {
+        switch (op) {
+            case PredicateOp::LT: return value < operand;
+            case PredicateOp::LE: return value <= operand;
+            case PredicateOp::GT: return value > operand;
+            case PredicateOp::GE: return value >= operand;
+            case PredicateOp::EQ: return value == operand;
+            case PredicateOp::NE: return value != operand;
+        }
+        return false;
+    }
+
+    void sort_index(VariableIndex& index) {
+        auto by_operand = [this](uint32_t a, uint32_t b) { return clause_operand[a] < clause_operand[b]; };
+        std::sort(index.ordered.begin(), index.ordered.end(), by_operand);
+        std::sort(index.equality.begin(), index.equality.end(), by_operand);
+        index.dirty = false;
+    }
+
+    void refresh_clause(uint32_t clause, float value) {
+        uint8_t holds = test(clause_op[clause], value, clause_operand[clause]) ? 1 : 0;
+        if (holds == clause_true[clause]) return;
+        clause_true[clause] = holds;
+
+        EventId event = clause_event[clause];
+        if (holds) {
+            if (--event_failing[event] == 0) insert_eligible(event);
+        } else {
+            if (event_failing[event]++ == 0) remove_eligible(event);
+        }
+    }
+
+    void insert_eligible(EventId event) {
+        float weight = event_weight[event];
+        if (!(weight > 0.0f)) return;
+
+        int exponent;
+        std::frexp(weight, &exponent);
+        size_t b = 0;
+        while (b < buckets.size() && buckets[b].exponent != exponent) ++b;
+        if (b == buckets.size()) buckets.push_back({exponent, {}, 0.0});
+
+        Bucket& bucket = buckets[b];
+        event_bucket[event] = static_cast<int32_t>(b);
+        event_position[event] = static_cast<uint32_t>(bucket.members.size());
+        bucket.members.push_back(event);
+        bucket.total += weight;
+        total_weight += weight;
+        ++eligible;
+    }
+
+    void remove_eligible(EventId event) {
+        int32_t b = event_bucket[event];
+        if (b < 0) return;
+
+        Bucket& bucket = buckets[b];
+        uint32_t position = event_position[event];
+        EventId last = bucket.members.back();
+        bucket.members[position] = last;
+        event_position[last] = position;
+        bucket.members.pop_back();
+        event_bucket[event] = -1;
+
+        // Reset sums once empty so float drift cannot accumulate
+        bucket.total = bucket.members.empty() ? 0.0 : bucket.total - event_weight[event];
+        --eligible;
+        total_weight = eligible == 0 ? 0.0 : total_weight - event_weight[event];
+    }
+};
+
+} // namespace Systems
+
+#endif // EVENTELIGIBILITY_HPP
@@ -1,5 +1,12 @@
 #include "HealthSystem.hpp"
+#include "../Core/WorkerPool.hpp"
+#include "../Core/WorldSeed.hpp"
+#include "../Map/Waypoint.hpp"
 #include <Math.hpp>
+#include <algorithm>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace Systems {
 
@@ -7,27 +14,158 @@ using namespace godot;
 
 void HealthSystem::_register_methods() {
     register_method("_init", &HealthSystem::_init);
+    register_method("_ready", &HealthSystem::_ready);
     register_method("update", &HealthSystem::update);
     register_method("set_nodes", &HealthSystem::set_nodes);
+    register_method("set_waypoints", &HealthSystem::set_waypoints);
 }
 
 HealthSystem::HealthSystem() {
     rng.instance();
-    rng->randomize();
+    rng->set_seed(Core::WorldSeed::get_instance().derive("health"));
 }
 
 HealthSystem::~HealthSystem() {}
 
 void HealthSystem::_init() {}
 
+// Keyed by node path once in the tree, so several health systems draw
+// different streams and save to different sections
+void HealthSystem::_ready() {
+    instance_key = String(get_path()).utf8().get_data();
+    rng->set_seed(Core::WorldSeed::get_instance().derive("health", instance_key));
+    if (!waypoints.empty()) bind_save_sections();
+}
+
 void HealthSystem::set_nodes(const std::vector<Node*>& node_list) {
-    nodes = node_list;
+    if (simulation) {
+        simulation->set_nodes(node_list);
+    } else {
+        nodes = node_list;
+    }
+    if (!waypoints.empty()) rebuild_contact_graph();
+}
+
+size_t HealthSystem::node_count() const {
+    return simulation ? simulation->get_stats().size() : nodes.size();
+}
+
+Node* HealthSystem::node_at(size_t index) const {
+    if (simulation) return simulation->get_node_at(index);
+    return index < nodes.size() ? nodes[index] : nullptr;
+}
+
+void HealthSystem::set_contact_graph(const std::vector<EpidemicModel::ContactEdge>& edges) {
+    size_t kept = epidemic.set_contact_graph(node_count(), edges);
+    if (kept < edges.size()) {
+        Godot::print_err(String("HealthSystem: dropped {0} contact edges outside the node range")
+            .format(Array::make(static_cast<int64_t>(edges.size() - kept))));
+    }
+}
+
+void HealthSystem::set_waypoints(const std::vector<::Waypoint*>& waypoint_list) {
+    waypoints = waypoint_list;
+    rebuild_contact_graph();
+    bind_save_sections();
+}
+
+// One record per waypoint in list order, in "waypoints" and, for the
+// waypoints that have a population, "populations". Loading needs the same
+// map. Every record is decoded and checked before any waypoint changes,
+// so a section that does not match leaves the map as it was.
+void HealthSystem::bind_save_sections() {
+    std::string suffix = instance_key.empty() ? std::string() : ":" + instance_key;
+    saved_waypoints.bind("waypoints" + suffix, 1,
+        [this](Core::SaveSection& section) {
+            section.put<uint64_t>(waypoints.size());
+            for (const auto* waypoint : waypoints) {
+                section.put<uint8_t>(waypoint != nullptr);
+                if (waypoint) waypoint->save_section(section);
+            }
+        },
+        [this](Core::SaveSectionReader& section) {
+            uint64_t count = 0;
+            if (!section.get(count) || count != waypoints.size()) return false;
+            std::vector<::Waypoint::SavedRecord> records(waypoints.size());
+            for (size_t i = 0; i < waypoints.size(); ++i) {
+                uint8_t present = 0;
+                if (!section.get(present) || present != (waypoints[i] != nullptr)) return false;
+                if (waypoints[i] && !waypoints[i]->read_section(section, records[i])) return false;
+            }
+            if (!section.at_end()) return false;
+            for (size_t i = 0; i < waypoints.size(); ++i) {
+                if (waypoints[i]) waypoints[i]->apply_section(std::move(records[i]));
+            }
+            return true;
+        });
+
+    saved_populations.bind("populations" + suffix, 4,
+        [this](Core::SaveSection& section) {
+            for (const auto* waypoint : waypoints) {
+                if (waypoint && waypoint->get_population()) waypoint->get_population()->save_section(section);
+            }
+        },
+        [this](Core::SaveSectionReader& section) {
+            using Population = std::remove_pointer_t<decltype(waypoints[0]->get_population())>;
+            std::vector<Population::SavedRecord> records;
+            records.reserve(waypoints.size());
+            for (const auto* waypoint : waypoints) {
+                if (!waypoint || !waypoint->get_population()) continue;
+                if (!Population::read_section(section, records.emplace_back())) return false;
+            }
+            if (!section.at_end()) return false;
+            size_t next = 0;
+            for (auto* waypoint : waypoints) {
+                if (waypoint && waypoint->get_population()) waypoint->get_population()->apply_section(records[next++]);
+            }
+            return true;
+        });
+}
+
+// One unit-weight edge per connected pair; connections may be recorded on
+// one side only, so pairs are deduplicated rather than assumed symmetric
+void HealthSystem::rebuild_contact_graph() {
+    std::unordered_map<const ::Waypoint*, EpidemicModel::NodeIndex> index_of;
+    size_t count = std::min(waypoints.size(), node_count());
+    for (size_t i = 0; i < count; ++i) {
+        if (waypoints[i]) index_of.emplace(waypoints[i], static_cast<EpidemicModel::NodeIndex>(i));
+    }
+
+    std::vector<EpidemicModel::ContactEdge> edges;
+    std::unordered_set<uint64_t> seen;
+    for (const auto& [waypoint, a] : index_of) {
+        for (const auto& connected : waypoint->get_connected_waypoints()) {
+            auto other = index_of.find(connected.get());
+            if (other == index_of.end() || other->second == a) continue;
+            EpidemicModel::NodeIndex b = other->second;
+            uint64_t key = (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+            if (seen.insert(key).second) edges.push_back({a, b, 1.0f});
+        }
+    }
+    epidemic.set_contact_graph(node_count(), edges);
+}
+
+void HealthSystem::attach_simulation(NodeSimulationSystem* node_simulation) {
+    simulation = node_simulation;
+    if (simulation) {
+        // Nodes set before attaching move over to the simulation
+        if (!nodes.empty()) simulation->set_nodes(nodes);
+        nodes.clear();
+        if (!waypoints.empty()) rebuild_contact_graph();
+        simulation->set_event_handler(NodeEventKind::HEALTH_INCIDENT, [this](size_t node_index) {
+            trigger_health_event(node_index);
+        });
+    }
 }
 
 void HealthSystem::update(float delta_time) {
-    for (auto* node : nodes) {
-        update_health(node, delta_time);
-        apply_healthcare_measures(node, delta_time);
+    // Attached: update_health and apply_healthcare_measures run in the
+    // fused kernel, including the random health events
+    if (!simulation) {
+        for (auto* node : nodes) {
+            update_health(node, delta_time);
+            apply_healthcare_measures(node, delta_time);
+        }
     }
     update_disease_spread(delta_time);
 }
@@ -50,44 +188,108 @@ void HealthSystem::update_health(Node* node, float delta_time) {
 }
 
 void HealthSystem::trigger_health_event(Node* node) {
+    auto it = std::find(nodes.begin(), nodes.end(), node);
+    if (it != nodes.end()) {
+        trigger_health_event(static_cast<size_t>(it - nodes.begin()));
+    }
+}
+
+void HealthSystem::trigger_health_event(size_t node_index) {
+    if (node_index >= node_count()) return;
+
     DiseaseOutbreak outbreak{
         "Viral Outbreak",
         rng->randf_range(0.5f, 1.5f),
         rng->randf_range(0.1f, 0.3f),
-        rng->randf_range(100.0f, 300.0f)
+        rng->randf_range(100.0f, 300.0f),
+        0
     };
-    
+
+    // Duration sets the infectious period, so most cases resolve within
+    // it; incubation takes roughly an eighth of that
+    EpidemicModel::Parameters params;
+    params.transmission = outbreak.spread_rate;
+    params.incubation = 8.0f / outbreak.duration;
+    params.recovery = 4.0f / outbreak.duration;
+    outbreak.model_id = epidemic.start_outbreak(static_cast<EpidemicModel::NodeIndex>(node_index), params);
+    EpidemicModel::OutbreakId id = outbreak.model_id;
+    outbreak.deadline = outbreak_timers.schedule_in(outbreak.duration, [this, id]() { end_outbreak(id); });
+
     active_outbreaks.push_back(outbreak);
     
     // Create and trigger the event
     GameEvent* event = GameEvent::_new();
     event->set_name("Disease Outbreak");
-    event->set_description("A disease outbreak has occurred in " + node->get_name());
+    Node* node = node_at(node_index);
+    event->set_description("A disease outbreak has occurred in " +
+                           (node ? node->get_name() : String::num_int64(static_cast<int64_t>(node_index))));
     
     EventManager::get_instance()->trigger_event(event);
 }
 
 void HealthSystem::update_disease_spread(float delta_time) {
-    for (auto it = active_outbreaks.begin(); it != active_outbreaks.end();) {
-        it->duration -= delta_time;
-        
-        if (it->duration <= 0) {
-            it = active_outbreaks.erase(it);
-        } else {
-            for (auto* node : nodes) {
-                float infection_risk = calculate_infection_risk(node);
-                if (rng->randf() < infection_risk * it->spread_rate * delta_time) {
-                    node->modify_health_risk(10.0f * it->severity);
-                }
-            }
-            ++it;
-        }
+    if (active_outbreaks.empty()) return;
+
+    snapshot_susceptibility();
+    finished_outbreaks.clear();
+    epidemic.step(delta_time, active_outbreaks.size() > 4 ? &Core::WorkerPool::get_instance() : nullptr,
+        [this](EpidemicModel::OutbreakId outbreak, EpidemicModel::NodeIndex node, float amount) {
+            apply_new_infections(outbreak, node, amount);
+        },
+        finished_outbreaks);
+
+    for (auto id : finished_outbreaks) end_outbreak(id);
+}
+
+// Ends an outbreak that drained or hit its deadline; whichever comes
+// second finds nothing left to do
+void HealthSystem::end_outbreak(EpidemicModel::OutbreakId id) {
+    for (size_t i = 0; i < active_outbreaks.size(); ++i) {
+        if (active_outbreaks[i].model_id != id) continue;
+        outbreak_timers.cancel(active_outbreaks[i].deadline);
+        active_outbreaks.erase(active_outbreaks.begin() + i);
+        epidemic.end_outbreak(id);
+        return;
+    }
+}
+
+// Pool workers read susceptibility during the step, so the stats are
+// read here on the main thread, for the outbreaks' frontier nodes only
+void HealthSystem::snapshot_susceptibility() {
+    auto& column = epidemic.susceptibility_column();
+    const size_t count = std::min(column.size(), node_count());
+    for (auto node : epidemic.frontier()) {
+        if (node < count) column[node] = calculate_infection_risk(node);
     }
 }
 
-float HealthSystem::calculate_infection_risk(Node* node) const {
-    float base_risk = node->get_stats().population_density / 100.0f;
-    float medical_factor = 1.0f - (node->get_stats().medical_resources / 100.0f);
+// New infections, as a fraction of the node's population, raise its
+// health risk in proportion to the outbreak's severity
+void HealthSystem::apply_new_infections(EpidemicModel::OutbreakId outbreak, size_t node_index, float amount) {
+    float severity = 1.0f;
+    for (const auto& active : active_outbreaks) {
+        if (active.model_id == outbreak) severity = active.severity;
+    }
+
+    if (simulation) {
+        simulation->get_stats().modify(&NodeStatColumns::health_risk, node_index, 100.0f * severity * amount);
+    } else if (node_index < nodes.size()) {
+        nodes[node_index]->modify_health_risk(100.0f * severity * amount);
+    }
+}
+
+float HealthSystem::calculate_infection_risk(size_t node_index) const {
+    float density = 0.0f, medical = 0.0f;
+    if (simulation) {
+        const auto& stats = simulation->get_stats();
+        density = stats.population_density[node_index];
+        medical = stats.medical_resources[node_index];
+    } else {
+        density = nodes[node_index]->get_stats().population_density;
+        medical = nodes[node_index]->get_stats().medical_resources;
+    }
+    float base_risk = density / 100.0f;
+    float medical_factor = 1.0f - (medical / 100.0f);
     return base_risk * medical_factor;
 }
 
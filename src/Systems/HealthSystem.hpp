@@ -7,25 +7,50 @@
 #include "ISystem.hpp"
 #include "../Models/Node.hpp"
 #include "../Events/EventManager.hpp"
+#include "EpidemicModel.hpp"
+#include "NodeSimulationSystem.hpp"
+#include "../Core/GameScheduler.hpp"
+#include "../Core/SaveRegistry.hpp"
+#include <memory>
 #include <vector>
 
+class Waypoint;
+
 namespace Systems {
 
 class HealthSystem : public godot::Node, public ISystem {
     GODOT_CLASS(HealthSystem, godot::Node)
 
 private:
+    // Only used unattached; an attached simulation holds the node list
     std::vector<Node*> nodes;
     godot::Ref<godot::RandomNumberGenerator> rng;
+    // When attached, per-node health rules run in the fused kernel and
+    // outbreaks read and write the simulation's stat columns
+    NodeSimulationSystem* simulation{nullptr};
 
     struct DiseaseOutbreak {
         godot::String name;
         float severity;
         float spread_rate;
         float duration;
+        EpidemicModel::OutbreakId model_id;
+        Core::ScheduledTimers::Handle deadline;
     };
 
+    // Outbreaks spread over the contact graph and end once no node has
+    // exposed or infected population left, or when their duration runs
+    // out on game time
     std::vector<DiseaseOutbreak> active_outbreaks;
+    EpidemicModel epidemic;
+    Core::ScheduledTimers outbreak_timers;
+    // waypoints[i] is the map location of node i
+    std::vector<::Waypoint*> waypoints;
+    // Nothing else holds the map's waypoint list, so it is saved from here
+    Core::SavedSection saved_waypoints;
+    Core::SavedSection saved_populations;
+    std::string instance_key;  // Node path, set in _ready
+    std::vector<EpidemicModel::OutbreakId> finished_outbreaks;
 
 public:
     static void _register_methods();
@@ -34,14 +59,30 @@ public:
     ~HealthSystem();
 
     void _init();
+    void _ready();
     void set_nodes(const std::vector<Node*>& node_list);
+    // Waypoint connections by node index; weight scales contact between
+    // the two nodes
+    void set_contact_graph(const std::vector<EpidemicModel::ContactEdge>& edges);
+    // Builds the contact graph from the waypoints' connections, with
+    // waypoints[i] standing for nodes[i]
+    void set_waypoints(const std::vector<::Waypoint*>& waypoint_list);
+    void attach_simulation(NodeSimulationSystem* node_simulation);
     void update(float delta_time) override;
 
 private:
+    size_t node_count() const;
+    Node* node_at(size_t index) const;
     void update_health(Node* node, float delta_time);
     void trigger_health_event(Node* node);
+    void trigger_health_event(size_t node_index);
     void update_disease_spread(float delta_time);
-    float calculate_infection_risk(Node* node) const;
+    void rebuild_contact_graph();
+    void bind_save_sections();
+    void snapshot_susceptibility();
+    void end_outbreak(EpidemicModel::OutbreakId id);
+    void apply_new_infections(EpidemicModel::OutbreakId outbreak, size_t node_index, float amount);
+    float calculate_infection_risk(size_t node_index) const;
     void apply_healthcare_measures(Node* node, float delta_time);
 };
 
@@ -0,0 +1,117 @@
+#ifndef NODESIMULATIONREPLAY_HPP
+#define NODESIMULATIONREPLAY_HPP
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "NodeStatKernel.hpp"
+#include "../Core/ReplayLog.hpp"
+#include "../Core/WorldSeed.hpp"
+
+namespace Systems {
+
+// The engine-free part of a NodeSimulationSystem tick: the inputs queued
+// for the tick are applied to the columns, then the kernel steps them.
+// Live play and replays both tick through this, so a replay runs the
+// same code the recorded run did. The kernel is seeded from the world
+// seed's "node_simulation" stream.
+class NodeSimulationTick {
+public:
+    // Applies one player input to the columns. The game registers the
+    // same handler for live play and for replays.
+    using InputHandler = std::function<void(NodeStatColumns& stats, uint32_t channel, const uint8_t* data, size_t size)>;
+
+private:
+    struct Input {
+        uint32_t channel;
+        std::vector<uint8_t> data;
+    };
+
+    NodeStatKernel kernel;
+    InputHandler input_handler;
+    std::vector<Input> inputs;  // For the next tick
+
+public:
+    NodeSimulationTick() : kernel(seed()) {}
+
+    static uint64_t seed() { return Core::WorldSeed::get_instance().derive("node_simulation"); }
+
+    // Restarts the kernel's random streams from the current world seed,
+    // keeping its chances; for a replay that has just set the seed
+    void reseed() {
+        NodeStatKernel::Chances chances = kernel.get_chances();
+        kernel = NodeStatKernel(seed());
+        kernel.set_chances(chances);
+        inputs.clear();
+    }
+
+    NodeStatKernel& get_kernel() { return kernel; }
+    const NodeStatKernel& get_kernel() const { return kernel; }
+
+    void set_input_handler(InputHandler handler) { input_handler = std::move(handler); }
+    const InputHandler& get_input_handler() const { return input_handler; }
+
+    void queue_input(uint32_t channel, const uint8_t* data, size_t size) {
+        inputs.push_back({channel, std::vector<uint8_t>(data, data + size)});
+    }
+
+    void run(NodeStatColumns& stats, float dt, ThreadPool* pool, std::vector<NodeEvent>& events) {
+        if (input_handler) {
+            for (const auto& input : inputs) input_handler(stats, input.channel, input.data.data(), input.data.size());
+        }
+        inputs.clear();
+        kernel.step(stats, dt, pool, events);
+    }
+};
+
+// Replays a log recorded by NodeSimulationSystem without the engine, as
+// fast as the kernel steps. It sets the world seed from the log, feeds
+// the logged inputs through the input handler, steps at the logged tick
+// rate and compares every logged checksum. `stats` must hold the columns
+// the recorded run started from; it ends holding the replayed state.
+//
+// after_step gets each tick's fired events and column means, as
+// NodeSimulationSystem's event and means handlers do. Handlers that
+// change the columns in the game must run there too, or the replay
+// desyncs at the first tick they act on.
+struct NodeSimulationReplay {
+    using AfterStep = std::function<void(NodeStatColumns& stats, const std::vector<NodeEvent>& events,
+                                         const NodeStatMeans& means)>;
+
+    NodeSimulationTick::InputHandler input_handler;
+    AfterStep after_step;
+    NodeStatKernel::Chances chances;
+    ThreadPool* pool{nullptr};
+
+    // The fixed tick length of a log; recording steps at the same length
+    static float tick_seconds(uint32_t ticks_per_second) {
+        return ticks_per_second ? 1.0f / static_cast<float>(ticks_per_second) : 0.0f;
+    }
+
+    Core::ReplayPlayer::Result run(Core::ReplayReader& reader, NodeStatColumns& stats) const {
+        Core::WorldSeed::get_instance().set(reader.world_seed());
+        NodeSimulationTick simulation;
+        simulation.get_kernel().set_chances(chances);
+        simulation.set_input_handler(input_handler);
+
+        const float dt = tick_seconds(reader.ticks_per_second());
+        std::vector<NodeEvent> events;
+        Core::ReplayPlayer::Hooks hooks;
+        hooks.apply = [&simulation](const Core::ReplayReader::Record& record) {
+            if (record.kind == Core::ReplayFormat::Kind::INPUT) {
+                simulation.queue_input(record.channel, record.data, record.size);
+            }
+        };
+        hooks.step = [&](uint64_t) {
+            events.clear();
+            simulation.run(stats, dt, pool, events);
+            if (after_step) after_step(stats, events, simulation.get_kernel().last_means());
+        };
+        hooks.checksum = [&stats]() { return stats.checksum(); };
+        return Core::ReplayPlayer::run(reader, hooks);
+    }
+};
+
+} // namespace Systems
+
+#endif // NODESIMULATIONREPLAY_HPP
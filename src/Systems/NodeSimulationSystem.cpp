@@ -0,0 +1,239 @@
+#include "NodeSimulationSystem.hpp"
+#include "EconomySystem.hpp"
+#include "HealthSystem.hpp"
+#include "TechnologySystem.hpp"
+#include "../Core/WorldSeed.hpp"
+#include <Engine.hpp>
+#include <ProjectSettings.hpp>
+
+namespace Systems {
+
+using namespace godot;
+
+void NodeSimulationSystem::_register_methods() {
+    register_method("_init", &NodeSimulationSystem::_init);
+    register_method("_ready", &NodeSimulationSystem::_ready);
+    register_method("update", &NodeSimulationSystem::update);
+    register_method("set_node_count", &NodeSimulationSystem::set_node_count);
+    register_method("get_node_count", &NodeSimulationSystem::get_node_count);
+    register_method("sync_nodes", &NodeSimulationSystem::sync_nodes);
+    register_method("modify_stat", &NodeSimulationSystem::modify_stat);
+    register_method("save_game", &NodeSimulationSystem::save_game);
+    register_method("load_game", &NodeSimulationSystem::load_game);
+    register_method("start_recording", &NodeSimulationSystem::start_recording);
+    register_method("stop_recording", &NodeSimulationSystem::stop_recording);
+    register_method("record_input", &NodeSimulationSystem::record_input);
+    register_method("play_replay", &NodeSimulationSystem::play_replay);
+    register_method("get_tick", &NodeSimulationSystem::get_tick);
+}
+
+NodeSimulationSystem::NodeSimulationSystem() {
+    saved_stats.bind("node_stats", 4,
+        [this](Core::SaveSection& section) { stats.save_section(section); },
+        [this](Core::SaveSectionReader& section) { return load_stats(section); });
+}
+// The autosave in flight finishes before the sections go away
+NodeSimulationSystem::~NodeSimulationSystem() {
+    autosave_timers.clear();
+    autosave.reset();
+}
+
+void NodeSimulationSystem::_init() {}
+
+void NodeSimulationSystem::_ready() {
+    if (auto* economy = Object::cast_to<EconomySystem>(get_node("../EconomySystem"))) {
+        economy->attach_simulation(this);
+    }
+    if (auto* health = Object::cast_to<HealthSystem>(get_node("../HealthSystem"))) {
+        health->attach_simulation(this);
+    }
+    if (auto* technology = Object::cast_to<TechnologySystem>(get_node("../TechnologySystem"))) {
+        technology->attach_simulation(this);
+    }
+
+    if (!autosave) {
+        String directory = ProjectSettings::get_singleton()->globalize_path("user://autosaves");
+        autosave = std::make_unique<Core::Autosave>(directory.utf8().get_data(), [](Core::SaveWriter& writer) {
+            Core::SaveRegistry::get_instance().capture(writer);
+        });
+        autosave_timers.schedule_every(AUTOSAVE_PERIOD, [this]() { autosave->request(); });
+    }
+}
+
+void NodeSimulationSystem::set_nodes(const std::vector<Node*>& node_list) {
+    nodes = node_list;
+    stats.resize(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const auto& node_stats = nodes[i]->get_stats();
+        stats.economic_prosperity[i] = node_stats.economic_prosperity;
+        stats.resource_availability[i] = node_stats.resource_availability;
+        stats.population_density[i] = node_stats.population_density;
+        stats.environmental_health[i] = node_stats.environmental_health;
+        stats.medical_resources[i] = node_stats.medical_resources;
+        stats.health_risk[i] = node_stats.health_risk;
+        stats.research_investment[i] = node_stats.research_investment;
+        stats.technological_level[i] = node_stats.technological_level;
+    }
+}
+
+void NodeSimulationSystem::sync_nodes() {
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        auto& node_stats = nodes[i]->get_stats();
+        node_stats.economic_prosperity = stats.economic_prosperity[i];
+        node_stats.resource_availability = stats.resource_availability[i];
+        node_stats.population_density = stats.population_density[i];
+        node_stats.environmental_health = stats.environmental_health[i];
+        node_stats.medical_resources = stats.medical_resources[i];
+        node_stats.health_risk = stats.health_risk[i];
+        node_stats.research_investment = stats.research_investment[i];
+        node_stats.technological_level = stats.technological_level[i];
+    }
+}
+
+void NodeSimulationSystem::modify_stat(String stat, int node_index, float delta) {
+    static const std::pair<const char*, std::vector<float> NodeStatColumns::*> columns[] = {
+        {"economic_prosperity", &NodeStatColumns::economic_prosperity},
+        {"resource_availability", &NodeStatColumns::resource_availability},
+        {"population_density", &NodeStatColumns::population_density},
+        {"environmental_health", &NodeStatColumns::environmental_health},
+        {"medical_resources", &NodeStatColumns::medical_resources},
+        {"health_risk", &NodeStatColumns::health_risk},
+        {"research_investment", &NodeStatColumns::research_investment},
+        {"technological_level", &NodeStatColumns::technological_level},
+    };
+    if (node_index < 0) return;
+    for (const auto& [name, column] : columns) {
+        if (stat == name) {
+            stats.modify(column, static_cast<size_t>(node_index), delta);
+            return;
+        }
+    }
+    Godot::print_err(String("NodeSimulationSystem: unknown stat ") + stat);
+}
+
+void NodeSimulationSystem::set_node_count(int count) {
+    nodes.clear();
+    stats.resize(static_cast<size_t>(count > 0 ? count : 0));
+}
+
+void NodeSimulationSystem::set_event_handler(NodeEventKind kind, EventHandler handler) {
+    handlers[static_cast<size_t>(kind)] = std::move(handler);
+}
+
+// Handlers create game events, so they run on the main thread, after the
+// columns hold the tick's results
+void NodeSimulationSystem::dispatch(const std::vector<NodeEvent>& events, const NodeStatMeans& means) {
+    for (const auto& event : events) {
+        auto& handler = handlers[static_cast<size_t>(event.kind)];
+        if (handler) handler(event.node);
+    }
+    if (means_handler) means_handler(means);
+}
+
+void NodeSimulationSystem::update(float delta_time) {
+    // A replay steps at the logged tick length, so the recorded run does too
+    if (replay) delta_time = replay_tick;
+    fired_events.clear();
+    simulation.run(stats, delta_time,
+                   stats.size() > PARALLEL_THRESHOLD ? &Core::WorkerPool::get_instance() : nullptr, fired_events);
+
+    dispatch(fired_events, simulation.get_kernel().last_means());
+
+    if (replay) replay->record_checksum(tick, state_checksum());
+    ++tick;
+
+    // Main thread, after the kernel and its handlers: no worker is
+    // writing any columns while the snapshot is copied
+    if (autosave) autosave->at_tick_boundary();
+}
+
+bool NodeSimulationSystem::start_recording(String path) {
+    if (tick > 0) {
+        Godot::print_err("NodeSimulationSystem: replay recording must start before the first tick");
+        return false;
+    }
+    std::string native_path = ProjectSettings::get_singleton()->globalize_path(path).utf8().get_data();
+    auto recorder = std::make_unique<Core::ReplayRecorder>();
+    uint32_t ticks_per_second = static_cast<uint32_t>(Engine::get_singleton()->get_iterations_per_second());
+    if (!recorder->open(native_path, Core::WorldSeed::get_instance().get(), ticks_per_second)) {
+        Godot::print_err(String("NodeSimulationSystem: could not open replay log ") + path);
+        return false;
+    }
+    replay = std::move(recorder);
+    replay_tick = NodeSimulationReplay::tick_seconds(ticks_per_second);
+    return true;
+}
+
+void NodeSimulationSystem::stop_recording() {
+    replay.reset();
+}
+
+void NodeSimulationSystem::record_input(int channel, PoolByteArray data) {
+    PoolByteArray::Read bytes = data.read();
+    simulation.queue_input(static_cast<uint32_t>(channel), bytes.ptr(), static_cast<size_t>(data.size()));
+    if (replay) replay->record_input(tick, static_cast<uint32_t>(channel), bytes.ptr(), static_cast<size_t>(data.size()));
+}
+
+// Runs the log through NodeSimulationReplay with this system's input,
+// event and means handlers, so the handlers' game events fire as they
+// did live. Only the node simulation is reseeded here; other systems
+// replay exactly only if the world seed was set before they were created.
+bool NodeSimulationSystem::play_replay(String path) {
+    if (tick > 0 || replay) {
+        Godot::print_err("NodeSimulationSystem: a replay must start before the first tick and while not recording");
+        return false;
+    }
+    std::string native_path = ProjectSettings::get_singleton()->globalize_path(path).utf8().get_data();
+    Core::ReplayReader reader;
+    if (!reader.open(native_path)) {
+        Godot::print_err(String("NodeSimulationSystem: could not open replay log ") + path);
+        return false;
+    }
+
+    NodeSimulationReplay player;
+    player.input_handler = simulation.get_input_handler();
+    player.after_step = [this](NodeStatColumns&, const std::vector<NodeEvent>& events, const NodeStatMeans& means) {
+        dispatch(events, means);
+    };
+    player.chances = simulation.get_kernel().get_chances();
+    player.pool = stats.size() > PARALLEL_THRESHOLD ? &Core::WorkerPool::get_instance() : nullptr;
+    Core::ReplayPlayer::Result result = player.run(reader, stats);
+    tick = result.ticks;
+    simulation.reseed();
+
+    if (result.desynced) {
+        Godot::print_err(String("NodeSimulationSystem: replay desynced at tick {0}")
+            .format(Array::make(static_cast<int64_t>(result.desync_tick))));
+        return false;
+    }
+    if (result.truncated) Godot::print_err(String("NodeSimulationSystem: replay log ") + path + " ends mid-record");
+    return true;
+}
+
+bool NodeSimulationSystem::save_game(String path) {
+    std::string native_path = ProjectSettings::get_singleton()->globalize_path(path).utf8().get_data();
+    if (!Core::SaveRegistry::get_instance().save(native_path, &Core::WorkerPool::get_instance())) {
+        Godot::print_err(String("NodeSimulationSystem: could not write save ") + path);
+        return false;
+    }
+    return true;
+}
+
+bool NodeSimulationSystem::load_game(String path) {
+    std::string native_path = ProjectSettings::get_singleton()->globalize_path(path).utf8().get_data();
+    if (!Core::SaveRegistry::get_instance().load(native_path, &Core::WorkerPool::get_instance())) {
+        Godot::print_err(String("NodeSimulationSystem: could not load save ") + path);
+        return false;
+    }
+    return true;
+}
+
+// The columns must match the current nodes
+bool NodeSimulationSystem::load_stats(Core::SaveSectionReader& section) {
+    NodeStatColumns loaded;
+    if (!loaded.load_section(section) || (!nodes.empty() && loaded.size() != nodes.size())) return false;
+    stats = std::move(loaded);
+    return true;
+}
+
+} // namespace Systems
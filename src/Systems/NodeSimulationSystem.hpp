@@ -0,0 +1,133 @@
+#ifndef NODESIMULATIONSYSTEM_HPP
+#define NODESIMULATIONSYSTEM_HPP
+
+#include <Godot.hpp>
+#include <Node.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "ISystem.hpp"
+#include "../Models/Node.hpp"
+#include "NodeStatKernel.hpp"
+#include "NodeSimulationReplay.hpp"
+#include "../Core/Autosave.hpp"
+#include "../Core/GameScheduler.hpp"
+#include "../Core/ReplayLog.hpp"
+#include "../Core/SaveRegistry.hpp"
+#include "../Core/WorkerPool.hpp"
+
+namespace Systems {
+
+// Owns the per-node stat columns and runs the fused economy / health /
+// technology kernel once per tick. EconomySystem, HealthSystem and
+// TechnologySystem attach to it, register handlers for their random
+// events and stop looping over nodes themselves.
+//
+// The simulation holds the one node list: column i is the stats of
+// get_node_at(i), and the attached systems look nodes up here instead of
+// keeping lists of their own. set_nodes() reads the nodes' stats once;
+// from then on the columns are authoritative. Event effects and scripts
+// change stats through the columns (NodeStatColumns::modify,
+// modify_stat), and sync_nodes() copies the columns out to the Node
+// objects for readers that still look there. Without nodes the columns
+// are used on their own. On _ready the simulation attaches itself to
+// sibling EconomySystem, HealthSystem and TechnologySystem nodes.
+//
+// save_game() and load_game() write and read a binary save of every
+// section in Core::SaveRegistry; the stat columns are the "node_stats"
+// section. Every AUTOSAVE_PERIOD of game time the same sections are
+// snapshotted at the end of a tick and written to user://autosaves in
+// the background.
+//
+// update() is the fixed simulation tick. Player input goes through
+// record_input(), which queues it for the next tick's input handler. While
+// a replay is being recorded the input is logged against that tick, each
+// tick logs a checksum of the stat columns, and ticks run at the logged
+// fixed length. play_replay() runs such a log over these columns without
+// frame pacing and reports the first tick whose checksum differs (see
+// Core::ReplayLog and NodeSimulationReplay).
+class NodeSimulationSystem : public godot::Node, public ISystem {
+    GODOT_CLASS(NodeSimulationSystem, godot::Node)
+
+public:
+    using EventHandler = std::function<void(size_t node_index)>;
+    using MeansHandler = std::function<void(const NodeStatMeans& means)>;
+    using InputHandler = NodeSimulationTick::InputHandler;
+
+    // Below this many nodes the kernel runs on the calling thread
+    static constexpr size_t PARALLEL_THRESHOLD = NodeStatKernel::CHUNK * 4;
+    static constexpr double AUTOSAVE_PERIOD = 300.0;
+
+private:
+    std::vector<Node*> nodes;
+    NodeStatColumns stats;
+    NodeSimulationTick simulation;
+    std::vector<NodeEvent> fired_events;
+    EventHandler handlers[NodeStatKernel::EVENT_KINDS];
+    MeansHandler means_handler;
+    Core::SavedSection saved_stats;
+    std::unique_ptr<Core::Autosave> autosave;
+    Core::ScheduledTimers autosave_timers;
+    uint64_t tick{0};
+    std::unique_ptr<Core::ReplayRecorder> replay;
+    float replay_tick{0.0f};
+
+public:
+    static void _register_methods();
+
+    NodeSimulationSystem();
+    ~NodeSimulationSystem();
+
+    void _init();
+    void _ready();
+    void update(float delta_time) override;
+
+    // Column i holds node_list[i]'s stats, read from the node here
+    void set_nodes(const std::vector<Node*>& node_list);
+    // Headless use without Node objects
+    void set_node_count(int count);
+    int get_node_count() const { return static_cast<int>(stats.size()); }
+    // Null in headless use or past the end
+    Node* get_node_at(size_t index) const { return index < nodes.size() ? nodes[index] : nullptr; }
+    // Copies every column out to the Node objects
+    void sync_nodes();
+    // Script-facing NodeStatColumns::modify; stat is a column name such as
+    // "economic_prosperity"
+    void modify_stat(godot::String stat, int node_index, float delta);
+
+    NodeStatColumns& get_stats() { return stats; }
+    const NodeStatColumns& get_stats() const { return stats; }
+
+    void set_event_handler(NodeEventKind kind, EventHandler handler);
+    // Receives the column means at the end of every tick
+    void set_means_handler(MeansHandler handler) { means_handler = std::move(handler); }
+    const NodeStatMeans& get_stat_means() const { return simulation.get_kernel().last_means(); }
+    void set_event_chances(const NodeStatKernel::Chances& chances) { simulation.get_kernel().set_chances(chances); }
+    // Applies record_input()'s inputs, live and in replays
+    void set_input_handler(InputHandler handler) { simulation.set_input_handler(std::move(handler)); }
+
+    // Call between ticks; paths may be res:// or user:// paths
+    bool save_game(godot::String path);
+    bool load_game(godot::String path);
+
+    // Replay log of this run. A replay starts from the world seed, so
+    // recording must start before the first tick.
+    bool start_recording(godot::String path);
+    void stop_recording();
+    // Game-defined channel; the input applies to the next tick
+    void record_input(int channel, godot::PoolByteArray data);
+    // Replays a log from the current columns, which must be those the
+    // recorded run started from, before the first tick. Event handlers
+    // run as in live play; false on a desync or an unreadable log.
+    bool play_replay(godot::String path);
+    int64_t get_tick() const { return static_cast<int64_t>(tick); }
+    uint64_t state_checksum() const { return stats.checksum(); }
+
+private:
+    void dispatch(const std::vector<NodeEvent>& events, const NodeStatMeans& means);
+    bool load_stats(Core::SaveSectionReader& section);
+};
+
+} // namespace Systems
+
+#endif // NODESIMULATIONSYSTEM_HPP
@@ -0,0 +1,273 @@
+#ifndef NODESTATKERNEL_HPP
+#define NODESTATKERNEL_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <future>
+#include <vector>
+#include "../AI/Core/ThreadPool.hpp"
+#include "../Core/SaveArchive.hpp"
+
+namespace Systems {
+
+// Per-node stats the economy, health and technology rules read and write,
+// one contiguous column per stat indexed by node
+struct NodeStatColumns {
+    std::vector<float> economic_prosperity;
+    std::vector<float> resource_availability;
+    std::vector<float> population_density;
+    std::vector<float> environmental_health;
+    std::vector<float> medical_resources;
+    std::vector<float> health_risk;
+    std::vector<float> research_investment;
+    std::vector<float> technological_level;
+
+    size_t size() const { return economic_prosperity.size(); }
+
+    // Event effects and scripts change a stat through here, with the same
+    // 0..100 clamp the kernel applies, e.g.
+    // modify(&NodeStatColumns::economic_prosperity, node, 20.0f)
+    void modify(std::vector<float> NodeStatColumns::*column, size_t node, float delta) {
+        auto& values = this->*column;
+        if (node < values.size()) values[node] = std::clamp(values[node] + delta, 0.0f, 100.0f);
+    }
+
+    void resize(size_t count) {
+        for (auto* column : {&economic_prosperity, &resource_availability, &population_density,
+                             &environmental_health, &medical_resources, &health_risk,
+                             &research_investment, &technological_level}) {
+            column->resize(count, 0.0f);
+        }
+    }
+
+    void save_section(Core::SaveSection& section) const {
+        for (const auto* column : {&economic_prosperity, &resource_availability, &population_density,
+                                   &environmental_health, &medical_resources, &health_risk,
+                                   &research_investment, &technological_level}) {
+            section.put_array(*column);
+        }
+    }
+
+    // State hash for replay checksums; equal columns give equal hashes
+    uint64_t checksum() const {
+        uint64_t value = 0;
+        for (const auto* column : {&economic_prosperity, &resource_availability, &population_density,
+                                   &environmental_health, &medical_resources, &health_risk,
+                                   &research_investment, &technological_level}) {
+            value = value * 0x100000001B3ull ^ Core::SaveFormat::hash(
+                reinterpret_cast<const uint8_t*>(column->data()), column->size() * sizeof(float));
+        }
+        return value;
+    }
+
+    bool load_section(Core::SaveSectionReader& section) {
+        NodeStatColumns loaded;
+        for (auto* column : {&loaded.economic_prosperity, &loaded.resource_availability, &loaded.population_density,
+                             &loaded.environmental_health, &loaded.medical_resources, &loaded.health_risk,
+                             &loaded.research_investment, &loaded.technological_level}) {
+            if (!section.get_array(*column) || column->size() != loaded.size()) return false;
+        }
+        *this = std::move(loaded);
+        return true;
+    }
+};
+
+// Mean of each stat over every node, as of the end of a kernel step
+struct NodeStatMeans {
+    float economic_prosperity{0.0f};
+    float resource_availability{0.0f};
+    float population_density{0.0f};
+    float environmental_health{0.0f};
+    float medical_resources{0.0f};
+    float health_risk{0.0f};
+    float research_investment{0.0f};
+    float technological_level{0.0f};
+};
+
+enum class NodeEventKind : uint8_t {
+    ECONOMIC_BOOM,
+    HEALTH_INCIDENT,
+    TECH_BREAKTHROUGH,
+    COUNT
+};
+
+struct NodeEvent {
+    uint32_t node;
+    NodeEventKind kind;
+};
+
+// Fused per-node update for EconomySystem, HealthSystem and
+// TechnologySystem: one pass over the columns applies all three rule
+// sets, chunked across a thread pool.
+//
+// Random events are Bernoulli trials per node per tick. Instead of one
+// draw per node, each chunk draws the gap to its next event from a
+// geometric distribution and jumps straight to it, carrying the leftover
+// gap into the next tick. The cost is one draw per event, and chunks with
+// their own RNG streams stay deterministic regardless of thread timing.
+class NodeStatKernel {
+public:
+    static constexpr size_t CHUNK = 4096;
+    static constexpr size_t EVENT_KINDS = static_cast<size_t>(NodeEventKind::COUNT);
+
+    // Per-node, per-tick chances, matching the old per-system rolls
+    struct Chances {
+        float per_tick[EVENT_KINDS]{0.005f, 0.003f, 0.002f};
+    };
+
+private:
+    static constexpr size_t STAT_COUNT = 8;
+
+    struct ChunkState {
+        uint64_t rng;
+        uint64_t skip[EVENT_KINDS];
+        std::vector<NodeEvent> events;
+        double sums[STAT_COUNT];
+    };
+
+    Chances chances;
+    uint64_t seed;
+    std::vector<ChunkState> chunks;
+    NodeStatMeans means;
+
+public:
+    explicit NodeStatKernel(uint64_t rng_seed = 0x9E3779B97F4A7C15ull) : seed(rng_seed) {}
+
+    void set_chances(const Chances& value) {
+        chances = value;
+        chunks.clear();
+    }
+
+    const Chances& get_chances() const { return chances; }
+
+    // Column means of the most recent step, summed while each chunk is
+    // still in cache, so readers of averages need no pass of their own
+    const NodeStatMeans& last_means() const { return means; }
+
+    // Advances every node by dt; events that fired are appended in chunk
+    // order for the caller to dispatch on its own thread
+    void step(NodeStatColumns& stats, float dt, ThreadPool* pool,
+              std::vector<NodeEvent>& events) {
+        const size_t count = stats.size();
+        const size_t chunk_count = (count + CHUNK - 1) / CHUNK;
+        if (chunks.size() != chunk_count) reset_chunks(chunk_count);
+
+        auto run_chunk = [this, &stats, dt, count](size_t chunk) {
+            size_t begin = chunk * CHUNK;
+            size_t end = std::min(begin + CHUNK, count);
+            apply_rules(stats, begin, end, dt);
+            sum_columns(stats, begin, end, chunks[chunk].sums);
+            sample_events(chunks[chunk], begin, end);
+        };
+
+        if (!pool || chunk_count <= 1) {
+            for (size_t chunk = 0; chunk < chunk_count; ++chunk) run_chunk(chunk);
+        } else {
+            std::vector<std::future<void>> pending;
+            pending.reserve(chunk_count);
+            for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+                pending.push_back(pool->enqueue(run_chunk, chunk));
+            }
+            for (auto& future : pending) future.wait();
+        }
+
+        double totals[STAT_COUNT]{};
+        for (auto& chunk : chunks) {
+            events.insert(events.end(), chunk.events.begin(), chunk.events.end());
+            chunk.events.clear();
+            for (size_t stat = 0; stat < STAT_COUNT; ++stat) totals[stat] += chunk.sums[stat];
+        }
+        const double scale = count ? 1.0 / static_cast<double>(count) : 0.0;
+        float* out[STAT_COUNT] = {&means.economic_prosperity, &means.resource_availability,
+                                  &means.population_density, &means.environmental_health,
+                                  &means.medical_resources, &means.health_risk,
+                                  &means.research_investment, &means.technological_level};
+        for (size_t stat = 0; stat < STAT_COUNT; ++stat) *out[stat] = static_cast<float>(totals[stat] * scale);
+    }
+
+private:
+    // The three systems' per-node rules, column by column
+    static void apply_rules(NodeStatColumns& s, size_t begin, size_t end, float dt) {
+        float* prosperity = s.economic_prosperity.data();
+        const float* resources = s.resource_availability.data();
+        const float* density = s.population_density.data();
+        const float* environment = s.environmental_health.data();
+        const float* medical = s.medical_resources.data();
+        float* risk = s.health_risk.data();
+        const float* research = s.research_investment.data();
+        float* tech = s.technological_level.data();
+
+        for (size_t i = begin; i < end; ++i) {
+            // Economy: resources raise prosperity, crowding lowers it
+            float prosperity_change = dt * (resources[i] * 0.1f - density[i] * 0.05f);
+            prosperity[i] = std::clamp(prosperity[i] + prosperity_change, 0.0f, 100.0f);
+
+            // Health: environment, medical resources and density, then
+            // emergency care above the risk threshold
+            float updated = risk[i] + dt * (-environment[i] * 0.05f + medical[i] * 0.1f
+                                            - density[i] * 0.02f);
+            float care = updated > 50.0f ? medical[i] * 0.2f * dt : 0.0f;
+            risk[i] = std::clamp(updated - care, 0.0f, 100.0f);
+
+            // Technology: research investment raises the tech level
+            tech[i] = std::clamp(tech[i] + dt * research[i] * 0.1f, 0.0f, 100.0f);
+        }
+    }
+
+    static void sum_columns(const NodeStatColumns& s, size_t begin, size_t end, double (&sums)[STAT_COUNT]) {
+        const std::vector<float>* columns[STAT_COUNT] = {
+            &s.economic_prosperity, &s.resource_availability, &s.population_density,
+            &s.environmental_health, &s.medical_resources, &s.health_risk,
+            &s.research_investment, &s.technological_level};
+        for (size_t stat = 0; stat < STAT_COUNT; ++stat) {
+            const float* values = columns[stat]->data();
+            double sum = 0.0;
+            for (size_t i = begin; i < end; ++i) sum += values[i];
+            sums[stat] = sum;
+        }
+    }
+
+    void sample_events(ChunkState& state, size_t begin, size_t end) {
+        const uint64_t span = end - begin;
+        for (size_t kind = 0; kind < EVENT_KINDS; ++kind) {
+            uint64_t position = state.skip[kind];
+            while (position < span) {
+                state.events.push_back({static_cast<uint32_t>(begin + position),
+                                        static_cast<NodeEventKind>(kind)});
+                position += 1 + geometric_gap(state.rng, chances.per_tick[kind]);
+            }
+            state.skip[kind] = position - span;
+        }
+    }
+
+    void reset_chunks(size_t chunk_count) {
+        chunks.assign(chunk_count, ChunkState{});
+        for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+            chunks[chunk].rng = seed ^ (0xD1B54A32D192ED03ull * (chunk + 1));
+            for (size_t kind = 0; kind < EVENT_KINDS; ++kind) {
+                chunks[chunk].skip[kind] = geometric_gap(chunks[chunk].rng, chances.per_tick[kind]);
+            }
+        }
+    }
+
+    static uint64_t next_random(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Failures before the next success of a Bernoulli(p) sequence
+    static uint64_t geometric_gap(uint64_t& state, float p) {
+        if (p <= 0.0f) return UINT64_MAX / 2;
+        if (p >= 1.0f) return 0;
+        // Uniform in (0, 1]
+        double u = (static_cast<double>(next_random(state) >> 11) + 1.0) * 0x1.0p-53;
+        return static_cast<uint64_t>(std::floor(std::log(u) / std::log1p(-static_cast<double>(p))));
+    }
+};
+
+} // namespace Systems
+
+#endif // NODESTATKERNEL_HPP
@@ -1,4 +1,5 @@
 #include "PopulationSystem.hpp"
+#include "../Core/WorldSeed.hpp"
 #include <ResourceLoader.hpp>
 #include <MeshInstance.hpp>
 #include <Transform.hpp>
@@ -20,7 +21,7 @@ PopulationSystem::~PopulationSystem() {}
 
 void PopulationSystem::_init() {
     rng.instance();
-    rng->randomize();
+    rng->set_seed(Core::WorldSeed::get_instance().derive("population"));
 }
 
 void PopulationSystem::_ready() {
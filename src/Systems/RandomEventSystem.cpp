@@ -1,5 +1,6 @@
 #include "RandomEventSystem.hpp"
 #include "../Events/EventManager.hpp"
+#include "../Core/WorldSeed.hpp"
 
 namespace Systems {
 
@@ -15,7 +16,7 @@ RandomEventSystem::~RandomEventSystem() {}
 
 void RandomEventSystem::_init() {
     rng.instance();
-    rng->randomize();
+    rng->set_seed(Core::WorldSeed::get_instance().derive("random_events"));
     initialize_possible_events();
 }
 
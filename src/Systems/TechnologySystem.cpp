@@ -3,6 +3,7 @@
 #include <Godot.hpp>
 #include "Models/GameEvent.h"
 #include "EventManager.h"
+#include "../Core/WorldSeed.hpp"
 
 namespace Systems {
 
@@ -16,10 +17,20 @@ TechnologySystem::TechnologySystem() {}
 TechnologySystem::~TechnologySystem() {}
 
 void TechnologySystem::_init() {
-    // Initialization if needed
+    rng.instance();
+    rng->set_seed(Core::WorldSeed::get_instance().derive("technology"));
+}
+
+void TechnologySystem::attach_simulation(NodeSimulationSystem* node_simulation) {
+    simulation = node_simulation;
+    if (simulation) {
+        simulation->set_event_handler(NodeEventKind::TECH_BREAKTHROUGH,
+            [this](size_t node_index) { trigger_tech_breakthrough(static_cast<int>(node_index)); });
+    }
 }
 
 void TechnologySystem::update_system(float delta_time) {
+    if (simulation) return;  // Rules run in NodeSimulationSystem's fused kernel
     for (int i = 0; i < nodes.size(); i++) {
         update_technology(i, delta_time);
     }
@@ -38,7 +49,7 @@ void TechnologySystem::update_technology(int node_index, float delta_time) {
         node->get_stats()->technological_level = Math::clamp(node->get_stats()->technological_level, 0.0f, 100.0f);
 
         // Random technological breakthroughs
-        float random_chance = (float)rand() / RAND_MAX;
+        float random_chance = rng->randf();
         if (random_chance < 0.002f) { // 0.2% chance per update
             trigger_tech_breakthrough(i);
         }
@@ -46,6 +57,28 @@ void TechnologySystem::update_technology(int node_index, float delta_time) {
 }
 
 void TechnologySystem::trigger_tech_breakthrough(int node_index) {
+    if (node_index < 0) return;
+    if (simulation) {
+        // Kernel events index the simulation's columns, which are
+        // authoritative while attached
+        size_t index = static_cast<size_t>(node_index);
+        if (index >= simulation->get_stats().size()) return;
+        NodeSimulationSystem* columns = simulation;
+        Node* node = simulation->get_node_at(index);
+        String where = node ? node->get_name() : String::num_int64(node_index);
+
+        GameEvent renewable_energy;
+        renewable_energy.name = "Renewable Energy Breakthrough";
+        renewable_energy.effect = [columns, index, where]() {
+            columns->get_stats().modify(&NodeStatColumns::environmental_health, index, 15.0f);
+            columns->get_stats().modify(&NodeStatColumns::economic_prosperity, index, 10.0f);
+            Godot::print(String("Renewable Energy Breakthrough in ") + where + "!");
+        };
+        EventManager::trigger_event(renewable_energy);
+        return;
+    }
+
+    if (node_index >= nodes.size()) return;
     Node *node = Object::cast_to<Node>(nodes[node_index]);
     if (node) {
         // Create a new GameEvent
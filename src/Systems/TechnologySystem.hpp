@@ -3,7 +3,9 @@
 
 #include <Godot.hpp>
 #include <Node.hpp>
+#include <RandomNumberGenerator.hpp>
 #include "Models/Node.h"
+#include "NodeSimulationSystem.hpp"
 
 namespace Systems {
 
@@ -12,6 +14,10 @@ class TechnologySystem : public godot::Node {
 
 private:
     godot::Array nodes; // Assuming nodes are instances of a Node class
+    godot::Ref<godot::RandomNumberGenerator> rng;
+    // When attached, per-node rules run in the fused kernel, and node
+    // indices are the simulation's column indices
+    NodeSimulationSystem* simulation{nullptr};
 
 public:
     static void _register_methods();
@@ -20,6 +26,7 @@ public:
     ~TechnologySystem();
 
     void _init(); // Called by Godot
+    void attach_simulation(NodeSimulationSystem* node_simulation);
     void update_system(float delta_time);
     void update_technology(int node_index, float delta_time);
     void trigger_tech_breakthrough(int node_index);
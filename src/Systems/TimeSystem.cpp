@@ -1,4 +1,5 @@
 #include "TimeSystem.hpp"
+#include "../Core/GameScheduler.hpp"
 #include <Math.hpp>
 
 namespace Systems {
@@ -52,6 +53,10 @@ void TimeSystem::resume_time() {
 void TimeSystem::update_time(float delta_time) {
     float scaled_delta = delta_time * time_scale;
     elapsed_time += scaled_delta;
+
+    // Single driver of the shared deadline queue; everything scheduled on
+    // game time (elections, effects, outbreaks) fires from here
+    Core::GameScheduler::get_instance().advance(scaled_delta);
     
     // Update minutes (1 real second = 1 game minute)
     current_date.minute += scaled_delta * 60.0f;
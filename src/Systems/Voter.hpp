@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <memory>
@@ -22,6 +23,7 @@ public:
     explicit Voter(const std::string& voter_id) : id(voter_id) {}
 
     const std::string& get_id() const { return id; }
+    const std::vector<Opinion>& get_opinions() const { return opinions; }
 
     void add_opinion(const std::string& topic, float initial_value) {
         opinions.push_back({topic, initial_value});
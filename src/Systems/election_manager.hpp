@@ -19,8 +19,8 @@ class ElectionManager : public Node {
     GDCLASS(ElectionManager, Node)
 
 private:
+    // Countries schedule their own elections on the shared GameScheduler
     std::vector<Country*> countries;
-    double election_timer;
     double election_campaign_duration;
     bool campaign_phase_active;
     
@@ -29,8 +29,6 @@ private:
     std::vector<ElectionEventHandler> election_end_callbacks;
 
     static void _bind_methods();
-    void trigger_elections();
-    void set_next_election_cycle();
     void start_campaign_phase();
     void end_campaign_phase();
     void update_campaign_effects(double delta);
@@ -45,7 +43,6 @@ public:
 
     void _ready() override;
     void _notification(int p_what);
-    void update(double delta);
     
     // Configuration methods
     void set_election_cycle_duration(double duration);
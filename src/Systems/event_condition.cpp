@@ -33,7 +33,7 @@ bool EventCondition::is_met(GameManager* game_manager) const {
 // Implementation of other methods...
 // (For brevity, I'm showing just a few key methods. The complete implementation would include all the checking methods)
 
-double EventCondition::parse_population_density(const String& density) const {
+double EventCondition::parse_population_density(const String& density) {
     String lower_density = density.to_lower();
     if (lower_density == "high") return 70.0;
     if (lower_density == "medium") return 50.0;
@@ -35,7 +35,6 @@ private:
     bool check_custom_conditions(GameManager* game_manager) const;
     bool check_custom_condition(const String& key, const String& value, GameManager* game_manager) const;
     double get_stat_value(const String& stat_name, GameManager* game_manager) const;
-    double parse_population_density(const String& density) const;
     void clear_cache();
 
 protected:
@@ -48,6 +47,7 @@ public:
     ~EventCondition();
 
     bool is_met(GameManager* game_manager) const;
+    static double parse_population_density(const String& density);
     float get_condition_weight(const String& condition_name) const;
     Dictionary get_condition_status(GameManager* game_manager) const;
 
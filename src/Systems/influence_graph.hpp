@@ -0,0 +1,322 @@
+#ifndef INFLUENCE_GRAPH_HPP
+#define INFLUENCE_GRAPH_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "voter_population.hpp"
+#include "../AI/Core/StringInterner.hpp"
+#include "../AI/Core/ThreadPool.hpp"
+
+namespace game_systems {
+
+// Sparse influence network from campaign sources to voters.
+//
+// An edge (source, voter) carries two things: an audience weight, set
+// when a campaign's audience is wired up, and the signed sum of the
+// targeted influences aimed at that voter by that source. Campaign
+// influences raise a source's strength across its whole wired audience;
+// targeted influences only touch their own edge, so a source can push
+// one voter and pull another without the two cancelling. An edge that
+// was created by targeted influences alone is dropped when the last of
+// them is removed.
+//
+// Edges are compiled into a voter-major CSR matrix when the audience
+// changes. A propagation pass is one sparse matrix-vector product,
+// delta[voter] = sum(weight * strength[source] + targeted), followed by
+// applying each delta to the voter's opinion columns. Only voters with at
+// least one incoming edge are visited, and rows split into independent
+// chunks for the thread pool.
+//
+// The graph keeps no clock. Owners expire influences by calling
+// remove_influence, typically from a GameScheduler deadline, so
+// durations follow scaled game time.
+class InfluenceGraph {
+public:
+    using SourceId = StringInterner::Id;
+    using VoterIndex = uint32_t;
+    using InfluenceId = uint32_t;
+
+    static constexpr size_t PARALLEL_CHUNK = 1 << 14;
+    static constexpr InfluenceId INVALID_INFLUENCE = static_cast<InfluenceId>(-1);
+
+private:
+    struct Edge {
+        float weight{0.0f};    // Audience weight for campaign influences
+        float targeted{0.0f};  // Sum of live targeted influences
+        uint32_t influences{0};
+    };
+
+    struct Influence {
+        uint64_t edge;  // Edge key, or the source for campaign influences
+        float strength;
+        bool targeted;
+        bool live;
+    };
+
+    StringInterner sources;
+    std::vector<float> source_strength;   // Campaign strength per source
+    std::vector<uint32_t> source_campaigns;
+    std::vector<Influence> influences;
+    std::vector<InfluenceId> free_influences;
+    size_t active_influences{0};
+
+    // Authoritative edge set, keyed by (source << 32 | voter)
+    std::unordered_map<uint64_t, Edge> edges;
+    bool dirty{false};
+
+    // CSR over the voters that have incoming edges
+    std::vector<VoterIndex> row_voter;
+    std::vector<uint32_t> row_offsets;
+    std::vector<SourceId> column_source;
+    std::vector<float> column_weight;
+    std::vector<float> column_targeted;
+    std::unordered_map<uint64_t, uint32_t> column_of;  // Edge key -> CSR entry
+
+    std::vector<float> deltas;
+
+public:
+    SourceId intern_source(const std::string& source_id) {
+        SourceId id = sources.intern(source_id);
+        if (id >= source_strength.size()) {
+            source_strength.resize(static_cast<size_t>(id) + 1, 0.0f);
+            source_campaigns.resize(static_cast<size_t>(id) + 1, 0);
+        }
+        return id;
+    }
+
+    SourceId find_source(const std::string& source_id) const { return sources.find(source_id); }
+    const std::string& source_name(SourceId source) const { return sources.name(source); }
+    size_t source_count() const { return source_strength.size(); }
+    size_t edge_count() const { return edges.size(); }
+    size_t active_count() const { return active_influences; }
+
+    // Campaign strength of a source
+    float strength(SourceId source) const {
+        return source < source_strength.size() ? source_strength[source] : 0.0f;
+    }
+
+    // Targeted strength on one edge
+    float targeted_strength(SourceId source, VoterIndex voter) const {
+        auto it = edges.find(edge_key(source, voter));
+        return it != edges.end() ? it->second.targeted : 0.0f;
+    }
+
+    // Adds or reweights a single audience edge
+    void connect(SourceId source, VoterIndex voter, float weight = 1.0f) {
+        set_weight(edge_key(source, voter), weight);
+    }
+
+    void connect_audience(SourceId source, const std::vector<VoterIndex>& voters,
+                          float weight = 1.0f) {
+        for (VoterIndex voter : voters) set_weight(edge_key(source, voter), weight);
+    }
+
+    // Removes the voter from the source's audience; targeted influences on
+    // the edge stay until they are removed
+    void disconnect(SourceId source, VoterIndex voter) {
+        auto it = edges.find(edge_key(source, voter));
+        if (it != edges.end()) unwire(it);
+    }
+
+    void disconnect_source(SourceId source) {
+        for (auto it = edges.begin(); it != edges.end();) {
+            if (static_cast<SourceId>(it->first >> 32) == source && it->second.weight != 0.0f) {
+                it = unwire(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Pushes one voter by `signed_strength` per propagation until removed
+    InfluenceId add_influence(SourceId source, VoterIndex voter, float signed_strength) {
+        uint64_t key = edge_key(source, voter);
+        auto [it, inserted] = edges.try_emplace(key);
+        it->second.targeted += signed_strength;
+        ++it->second.influences;
+        if (inserted) {
+            dirty = true;
+        } else {
+            update_column(key, it->second.targeted);
+        }
+        return allocate({key, signed_strength, true, true});
+    }
+
+    // Pushes the source's whole wired audience until removed
+    InfluenceId add_campaign_influence(SourceId source, float signed_strength) {
+        source_strength[source] += signed_strength;
+        ++source_campaigns[source];
+        return allocate({source, signed_strength, false, true});
+    }
+
+    // Undoes an influence; false if it was already removed
+    bool remove_influence(InfluenceId id) {
+        if (id >= influences.size() || !influences[id].live) return false;
+        Influence& influence = influences[id];
+        influence.live = false;
+        free_influences.push_back(id);
+        --active_influences;
+
+        if (!influence.targeted) {
+            SourceId source = static_cast<SourceId>(influence.edge);
+            source_strength[source] -= influence.strength;
+            // Drop accumulated rounding once the source has no campaigns
+            if (--source_campaigns[source] == 0) source_strength[source] = 0.0f;
+            return true;
+        }
+
+        auto it = edges.find(influence.edge);
+        if (it == edges.end()) return true;
+        Edge& edge = it->second;
+        edge.targeted = --edge.influences == 0 ? 0.0f : edge.targeted - influence.strength;
+        if (edge.influences == 0 && edge.weight == 0.0f) {
+            edges.erase(it);
+            dirty = true;
+        } else {
+            update_column(influence.edge, edge.targeted);
+        }
+        return true;
+    }
+
+    // Applies one tick of every active influence to the population
+    void propagate(VoterPopulation& population, ThreadPool* pool = nullptr) {
+        if (dirty) rebuild();
+        if (active_influences == 0 || row_voter.empty()) return;
+
+        // Rows are sorted by voter, so edges to voters the population no
+        // longer has (after a load shrank it, say) are the trailing rows
+        const size_t rows = static_cast<size_t>(
+            std::lower_bound(row_voter.begin(), row_voter.end(), population.size()) - row_voter.begin());
+        deltas.assign(row_voter.size(), 0.0f);
+        if (rows == 0) return;
+        if (!pool || rows <= PARALLEL_CHUNK) {
+            propagate_rows(population, 0, rows);
+            return;
+        }
+
+        std::vector<std::future<void>> pending;
+        pending.reserve((rows + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK);
+        for (size_t begin = 0; begin < rows; begin += PARALLEL_CHUNK) {
+            size_t end = std::min(begin + PARALLEL_CHUNK, rows);
+            // Rows are distinct voters, so chunks write disjoint opinions
+            pending.push_back(pool->enqueue([this, &population, begin, end]() {
+                propagate_rows(population, begin, end);
+            }));
+        }
+        for (auto& future : pending) future.wait();
+    }
+
+    // Per-voter influence delta of the most recent propagate call
+    template<typename F>
+    void for_each_delta(F&& visit) const {
+        for (size_t row = 0; row < row_voter.size() && row < deltas.size(); ++row) {
+            visit(row_voter[row], deltas[row]);
+        }
+    }
+
+private:
+    static uint64_t edge_key(SourceId source, VoterIndex voter) {
+        return (static_cast<uint64_t>(source) << 32) | voter;
+    }
+
+    InfluenceId allocate(const Influence& influence) {
+        ++active_influences;
+        if (!free_influences.empty()) {
+            InfluenceId id = free_influences.back();
+            free_influences.pop_back();
+            influences[id] = influence;
+            return id;
+        }
+        influences.push_back(influence);
+        return static_cast<InfluenceId>(influences.size() - 1);
+    }
+
+    void set_weight(uint64_t key, float weight) {
+        auto [it, inserted] = edges.try_emplace(key);
+        if (!inserted && it->second.weight == weight) return;
+        it->second.weight = weight;
+        dirty = true;
+    }
+
+    std::unordered_map<uint64_t, Edge>::iterator unwire(std::unordered_map<uint64_t, Edge>::iterator it) {
+        dirty = true;
+        if (it->second.influences > 0) {
+            it->second.weight = 0.0f;
+            return std::next(it);
+        }
+        return edges.erase(it);
+    }
+
+    // Targeted strength changes on a compiled edge are patched in place
+    void update_column(uint64_t key, float targeted) {
+        if (dirty) return;
+        auto it = column_of.find(key);
+        if (it != column_of.end()) column_targeted[it->second] = targeted;
+    }
+
+    void rebuild() {
+        std::vector<std::pair<uint64_t, const Edge*>> sorted;
+        sorted.reserve(edges.size());
+        for (const auto& [key, edge] : edges) {
+            // Voter-major key so each row's entries are contiguous
+            uint64_t voter = key & 0xffffffffu;
+            sorted.push_back({(voter << 32) | (key >> 32), &edge});
+        }
+        std::sort(sorted.begin(), sorted.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        row_voter.clear();
+        row_offsets.clear();
+        column_of.clear();
+        column_source.resize(sorted.size());
+        column_weight.resize(sorted.size());
+        column_targeted.resize(sorted.size());
+        for (size_t e = 0; e < sorted.size(); ++e) {
+            VoterIndex voter = static_cast<VoterIndex>(sorted[e].first >> 32);
+            SourceId source = static_cast<SourceId>(sorted[e].first & 0xffffffffu);
+            if (row_voter.empty() || row_voter.back() != voter) {
+                row_voter.push_back(voter);
+                row_offsets.push_back(static_cast<uint32_t>(e));
+            }
+            column_source[e] = source;
+            column_weight[e] = sorted[e].second->weight;
+            column_targeted[e] = sorted[e].second->targeted;
+            column_of[edge_key(source, voter)] = static_cast<uint32_t>(e);
+        }
+        row_offsets.push_back(static_cast<uint32_t>(sorted.size()));
+        dirty = false;
+    }
+
+    void propagate_rows(VoterPopulation& population, size_t begin, size_t end) {
+        const float* strength = source_strength.data();
+        for (size_t row = begin; row < end; ++row) {
+            float delta = 0.0f;
+            for (uint32_t e = row_offsets[row]; e < row_offsets[row + 1]; ++e) {
+                delta += column_weight[e] * strength[column_source[e]] + column_targeted[e];
+            }
+            deltas[row] = delta;
+        }
+
+        // Same rule as VoterPopulation::modify_opinion, one column at a time
+        const float* resistance = population.resistance_column();
+        for (VoterPopulation::TopicId topic = 0; topic < population.topic_count(); ++topic) {
+            float* column = population.opinion_column(topic);
+            for (size_t row = begin; row < end; ++row) {
+                if (deltas[row] == 0.0f) continue;
+                VoterIndex voter = row_voter[row];
+                float actual_delta = deltas[row] * (1.0f - resistance[voter]);
+                column[voter] = std::clamp(column[voter] + actual_delta, -1.0f, 1.0f);
+            }
+        }
+    }
+};
+
+}  // namespace game_systems
+
+#endif // INFLUENCE_GRAPH_HPP
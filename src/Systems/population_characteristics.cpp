@@ -81,6 +81,32 @@ void PopulationCharacteristics::deserialize_population(const Dictionary& data) {
     if (data.has("health_level")) health_level = static_cast<float>(data["health_level"]);
 }
 
+void PopulationCharacteristics::save_section(Core::SaveSection& section) const {
+    section.put<int32_t>(size);
+    section.put(growth_rate);
+    section.put(education_level);
+    section.put(health_level);
+}
+
+bool PopulationCharacteristics::read_section(Core::SaveSectionReader& section, SavedRecord& record) {
+    return section.get(record.size) && section.get(record.growth_rate) &&
+           section.get(record.education_level) && section.get(record.health_level);
+}
+
+void PopulationCharacteristics::apply_section(const SavedRecord& record) {
+    set_size(record.size);
+    set_growth_rate(record.growth_rate);
+    education_level = record.education_level;
+    health_level = record.health_level;
+}
+
+bool PopulationCharacteristics::load_section(Core::SaveSectionReader& section) {
+    SavedRecord record;
+    if (!read_section(section, record)) return false;
+    apply_section(record);
+    return true;
+}
+
 // Getters/Setters
 void PopulationCharacteristics::set_size(int p_size) {
     size = std::clamp(p_size, 0, 1000000);
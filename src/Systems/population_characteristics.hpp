@@ -5,6 +5,7 @@
 #include <godot_cpp/core/class_db.hpp>
 #include "waypoint_stats.hpp"
 #include "terrain_feature.hpp"
+#include "../Core/SaveArchive.hpp"
 
 namespace game_systems {
 
@@ -34,6 +35,22 @@ public:
     Dictionary serialize_population() const;
     void deserialize_population(const Dictionary& data);
 
+    // Fixed-size binary record, appended to the shared "populations"
+    // section in waypoint order
+    void save_section(Core::SaveSection& section) const;
+    bool load_section(Core::SaveSectionReader& section);
+
+    // A decoded record, so the shared section can be read in full before
+    // any population changes
+    struct SavedRecord {
+        int32_t size{0};
+        float growth_rate{0.0f};
+        float education_level{0.0f};
+        float health_level{0.0f};
+    };
+    static bool read_section(Core::SaveSectionReader& section, SavedRecord& record);
+    void apply_section(const SavedRecord& record);
+
     // Getters/Setters
     void set_size(int p_size);
     int get_size() const;
@@ -1,6 +1,11 @@
 #include "region.hpp"
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
+#include <algorithm>
+#include <random>
+#include "voting_influencer.hpp"
+#include "../Core/WorkerPool.hpp"
+#include "../Core/WorldSeed.hpp"
 
 namespace game_systems {
 
@@ -8,27 +13,109 @@ void Region::_bind_methods() {
     ClassDB::bind_method(D_METHOD("set_name", "name"), &Region::set_name);
     ClassDB::bind_method(D_METHOD("get_name"), &Region::get_name);
     ClassDB::bind_method(D_METHOD("initialize_elections"), &Region::initialize_elections);
-    ClassDB::bind_method(D_METHOD("handle_elections", "delta"), &Region::handle_elections);
+    ClassDB::bind_method(D_METHOD("get_time_until_election", "index"), &Region::get_time_until_election);
+    ClassDB::bind_method(D_METHOD("set_electorate_mode", "mode", "virtual_size"), &Region::set_electorate_mode_bound);
+    ClassDB::bind_method(D_METHOD("get_electorate_mode"), &Region::get_electorate_mode_bound);
+    ClassDB::bind_method(D_METHOD("attach_influencer", "influencer"), &Region::attach_influencer);
+    ClassDB::bind_method(D_METHOD("detach_influencer", "influencer"), &Region::detach_influencer);
 
     ADD_PROPERTY(PropertyInfo(Variant::STRING, "name"), "set_name", "get_name");
 }
 
+template<typename F>
+void Region::for_each_influencer(F&& visit) {
+    for (auto id : influencers) {
+        if (auto* influencer = Object::cast_to<VotingInfluencer>(ObjectDB::get_instance(id))) {
+            visit(*influencer);
+        }
+    }
+}
+
 Region::Region() : name(""), stats() {
     initialize_voters();
+    bind_save_section();
 }
 
 Region::Region(const String& p_name) : name(p_name), stats() {
     initialize_voters();
+    bind_save_section();
+}
+
+Region::~Region() {
+    for_each_influencer([this](VotingInfluencer& influencer) {
+        influencer.detach_population(&voters);
+        influencer.detach_cohorts(&cohorts);
+    });
+    auto& scheduler = Core::GameScheduler::get_instance();
+    for (auto timer : election_timers) {
+        scheduler.cancel(timer);
+    }
+}
+
+void Region::attach_influencer(VotingInfluencer* influencer) {
+    if (!influencer) return;
+    uint64_t id = influencer->get_instance_id();
+    if (std::find(influencers.begin(), influencers.end(), id) == influencers.end()) {
+        influencers.push_back(id);
+    }
+    influencer->attach_population(&voters);
+    influencer->register_cohorts(&cohorts);
+}
+
+void Region::detach_influencer(VotingInfluencer* influencer) {
+    if (!influencer) return;
+    influencers.erase(std::remove(influencers.begin(), influencers.end(), influencer->get_instance_id()),
+                      influencers.end());
+    influencer->detach_population(&voters);
+    influencer->detach_cohorts(&cohorts);
+}
+
+void Region::set_name(const String& p_name) {
+    name = p_name;
+    bind_save_section();
+}
+
+// Unnamed regions are not saved until they get a name
+void Region::bind_save_section() {
+    saved_voters.reset();
+    if (name.is_empty()) return;
+    std::string key = std::string("voters:") + name.utf8().get_data();
+    if (!saved_voters.bind(key, 4,
+            [this](Core::SaveSection& section) { voters.save_section(section); },
+            [this](Core::SaveSectionReader& section) { return voters.load_section(section); })) {
+        UtilityFunctions::print("Region ", name, ": another region already saves as ", String(key.c_str()));
+    }
 }
 
 void Region::initialize_voters() {
     // Create initial voter population
     const int BASE_VOTERS = 1000;
-    voters.reserve(BASE_VOTERS);
-    
-    for (int i = 0; i < BASE_VOTERS; i++) {
-        voters.push_back(std::make_unique<Voter>());
+    voters.add_voters(BASE_VOTERS);
+}
+
+void Region::set_electorate_mode(ElectorateMode mode, uint64_t virtual_size) {
+    if (mode == ElectorateMode::COHORT && electorate_mode != ElectorateMode::COHORT) {
+        // Cohort indices change, so influences on the old cohorts go first
+        for_each_influencer([this](VotingInfluencer& influencer) { influencer.detach_cohorts(&cohorts); });
+        cohorts = VoterCohorts();
+        cohorts.add_cohort_from_population(
+            name.utf8().get_data(), voters, 0, voters.size(), virtual_size);
+        for_each_influencer([this](VotingInfluencer& influencer) { influencer.register_cohorts(&cohorts); });
+    } else if (mode == ElectorateMode::EXACT && electorate_mode == ElectorateMode::COHORT &&
+               cohorts.size() > 0) {
+        // Hand the opinion shifts the cohort took while it stood in for
+        // the voters back to them, topic by topic
+        for (VoterPopulation::TopicId topic = 0; topic < voters.topic_count(); ++topic) {
+            voters.shift_topic(topic, 0, voters.size(), cohorts.mean_shift(0, topic));
+        }
     }
+    electorate_mode = mode;
+}
+
+void Region::set_electorate_mode_bound(int mode, int64_t virtual_size) {
+    set_electorate_mode(mode == static_cast<int>(ElectorateMode::COHORT) ? ElectorateMode::COHORT
+                                                                          : ElectorateMode::EXACT,
+                        static_cast<uint64_t>(std::max<int64_t>(virtual_size, 0)));
 }
 
 void Region::initialize_elections() {
@@ -36,33 +123,48 @@ void Region::initialize_elections() {
     mayoral_election->set_title("Mayoral Election");
     mayoral_election->set_type(ElectionType::MAYOR);
     mayoral_election->set_frequency(1.0);
-    mayoral_election->set_next_election_time(godot::UtilityFunctions::randf() * 3600.0);
+    // Per-region stream, so the offset survives replays and region order
+    std::mt19937_64 rng(Core::WorldSeed::get_instance().derive("elections", name.utf8().get_data()));
+    mayoral_election->set_next_election_time(std::uniform_real_distribution<double>(0.0, 1.0)(rng) * 3600.0);
     
     elections.push_back(std::move(mayoral_election));
-}
 
-void Region::handle_elections(double delta) {
-    for (auto& election : elections) {
-        if (election->get_next_election_time() <= 0.0) {
-            conduct_election(election.get());
-            election->set_next_election_time(election->get_frequency() * 3600.0);
-        } else {
-            election->set_next_election_time(election->get_next_election_time() - delta);
-        }
+    auto& scheduler = Core::GameScheduler::get_instance();
+    for (size_t i = election_timers.size(); i < elections.size(); ++i) {
+        Election* election = elections[i].get();
+        election_timers.push_back(scheduler.schedule_every(
+            election->get_frequency() * 3600.0,
+            [this, election]() { conduct_election(election); },
+            election->get_next_election_time()));
     }
 }
 
+double Region::get_time_until_election(int index) const {
+    if (index < 0 || index >= static_cast<int>(election_timers.size())) return -1.0;
+    return Core::GameScheduler::get_instance().time_until(election_timers[index]);
+}
+
 void Region::conduct_election(Election* election) {
     auto candidates = load_candidates(election->get_type());
     
-    // Count votes using modern C++ algorithms
-    std::vector<std::pair<Candidate*, int>> results;
+    auto profiles = build_candidate_profiles(candidates);
+
+    std::vector<std::pair<Candidate*, double>> results;
     results.reserve(candidates.size());
 
-    for (auto& candidate : candidates) {
-        int votes = std::count_if(voters.begin(), voters.end(),
-            [&](const auto& voter) { return voter->supports(&candidate, this); });
-        results.push_back({&candidate, votes});
+    if (electorate_mode == ElectorateMode::COHORT) {
+        auto tally = cohorts.tally(profiles);
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            results.push_back({&candidates[i], tally.expected_votes[i]});
+        }
+    } else {
+        // Single pass over the voter columns scores every candidate at once;
+        // large populations are split across the shared pool
+        ThreadPool* pool = voters.size() > VoterPopulation::PARALLEL_CHUNK ? &Core::WorkerPool::get_instance() : nullptr;
+        auto tally = voters.tally(profiles, pool);
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            results.push_back({&candidates[i], static_cast<double>(tally.votes[i])});
+        }
     }
 
     // Find winner
@@ -78,4 +180,36 @@ void Region::conduct_election(Election* election) {
         winner->apply_policies(this);
     }
 }
+
+std::vector<VoterPopulation::CandidateProfile> Region::build_candidate_profiles(
+    const std::vector<Candidate>& candidates) {
+    // Platform thresholds against region stats are the same for every
+    // voter, so they fold into one base score per candidate (the
+    // Voter::supports rule). Every platform key is also an opinion topic,
+    // adding a per-voter term weighted by the platform value; keys voters
+    // had no opinion on start neutral and move with influence.
+    const float OPINION_WEIGHT = 10.0f;
+
+    std::vector<VoterPopulation::CandidateProfile> profiles;
+    profiles.reserve(candidates.size());
+
+    for (const auto& candidate : candidates) {
+        VoterPopulation::CandidateProfile profile;
+        Dictionary platform = candidate.get_platform();
+        Array keys = platform.keys();
+
+        for (int i = 0; i < keys.size(); i++) {
+            String key = keys[i];
+            float value = platform[key];
+            float region_stat = stats.get_stat_value(key);
+            profile.base_score += region_stat >= value ? 10.0f : -5.0f;
+
+            auto topic = voters.intern_topic(key.utf8().get_data());
+            profile.topic_weights.push_back({topic, OPINION_WEIGHT * value / 100.0f});
+        }
+        profiles.push_back(std::move(profile));
+    }
+    cohorts.ensure_topics(voters.topic_count());
+    return profiles;
+}
 }  // namespace game_systems 
\ No newline at end of file
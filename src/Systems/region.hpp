@@ -7,10 +7,23 @@
 #include <memory>
 #include "election.hpp"
 #include "voter.hpp"
+#include "voter_population.hpp"
+#include "voter_cohorts.hpp"
 #include "node_stats.hpp"
+#include "../Core/GameScheduler.hpp"
+#include "../Core/SaveRegistry.hpp"
+
+class VotingInfluencer;
 
 namespace game_systems {
 
+// EXACT tallies every voter; COHORT tallies opinion distributions, which
+// costs the same for any electorate size and reports error bounds
+enum class ElectorateMode {
+    EXACT,
+    COHORT
+};
+
 class Region : public godot::Node {
     GDCLASS(Region, Node)
 
@@ -18,10 +31,24 @@ private:
     String name;
     NodeStats stats;
     std::vector<std::unique_ptr<Election>> elections;
-    std::vector<std::unique_ptr<Voter>> voters;
+    VoterPopulation voters;
+    VoterCohorts cohorts;
+    ElectorateMode electorate_mode{ElectorateMode::EXACT};
+    // Recurring GameScheduler timers, one per election
+    std::vector<Core::GameScheduler::TimerId> election_timers;
+    // The voter columns, saved as "voters:<name>"
+    Core::SavedSection saved_voters;
+    // Influencers acting on this electorate; looked up by id, since an
+    // influencer may be freed before the region
+    std::vector<uint64_t> influencers;
 
     void initialize_voters();
+    void bind_save_section();
+    template<typename F>
+    void for_each_influencer(F&& visit);
     void conduct_election(Election* election);
+    std::vector<VoterPopulation::CandidateProfile> build_candidate_profiles(
+        const std::vector<Candidate>& candidates);
     std::vector<Candidate> load_candidates(ElectionType type);
 
 protected:
@@ -30,17 +57,38 @@ protected:
 public:
     Region();
     explicit Region(const String& p_name);
-    ~Region() = default;
+    ~Region();
 
+    // Elections run from recurring GameScheduler deadlines
     void initialize_elections();
-    void handle_elections(double delta);
+    double get_time_until_election(int index) const;
 
     // Getters/Setters
-    void set_name(const String& p_name) { name = p_name; }
+    void set_name(const String& p_name);
     String get_name() const { return name; }
     NodeStats* get_stats() { return &stats; }
     
-    const std::vector<std::unique_ptr<Voter>>& get_voters() const { return voters; }
+    const VoterPopulation& get_voters() const { return voters; }
+    VoterPopulation& get_voters() { return voters; }
+    // Adds a voter with its opinions; returns its index in get_voters()
+    size_t add_voter(const Voter& voter, float loyalty = 0.5f, float independence = 0.5f) {
+        return voters.add_voter(voter, loyalty, independence);
+    }
+
+    // Switching to COHORT summarises the current voters into one cohort
+    // standing for virtual_size voters (0 keeps the real count); switching
+    // back applies the cohort's opinion shifts to the voters
+    void set_electorate_mode(ElectorateMode mode, uint64_t virtual_size = 0);
+    ElectorateMode get_electorate_mode() const { return electorate_mode; }
+    // Script-facing forms; mode is 0 for EXACT, 1 for COHORT
+    void set_electorate_mode_bound(int mode, int64_t virtual_size);
+    int get_electorate_mode_bound() const { return static_cast<int>(electorate_mode); }
+    VoterCohorts& get_cohorts() { return cohorts; }
+
+    // Points the influencer at this region's voters and cohorts. The region
+    // detaches it before it rebuilds the cohorts or goes away.
+    void attach_influencer(VotingInfluencer* influencer);
+    void detach_influencer(VotingInfluencer* influencer);
 };
 
 }  // namespace game_systems
@@ -0,0 +1,355 @@
+#ifndef VOTER_COHORTS_HPP
+#define VOTER_COHORTS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "voter_population.hpp"
+
+namespace game_systems {
+
+// Approximate electorate: voters are aggregated into demographic cohorts
+// and each cohort keeps one opinion histogram per topic instead of one
+// value per voter. Opinion shifts, influences and tallies cost the same
+// whether a cohort stands for a thousand voters or a hundred million.
+//
+// Topic IDs line up with the VoterPopulation a cohort set was built from,
+// so the same CandidateProfiles tally both paths. Tallies return expected
+// approval counts plus an error bound against the per-voter path.
+class VoterCohorts {
+public:
+    using TopicId = VoterPopulation::TopicId;
+
+    static constexpr size_t BINS = 64;
+    static constexpr float BIN_WIDTH = 2.0f / BINS;
+    // Affinity (loyalty and independence terms of the score) is kept as a
+    // distribution over [-1, 1] in units of this weight
+    static constexpr float AFFINITY_SCALE =
+        std::max(VoterPopulation::LOYALTY_WEIGHT, VoterPopulation::INDEPENDENCE_WEIGHT);
+
+    struct TopicDistribution {
+        // Fraction of the cohort per opinion bin over [-1, 1]
+        std::array<float, BINS> histogram{};
+        // Sub-bin shift not yet folded into the histogram
+        float offset{0.0f};
+
+        float mean() const {
+            float total = 0.0f;
+            for (size_t b = 0; b < BINS; ++b) total += histogram[b] * bin_center(b);
+            return std::clamp(total + offset, -1.0f, 1.0f);
+        }
+
+        float variance() const {
+            return central_moment(2);
+        }
+
+        float central_moment(int order) const {
+            float m = mean() - offset;
+            float total = 0.0f;
+            for (size_t b = 0; b < BINS; ++b) {
+                float d = std::abs(bin_center(b) - m);
+                total += histogram[b] * (order == 2 ? d * d : d * d * d);
+            }
+            return total;
+        }
+    };
+
+    struct Cohort {
+        std::string name;
+        uint64_t size{0};
+        float loyalty{0.5f};
+        float independence{0.5f};
+        float resistance{0.0f};
+        // Per-voter affinity / AFFINITY_SCALE; a point mass unless the
+        // cohort was summarised from a population
+        TopicDistribution affinity;
+        std::vector<TopicDistribution> topics;
+        // Topic means when the cohort was built, so later shifts can be
+        // handed back to a per-voter population
+        std::vector<float> initial_means;
+    };
+
+    struct TallyResult {
+        std::vector<double> expected_votes;
+        // Absolute bound per candidate on |cohort tally - per-voter tally|
+        std::vector<double> error_bound;
+        uint64_t voters{0};
+    };
+
+private:
+    std::vector<Cohort> cohorts;
+    size_t topic_count{0};
+
+public:
+    size_t size() const { return cohorts.size(); }
+    Cohort& get_cohort(size_t index) { return cohorts[index]; }
+    const Cohort& get_cohort(size_t index) const { return cohorts[index]; }
+
+    uint64_t voter_count() const {
+        uint64_t total = 0;
+        for (const auto& cohort : cohorts) total += cohort.size;
+        return total;
+    }
+
+    size_t find_cohort(const std::string& name) const {
+        for (size_t i = 0; i < cohorts.size(); ++i) {
+            if (cohorts[i].name == name) return i;
+        }
+        return cohorts.size();
+    }
+
+    size_t add_cohort(const std::string& name, uint64_t cohort_size,
+                      float loyalty = 0.5f, float independence = 0.5f) {
+        Cohort cohort{name, cohort_size, loyalty, independence, 0.0f, {}, {}, {}};
+        cohort.affinity.histogram[value_to_bin(
+            (loyalty * VoterPopulation::LOYALTY_WEIGHT -
+             independence * VoterPopulation::INDEPENDENCE_WEIGHT) / AFFINITY_SCALE)] = 1.0f;
+        cohort.topics.resize(topic_count);
+        for (auto& topic : cohort.topics) {
+            // Everyone starts neutral, as new VoterPopulation voters do
+            topic.histogram[value_to_bin(0.0f)] = 1.0f;
+        }
+        cohorts.push_back(std::move(cohort));
+        return cohorts.size() - 1;
+    }
+
+    // Summarises voters [begin, end) of a population into one cohort.
+    // virtual_size lets the cohort stand for more voters than were sampled.
+    size_t add_cohort_from_population(const std::string& name,
+                                      const VoterPopulation& population,
+                                      size_t begin, size_t end,
+                                      uint64_t virtual_size = 0) {
+        ensure_topics(population.topic_count());
+        const size_t count = end - begin;
+        size_t index = add_cohort(name, virtual_size ? virtual_size : count);
+        if (count == 0) return index;
+
+        Cohort& cohort = cohorts[index];
+        const float weight = 1.0f / static_cast<float>(count);
+        float loyalty = 0.0f, independence = 0.0f, resistance = 0.0f;
+        cohort.affinity.histogram.fill(0.0f);
+        for (size_t v = begin; v < end; ++v) {
+            float voter_loyalty = population.get_loyalty(v);
+            float voter_independence = population.get_independence(v);
+            loyalty += voter_loyalty;
+            independence += voter_independence;
+            resistance += population.get_resistance(v);
+            cohort.affinity.histogram[value_to_bin(
+                (voter_loyalty * VoterPopulation::LOYALTY_WEIGHT -
+                 voter_independence * VoterPopulation::INDEPENDENCE_WEIGHT) / AFFINITY_SCALE)] += weight;
+        }
+        cohort.loyalty = loyalty * weight;
+        cohort.independence = independence * weight;
+        cohort.resistance = resistance * weight;
+
+        cohort.initial_means.assign(population.topic_count(), 0.0f);
+        for (TopicId topic = 0; topic < population.topic_count(); ++topic) {
+            auto& histogram = cohort.topics[topic].histogram;
+            histogram.fill(0.0f);
+            const float* column = population.opinion_column(topic);
+            for (size_t v = begin; v < end; ++v) {
+                histogram[value_to_bin(column[v])] += weight;
+            }
+            cohort.initial_means[topic] = cohort.topics[topic].mean();
+        }
+        return index;
+    }
+
+    void ensure_topics(size_t count) {
+        if (count <= topic_count) return;
+        for (auto& cohort : cohorts) {
+            size_t old = cohort.topics.size();
+            cohort.topics.resize(count);
+            for (size_t t = old; t < count; ++t) {
+                cohort.topics[t].histogram[value_to_bin(0.0f)] = 1.0f;
+            }
+        }
+        topic_count = count;
+    }
+
+    // Distribution form of Voter::modify_opinion: every topic of every
+    // voter in the cohort moves by delta damped by resistance, clamped
+    void modify_opinion(size_t cohort_index, float delta) {
+        Cohort& cohort = cohorts[cohort_index];
+        float actual_delta = delta * (1.0f - cohort.resistance);
+        for (auto& topic : cohort.topics) shift(topic, actual_delta);
+    }
+
+    void modify_topic(size_t cohort_index, TopicId topic, float delta) {
+        Cohort& cohort = cohorts[cohort_index];
+        shift(cohort.topics[topic], delta * (1.0f - cohort.resistance));
+    }
+
+    // How far a topic's mean has moved since the cohort was built
+    float mean_shift(size_t cohort_index, TopicId topic) const {
+        const Cohort& cohort = cohorts[cohort_index];
+        if (topic >= cohort.topics.size()) return 0.0f;
+        float initial = topic < cohort.initial_means.size() ? cohort.initial_means[topic] : 0.0f;
+        return cohort.topics[topic].mean() - initial;
+    }
+
+    // Expected approval counts. Affinity counts as one more distribution
+    // next to the opinion topics, so the bound covers how loyalty and
+    // independence vary inside a cohort. Up to two distributions are read
+    // off the histograms directly; more are combined with a normal
+    // approximation bounded by Berry-Esseen. Distributions are treated as
+    // independent within a cohort, and the bound does not cover that.
+    TallyResult tally(const std::vector<VoterPopulation::CandidateProfile>& candidates) const {
+        TallyResult result;
+        result.expected_votes.assign(candidates.size(), 0.0);
+        result.error_bound.assign(candidates.size(), 0.0);
+        result.voters = voter_count();
+
+        for (const auto& cohort : cohorts) {
+            const double n = static_cast<double>(cohort.size);
+
+            for (size_t c = 0; c < candidates.size(); ++c) {
+                float approx_error = 0.0f;
+                float p = approval_probability(cohort, candidates[c], approx_error);
+
+                result.expected_votes[c] += n * p;
+                // Approximation error plus a 3-sigma binomial term for how a
+                // concrete per-voter population would scatter around p
+                result.error_bound[c] += n * approx_error +
+                                         3.0 * std::sqrt(n * p * (1.0 - p));
+            }
+        }
+        return result;
+    }
+
+private:
+    static float bin_center(size_t bin) {
+        return -1.0f + (static_cast<float>(bin) + 0.5f) * BIN_WIDTH;
+    }
+
+    static size_t value_to_bin(float value) {
+        float scaled = (std::clamp(value, -1.0f, 1.0f) + 1.0f) / BIN_WIDTH;
+        return std::min(static_cast<size_t>(scaled), BINS - 1);
+    }
+
+    // Whole-bin shifts move mass exactly, piling clamped voters into the
+    // edge bins; the fractional remainder stays in offset so repeated small
+    // deltas do not smear the histogram
+    static void shift(TopicDistribution& topic, float delta) {
+        topic.offset += delta;
+        int whole = static_cast<int>(topic.offset / BIN_WIDTH);
+        if (whole == 0) return;
+        topic.offset -= static_cast<float>(whole) * BIN_WIDTH;
+
+        std::array<float, BINS> shifted{};
+        for (int b = 0; b < static_cast<int>(BINS); ++b) {
+            int target = std::clamp(b + whole, 0, static_cast<int>(BINS) - 1);
+            shifted[target] += topic.histogram[b];
+        }
+        topic.histogram = shifted;
+    }
+
+    // P(opinion > threshold), interpolating linearly inside a bin;
+    // bin_mass receives the mass of the bin the threshold falls in
+    static float tail_probability(const TopicDistribution& topic,
+                                  float threshold, float& bin_mass) {
+        float t = threshold - topic.offset;
+        bin_mass = 0.0f;
+        if (t < -1.0f) return 1.0f;
+        if (t >= 1.0f) return 0.0f;
+
+        size_t bin = value_to_bin(t);
+        float above = 0.0f;
+        for (size_t b = bin + 1; b < BINS; ++b) above += topic.histogram[b];
+        float bin_start = -1.0f + static_cast<float>(bin) * BIN_WIDTH;
+        float fraction_above = 1.0f - (t - bin_start) / BIN_WIDTH;
+        bin_mass = topic.histogram[bin];
+        return above + bin_mass * fraction_above;
+    }
+
+    // Histogram mass of every bin overlapping [lo, hi]
+    static float mass_between(const TopicDistribution& topic, float lo, float hi) {
+        lo -= topic.offset;
+        hi -= topic.offset;
+        if (hi < -1.0f || lo >= 1.0f) return 0.0f;
+        float mass = 0.0f;
+        for (size_t b = value_to_bin(lo); b <= value_to_bin(hi); ++b) {
+            mass += topic.histogram[b];
+        }
+        return mass;
+    }
+
+    // P(w1*x1 + w2*x2 + k > 0), summing over the bins of x1. The error
+    // bound covers x1 varying inside its bin and the interpolation of x2.
+    static float pair_probability(const TopicDistribution& x1, float w1,
+                                  const TopicDistribution& x2, float w2,
+                                  float constant, float& approx_error) {
+        float p = 0.0f;
+        approx_error = 0.0f;
+        for (size_t b = 0; b < BINS; ++b) {
+            float mass = x1.histogram[b];
+            if (mass <= 0.0f) continue;
+
+            float center = std::clamp(bin_center(b) + x1.offset, -1.0f, 1.0f);
+            float threshold = -(constant + w1 * center) / w2;
+            float unused = 0.0f;
+            float tail = tail_probability(x2, threshold, unused);
+            p += mass * (w2 > 0.0f ? tail : 1.0f - tail);
+
+            float spread = std::abs(w1 / w2) * BIN_WIDTH * 0.5f;
+            approx_error += mass * mass_between(x2, threshold - spread, threshold + spread);
+        }
+        approx_error = std::min(approx_error, 1.0f);
+        return std::clamp(p, 0.0f, 1.0f);
+    }
+
+    float approval_probability(const Cohort& cohort,
+                               const VoterPopulation::CandidateProfile& candidate,
+                               float& approx_error) const {
+        float constant = candidate.base_score;
+        std::vector<std::pair<const TopicDistribution*, float>> terms;
+        terms.push_back({&cohort.affinity, AFFINITY_SCALE});
+        for (const auto& [topic, weight] : candidate.topic_weights) {
+            if (topic < cohort.topics.size() && weight != 0.0f) {
+                terms.push_back({&cohort.topics[topic], weight});
+            }
+        }
+
+        if (terms.size() == 1) {
+            // w*x + k > 0  <=>  x > -k/w (w > 0) or x < -k/w (w < 0)
+            const auto& [topic, weight] = terms[0];
+            float threshold = -constant / weight;
+            float p = tail_probability(*topic, threshold, approx_error);
+            return weight > 0.0f ? p : 1.0f - p;
+        }
+
+        if (terms.size() == 2) {
+            // Summing over the lighter-weighted distribution keeps the
+            // in-bin threshold spread, and so the bound, small
+            if (std::abs(terms[0].second) > std::abs(terms[1].second)) std::swap(terms[0], terms[1]);
+            return pair_probability(*terms[0].first, terms[0].second,
+                                    *terms[1].first, terms[1].second,
+                                    constant, approx_error);
+        }
+
+        double mean = constant, variance = 0.0, third_moment = 0.0;
+        for (const auto& [topic, weight] : terms) {
+            double w = weight;
+            mean += w * topic->mean();
+            variance += w * w * topic->variance();
+            third_moment += std::abs(w * w * w) * topic->central_moment(3);
+        }
+
+        if (variance <= 1e-12) {
+            approx_error = 0.0f;
+            return mean > 0.0 ? 1.0f : 0.0f;
+        }
+
+        double sigma = std::sqrt(variance);
+        approx_error = static_cast<float>(
+            std::min(1.0, 0.56 * third_moment / (sigma * sigma * sigma)));
+        return static_cast<float>(0.5 * std::erfc(-mean / (sigma * std::sqrt(2.0))));
+    }
+};
+
+}  // namespace game_systems
+
+#endif // VOTER_COHORTS_HPP
@@ -0,0 +1,243 @@
+#ifndef VOTER_POPULATION_HPP
+#define VOTER_POPULATION_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+#include <immintrin.h>
+#include "Voter.hpp"
+#include "../AI/Core/StringInterner.hpp"
+#include "../AI/Core/ThreadPool.hpp"
+#include "../Core/SaveArchive.hpp"
+
+namespace game_systems {
+
+// Columnar voter store. Each topic is one contiguous float column of
+// opinions (-1..1) indexed by voter, with loyalty, independence and
+// influence resistance as extra columns. A region can hold millions of
+// voters without a heap object per voter.
+//
+// Elections are tallied in a single pass over the columns: for each block
+// of 8 voters every candidate is scored at once, and the approval count
+// (score > 0, the same rule as Voter::supports) is accumulated per
+// candidate.
+class VoterPopulation {
+public:
+    using TopicId = StringInterner::Id;
+
+    // Per-candidate scoring: base_score holds the voter-independent part
+    // (e.g. platform vs region stats); each topic weight multiplies the
+    // voter's opinion on that topic
+    struct CandidateProfile {
+        float base_score{0.0f};
+        std::vector<std::pair<TopicId, float>> topic_weights;
+    };
+
+    struct TallyResult {
+        std::vector<uint64_t> votes;
+        uint64_t voters{0};
+    };
+
+    static constexpr float LOYALTY_WEIGHT = 10.0f;
+    static constexpr float INDEPENDENCE_WEIGHT = 5.0f;
+    static constexpr size_t PARALLEL_CHUNK = 1 << 16;
+
+private:
+    StringInterner topics;
+    std::vector<std::vector<float>> opinions;  // [topic][voter]
+    std::vector<float> loyalty;                // 0..1
+    std::vector<float> independence;           // 0..1
+    std::vector<float> resistance;             // 0..1
+
+public:
+    TopicId intern_topic(const std::string& topic) {
+        TopicId id = topics.intern(topic);
+        if (id >= opinions.size()) opinions.resize(static_cast<size_t>(id) + 1,
+                                                   std::vector<float>(size(), 0.0f));
+        return id;
+    }
+
+    TopicId find_topic(const std::string& topic) const { return topics.find(topic); }
+    size_t topic_count() const { return opinions.size(); }
+    size_t size() const { return loyalty.size(); }
+
+    void add_voters(size_t count,
+                    float voter_loyalty = 0.5f,
+                    float voter_independence = 0.5f) {
+        size_t new_size = size() + count;
+        for (auto& column : opinions) column.resize(new_size, 0.0f);
+        loyalty.resize(new_size, voter_loyalty);
+        independence.resize(new_size, voter_independence);
+        resistance.resize(new_size, 0.0f);
+    }
+
+    // Imports one Voter record; each of its opinion topics becomes a column
+    // and its resistance is the mean of the per-opinion resistances
+    size_t add_voter(const Voter& voter,
+                     float voter_loyalty = 0.5f,
+                     float voter_independence = 0.5f) {
+        size_t index = size();
+        add_voters(1, voter_loyalty, voter_independence);
+        float total_resistance = 0.0f;
+        for (const auto& opinion : voter.get_opinions()) {
+            set_opinion(index, intern_topic(opinion.topic), opinion.value);
+            total_resistance += opinion.influence_resistance;
+        }
+        if (!voter.get_opinions().empty()) {
+            set_resistance(index, total_resistance / static_cast<float>(voter.get_opinions().size()));
+        }
+        return index;
+    }
+
+    float get_opinion(size_t voter, TopicId topic) const {
+        return topic < opinions.size() ? opinions[topic][voter] : 0.0f;
+    }
+
+    void set_opinion(size_t voter, TopicId topic, float value) {
+        opinions[topic][voter] = std::clamp(value, -1.0f, 1.0f);
+    }
+
+    // Same rule as Voter::modify_opinion: every topic moves by delta,
+    // damped by the voter's resistance
+    void modify_opinion(size_t voter, float delta) {
+        float actual_delta = delta * (1.0f - resistance[voter]);
+        for (auto& column : opinions) {
+            column[voter] = std::clamp(column[voter] + actual_delta, -1.0f, 1.0f);
+        }
+    }
+
+    // Moves one topic of voters [begin, end) by delta, clamped; resistance
+    // is the caller's business (e.g. already applied to a cohort shift)
+    void shift_topic(TopicId topic, size_t begin, size_t end, float delta) {
+        if (topic >= opinions.size() || delta == 0.0f) return;
+        float* column = opinions[topic].data();
+        for (size_t v = begin; v < end; ++v) column[v] = std::clamp(column[v] + delta, -1.0f, 1.0f);
+    }
+
+    void set_loyalty(size_t voter, float value) { loyalty[voter] = std::clamp(value, 0.0f, 1.0f); }
+    void set_independence(size_t voter, float value) { independence[voter] = std::clamp(value, 0.0f, 1.0f); }
+    void set_resistance(size_t voter, float value) { resistance[voter] = std::clamp(value, 0.0f, 1.0f); }
+    float get_loyalty(size_t voter) const { return loyalty[voter]; }
+    float get_independence(size_t voter) const { return independence[voter]; }
+    float get_resistance(size_t voter) const { return resistance[voter]; }
+
+    float* opinion_column(TopicId topic) { return opinions[topic].data(); }
+    const float* opinion_column(TopicId topic) const { return opinions[topic].data(); }
+    const float* resistance_column() const { return resistance.data(); }
+
+    // Columns are written whole; topic names are stored so ids can be
+    // re-interned on load
+    void save_section(Core::SaveSection& section) const {
+        section.put<uint64_t>(opinions.size());
+        for (size_t topic = 0; topic < opinions.size(); ++topic) {
+            section.put_string(topics.name(static_cast<TopicId>(topic)));
+            section.put_array(opinions[topic]);
+        }
+        section.put_array(loyalty);
+        section.put_array(independence);
+        section.put_array(resistance);
+    }
+
+    bool load_section(Core::SaveSectionReader& section) {
+        VoterPopulation loaded;
+        uint64_t topic_count = 0;
+        section.get(topic_count);
+        std::string name;
+        for (uint64_t i = 0; i < topic_count && section.ok(); ++i) {
+            section.get_string(name);
+            section.get_array(loaded.opinions[loaded.intern_topic(name)]);
+        }
+        section.get_array(loaded.loyalty);
+        section.get_array(loaded.independence);
+        section.get_array(loaded.resistance);
+        for (const auto& column : loaded.opinions) {
+            if (column.size() != loaded.size()) return false;
+        }
+        if (!section.ok() || loaded.independence.size() != loaded.size() || loaded.resistance.size() != loaded.size()) {
+            return false;
+        }
+        *this = std::move(loaded);
+        return true;
+    }
+
+    // Tallies every voter; with a pool the population is split into
+    // independent chunks whose counts are summed afterwards
+    TallyResult tally(const std::vector<CandidateProfile>& candidates,
+                      ThreadPool* pool = nullptr) const {
+        TallyResult result;
+        result.votes.assign(candidates.size(), 0);
+        result.voters = size();
+
+        if (!pool || size() <= PARALLEL_CHUNK) {
+            tally_range(candidates, 0, size(), result.votes.data());
+            return result;
+        }
+
+        const size_t chunks = (size() + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+        std::vector<std::vector<uint64_t>> partial(chunks,
+            std::vector<uint64_t>(candidates.size(), 0));
+        std::vector<std::future<void>> pending;
+        pending.reserve(chunks);
+
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            size_t begin = chunk * PARALLEL_CHUNK;
+            size_t end = std::min(begin + PARALLEL_CHUNK, size());
+            pending.push_back(pool->enqueue([this, &candidates, &partial, chunk, begin, end]() {
+                tally_range(candidates, begin, end, partial[chunk].data());
+            }));
+        }
+        for (auto& future : pending) future.wait();
+
+        for (const auto& counts : partial) {
+            for (size_t c = 0; c < counts.size(); ++c) result.votes[c] += counts[c];
+        }
+        return result;
+    }
+
+    // Adds approval counts for voters [begin, end) into votes
+    void tally_range(const std::vector<CandidateProfile>& candidates,
+                     size_t begin, size_t end, uint64_t* votes) const {
+        size_t v = begin;
+#if defined(__AVX2__) && defined(__FMA__)
+        const __m256 loyalty_weight = _mm256_set1_ps(LOYALTY_WEIGHT);
+        const __m256 independence_weight = _mm256_set1_ps(INDEPENDENCE_WEIGHT);
+        const __m256 zero = _mm256_setzero_ps();
+
+        for (; v + 8 <= end; v += 8) {
+            __m256 affinity = _mm256_fmsub_ps(
+                _mm256_loadu_ps(&loyalty[v]), loyalty_weight,
+                _mm256_mul_ps(_mm256_loadu_ps(&independence[v]), independence_weight));
+
+            for (size_t c = 0; c < candidates.size(); ++c) {
+                const auto& candidate = candidates[c];
+                __m256 score = _mm256_add_ps(affinity, _mm256_set1_ps(candidate.base_score));
+                for (const auto& [topic, weight] : candidate.topic_weights) {
+                    if (topic >= opinions.size()) continue;
+                    score = _mm256_fmadd_ps(_mm256_set1_ps(weight),
+                                            _mm256_loadu_ps(&opinions[topic][v]),
+                                            score);
+                }
+                int mask = _mm256_movemask_ps(_mm256_cmp_ps(score, zero, _CMP_GT_OQ));
+                votes[c] += static_cast<uint64_t>(__builtin_popcount(static_cast<unsigned>(mask)));
+            }
+        }
+#endif
+        for (; v < end; ++v) {
+            float affinity = loyalty[v] * LOYALTY_WEIGHT - independence[v] * INDEPENDENCE_WEIGHT;
+            for (size_t c = 0; c < candidates.size(); ++c) {
+                float score = candidates[c].base_score + affinity;
+                for (const auto& [topic, weight] : candidates[c].topic_weights) {
+                    if (topic < opinions.size()) score += weight * opinions[topic][v];
+                }
+                if (score > 0.0f) ++votes[c];
+            }
+        }
+    }
+};
+
+}  // namespace game_systems
+
+#endif // VOTER_POPULATION_HPP
@@ -1,85 +1,185 @@
 #pragma once
 #include <godot_cpp/classes/node.hpp>
+#include <algorithm>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
-#include <memory>
-#include "../Systems/Voter.hpp"
+#include "../Systems/influence_graph.hpp"
+#include "../Systems/voter_cohorts.hpp"
 #include "../Systems/TimeSystem.hpp"
+#include "../Core/GameScheduler.hpp"
+#include "../Core/WorkerPool.hpp"
 
 class VotingInfluencer : public godot::Node {
     GDCLASS(VotingInfluencer, Node)
 
 private:
-    struct Influence {
-        std::string source_id;
-        std::string target_id;
-        float strength{0.0f};
-        float duration{0.0f};
-        bool is_positive{true};
+    // A registered cohort set. The serial tells a re-registered set at the
+    // same address apart from the one whose influences are still pending.
+    struct CohortSet {
+        game_systems::VoterCohorts* cohorts;
+        uint32_t serial;
+    };
+
+    // Cohort-mode edge: the summed strength of the targeted influences a
+    // source aims at one cohort
+    struct CohortEdge {
+        game_systems::InfluenceGraph::SourceId source;
+        game_systems::VoterCohorts* cohorts;
+        uint32_t set;
+        size_t cohort;
+        float strength;
+        uint32_t influences;
     };
 
-    std::vector<Influence> active_influences;
-    std::vector<std::weak_ptr<Voter>> affected_voters;
+    game_systems::InfluenceGraph graph;
+    game_systems::VoterPopulation* population{nullptr};
+    std::unordered_map<std::string, game_systems::InfluenceGraph::VoterIndex> voter_lookup;
+    // Cohort-mode electorates; influences whose target is a cohort name
+    // shift that cohort's opinion distribution
+    std::vector<CohortSet> cohort_sets;
+    std::vector<CohortEdge> cohort_edges;
+    uint32_t next_set_serial{1};
     TimeSystem* time_system{nullptr};
+    // Influence expiries on the shared GameScheduler
+    Core::ScheduledTimers expiries;
 
 public:
+    // Pushes the target (a registered voter or a cohort name) for
+    // `duration` seconds of game time. Each influence stays on its own
+    // edge, so opposite influences from one source on different targets
+    // do not cancel, and the edge goes away when it expires.
     void add_influence(const std::string& source_id, 
                       const std::string& target_id,
                       float strength,
                       float duration,
                       bool is_positive = true) {
-        active_influences.push_back({
-            source_id,
-            target_id,
-            strength,
-            duration,
-            is_positive
-        });
+        auto source = graph.intern_source(source_id);
+        float signed_strength = is_positive ? strength : -strength;
+
+        auto voter = voter_lookup.find(target_id);
+        if (voter != voter_lookup.end()) {
+            auto influence = graph.add_influence(source, voter->second, signed_strength);
+            expiries.schedule_in(duration, [this, influence]() { graph.remove_influence(influence); });
+            return;
+        }
+
+        for (const auto& set : cohort_sets) {
+            size_t cohort = set.cohorts->find_cohort(target_id);
+            if (cohort >= set.cohorts->size()) continue;
+            add_cohort_influence(source, set, cohort, signed_strength);
+            uint32_t serial = set.serial;
+            expiries.schedule_in(duration, [this, source, serial, cohort, signed_strength]() {
+                remove_cohort_influence(source, serial, cohort, signed_strength);
+            });
+        }
     }
 
-    void register_voter(std::shared_ptr<Voter> voter) {
-        affected_voters.push_back(voter);
+    // Campaign influence over the source's wired audience (see
+    // connect_audience) for `duration` seconds of game time
+    void add_campaign_influence(const std::string& source_id, float strength, float duration) {
+        auto influence = graph.add_campaign_influence(graph.intern_source(source_id), strength);
+        expiries.schedule_in(duration, [this, influence]() { graph.remove_influence(influence); });
     }
 
+    // Bulk audience wiring for campaigns reaching many voters at once
+    void connect_audience(const std::string& source_id,
+                          const std::vector<game_systems::InfluenceGraph::VoterIndex>& voters,
+                          float weight = 1.0f) {
+        graph.connect_audience(graph.intern_source(source_id), voters, weight);
+    }
+
+    // The owner of the population (a Region) detaches it again before
+    // the voters go away
+    void attach_population(game_systems::VoterPopulation* voters) {
+        if (population != voters) voter_lookup.clear();
+        population = voters;
+    }
+
+    void detach_population(const game_systems::VoterPopulation* voters) {
+        if (population != voters) return;
+        population = nullptr;
+        voter_lookup.clear();
+    }
+
+    // False if no population is attached or the index is not one of its voters
+    bool register_voter(const std::string& voter_id,
+                        game_systems::InfluenceGraph::VoterIndex index) {
+        if (!population || index >= population->size()) return false;
+        voter_lookup[voter_id] = index;
+        return true;
+    }
+
+    void register_cohorts(game_systems::VoterCohorts* cohorts) {
+        for (const auto& set : cohort_sets) {
+            if (set.cohorts == cohorts) return;
+        }
+        cohort_sets.push_back({cohorts, next_set_serial++});
+    }
+
+    // Drops the set and the influences on its cohorts; called by the owner
+    // before it rebuilds or frees the cohorts. Pending expiries of those
+    // influences find nothing to remove.
+    void detach_cohorts(const game_systems::VoterCohorts* cohorts) {
+        for (size_t i = 0; i < cohort_sets.size(); ++i) {
+            if (cohort_sets[i].cohorts != cohorts) continue;
+            uint32_t serial = cohort_sets[i].serial;
+            cohort_sets.erase(cohort_sets.begin() + i);
+            cohort_edges.erase(std::remove_if(cohort_edges.begin(), cohort_edges.end(),
+                [serial](const CohortEdge& edge) { return edge.set == serial; }), cohort_edges.end());
+            return;
+        }
+    }
+
+    game_systems::InfluenceGraph& get_graph() { return graph; }
+
     void _ready() override {
         time_system = get_node<TimeSystem>("../TimeSystem");
     }
 
+    // Expiries fire from the GameScheduler on scaled game time; while the
+    // game is paused nothing is applied either
     void _process(float delta) override {
-        update_influences(delta);
+        if (time_system && time_system->get_time_scale() <= 0.0f) return;
         apply_influences();
     }
 
 private:
-    void update_influences(float delta) {
-        auto it = active_influences.begin();
-        while (it != active_influences.end()) {
-            it->duration -= delta;
-            if (it->duration <= 0) {
-                it = active_influences.erase(it);
-            } else {
-                ++it;
+    void add_cohort_influence(game_systems::InfluenceGraph::SourceId source,
+                              const CohortSet& set, size_t cohort, float strength) {
+        for (auto& edge : cohort_edges) {
+            if (edge.source == source && edge.set == set.serial && edge.cohort == cohort) {
+                edge.strength += strength;
+                ++edge.influences;
+                return;
             }
         }
+        cohort_edges.push_back({source, set.cohorts, set.serial, cohort, strength, 1});
+    }
+
+    void remove_cohort_influence(game_systems::InfluenceGraph::SourceId source,
+                                 uint32_t set, size_t cohort, float strength) {
+        for (size_t i = 0; i < cohort_edges.size(); ++i) {
+            CohortEdge& edge = cohort_edges[i];
+            if (edge.source != source || edge.set != set || edge.cohort != cohort) continue;
+            edge.strength -= strength;
+            if (--edge.influences == 0) {
+                cohort_edges[i] = cohort_edges.back();
+                cohort_edges.pop_back();
+            }
+            return;
+        }
     }
 
     void apply_influences() {
-        // Clean up expired voter references
-        affected_voters.erase(
-            std::remove_if(affected_voters.begin(), affected_voters.end(),
-                [](const auto& weak_voter) { return weak_voter.expired(); }),
-            affected_voters.end()
-        );
-
-        // Apply influences to remaining voters
-        for (const auto& weak_voter : affected_voters) {
-            if (auto voter = weak_voter.lock()) {
-                for (const auto& influence : active_influences) {
-                    if (voter->get_id() == influence.target_id) {
-                        float modifier = influence.is_positive ? 1.0f : -1.0f;
-                        voter->modify_opinion(influence.strength * modifier);
-                    }
-                }
+        if (population && graph.active_count() > 0) {
+            graph.propagate(*population, &Core::WorkerPool::get_instance());
+        }
+
+        for (const auto& edge : cohort_edges) {
+            if (edge.strength != 0.0f && edge.cohort < edge.cohorts->size()) {
+                edge.cohorts->modify_opinion(edge.cohort, edge.strength);
             }
         }
     }
@@ -89,5 +189,7 @@ protected:
         ClassDB::bind_method(D_METHOD("add_influence", "source_id", "target_id", 
                                     "strength", "duration", "is_positive"),
                            &VotingInfluencer::add_influence);
+        ClassDB::bind_method(D_METHOD("add_campaign_influence", "source_id", "strength", "duration"),
+                           &VotingInfluencer::add_campaign_influence);
     }
-}; 
\ No newline at end of file
+};
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include "Events/ConditionEvaluator.hpp"
+#include "TestHarness.hpp"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using Op = ConditionEvaluator::Op;
+
+namespace {
+
+// The same trees evaluated one region at a time without masks, memo or
+// short-circuit
+struct Reference {
+    struct Node {
+        enum class Kind { LEAF, ALL, ANY } kind;
+        uint32_t variable;
+        Op op;
+        float threshold;
+        std::vector<size_t> children;
+    };
+    std::vector<Node> nodes;
+    std::vector<std::vector<float>> values;  // [variable][region]
+
+    bool holds(size_t id, size_t region) const {
+        const Node& node = nodes[id];
+        if (node.kind == Node::Kind::LEAF) {
+            float value = values[node.variable][region];
+            switch (node.op) {
+                case Op::LT: return value < node.threshold;
+                case Op::LE: return value <= node.threshold;
+                case Op::GT: return value > node.threshold;
+                case Op::GE: return value >= node.threshold;
+                case Op::EQ: return value == node.threshold;
+                case Op::NE: return value != node.threshold;
+            }
+            return false;
+        }
+        bool all = node.kind == Node::Kind::ALL;
+        for (size_t child : node.children) {
+            if (holds(child, region) != all) return !all;
+        }
+        return all;
+    }
+};
+
+// Builds matching random trees in both evaluators. Leaves are drawn from
+// a small pool so identical leaves recur across roots and within one
+// tree, which is what the leaf memo shares.
+struct Forest {
+    ConditionEvaluator evaluator;
+    Reference reference;
+    std::vector<ConditionEvaluator::NodeId> ids;  // Reference node -> evaluator node
+    std::vector<size_t> roots;                    // Reference nodes
+    std::vector<ConditionEvaluator::NodeId> root_ids;
+
+    size_t add_leaf(std::mt19937& rng, size_t variables) {
+        static const Op OPS[] = {Op::LT, Op::LE, Op::GT, Op::GE, Op::EQ, Op::NE};
+        uint32_t variable = static_cast<uint32_t>(rng() % variables);
+        Op op = OPS[rng() % 6];
+        float threshold = static_cast<float>(rng() % 5);
+        ids.push_back(evaluator.add_condition("v" + std::to_string(variable), op, threshold));
+        reference.nodes.push_back({Reference::Node::Kind::LEAF, variable, op, threshold, {}});
+        return reference.nodes.size() - 1;
+    }
+
+    size_t add_tree(std::mt19937& rng, size_t variables, int depth) {
+        if (depth == 0 || rng() % 3 == 0) return add_leaf(rng, variables);
+        // Empty groups included: ALL of nothing holds, ANY of nothing never
+        size_t count = rng() % 5;
+        std::vector<size_t> children;
+        std::vector<ConditionEvaluator::NodeId> child_ids;
+        for (size_t c = 0; c < count; ++c) {
+            children.push_back(add_tree(rng, variables, depth - 1));
+            child_ids.push_back(ids[children.back()]);
+        }
+        bool all = rng() % 2 == 0;
+        ids.push_back(all ? evaluator.add_all(child_ids) : evaluator.add_any(child_ids));
+        reference.nodes.push_back({all ? Reference::Node::Kind::ALL : Reference::Node::Kind::ANY,
+                                   0, Op::EQ, 0.0f, std::move(children)});
+        return reference.nodes.size() - 1;
+    }
+};
+
+void check_matches(Forest& forest, size_t regions) {
+    forest.evaluator.evaluate(forest.root_ids);
+    const size_t words = forest.evaluator.words_per_mask();
+    for (size_t root = 0; root < forest.roots.size(); ++root) {
+        bool everywhere = true;
+        for (size_t region = 0; region < regions; ++region) {
+            bool expected = forest.reference.holds(forest.roots[root], region);
+            CHECK(forest.evaluator.holds(root, region) == expected);
+            everywhere = everywhere && expected;
+        }
+        CHECK(forest.evaluator.holds_everywhere(root) == everywhere);
+        // Padding lanes past the last region never report true
+        const uint64_t* mask = forest.evaluator.mask(root);
+        for (size_t lane = regions; lane < words * ConditionEvaluator::BLOCK; ++lane) {
+            CHECK(((mask[lane / ConditionEvaluator::BLOCK] >> (lane % ConditionEvaluator::BLOCK)) & 1u) == 0);
+        }
+    }
+}
+
+void test_random_trees() {
+    std::mt19937 rng(1234);
+    const size_t region_counts[] = {1, 7, 63, 64, 65, 200};
+    for (size_t regions : region_counts) {
+        for (int round = 0; round < 20; ++round) {
+            const size_t variables = 1 + rng() % 4;
+            auto forest = std::make_unique<Forest>();
+            forest->evaluator.set_region_count(regions);
+            for (int root = 0; root < 12; ++root) {
+                forest->roots.push_back(forest->add_tree(rng, variables, 3));
+                forest->root_ids.push_back(forest->ids[forest->roots.back()]);
+            }
+
+            // Small integer values so EQ and the ties of LE/GE come up
+            forest->reference.values.assign(variables, std::vector<float>(regions));
+            for (size_t v = 0; v < variables; ++v) {
+                uint32_t id = forest->evaluator.variable("v" + std::to_string(v));
+                for (size_t region = 0; region < regions; ++region) {
+                    float value = static_cast<float>(rng() % 5);
+                    forest->reference.values[v][region] = value;
+                    forest->evaluator.set_value(id, region, value);
+                }
+                // Padding lanes hold values that satisfy NE, GT and the rest
+                float* column = forest->evaluator.column(id);
+                for (size_t lane = regions; lane < forest->evaluator.words_per_mask() * ConditionEvaluator::BLOCK; ++lane) {
+                    column[lane] = static_cast<float>(rng() % 5);
+                }
+            }
+            check_matches(*forest, regions);
+
+            // The memo is per evaluation; changed values are seen next time
+            for (size_t v = 0; v < variables; ++v) {
+                uint32_t id = forest->evaluator.variable("v" + std::to_string(v));
+                size_t region = rng() % regions;
+                float value = static_cast<float>(rng() % 5);
+                forest->reference.values[v][region] = value;
+                forest->evaluator.set_value(id, region, value);
+            }
+            check_matches(*forest, regions);
+        }
+    }
+}
+
+void test_short_circuit_keeps_memo_valid() {
+    // The first root stops its AND at a leaf that clears every bit, so the
+    // shared leaf after it is never evaluated there; the second root must
+    // still compute it rather than read a stale memo entry
+    ConditionEvaluator evaluator;
+    evaluator.set_region_count(70);
+    ConditionEvaluator::NodeId never = evaluator.add_condition("a", Op::GT, 100.0f);
+    ConditionEvaluator::NodeId shared = evaluator.add_condition("b", Op::GE, 1.0f);
+    ConditionEvaluator::NodeId always = evaluator.add_condition("a", Op::LT, 100.0f);
+    uint32_t b = evaluator.variable("b");
+    for (size_t region = 0; region < 70; ++region) evaluator.set_value(b, region, region % 2 ? 1.0f : 0.0f);
+
+    std::vector<ConditionEvaluator::NodeId> roots = {
+        evaluator.add_all({never, shared}),
+        evaluator.add_all({shared}),
+        evaluator.add_any({always, shared}),
+        evaluator.add_any({shared, always}),
+    };
+    evaluator.evaluate(roots);
+    for (size_t region = 0; region < 70; ++region) {
+        CHECK(!evaluator.holds(0, region));
+        CHECK(evaluator.holds(1, region) == (region % 2 == 1));
+        CHECK(evaluator.holds(2, region));
+        CHECK(evaluator.holds(3, region));
+    }
+    CHECK(evaluator.holds_everywhere(2) && !evaluator.holds_everywhere(1));
+}
+
+void test_identical_leaves_share_a_node() {
+    ConditionEvaluator evaluator;
+    evaluator.set_region_count(1);
+    CHECK(evaluator.add_condition("a", Op::GT, 1.0f) == evaluator.add_condition("a", Op::GT, 1.0f));
+    CHECK(evaluator.add_condition("a", Op::GT, 1.0f) != evaluator.add_condition("a", Op::GE, 1.0f));
+    CHECK(evaluator.add_condition("a", Op::GT, 1.0f) != evaluator.add_condition("b", Op::GT, 1.0f));
+
+    // Cleared conditions start over; variables and their values stay
+    uint32_t a = evaluator.variable("a");
+    evaluator.set_value(a, 0, 5.0f);
+    evaluator.clear_conditions();
+    std::vector<ConditionEvaluator::NodeId> roots = {evaluator.add_condition("a", Op::GT, 1.0f)};
+    CHECK(roots[0] == 0);
+    evaluator.evaluate(roots);
+    CHECK(evaluator.holds(0, 0));
+}
+
+void test_region_count_keeps_values() {
+    ConditionEvaluator evaluator;
+    evaluator.set_region_count(3);
+    uint32_t a = evaluator.variable("a");
+    evaluator.set_value(a, 2, 9.0f);
+    evaluator.set_region_count(130);
+    std::vector<ConditionEvaluator::NodeId> roots = {evaluator.add_condition("a", Op::GT, 1.0f)};
+    evaluator.evaluate(roots);
+    CHECK(evaluator.words_per_mask() == 3);
+    CHECK(evaluator.holds(0, 2) && !evaluator.holds(0, 1) && !evaluator.holds(0, 129));
+}
+
+} // namespace
+
+int main() {
+    test_random_trees();
+    test_short_circuit_keeps_memo_valid();
+    test_identical_leaves_share_a_node();
+    test_region_count_keeps_values();
+    return TEST_RESULT();
+}
@@ -0,0 +1,194 @@
+#include "Data/DataIngest.hpp"
+#include "TestHarness.hpp"
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+using namespace Data;
+
+namespace {
+
+// Compact text form of a parsed value; dictionaries come out key-sorted
+// because the cache sorts them
+std::string dump(const DataCache::Value& value) {
+    switch (value.type()) {
+        case DataCache::Type::NIL: return "null";
+        case DataCache::Type::BOOL: return value.as_bool() ? "true" : "false";
+        case DataCache::Type::INT: return std::to_string(value.as_int());
+        case DataCache::Type::FLOAT: {
+            char text[32];
+            std::snprintf(text, sizeof(text), "%g", value.as_float());
+            return std::string(text) + "f";
+        }
+        case DataCache::Type::STRING: return "\"" + std::string(value.as_string()) + "\"";
+        case DataCache::Type::ARRAY: {
+            std::string text = "[";
+            for (size_t i = 0; i < value.size(); ++i) text += (i ? "," : "") + dump(value.at(i));
+            return text + "]";
+        }
+        case DataCache::Type::DICTIONARY: {
+            std::string text = "{";
+            for (size_t i = 0; i < value.size(); ++i) {
+                text += (i ? "," : "") + std::string(value.key_at(i).as_string()) + ":" + dump(value.value_at(i));
+            }
+            return text + "}";
+        }
+    }
+    return "?";
+}
+
+// Parses through CacheBuilder into a cache image and reads it back; ""
+// on a parse error, with the error in `error`
+std::string parse(std::string_view source, DataFormat format, IngestError* error = nullptr) {
+    DataCacheWriter writer;
+    CacheBuilder builder(writer);
+    IngestError ignored;
+    IngestError& out = error ? *error : ignored;
+    if (!ingest(source, format, builder, out) || !builder.is_complete()) return "";
+    DataCache cache;
+    if (!cache.open_image(writer.finish(1), 1)) return "";
+    return dump(cache.root());
+}
+
+void test_json_values() {
+    CHECK(parse(R"({"a": 1, "b": -2.5, "c": [true, false, null], "d": {}})", DataFormat::JSON) ==
+          R"({a:1,b:-2.5f,c:[true,false,null],d:{}})");
+    CHECK(parse("\xEF\xBB\xBF[1e3, 0, -0.0, 12345678901234567890]", DataFormat::JSON) ==
+          "[1000f,0,-0f,1.23457e+19f]");
+    CHECK(parse("[9223372036854775807, -9223372036854775808]", DataFormat::JSON) ==
+          "[9223372036854775807,-9223372036854775808]");
+}
+
+void test_json_escapes() {
+    CHECK(parse(R"(["a\"b\\c\/d", "\n\t\r\b\f"])", DataFormat::JSON) == "[\"a\"b\\c/d\",\"\n\t\r\b\f\"]");
+    CHECK(parse(R"(["\u00e9\u20AC", "\ud83d\ude00", "x\u0041y"])", DataFormat::JSON) ==
+          "[\"\xC3\xA9\xE2\x82\xAC\",\"\xF0\x9F\x98\x80\",\"xAy\"]");
+    // Long strings take the vectorised scan, with the escape at the end
+    std::string long_text(100, 'q');
+    CHECK(parse("[\"" + long_text + "\\n\"]", DataFormat::JSON) == "[\"" + long_text + "\n\"]");
+}
+
+void test_json_errors() {
+    IngestError error;
+    CHECK(parse("{\"a\": 1,\n\"b\": }", DataFormat::JSON, &error).empty());
+    CHECK(error.line == 2);
+
+    const char* invalid[] = {
+        R"(["\ud83d"])",          // High surrogate alone
+        R"(["\ud83dx"])",
+        R"(["\ud83d\u0041"])",    // High surrogate followed by a non-surrogate
+        R"(["\ude00"])",          // Low surrogate alone
+        R"(["\u12G4"])",
+        R"(["\q"])",
+        "[\"tab\there\"]",
+        R"(["open)",
+        "[1,]",
+        "{\"a\" 1}",
+        "[01x]",
+        "[-]",
+        "[1.]",
+        "[1e]",
+        "[tru]",
+        "[1] 2",
+        "",
+    };
+    for (const char* source : invalid) {
+        IngestError failure;
+        CHECK(parse(source, DataFormat::JSON, &failure).empty());
+        CHECK(!failure.message.empty());
+    }
+}
+
+void test_yaml() {
+    CHECK(parse("a: yes\nb: 'yes'\nc: off\nd: ~\ne: 0x1F\nf: .inf\ng: 3.5\nh: text\n", DataFormat::YAML) ==
+          R"({a:true,b:"yes",c:false,d:null,e:31,f:inff,g:3.5f,h:"text"})");
+
+    // Aliases replay scalars and whole collections
+    CHECK(parse("base: &stats {wood: 5, stone: [1, 2]}\nname: &n granary\ncopy: *stats\nlabel: *n\n",
+                DataFormat::YAML) ==
+          R"({base:{stone:[1,2],wood:5},copy:{stone:[1,2],wood:5},label:"granary",name:"granary"})");
+
+    IngestError error;
+    CHECK(parse("? [a, b]\n: 1\n", DataFormat::YAML, &error).empty());
+    CHECK(error.message == "collection used as a mapping key");
+    CHECK(parse("a: [1, 2\nb: 3\n", DataFormat::YAML, &error).empty());
+    CHECK(error.line > 0);
+}
+
+void test_xml() {
+    // Repeated children and <buildings><building/></buildings> fold into
+    // arrays; attributes and text become members
+    CHECK(parse("<data><buildings><building id=\"mill\" cost=\"10\"/></buildings>"
+                "<tag>a</tag><tag>b</tag><note lang=\"en\">hello</note><empty/></data>", DataFormat::XML) ==
+          R"({buildings:[{cost:10,id:"mill"}],empty:null,note:{lang:"en",text:"hello"},tag:["a","b"]})");
+
+    // Only true/false are booleans in XML; YAML words stay text
+    CHECK(parse("<flags><a>true</a><b>no</b><c>on</c><d>NO</d><e>false</e><f>1.5</f><g>~</g></flags>",
+                DataFormat::XML) == R"({a:true,b:"no",c:"on",d:"NO",e:false,f:1.5f,g:"~"})");
+
+    IngestError error;
+    CHECK(parse("<data><open></data>", DataFormat::XML, &error).empty());
+    CHECK(!error.message.empty());
+}
+
+struct ScalarProbe : DataSink {
+    std::string seen;
+    void null() override { seen = "null"; }
+    void boolean(bool value) override { seen = value ? "true" : "false"; }
+    void integer(int64_t value) override { seen = std::to_string(value); }
+    void real(double value) override { seen = std::isnan(value) ? "nan" : std::to_string(value); }
+    void string(std::string_view value) override { seen = "\"" + std::string(value) + "\""; }
+    void begin_array() override {}
+    void end_array() override {}
+    void begin_object() override {}
+    void key(std::string_view) override {}
+    void end_object() override {}
+};
+
+std::string scalar(std::string_view text, ScalarRules rules) {
+    ScalarProbe probe;
+    emit_scalar(probe, text, rules);
+    return probe.seen;
+}
+
+void test_scalar_rules() {
+    CHECK(scalar("YES", ScalarRules::YAML) == "true" && scalar("YES", ScalarRules::XML) == "\"YES\"");
+    CHECK(scalar("Off", ScalarRules::YAML) == "false" && scalar("Off", ScalarRules::XML) == "\"Off\"");
+    CHECK(scalar("null", ScalarRules::YAML) == "null" && scalar("null", ScalarRules::XML) == "\"null\"");
+    CHECK(scalar(".nan", ScalarRules::YAML) == "nan" && scalar(".nan", ScalarRules::XML) == "\".nan\"");
+    CHECK(scalar("", ScalarRules::XML) == "null");
+    CHECK(scalar("true", ScalarRules::XML) == "true");
+    CHECK(scalar("+42", ScalarRules::XML) == "42" && scalar("-7", ScalarRules::YAML) == "-7");
+    // strtod would take these; data files mean them as text
+    CHECK(scalar("inf", ScalarRules::YAML) == "\"inf\"" && scalar("0x1p3", ScalarRules::XML) == "\"0x1p3\"");
+    CHECK(scalar("1e2", ScalarRules::XML) == std::to_string(100.0));
+}
+
+void test_sniff_format() {
+    CHECK(sniff_format("{\"a\": 1}") == DataFormat::JSON);
+    CHECK(sniff_format("\xEF\xBB\xBF  [1, 2]") == DataFormat::JSON);
+    CHECK(sniff_format("[\"a\"]") == DataFormat::JSON);
+    CHECK(sniff_format("# comment\n[section]\nkey = 1") == DataFormat::TOML);
+    CHECK(sniff_format("[[buildings]]\r\n") == DataFormat::TOML);
+    CHECK(sniff_format("name = \"a: b\"") == DataFormat::TOML);
+    CHECK(sniff_format("\n# comment\nname: value") == DataFormat::YAML);
+    CHECK(sniff_format("- item") == DataFormat::YAML);
+    CHECK(sniff_format("<?xml version=\"1.0\"?><a/>") == DataFormat::XML);
+    CHECK(sniff_format("") == DataFormat::UNKNOWN);
+    CHECK(sniff_format("# only a comment") == DataFormat::UNKNOWN);
+    CHECK(sniff_format("plain words") == DataFormat::UNKNOWN);
+}
+
+} // namespace
+
+int main() {
+    test_json_values();
+    test_json_escapes();
+    test_json_errors();
+    test_yaml();
+    test_xml();
+    test_scalar_rules();
+    test_sniff_format();
+    return TEST_RESULT();
+}
@@ -0,0 +1,170 @@
+#include "Systems/EventEligibility.hpp"
+#include "TestHarness.hpp"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using Systems::EventEligibility;
+using Systems::PredicateOp;
+using Systems::PredicateProgram;
+
+namespace {
+
+// Brute-force check of every clause against the current values
+struct Reference {
+    struct Clause { uint32_t variable; PredicateOp op; float operand; };
+    std::vector<std::vector<Clause>> events;
+    std::vector<float> values;
+
+    bool holds(size_t event) const {
+        for (const auto& clause : events[event]) {
+            float value = values[clause.variable];
+            bool ok = false;
+            switch (clause.op) {
+                case PredicateOp::LT: ok = value < clause.operand; break;
+                case PredicateOp::LE: ok = value <= clause.operand; break;
+                case PredicateOp::GT: ok = value > clause.operand; break;
+                case PredicateOp::GE: ok = value >= clause.operand; break;
+                case PredicateOp::EQ: ok = value == clause.operand; break;
+                case PredicateOp::NE: ok = value != clause.operand; break;
+            }
+            if (!ok) return false;
+        }
+        return true;
+    }
+};
+
+void test_parse() {
+    EventEligibility index;
+    PredicateProgram program;
+    CHECK(index.add_condition(program, "prosperity", ">= 40"));
+    CHECK(index.add_condition(program, "unrest", "< 10"));
+    CHECK(index.add_condition(program, "weather", "rain"));
+    CHECK(program.compiled);
+    CHECK(program.clauses.size() == 3);
+    CHECK(program.clauses[0].op == PredicateOp::GE && program.clauses[0].operand == 40.0f);
+    CHECK(program.clauses[1].op == PredicateOp::LT && program.clauses[1].operand == 10.0f);
+    CHECK(program.clauses[2].op == PredicateOp::EQ);
+
+    PredicateProgram ordered_word;
+    CHECK(!index.add_condition(ordered_word, "weather", "> rain"));
+    CHECK(!ordered_word.compiled);
+
+    PredicateProgram numeric_only;
+    CHECK(!index.add_condition(numeric_only, "weather", "rain", false));
+    CHECK(!numeric_only.compiled);
+
+    PredicateProgram empty;
+    CHECK(!index.add_condition(empty, "prosperity", "  "));
+}
+
+// Events enter and leave the eligible set as values cross their operands
+void test_thresholds_and_symbols() {
+    EventEligibility index;
+    PredicateProgram boom;
+    index.add_condition(boom, "prosperity", ">= 40");
+    index.add_condition(boom, "weather", "== sunny");
+    auto boom_id = index.add_event(boom, 2.0f);
+
+    PredicateProgram slump;
+    index.add_condition(slump, "prosperity", "< 20");
+    auto slump_id = index.add_event(slump);
+
+    CHECK(!index.is_eligible(boom_id));
+    CHECK(index.is_eligible(slump_id));
+
+    index.set_value("prosperity", 40.0f);
+    CHECK(!index.is_eligible(boom_id));
+    CHECK(!index.is_eligible(slump_id));
+
+    index.set_symbol("weather", "sunny");
+    CHECK(index.is_eligible(boom_id));
+    CHECK(index.eligible_count() == 1);
+    CHECK(index.eligible_weight() == 2.0);
+
+    index.set_symbol("weather", "rain");
+    CHECK(!index.is_eligible(boom_id));
+
+    index.set_value("prosperity", 5.0f);
+    CHECK(index.is_eligible(slump_id));
+    CHECK(index.eligible_count() == 1);
+}
+
+// Random programs and value walks agree with a brute-force evaluation
+void test_matches_reference() {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pick_variable(0, 3);
+    std::uniform_int_distribution<int> pick_op(0, 5);
+    std::uniform_int_distribution<int> pick_value(0, 10);
+    std::uniform_int_distribution<int> pick_clauses(1, 3);
+
+    EventEligibility index;
+    Reference reference;
+    reference.values.assign(4, 0.0f);
+    uint32_t variables[4];
+    for (int v = 0; v < 4; ++v) variables[v] = index.variable("v" + std::to_string(v));
+
+    for (int e = 0; e < 200; ++e) {
+        PredicateProgram program;
+        std::vector<Reference::Clause> clauses;
+        for (int c = pick_clauses(rng); c > 0; --c) {
+            int v = pick_variable(rng);
+            auto op = static_cast<PredicateOp>(pick_op(rng));
+            float operand = static_cast<float>(pick_value(rng));
+            index.add_clause(program, "v" + std::to_string(v), op, operand);
+            clauses.push_back({static_cast<uint32_t>(v), op, operand});
+        }
+        index.add_event(program, 1.0f + (e % 5));
+        reference.events.push_back(clauses);
+    }
+
+    for (int step = 0; step < 500; ++step) {
+        int v = pick_variable(rng);
+        float value = static_cast<float>(pick_value(rng));
+        index.set_value(variables[v], value);
+        reference.values[v] = value;
+
+        size_t expected = 0;
+        for (size_t e = 0; e < reference.events.size(); ++e) {
+            bool holds = reference.holds(e);
+            CHECK(index.is_eligible(static_cast<EventEligibility::EventId>(e)) == holds);
+            if (holds) ++expected;
+        }
+        CHECK(index.eligible_count() == expected);
+    }
+}
+
+// Draws come only from the eligible set, in proportion to weight
+void test_sampling() {
+    EventEligibility index;
+    PredicateProgram always;
+    auto light = index.add_event(always, 1.0f);
+    auto heavy = index.add_event(always, 3.0f);
+    PredicateProgram never;
+    index.add_condition(never, "x", "> 1");
+    index.add_event(never, 100.0f);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    int counts[2] = {0, 0};
+    for (int i = 0; i < 40000; ++i) {
+        auto event = index.sample([&]() { return uniform(rng); });
+        CHECK(event == light || event == heavy);
+        if (event == light || event == heavy) ++counts[event];
+    }
+    double share = counts[heavy] / 40000.0;
+    CHECK(share > 0.73 && share < 0.77);
+
+    EventEligibility empty;
+    CHECK(empty.sample([&]() { return uniform(rng); }) == EventEligibility::INVALID_EVENT);
+}
+
+} // namespace
+
+int main() {
+    test_parse();
+    test_thresholds_and_symbols();
+    test_matches_reference();
+    test_sampling();
+    return TEST_RESULT();
+}
@@ -0,0 +1,186 @@
+#include "Events/EventInstanceManager.hpp"
+#include "TestHarness.hpp"
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+
+using Handle = EventInstanceManager::Handle;
+
+namespace {
+
+std::vector<EventInstanceManager::EventId> expire(EventInstanceManager& manager, float delta) {
+    std::vector<EventInstanceManager::EventId> expired;
+    manager.expire(delta, [&expired](EventInstanceManager::EventId event) { expired.push_back(event); });
+    return expired;
+}
+
+void test_handles_outlive_their_instance() {
+    EventInstanceManager manager(4);
+    manager.reserve_events(3);
+    Handle first = manager.activate(0, 1.0f);
+    CHECK(manager.get(first) && manager.get(first)->event == 0);
+    CHECK(manager.is_active(0));
+
+    CHECK(expire(manager, 1.0f) == std::vector<EventInstanceManager::EventId>({0}));
+    CHECK(!manager.get(first) && !manager.is_active(0));
+
+    // The freed slot is reused under a new generation; the old handle
+    // stays dead
+    Handle second = manager.activate(1, 2.0f);
+    CHECK(second.slot == first.slot && second.generation != first.generation);
+    CHECK(!manager.get(first));
+    CHECK(manager.get(second) && manager.get(second)->event == 1);
+
+    // Ids outside the registered range and default handles resolve to nothing
+    CHECK(manager.activate(3, 1.0f) == Handle{});
+    CHECK(!manager.get(Handle{}) && !manager.is_active(3));
+}
+
+void test_activate_refreshes_instead_of_stacking() {
+    EventInstanceManager manager(4);
+    manager.reserve_events(2);
+    Handle handle = manager.activate(1, 2.0f);
+    CHECK(manager.activate(1, 5.0f) == handle);
+    CHECK(manager.activate(1, 3.0f) == handle);
+    CHECK(manager.size() == 1 && manager.get(handle)->lifetime == 5.0f);
+}
+
+void test_expiry_swaps_and_ages_each_instance_once() {
+    EventInstanceManager manager(8);
+    manager.reserve_events(6);
+    const float lifetimes[] = {5.0f, 1.0f, 4.0f, 1.0f, 3.0f, 1.0f};
+    std::vector<Handle> handles;
+    for (uint32_t event = 0; event < 6; ++event) handles.push_back(manager.activate(event, lifetimes[event]));
+
+    // 1 and 3 leave holes that the instances from the back fill; 5 is one
+    // of those and expires in its new position
+    std::vector<EventInstanceManager::EventId> expired = expire(manager, 1.0f);
+    std::sort(expired.begin(), expired.end());
+    CHECK(expired == std::vector<EventInstanceManager::EventId>({1, 3, 5}));
+    CHECK(manager.size() == 3);
+    for (uint32_t event : {0u, 2u, 4u}) {
+        const auto* instance = manager.get(handles[event]);
+        CHECK(instance && instance->event == event && instance->lifetime == lifetimes[event] - 1.0f);
+        CHECK(manager.is_active(event));
+    }
+    for (uint32_t event : {1u, 3u, 5u}) CHECK(!manager.get(handles[event]) && !manager.is_active(event));
+
+    // The packed array holds exactly the live instances
+    float total = 0.0f;
+    for (const auto& instance : manager.active()) total += instance.lifetime;
+    CHECK(total == 4.0f + 3.0f + 2.0f);
+
+    manager.clear();
+    CHECK(manager.size() == 0);
+    for (const Handle& handle : handles) CHECK(!manager.get(handle));
+}
+
+void test_active_set_is_bounded() {
+    EventInstanceManager manager(2);
+    manager.reserve_events(4);
+    Handle a = manager.activate(0, 1.0f);
+    manager.activate(1, 3.0f);
+    CHECK(manager.activate(2, 1.0f) == Handle{});
+    CHECK(manager.dropped_count() == 1 && manager.size() == manager.capacity());
+
+    // Refreshing a live instance is not an addition
+    CHECK(manager.activate(0, 2.0f) == a && manager.dropped_count() == 1);
+
+    expire(manager, 2.0f);
+    CHECK(manager.size() == 1);
+    CHECK(manager.get(manager.activate(2, 1.0f)));
+}
+
+void test_merge_applies_emitters_in_order() {
+    // Three jobs on their own threads; with room for two instances the
+    // ones that survive are decided by emitter order, not thread timing
+    EventInstanceManager manager(2);
+    manager.reserve_events(4);
+    manager.begin_emission(3);
+    std::vector<std::thread> jobs;
+    jobs.emplace_back([&manager] { manager.emit(2, 3, 1.0f); });
+    jobs.emplace_back([&manager] {
+        manager.emit(0, 1, 1.0f);
+        manager.emit(0, 1, 4.0f);
+    });
+    jobs.emplace_back([&manager] {
+        manager.emit(1, 2, 2.0f);
+        manager.emit(1, 1, 2.0f);
+    });
+    for (auto& job : jobs) job.join();
+
+    CHECK(manager.size() == 0);
+    manager.merge();
+    CHECK(manager.is_active(1) && manager.is_active(2) && !manager.is_active(3));
+    CHECK(manager.dropped_count() == 1);
+    CHECK(manager.active()[0].event == 1 && manager.active()[0].lifetime == 4.0f);
+    CHECK(manager.active()[1].event == 2);
+
+    // Buffers are emptied, so merging again changes nothing
+    manager.merge();
+    CHECK(manager.size() == 2 && manager.dropped_count() == 1);
+
+    // Fewer emitters next pass: the unused buffers hold nothing stale
+    manager.begin_emission(3);
+    manager.emit(2, 3, 1.0f);
+    manager.begin_emission(1);
+    manager.merge();
+    CHECK(manager.dropped_count() == 1);
+}
+
+void test_random_operations_match_a_map() {
+    std::mt19937 rng(99);
+    const uint32_t events = 40;
+    EventInstanceManager manager(16);
+    manager.reserve_events(events);
+    std::map<uint32_t, float> reference;  // event -> lifetime
+    uint64_t dropped = 0;
+
+    for (int round = 0; round < 2000; ++round) {
+        if (rng() % 3 != 0) {
+            uint32_t event = rng() % events;
+            float lifetime = static_cast<float>(1 + rng() % 8);
+            auto it = reference.find(event);
+            if (it != reference.end()) {
+                it->second = std::max(it->second, lifetime);
+            } else if (reference.size() < 16) {
+                reference[event] = lifetime;
+            } else {
+                ++dropped;
+            }
+            manager.activate(event, lifetime);
+        } else {
+            std::vector<EventInstanceManager::EventId> expected;
+            for (auto it = reference.begin(); it != reference.end();) {
+                it->second -= 1.0f;
+                if (it->second <= 0.0f) {
+                    expected.push_back(it->first);
+                    it = reference.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            std::vector<EventInstanceManager::EventId> expired = expire(manager, 1.0f);
+            std::sort(expired.begin(), expired.end());
+            CHECK(expired == expected);
+        }
+
+        CHECK(manager.size() == reference.size() && manager.dropped_count() == dropped);
+        std::map<uint32_t, float> live;
+        for (const auto& instance : manager.active()) live[instance.event] = instance.lifetime;
+        CHECK(live == reference);
+    }
+}
+
+} // namespace
+
+int main() {
+    test_handles_outlive_their_instance();
+    test_activate_refreshes_instead_of_stacking();
+    test_expiry_swaps_and_ages_each_instance_once();
+    test_active_set_is_bounded();
+    test_merge_applies_emitters_in_order();
+    test_random_operations_match_a_map();
+    return TEST_RESULT();
+}
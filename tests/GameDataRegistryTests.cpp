@@ -0,0 +1,346 @@
+#include "Data/GameDataRegistry.hpp"
+#include "Data/ModResolver.hpp"
+#include "TestHarness.hpp"
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Data;
+
+namespace {
+
+// Small document tree written through DataCacheWriter, standing in for a
+// parsed data file
+struct Doc {
+    enum Kind { NUMBER, STRING, ARRAY, DICTIONARY } kind{NUMBER};
+    double number{0.0};
+    std::string text;
+    std::vector<Doc> items;
+    std::vector<std::pair<std::string, Doc>> entries;
+};
+
+Doc number(double value) { Doc doc; doc.number = value; return doc; }
+Doc string(const std::string& value) { Doc doc; doc.kind = Doc::STRING; doc.text = value; return doc; }
+Doc array(std::vector<Doc> items) { Doc doc; doc.kind = Doc::ARRAY; doc.items = std::move(items); return doc; }
+Doc dictionary(std::vector<std::pair<std::string, Doc>> entries) {
+    Doc doc;
+    doc.kind = Doc::DICTIONARY;
+    doc.entries = std::move(entries);
+    return doc;
+}
+
+void write(DataCacheWriter& writer, uint32_t slot, const Doc& doc) {
+    switch (doc.kind) {
+        case Doc::NUMBER: writer.set_float(slot, doc.number); break;
+        case Doc::STRING: writer.set_string(slot, doc.text); break;
+        case Doc::ARRAY: {
+            uint32_t first = writer.set_array(slot, doc.items.size());
+            for (size_t i = 0; i < doc.items.size(); ++i) write(writer, first + static_cast<uint32_t>(i), doc.items[i]);
+            break;
+        }
+        case Doc::DICTIONARY: {
+            uint32_t first = writer.set_dictionary(slot, doc.entries.size());
+            for (size_t i = 0; i < doc.entries.size(); ++i) {
+                writer.set_string(first + static_cast<uint32_t>(2 * i), doc.entries[i].first);
+                write(writer, first + static_cast<uint32_t>(2 * i + 1), doc.entries[i].second);
+            }
+            break;
+        }
+    }
+}
+
+void ingest(GameDataRegistry& registry, const Doc& doc) {
+    DataCacheWriter writer;
+    write(writer, writer.reserve(1), doc);
+    DataCache cache;
+    CHECK(cache.open_image(writer.finish(1), 1));
+    registry.ingest(cache.root());
+}
+
+Doc event(const std::string& id, float gold, const std::string& next) {
+    return dictionary({
+        {"id", string(id)},
+        {"titleKey", string(id + "_title")},
+        {"description", string(id + " happens")},
+        {"conditions", dictionary({{"prosperity", string(">= 40")}})},
+        {"choices", array({dictionary({
+            {"choiceText", string("accept")},
+            {"outcome", dictionary({
+                {"effects", dictionary({{"gold", number(gold)}})},
+                {"triggerNextEvents", array({string(next)})},
+            })},
+        })})},
+    });
+}
+
+Doc world(float gold) {
+    return dictionary({
+        {"events", array({event("flood", gold, "famine"), event("famine", gold * 2, "flood")})},
+        {"buildings", array({dictionary({
+            {"id", string("granary")},
+            {"name", string("Granary")},
+            {"space_required", number(2)},
+            {"cost", dictionary({{"wood", number(30)}})},
+        })})},
+        {"actions", array({dictionary({
+            {"id", string("store_grain")},
+            {"requirements", dictionary({{"buildings", array({string("granary")})}})},
+            {"effects", dictionary({{"food", number(5)}})},
+        })})},
+    });
+}
+
+RecordId first_next_event(const GameDataRegistry& registry, RecordId event) {
+    auto choices = registry.view(registry.event(event).choices);
+    if (choices.empty()) return INVALID_RECORD;
+    auto next = registry.view(choices[0].next_events);
+    return next.empty() ? INVALID_RECORD : next[0];
+}
+
+void test_references_resolve() {
+    GameDataRegistry registry;
+    ingest(registry, world(10.0f));
+    RecordId flood = registry.find_event("flood");
+    RecordId famine = registry.find_event("famine");
+    CHECK(flood != INVALID_RECORD && famine != INVALID_RECORD);
+    CHECK(first_next_event(registry, flood) == famine);
+    CHECK(first_next_event(registry, famine) == flood);
+
+    RecordId store = registry.find_action("store_grain");
+    auto required = registry.view(registry.action(store).required_buildings);
+    CHECK(required.size() == 1 && required[0] == registry.find_building("granary"));
+
+    CHECK(registry.erase(RecordKind::EVENT, "famine"));
+    registry.resolve_references();
+    CHECK(first_next_event(registry, flood) == INVALID_RECORD);
+}
+
+// Replacing records over and over must not grow the pools without bound,
+// and compaction keeps every live span and reference intact
+void test_replacement_compacts_pools() {
+    GameDataRegistry registry;
+    ingest(registry, world(1.0f));
+    for (int round = 2; round <= 3000; ++round) ingest(registry, world(static_cast<float>(round)));
+
+    CHECK(registry.pool_elements() < 3 * 4096);
+    RecordId flood = registry.find_event("flood");
+    RecordId famine = registry.find_event("famine");
+    auto choices = registry.view(registry.event(famine).choices);
+    CHECK(choices.size() == 1);
+    CHECK(registry.stat(choices[0].effects, registry.find_text("gold")) == 6000.0f);
+    CHECK(first_next_event(registry, famine) == flood);
+    CHECK(registry.view(registry.event(flood).conditions).size() == 1);
+
+    RecordId granary = registry.find_building("granary");
+    CHECK(registry.stat(registry.building(granary).cost, registry.find_text("wood")) == 30.0f);
+    auto required = registry.view(registry.action(registry.find_action("store_grain")).required_buildings);
+    CHECK(required.size() == 1 && required[0] == granary);
+}
+
+void test_clear_bumps_generation() {
+    GameDataRegistry registry;
+    ingest(registry, world(1.0f));
+    uint32_t before = registry.generation();
+    registry.clear();
+    CHECK(registry.generation() == before + 1);
+    CHECK(!registry.is_live(RecordKind::EVENT, 0));
+    CHECK(registry.find_event("flood") == INVALID_RECORD);
+}
+
+std::unique_ptr<DataCache> compile(const Doc& doc) {
+    DataCacheWriter writer;
+    write(writer, writer.reserve(1), doc);
+    auto cache = std::make_unique<DataCache>();
+    CHECK(cache->open_image(writer.finish(1), 1));
+    return cache;
+}
+
+// A full resolve rebuilds the registry in place: surviving records keep
+// their RecordIds and bound views stay on the same generation
+void test_full_resolve_keeps_record_ids() {
+    GameDataRegistry registry;
+    ModResolver resolver;
+    std::vector<ModResolver::RecordKey> changed;
+    auto base = compile(world(1.0f));
+    resolver.set_base({base.get()});
+    resolver.resolve(registry, changed);
+    RecordId flood = registry.find_event("flood");
+    RecordId famine = registry.find_event("famine");
+    RecordId granary = registry.find_building("granary");
+    uint32_t generation = registry.generation();
+
+    auto famine_only = compile(dictionary({
+        {"events", array({event("famine", 4.0f, "flood")})},
+        {"buildings", array({dictionary({{"id", string("granary")}, {"name", string("Granary")}})})},
+    }));
+    resolver.set_base({famine_only.get()});
+    resolver.resolve(registry, changed);
+    CHECK(registry.generation() == generation);
+    CHECK(registry.find_event("famine") == famine);
+    CHECK(registry.find_building("granary") == granary);
+    CHECK(registry.find_event("flood") == INVALID_RECORD && !registry.is_live(RecordKind::EVENT, flood));
+    CHECK(first_next_event(registry, famine) == INVALID_RECORD);
+
+    resolver.set_base({base.get()});
+    resolver.resolve(registry, changed);
+    CHECK(registry.find_event("flood") == flood);
+    CHECK(first_next_event(registry, famine) == flood);
+    CHECK(registry.generation() == generation);
+}
+
+Doc building(const std::string& id, float wood) {
+    return dictionary({{"id", string(id)}, {"name", string(id)}, {"cost", dictionary({{"wood", number(wood)}})}});
+}
+
+Doc buildings(std::vector<Doc> items) { return dictionary({{"buildings", array(std::move(items))}}); }
+
+float wood(const GameDataRegistry& registry, const std::string& id) {
+    RecordId record = registry.find_building(id);
+    return record == INVALID_RECORD ? -1.0f
+                                    : registry.stat(registry.building(record).cost, registry.find_text("wood"));
+}
+
+bool has_change(const std::vector<ModResolver::RecordKey>& changed, const std::string& id) {
+    for (const auto& key : changed) {
+        if (key.kind == RecordKind::BUILDING && key.id == id) return true;
+    }
+    return false;
+}
+
+// Toggling re-resolves only the toggled mod's records, and a dependent
+// switched off by its dependency comes back with it
+void test_set_enabled_is_incremental() {
+    GameDataRegistry registry;
+    ModResolver resolver;
+    std::vector<ModResolver::RecordKey> changed;
+    auto base = compile(buildings({building("granary", 30), building("mill", 10)}));
+    auto walls = compile(buildings({building("granary", 40), building("wall", 50)}));
+    auto towers = compile(buildings({building("wall", 60)}));
+    resolver.set_base({base.get()});
+    resolver.add_mod("walls", {}, {walls.get()}, false);
+    resolver.add_mod("towers", {"walls"}, {towers.get()});
+    resolver.resolve(registry, changed);
+
+    // towers stays enabled but cannot be active without walls
+    CHECK(!resolver.is_active("walls") && !resolver.is_active("towers"));
+    CHECK(resolver.is_enabled("towers"));
+    CHECK(wood(registry, "granary") == 30.0f && wood(registry, "wall") == -1.0f);
+    RecordId granary = registry.find_building("granary");
+
+    changed.clear();
+    CHECK(resolver.set_enabled("walls", true, registry, changed).empty());
+    CHECK(resolver.is_active("walls") && resolver.is_active("towers"));
+    CHECK(wood(registry, "granary") == 40.0f && wood(registry, "wall") == 60.0f);
+    CHECK(registry.find_building("granary") == granary);
+    CHECK(has_change(changed, "granary") && has_change(changed, "wall") && !has_change(changed, "mill"));
+    CHECK(*resolver.provenance(RecordKind::BUILDING, "wall") == "towers");
+    CHECK(resolver.overrides(RecordKind::BUILDING, "granary") == std::vector<std::string>({"", "walls"}));
+
+    // An active dependent blocks disabling its dependency
+    changed.clear();
+    CHECK(resolver.set_enabled("walls", false, registry, changed) == std::vector<std::string>({"towers"}));
+    CHECK(changed.empty() && resolver.is_active("walls"));
+
+    CHECK(resolver.set_enabled("towers", false, registry, changed).empty());
+    CHECK(resolver.set_enabled("walls", false, registry, changed).empty());
+    CHECK(wood(registry, "granary") == 30.0f && wood(registry, "wall") == -1.0f);
+    CHECK(resolver.provenance(RecordKind::BUILDING, "wall") == nullptr);
+    CHECK(resolver.set_enabled("towers", true, registry, changed) == std::vector<std::string>({"walls"}));
+}
+
+// A reload touches the registry only for records that moved or that the
+// reloaded file edited
+void test_reload_layer_reports_edits() {
+    GameDataRegistry registry;
+    ModResolver resolver;
+    std::vector<ModResolver::RecordKey> changed;
+    auto base = compile(buildings({building("granary", 30), building("mill", 10)}));
+    auto mod = compile(buildings({building("granary", 40), building("mill", 15)}));
+    resolver.set_base({base.get()});
+    resolver.add_mod("farms", {}, {mod.get()});
+    resolver.resolve(registry, changed);
+    RecordId mill = registry.find_building("mill");
+
+    // granary edited, mill dropped from the mod, barn added
+    auto edited = compile(buildings({building("granary", 45), building("barn", 5)}));
+    changed.clear();
+    resolver.reload_layer("farms", {edited.get()}, {{RecordKind::BUILDING, "granary"}}, registry, changed);
+    CHECK(wood(registry, "granary") == 45.0f && wood(registry, "mill") == 10.0f && wood(registry, "barn") == 5.0f);
+    CHECK(registry.find_building("mill") == mill);
+    CHECK(has_change(changed, "granary") && has_change(changed, "mill") && has_change(changed, "barn"));
+    CHECK(*resolver.provenance(RecordKind::BUILDING, "mill") == "");
+
+    // Same winner and not edited: the registry is left alone
+    auto same = compile(buildings({building("granary", 45), building("barn", 5)}));
+    changed.clear();
+    resolver.reload_layer("farms", {same.get()}, {}, registry, changed);
+    CHECK(changed.empty());
+    CHECK(wood(registry, "barn") == 5.0f);
+
+    // Base reloads while the mod still wins its records
+    auto base_edit = compile(buildings({building("granary", 31), building("mill", 11)}));
+    changed.clear();
+    resolver.reload_layer("", {base_edit.get()}, {{RecordKind::BUILDING, "granary"}, {RecordKind::BUILDING, "mill"}},
+                          registry, changed);
+    CHECK(wood(registry, "granary") == 45.0f && wood(registry, "mill") == 11.0f);
+    CHECK(!has_change(changed, "granary") && has_change(changed, "mill"));
+}
+
+void test_numeric_conditions_keep_numbers() {
+    GameDataRegistry registry;
+    ingest(registry, dictionary({{"events", array({dictionary({
+        {"id", string("riot")},
+        {"conditions", dictionary({{"unrest", number(12.5)}, {"prosperity", string("< 20")}})},
+    })})}}));
+    auto conditions = registry.view(registry.event(registry.find_event("riot")).conditions);
+    CHECK(conditions.size() == 2);
+    for (const auto& condition : conditions) {
+        if (registry.text(condition.stat) == "unrest") {
+            CHECK(condition.is_number() && condition.number == 12.5);
+        } else {
+            CHECK(!condition.is_number() && registry.text(condition.expression) == "< 20");
+        }
+    }
+}
+
+void test_cache_rejects_corrupt_children() {
+    DataCacheWriter writer;
+    write(writer, writer.reserve(1), array({number(1.0), number(2.0)}));
+    std::vector<uint8_t> image = writer.finish(1);
+    DataCache cache;
+    CHECK(cache.open_image(image, 1));
+
+    // A child index that wraps around when the span is added
+    size_t root_at = DataCacheFormat::align8(sizeof(DataCacheFormat::Header));
+    DataCacheFormat::Node root;
+    std::memcpy(&root, image.data() + root_at, sizeof(root));
+    root.first = std::numeric_limits<uint64_t>::max();
+    std::memcpy(image.data() + root_at, &root, sizeof(root));
+    CHECK(!cache.open_image(image, 1));
+    CHECK(!cache.is_open());
+
+    // A node count too large for the file
+    std::vector<uint8_t> oversized = writer.finish(1);
+    DataCacheFormat::Header header;
+    std::memcpy(&header, oversized.data(), sizeof(header));
+    header.node_count = std::numeric_limits<uint64_t>::max() / sizeof(DataCacheFormat::Node) + 2;
+    std::memcpy(oversized.data(), &header, sizeof(header));
+    CHECK(!cache.open_image(oversized, 1));
+}
+
+} // namespace
+
+int main() {
+    test_references_resolve();
+    test_replacement_compacts_pools();
+    test_clear_bumps_generation();
+    test_full_resolve_keeps_record_ids();
+    test_set_enabled_is_incremental();
+    test_reload_layer_reports_edits();
+    test_numeric_conditions_keep_numbers();
+    test_cache_rejects_corrupt_children();
+    return TEST_RESULT();
+}
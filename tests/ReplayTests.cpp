@@ -0,0 +1,211 @@
+#include "Systems/NodeSimulationReplay.hpp"
+#include "TestHarness.hpp"
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace Systems;
+
+namespace {
+
+constexpr uint32_t TICKS_PER_SECOND = 30;
+constexpr uint32_t NUDGE = 1;  // Input channel: {node, delta} added to prosperity
+
+struct Nudge {
+    uint32_t node;
+    float delta;
+};
+
+std::filesystem::path scratch_directory() {
+    auto directory = std::filesystem::temp_directory_path() / "gameai_replay_tests";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+NodeStatColumns starting_columns() {
+    // More than one kernel chunk, so the pool splits the work
+    NodeStatColumns stats;
+    stats.resize(NodeStatKernel::CHUNK * 2 + 100);
+    for (size_t i = 0; i < stats.size(); ++i) {
+        stats.economic_prosperity[i] = static_cast<float>(i % 100);
+        stats.resource_availability[i] = static_cast<float>((i * 7) % 100);
+        stats.population_density[i] = static_cast<float>((i * 13) % 100);
+        stats.environmental_health[i] = 50.0f;
+        stats.medical_resources[i] = static_cast<float>((i * 3) % 100);
+        stats.health_risk[i] = 40.0f;
+        stats.research_investment[i] = static_cast<float>((i * 11) % 100);
+    }
+    return stats;
+}
+
+void apply_nudge(NodeStatColumns& stats, uint32_t channel, const uint8_t* data, size_t size) {
+    Nudge nudge;
+    if (channel != NUDGE || size != sizeof(nudge)) return;
+    std::memcpy(&nudge, data, sizeof(nudge));
+    stats.modify(&NodeStatColumns::economic_prosperity, nudge.node, nudge.delta);
+}
+
+// A game handler that acts on events by changing the columns
+void after_step(NodeStatColumns& stats, const std::vector<NodeEvent>& events, const NodeStatMeans&) {
+    for (const auto& event : events) {
+        if (event.kind == NodeEventKind::HEALTH_INCIDENT) stats.modify(&NodeStatColumns::health_risk, event.node, 5.0f);
+    }
+}
+
+NodeStatKernel::Chances busy_chances() {
+    NodeStatKernel::Chances chances;
+    for (float& chance : chances.per_tick) chance = 0.01f;
+    return chances;
+}
+
+// Records a run the way NodeSimulationSystem::update does; returns the
+// final checksum
+uint64_t record_run(const std::string& path, uint64_t world_seed, uint64_t ticks, ThreadPool* pool) {
+    Core::WorldSeed::get_instance().set(world_seed);
+    NodeStatColumns stats = starting_columns();
+    NodeSimulationTick simulation;
+    simulation.get_kernel().set_chances(busy_chances());
+    simulation.set_input_handler(apply_nudge);
+
+    Core::ReplayRecorder recorder;
+    CHECK(recorder.open(path, world_seed, TICKS_PER_SECOND));
+    const float dt = NodeSimulationReplay::tick_seconds(TICKS_PER_SECOND);
+    std::vector<NodeEvent> events;
+    for (uint64_t tick = 0; tick < ticks; ++tick) {
+        if (tick % 7 == 3) {
+            Nudge nudge{static_cast<uint32_t>(tick * 37 % stats.size()), tick % 2 ? 15.0f : -15.0f};
+            simulation.queue_input(NUDGE, reinterpret_cast<const uint8_t*>(&nudge), sizeof(nudge));
+            CHECK(recorder.record_input(tick, NUDGE, &nudge, sizeof(nudge)));
+        }
+        events.clear();
+        simulation.run(stats, dt, pool, events);
+        after_step(stats, events, simulation.get_kernel().last_means());
+        CHECK(recorder.record_checksum(tick, stats.checksum()));
+    }
+    recorder.close();
+    return stats.checksum();
+}
+
+NodeSimulationReplay replayer(ThreadPool* pool) {
+    NodeSimulationReplay replay;
+    replay.input_handler = apply_nudge;
+    replay.after_step = after_step;
+    replay.chances = busy_chances();
+    replay.pool = pool;
+    return replay;
+}
+
+void test_record_replay_round_trip(const std::filesystem::path& directory) {
+    ThreadPool pool(2);
+    std::string path = (directory / "round_trip.rpl").string();
+    uint64_t recorded = record_run(path, 0x5EED, 120, &pool);
+
+    // A later session starts with a different seed; the log brings back
+    // the recorded one, and threading does not matter
+    for (ThreadPool* replay_pool : {static_cast<ThreadPool*>(nullptr), &pool}) {
+        Core::WorldSeed::get_instance().set(1);
+        Core::ReplayReader reader;
+        CHECK(reader.open(path));
+        NodeStatColumns stats = starting_columns();
+        Core::ReplayPlayer::Result result = replayer(replay_pool).run(reader, stats);
+        CHECK(!result.desynced && !result.truncated);
+        CHECK(result.ticks == 120);
+        CHECK(stats.checksum() == recorded);
+        CHECK(Core::WorldSeed::get_instance().get() == 0x5EED);
+    }
+}
+
+void test_replay_reports_first_desync(const std::filesystem::path& directory) {
+    std::string path = (directory / "desync.rpl").string();
+    record_run(path, 77, 60, nullptr);
+
+    // Inputs handled differently than when recording: the first input is
+    // logged for tick 3
+    NodeSimulationReplay replay = replayer(nullptr);
+    replay.input_handler = [](NodeStatColumns& stats, uint32_t channel, const uint8_t* data, size_t size) {
+        apply_nudge(stats, channel, data, size);
+        apply_nudge(stats, channel, data, size);
+    };
+    Core::ReplayReader reader;
+    CHECK(reader.open(path));
+    NodeStatColumns stats = starting_columns();
+    Core::ReplayPlayer::Result result = replay.run(reader, stats);
+    CHECK(result.desynced && result.desync_tick == 3 && result.ticks == 4);
+    CHECK(result.expected != result.actual);
+
+    // A different starting state diverges on the first tick
+    CHECK(reader.open(path));
+    stats = starting_columns();
+    stats.health_risk[0] = 90.0f;
+    result = replayer(nullptr).run(reader, stats);
+    CHECK(result.desynced && result.desync_tick == 0);
+}
+
+void test_truncated_log_replays_whole_records(const std::filesystem::path& directory) {
+    std::string path = (directory / "truncated.rpl").string();
+    record_run(path, 9, 40, nullptr);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+
+    Core::ReplayReader reader;
+    CHECK(reader.open(path));
+    NodeStatColumns stats = starting_columns();
+    Core::ReplayPlayer::Result result = replayer(nullptr).run(reader, stats);
+    CHECK(!result.desynced && result.truncated);
+    CHECK(result.ticks == 39);
+}
+
+void test_recorder_rejects_backwards_ticks(const std::filesystem::path& directory) {
+    std::string path = (directory / "backwards.rpl").string();
+    Core::ReplayRecorder recorder;
+    CHECK(!recorder.record_input(0, NUDGE, "x", 1));
+    CHECK(recorder.open(path, 5, TICKS_PER_SECOND));
+    CHECK(recorder.record_input(4, NUDGE, "a", 1));
+    CHECK(!recorder.record_input(3, NUDGE, "b", 1));
+    CHECK(recorder.record_event(4, 2, "c"));
+    CHECK(recorder.record_checksum(6, 42));
+    recorder.close();
+
+    Core::ReplayReader reader;
+    Core::ReplayReader::Record record;
+    CHECK(reader.open(path) && reader.world_seed() == 5);
+    CHECK(reader.next(record) && record.tick == 4 && record.data[0] == 'a');
+    CHECK(reader.next(record) && record.tick == 4 && record.kind == Core::ReplayFormat::Kind::EVENT);
+    CHECK(reader.next(record) && record.tick == 6 && record.kind == Core::ReplayFormat::Kind::CHECKSUM);
+    CHECK(!reader.next(record) && !reader.is_truncated());
+}
+
+void test_draws_depend_only_on_key() {
+    Core::WorldSeed::get_instance().set(123);
+    uint64_t stream = Core::WorldSeed::get_instance().derive("waypoint_traits");
+    uint64_t first = Core::WorldSeed::draw(stream, 7, 100);
+    CHECK(Core::WorldSeed::draw(stream, 8, 100) != first);
+    CHECK(Core::WorldSeed::draw(stream, 7, 101) != first);
+    CHECK(Core::WorldSeed::draw(stream, 7, 100) == first);
+
+    Core::WorldSeed::get_instance().set(124);
+    CHECK(Core::WorldSeed::get_instance().derive("waypoint_traits") != stream);
+
+    // Rolls below a chance come up at about that rate
+    size_t hits = 0;
+    for (uint64_t tick = 0; tick < 10000; ++tick) {
+        float roll = Core::WorldSeed::unit(Core::WorldSeed::draw(stream, 1, tick));
+        CHECK(roll >= 0.0f && roll < 1.0f);
+        hits += roll < 0.3f;
+    }
+    CHECK(hits > 2800 && hits < 3200);
+}
+
+} // namespace
+
+int main() {
+    auto directory = scratch_directory();
+    test_record_replay_round_trip(directory);
+    test_replay_reports_first_desync(directory);
+    test_truncated_log_replays_whole_records(directory);
+    test_recorder_rejects_backwards_ticks(directory);
+    test_draws_depend_only_on_key();
+    std::filesystem::remove_all(directory);
+    return TEST_RESULT();
+}
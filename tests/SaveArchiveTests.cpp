@@ -0,0 +1,256 @@
+#include "Core/Autosave.hpp"
+#include "Core/SaveRegistry.hpp"
+#include "TestHarness.hpp"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Core;
+
+namespace {
+
+std::filesystem::path scratch_directory() {
+    auto directory = std::filesystem::temp_directory_path() / "gameai_save_archive_tests";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+std::vector<float> wave(size_t count, float phase) {
+    std::vector<float> values(count);
+    for (size_t i = 0; i < count; ++i) values[i] = 20.0f + 5.0f * std::sin(0.001f * i + phase);
+    return values;
+}
+
+bool codec_round_trips(const std::vector<uint8_t>& raw, uint32_t element_size, ChunkCodec::Method* used = nullptr) {
+    std::vector<uint8_t> stored;
+    ChunkCodec::Method method = ChunkCodec::compress(raw.data(), raw.size(), element_size, stored);
+    if (used) *used = method;
+    std::vector<uint8_t> decoded(raw.size());
+    return ChunkCodec::decompress(method, stored.data(), stored.size(), element_size, decoded.data(), raw.size()) &&
+           decoded == raw;
+}
+
+void test_codec_round_trip() {
+    std::vector<float> floats = wave(4096, 0.0f);
+    std::vector<uint8_t> columns(reinterpret_cast<const uint8_t*>(floats.data()),
+                                 reinterpret_cast<const uint8_t*>(floats.data() + floats.size()));
+    ChunkCodec::Method method;
+    CHECK(codec_round_trips(columns, 4, &method));
+    CHECK(method == ChunkCodec::Method::SHUFFLE_LZ);
+
+    std::string text;
+    for (int i = 0; i < 500; ++i) text += "Trading Hub;Fortress Evolution;";
+    CHECK(codec_round_trips(std::vector<uint8_t>(text.begin(), text.end()), 1, &method));
+    CHECK(method == ChunkCodec::Method::LZ);
+
+    // Noise does not shrink, so it is stored as is
+    std::mt19937 rng(7);
+    std::vector<uint8_t> noise(10000);
+    for (auto& byte : noise) byte = static_cast<uint8_t>(rng());
+    CHECK(codec_round_trips(noise, 1, &method));
+    CHECK(method == ChunkCodec::Method::STORE);
+
+    CHECK(codec_round_trips({}, 4));
+    CHECK(codec_round_trips({42}, 4));
+}
+
+void test_codec_rejects_truncated_input() {
+    std::string text;
+    for (int i = 0; i < 200; ++i) text += "abcabcabd";
+    std::vector<uint8_t> stored;
+    auto method = ChunkCodec::compress(reinterpret_cast<const uint8_t*>(text.data()), text.size(), 1, stored);
+    CHECK(method == ChunkCodec::Method::LZ);
+    std::vector<uint8_t> decoded(text.size());
+    CHECK(!ChunkCodec::decompress(method, stored.data(), stored.size() / 2, 1, decoded.data(), decoded.size()));
+}
+
+void test_sections_round_trip(const std::filesystem::path& directory) {
+    // Larger than one chunk, so the section spans several
+    std::vector<float> temperatures = wave(200000, 0.5f);
+    std::vector<int32_t> ids = {3, 1, 4, 1, 5};
+
+    SaveWriter writer;
+    SaveSection& climate = writer.add_section("climate");
+    climate.put_array(temperatures);
+    SaveSection& waypoints = writer.add_section("waypoints", 1);
+    waypoints.put<uint64_t>(2);
+    waypoints.put_string("North Gate");
+    waypoints.put_array(ids);
+
+    ThreadPool pool(2);
+    std::string path = (directory / "round_trip.sav").string();
+    CHECK(writer.write(path, &pool));
+    CHECK(std::filesystem::file_size(path) < temperatures.size() * sizeof(float));
+
+    SaveReader reader;
+    CHECK(reader.open(path));
+    CHECK(reader.section_names() == std::vector<std::string>({"climate", "waypoints"}));
+    CHECK(!reader.has_section("voters"));
+
+    SaveSectionReader section;
+    std::vector<float> loaded;
+    CHECK(reader.load("climate", section, &pool));
+    CHECK(section.get_array(loaded) && section.at_end());
+    CHECK(loaded == temperatures);
+
+    uint64_t count = 0;
+    std::string name;
+    std::vector<int32_t> loaded_ids;
+    CHECK(reader.load("waypoints", section));
+    CHECK(section.get(count) && section.get_string(name) && section.get_array(loaded_ids));
+    CHECK(count == 2 && name == "North Gate" && loaded_ids == ids);
+    CHECK(!section.get(count) && !section.ok());
+
+    // A range straddling the first chunk boundary, past the count prefix
+    size_t first = SaveFormat::CHUNK_SIZE / sizeof(float) - 10;
+    std::vector<float> range(20);
+    CHECK(reader.read("climate", sizeof(uint64_t) + first * sizeof(float), range.data(), range.size() * sizeof(float)));
+    CHECK(std::equal(range.begin(), range.end(), temperatures.begin() + first));
+    CHECK(!reader.read("climate", reader.section_size("climate") - 2, range.data(), 4));
+}
+
+void test_corrupt_chunk_rejected(const std::filesystem::path& directory) {
+    SaveWriter writer;
+    writer.add_section("climate").put_array(wave(1000, 0.0f));
+    std::string path = (directory / "corrupt.sav").string();
+    CHECK(writer.write(path));
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(sizeof(SaveFormat::Header) + 4);
+        file.put('\x5A');
+    }
+
+    SaveReader reader;
+    SaveSectionReader section;
+    CHECK(reader.open(path));
+    CHECK(!reader.load("climate", section));
+}
+
+void test_delta_references_base(const std::filesystem::path& directory) {
+    std::vector<float> temperatures = wave(300000, 0.0f);
+    SaveWriter writer;
+    SaveBaseline baseline;
+    writer.add_section("climate").put_array(temperatures);
+    std::string base_path = (directory / "base.sav").string();
+    CHECK(writer.write(base_path, nullptr, &baseline));
+
+    // One value in the last chunk changes; the other chunks are references
+    temperatures.back() = -40.0f;
+    writer.add_section("climate").put_array(temperatures);
+    std::string delta_path = (directory / "delta.sav").string();
+    CHECK(writer.write_delta(delta_path, baseline, nullptr, &baseline));
+    CHECK(std::filesystem::file_size(delta_path) * 4 < std::filesystem::file_size(base_path));
+
+    SaveReader reader;
+    SaveSectionReader section;
+    std::vector<float> loaded;
+    CHECK(reader.open(delta_path));
+    CHECK(reader.section_names() == std::vector<std::string>({"climate"}));
+    CHECK(reader.load("climate", section) && section.get_array(loaded));
+    CHECK(loaded == temperatures);
+
+    std::filesystem::remove(base_path);
+    CHECK(!reader.open(delta_path));
+}
+
+void test_registry_saves_and_loads(const std::filesystem::path& directory) {
+    std::vector<float> prosperity = {1.0f, 2.0f, 3.0f};
+    std::string label = "north";
+
+    SavedSection stats;
+    CHECK(stats.bind("node_stats", 4,
+        [&](SaveSection& section) { section.put_array(prosperity); },
+        [&](SaveSectionReader& section) { return section.get_array(prosperity); }));
+    SavedSection duplicate;
+    CHECK(!duplicate.bind("node_stats", 4, [](SaveSection&) {}, [](SaveSectionReader&) { return true; }));
+
+    std::string long_key = "voters:" + std::string(40, 'x');
+    std::string other_long_key = long_key + "y";
+    CHECK(SaveRegistry::section_name(long_key).size() < SaveFormat::NAME_SIZE);
+    CHECK(SaveRegistry::section_name(long_key) != SaveRegistry::section_name(other_long_key));
+    {
+        SavedSection voters;
+        CHECK(voters.bind(long_key, 1,
+            [&](SaveSection& section) { section.put_string(label); },
+            [&](SaveSectionReader& section) { return section.get_string(label); }));
+
+        std::string path = (directory / "registry.sav").string();
+        CHECK(SaveRegistry::get_instance().save(path));
+        prosperity.assign(3, 0.0f);
+        label.clear();
+        CHECK(SaveRegistry::get_instance().load(path));
+        CHECK(prosperity == std::vector<float>({1.0f, 2.0f, 3.0f}));
+        CHECK(label == "north");
+    }
+
+    // Sections of systems that went away drop out of a reused writer
+    CHECK(SaveRegistry::get_instance().size() == 1);
+    SaveWriter writer;
+    writer.add_section("stale").put<int32_t>(1);
+    SaveRegistry::get_instance().capture(writer);
+    std::string path = (directory / "capture.sav").string();
+    CHECK(writer.write(path));
+    SaveReader reader;
+    CHECK(reader.open(path));
+    CHECK(reader.section_names() == std::vector<std::string>({"node_stats"}));
+}
+
+size_t autosave_files(const std::filesystem::path& directory) {
+    size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        count += entry.path().extension() == ".sav";
+    }
+    return count;
+}
+
+void test_autosave_chains(const std::filesystem::path& root) {
+    auto directory = root / "autosaves";
+    std::filesystem::create_directories(directory);
+    std::ofstream(directory / "autosave_41.sav") << "left by an earlier session";
+
+    std::vector<float> column = wave(100000, 0.0f);
+    Autosave autosave(directory.string(),
+        [&column](SaveWriter& writer) { writer.add_section("column").put_array(column); }, 2);
+
+    CHECK(!autosave.at_tick_boundary());
+    for (int save = 0; save < 4; ++save) {
+        column[static_cast<size_t>(save)] = -1.0f;
+        autosave.request();
+        CHECK(autosave.at_tick_boundary());
+        autosave.flush();
+        CHECK(!autosave.last_save_failed());
+        if (save == 0) {
+            // The earlier session's file goes with the first full save
+            CHECK(autosave.latest_save() == (directory / "autosave_42.sav").string());
+            CHECK(autosave_files(directory) == 1);
+        }
+    }
+
+    // Full, delta, delta, then a new full save replaces that chain
+    CHECK(autosave_files(directory) == 1);
+    SaveReader reader;
+    SaveSectionReader section;
+    std::vector<float> loaded;
+    CHECK(reader.open(autosave.latest_save()));
+    CHECK(reader.load("column", section) && section.get_array(loaded));
+    CHECK(loaded == column);
+}
+
+} // namespace
+
+int main() {
+    auto directory = scratch_directory();
+    test_codec_round_trip();
+    test_codec_rejects_truncated_input();
+    test_sections_round_trip(directory);
+    test_corrupt_chunk_rejected(directory);
+    test_delta_references_base(directory);
+    test_registry_saves_and_loads(directory);
+    test_autosave_chains(directory);
+    std::filesystem::remove_all(directory);
+    return TEST_RESULT();
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdio>
+
+// Minimal checks for the engine-independent C++ tests. Each test file is
+// its own executable; a failed CHECK is reported and the run continues,
+// and TEST_RESULT() turns the failure count into the exit code for ctest.
+namespace test_harness {
+    inline int& failures() {
+        static int count = 0;
+        return count;
+    }
+}
+
+#define CHECK(condition)                                                           \
+    do {                                                                           \
+        if (!(condition)) {                                                        \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, \
+                         #condition);                                              \
+            ++test_harness::failures();                                            \
+        }                                                                          \
+    } while (0)
+
+#define TEST_RESULT() (test_harness::failures() == 0 ? 0 : 1)
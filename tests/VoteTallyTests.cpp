@@ -0,0 +1,150 @@
+#include "AI/Labor/VoteTally.hpp"
+#include "TestHarness.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> proposals(int count) {
+    std::vector<std::string> names;
+    for (int i = 0; i < count; ++i) names.push_back("p" + std::to_string(i));
+    return names;
+}
+
+// A clear first-round majority wins in one round
+void test_first_round_majority() {
+    VoteTally tally;
+    tally.add_ranked_ballot({"a", "b"}, 3.0f);
+    tally.add_ranked_ballot({"b", "a"}, 2.0f);
+    auto outcome = tally.ranked_choice();
+    CHECK(tally.proposal_name(outcome.winner) == "a");
+    CHECK(outcome.majority);
+    CHECK(outcome.rounds == 1);
+}
+
+// Eliminated proposals hand their ballots to the next preference
+void test_transfers() {
+    VoteTally tally;
+    tally.add_ranked_ballot({"a"}, 4.0f);
+    tally.add_ranked_ballot({"b"}, 3.0f);
+    tally.add_ranked_ballot({"c", "b"}, 2.0f);
+    auto outcome = tally.ranked_choice();
+    CHECK(tally.proposal_name(outcome.winner) == "b");
+    CHECK(outcome.winner_total == 5.0f);
+    CHECK(outcome.majority);
+}
+
+// Exhausted ballots leave the count instead of propping up a majority
+void test_exhausted_ballots() {
+    VoteTally tally;
+    tally.add_ranked_ballot({"a"}, 3.0f);
+    tally.add_ranked_ballot({"b"}, 2.0f);
+    tally.add_ranked_ballot({"c"}, 1.0f);
+    auto outcome = tally.ranked_choice();
+    CHECK(tally.proposal_name(outcome.winner) == "a");
+    CHECK(outcome.total == 5.0f);
+}
+
+// Preferences far down a long ballot still transfer
+void test_long_ballots_keep_every_preference() {
+    auto names = proposals(12);
+    VoteTally tally;
+    // p1..p10 are eliminated in turn, so the ballot ends up on its twelfth
+    // preference p11, which then beats p0
+    std::vector<std::string> long_ballot(names.begin() + 1, names.end());
+    tally.add_ranked_ballot(long_ballot, 3.0f);
+    tally.add_ranked_ballot({"p0"}, 4.0f);
+    tally.add_ranked_ballot({"p11"}, 4.0f);
+
+    auto outcome = tally.ranked_choice();
+    CHECK(outcome.winner != VoteTally::NO_CHOICE);
+    CHECK(tally.proposal_name(outcome.winner) == "p11");
+    CHECK(outcome.winner_total == 7.0f);
+    CHECK(outcome.majority);
+}
+
+// clear() keeps the tally reusable across elections
+void test_reuse_after_clear() {
+    VoteTally tally;
+    tally.add_ranked_ballot({"a", "b", "c"}, 1.0f);
+    tally.ranked_choice();
+    tally.clear();
+    tally.add_ranked_ballot({"x"}, 1.0f);
+    auto outcome = tally.ranked_choice();
+    CHECK(tally.proposal_count() == 1);
+    CHECK(tally.proposal_name(outcome.winner) == "x");
+}
+
+// Delegated weight follows the chain to the voter who casts a ballot
+void test_delegation_chain() {
+    VoteTally tally;
+    tally.add_delegation("a", "b", 1.0f);
+    tally.add_delegation("b", "c", 1.0f);
+    tally.add_ballot("c", "x", 1.0f);
+    tally.add_ballot("d", "y", 2.5f);
+    auto outcome = tally.liquid_democracy();
+    CHECK(tally.proposal_name(outcome.winner) == "x");
+    CHECK(outcome.winner_total == 3.0f);
+    CHECK(tally.totals()[tally.intern_proposal("y")] == 2.5f);
+    CHECK(tally.delegation_cycles().empty());
+}
+
+// The link that closes a cycle is reported, and neither the cycle nor
+// chains leading into it count toward any proposal
+void test_delegation_cycle() {
+    VoteTally tally;
+    tally.add_delegation("a", "b", 1.0f);
+    tally.add_delegation("b", "a", 1.0f);
+    tally.add_delegation("d", "a", 1.0f);
+    tally.add_ballot("c", "x", 1.0f);
+    auto outcome = tally.liquid_democracy();
+    CHECK(tally.delegation_cycles().size() == 1);
+    CHECK(tally.proposal_name(outcome.winner) == "x");
+    CHECK(outcome.winner_total == 1.0f);
+    CHECK(outcome.total == 1.0f);
+}
+
+// A direct ballot keeps the voter's weight even if they also delegated
+void test_direct_vote_overrides_delegation() {
+    VoteTally tally;
+    tally.add_delegation("a", "b", 1.0f);
+    tally.add_ballot("a", "y", 1.0f);
+    tally.add_ballot("b", "x", 2.0f);
+    auto outcome = tally.liquid_democracy();
+    CHECK(tally.proposal_name(outcome.winner) == "x");
+    CHECK(outcome.winner_total == 2.0f);
+    CHECK(tally.totals()[tally.intern_proposal("y")] == 1.0f);
+}
+
+// Ballots count the square root of the credits spent; negative credits
+// count nothing. Enough ballots to cover the vector loop and its tail.
+void test_quadratic() {
+    VoteTally tally;
+    for (int i = 0; i < 9; ++i) tally.add_ballot("many" + std::to_string(i), "a", 1.0f);
+    tally.add_ballot("rich", "b", 64.0f);
+    tally.add_ballot("broke", "c", -4.0f);
+    auto outcome = tally.quadratic();
+    CHECK(tally.proposal_name(outcome.winner) == "a");
+    CHECK(outcome.winner_total == 9.0f);
+    CHECK(tally.totals()[tally.intern_proposal("b")] == 8.0f);
+    CHECK(tally.totals()[tally.intern_proposal("c")] == 0.0f);
+    CHECK(outcome.total == 17.0f);
+
+    // Plurality counts the credits themselves
+    CHECK(tally.proposal_name(tally.plurality().winner) == "b");
+}
+
+} // namespace
+
+int main() {
+    test_first_round_majority();
+    test_transfers();
+    test_exhausted_ballots();
+    test_long_ballots_keep_every_preference();
+    test_reuse_after_clear();
+    test_delegation_chain();
+    test_delegation_cycle();
+    test_direct_vote_overrides_delegation();
+    test_quadratic();
+    return TEST_RESULT();
+}